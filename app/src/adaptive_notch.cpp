@@ -0,0 +1,174 @@
+/**
+ * @file adaptive_notch.cpp
+ * @brief LMS-adapted IIR notch cascade. See adaptive_notch.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "adaptive_notch.h"
+
+namespace audio {
+
+namespace {
+
+constexpr int kQ = AdaptiveNotch::kCoefBits;
+constexpr int32_t kOne = int32_t{1} << kQ;
+
+/* Start coefficients -2*cos(2*pi*f/8000) in Q29 for 50, 100, 150, 200 Hz. */
+constexpr int32_t kStartA[AdaptiveNotch::kMaxSections] = {-1072914008, -1070431836, -1066299136, -1060522280};
+
+/* pi / 8000 in Q29: r = 1 - pi * bandwidth / fs. */
+constexpr int32_t kPiOverFs = 210829;
+
+/* a stays inside (-2, 2); the state is bounded well below int32 at r <= 0.9996. */
+constexpr int32_t kMaxA = 2 * kOne - 1;
+constexpr int32_t kMaxState = int32_t{1} << 30;
+
+/* Power smoothing: 1/256 per sample, a 32 ms time constant. */
+constexpr int kPowerShift = 8;
+/* Below this input power (about 8 LSB rms) a section never counts as locked. */
+constexpr int64_t kMinLockPower = 64;
+
+/* Crossfade weight resolution, as in Emphasis. */
+constexpr int kFadeBits = 14;
+
+inline int32_t clamp32(int64_t v, int32_t lim) {
+  if (v > lim) {
+    return lim;
+  }
+  if (v < -lim) {
+    return -lim;
+  }
+  return static_cast<int32_t>(v);
+}
+
+inline int16_t sat16(int32_t v) {
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(v);
+}
+
+int bit_length(uint64_t v) {
+  int n = 0;
+  while (v != 0U) {
+    v >>= 1;
+    n++;
+  }
+  return n;
+}
+
+} // namespace
+
+AdaptiveNotch::AdaptiveNotch(const Config &cfg, bool enabled) : cfg_(cfg), enabled_(enabled) {
+  if (cfg_.sections < 1) {
+    cfg_.sections = 1;
+  }
+  if (cfg_.sections > kMaxSections) {
+    cfg_.sections = kMaxSections;
+  }
+  if (cfg_.bandwidth_hz < 1) {
+    cfg_.bandwidth_hz = 1;
+  }
+  if (cfg_.bandwidth_hz > 400) {
+    cfg_.bandwidth_hz = 400;
+  }
+  r_ = kOne - cfg_.bandwidth_hz * kPiOverFs;
+  r2_ = static_cast<int32_t>((static_cast<int64_t>(r_) * r_) >> kQ);
+  reset();
+}
+
+void AdaptiveNotch::reset() {
+  for (size_t i = 0; i < kMaxSections; i++) {
+    sec_[i] = Section{};
+    sec_[i].a = kStartA[i];
+    sec_[i].a_window = kStartA[i];
+  }
+  window_n_ = 0;
+}
+
+AdaptiveNotch::SectionStatus AdaptiveNotch::section(size_t i) const {
+  const Section &s = sec_[i];
+  return {s.a, s.locked, s.locks, s.converge_samples, static_cast<uint64_t>(s.p_in), static_cast<uint64_t>(s.p_out)};
+}
+
+int32_t AdaptiveNotch::step(Section &sec, int32_t x, int shift) {
+  const int32_t ra = static_cast<int32_t>((static_cast<int64_t>(r_) * sec.a) >> kQ);
+  const int64_t acc = (static_cast<int64_t>(x) << kQ) - static_cast<int64_t>(ra) * sec.s1 - static_cast<int64_t>(r2_) * sec.s2;
+  const int32_t s = clamp32((acc + (int64_t{1} << (kQ - 1))) >> kQ, kMaxState);
+  const int64_t y = s + ((static_cast<int64_t>(sec.a) * sec.s1) >> kQ) + sec.s2;
+
+  /* LMS on the output power: the gradient of y^2 in a is about 2*y*s1. */
+  const int64_t g = y * sec.s1;
+  const int64_t delta = shift >= 0 ? g >> shift : g * (int64_t{1} << -shift);
+  sec.a = clamp32(static_cast<int64_t>(sec.a) - delta, kMaxA);
+
+  sec.s2 = sec.s1;
+  sec.s1 = s;
+  sec.p_s1 += (static_cast<int64_t>(s) * s - sec.p_s1) >> kPowerShift;
+  sec.p_in += (static_cast<int64_t>(x) * x - sec.p_in) >> kPowerShift;
+  const int32_t out = clamp32(y, INT32_MAX);
+  sec.p_out += (static_cast<int64_t>(out) * out - sec.p_out) >> kPowerShift;
+  return out;
+}
+
+void AdaptiveNotch::check_lock(Section &sec) {
+  const int64_t moved = sec.a > sec.a_window ? static_cast<int64_t>(sec.a) - sec.a_window : static_cast<int64_t>(sec.a_window) - sec.a;
+  sec.a_window = sec.a;
+  if (!sec.locked) {
+    sec.since_unlock += kLockWindow;
+    if (moved < kLockDelta && sec.p_in >= kMinLockPower && 8 * (sec.p_in - sec.p_out) >= sec.p_in) {
+      sec.locked = true;
+      sec.locks++;
+      sec.converge_samples = sec.since_unlock;
+    }
+  } else if (moved > 4 * static_cast<int64_t>(kLockDelta) || sec.p_in < kMinLockPower || 16 * (sec.p_in - sec.p_out) < sec.p_in) {
+    sec.locked = false;
+    sec.since_unlock = 0;
+  }
+}
+
+void AdaptiveNotch::process(int16_t *samples, size_t count, bool enabled) {
+  if (count == 0) {
+    return;
+  }
+
+  /* Normalised step, rounded to a shift once per block: 2^-mu / P. */
+  int shift[kMaxSections];
+  for (size_t k = 0; k < cfg_.sections; k++) {
+    shift[k] = bit_length(static_cast<uint64_t>(sec_[k].p_s1) + 1U) + cfg_.mu_shift - kQ;
+  }
+
+  const bool fade = enabled != enabled_;
+  const int64_t n = static_cast<int64_t>(count);
+  for (size_t i = 0; i < count; i++) {
+    const int32_t dry = samples[i];
+    int32_t v = dry;
+    for (size_t k = 0; k < cfg_.sections; k++) {
+      v = step(sec_[k], v, shift[k]);
+    }
+    const int32_t wet = sat16(v);
+    if (fade) {
+      int32_t w = static_cast<int32_t>((static_cast<int64_t>(i + 1) << kFadeBits) / n);
+      if (!enabled) {
+        w = (1 << kFadeBits) - w;
+      }
+      samples[i] = sat16(dry + (((wet - dry) * w) >> kFadeBits));
+    } else if (enabled) {
+      samples[i] = static_cast<int16_t>(wet);
+    }
+
+    if (++window_n_ == kLockWindow) {
+      window_n_ = 0;
+      for (size_t k = 0; k < cfg_.sections; k++) {
+        check_lock(sec_[k]);
+      }
+    }
+  }
+  enabled_ = enabled;
+}
+
+} // namespace audio
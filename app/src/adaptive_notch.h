@@ -0,0 +1,114 @@
+/**
+ * @file adaptive_notch.h
+ * @brief LMS-adapted IIR notch cascade for hum and stray tones on RX audio.
+ *
+ * Each section is a constrained second-order notch, zeros on the unit circle
+ * and poles just inside at radius r (set by the notch bandwidth):
+ *
+ *   s[n] = x[n] - r*a*s[n-1] - r^2*s[n-2]
+ *   y[n] = s[n] + a*s[n-1] + s[n-2]            a = -2*cos(w0)
+ *
+ * The single coefficient a follows the simplified LMS gradient
+ * a -= mu * y[n] * s[n-1] / P, with P the smoothed power of s[n-1] rounded
+ * to a power of two (one shift per block, no divide), so the notch walks onto
+ * the strongest narrowband component and stays there while it moves. Sections
+ * run in cascade: the second one sees what the first left over and settles on
+ * the next strongest tone (a mains harmonic, a second carrier). They start at
+ * 50, 100, 150 and 200 Hz, i.e. on mains hum.
+ *
+ * Per section the unit reports the coefficient (frequency = acos(-a/2) * fs /
+ * 2pi), smoothed input and output power (depth = their ratio; first input
+ * over last output for the cascade) and a lock flag: set once a moved less
+ * than kLockDelta over a kLockWindow-sample window while the section removed
+ * at least 1/8 of its input power, cleared when it moves four times that or
+ * removes less than 1/16. A notch wandering over noise or voice removes far
+ * less. The samples from reset (or the last unlock) to lock are the
+ * convergence time.
+ *
+ * The cascade always adapts, so telemetry shows a hum even while the notch is
+ * switched out; switching is crossfaded across one block like the emphasis
+ * filter. Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_ADAPTIVE_NOTCH_H_
+#define OE5XRX_AUDIO_ADAPTIVE_NOTCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+class AdaptiveNotch {
+public:
+  /** Capture rate the bandwidth and the start frequencies refer to. */
+  static constexpr uint32_t kSampleRate = 8000;
+  static constexpr size_t kMaxSections = 4;
+  /** Coefficient a is Q29 (range +-2 plus headroom). */
+  static constexpr int kCoefBits = 29;
+  /** Lock test window, samples (32 ms). */
+  static constexpr uint32_t kLockWindow = 256;
+  /** Largest coefficient move over a window that still counts as settled (2e-4). */
+  static constexpr int32_t kLockDelta = 107374;
+
+  struct Config {
+    uint8_t sections;      /* 1 .. kMaxSections */
+    uint16_t bandwidth_hz; /* -3 dB notch width, 1 .. 400 */
+    uint8_t mu_shift;      /* adaptation step 2^-mu_shift; larger = slower, steadier */
+  };
+
+  struct SectionStatus {
+    int32_t a;                 /* Q29 */
+    bool locked;
+    uint32_t locks;            /* lock events since reset */
+    uint32_t converge_samples; /* reset / unlock to the last lock */
+    uint64_t power_in;         /* smoothed x^2 into this section */
+    uint64_t power_out;        /* smoothed y^2 out of it */
+  };
+
+  explicit AdaptiveNotch(const Config &cfg, bool enabled = false);
+
+  /** Back to the start frequencies with cleared history and counters. */
+  void reset();
+
+  /**
+   * Filter one block in place. @p enabled is the wanted state for this block;
+   * a change versus the previous block is crossfaded across this block.
+   */
+  void process(int16_t *samples, size_t count, bool enabled);
+
+  bool enabled() const { return enabled_; }
+  size_t sections() const { return cfg_.sections; }
+  SectionStatus section(size_t i) const;
+
+private:
+  struct Section {
+    int32_t a;
+    int32_t s1;
+    int32_t s2;
+    int64_t p_s1;   /* smoothed s1^2, the LMS normaliser */
+    int64_t p_in;
+    int64_t p_out;
+    int32_t a_window; /* a at the start of the lock window */
+    bool locked;
+    uint32_t locks;
+    uint32_t since_unlock;
+    uint32_t converge_samples;
+  };
+
+  /* One sample through section @p sec; @p shift is the block's LMS shift. */
+  int32_t step(Section &sec, int32_t x, int shift);
+  void check_lock(Section &sec);
+
+  Config cfg_;
+  int32_t r_;  /* pole radius, Q29 */
+  int32_t r2_; /* r^2, Q29 */
+  Section sec_[kMaxSections];
+  uint32_t window_n_ = 0;
+  bool enabled_;
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_ADAPTIVE_NOTCH_H_ */
@@ -0,0 +1,267 @@
+/**
+ * @file audio_module.cpp
+ * @brief `audio` module: run-time buffer, latency and gain settings.
+ *
+ * The USB audio bridge rings and the audio_stream gains as module settings,
+ * so latency can be traded against drop-out margin per site without a
+ * rebuild (`module audio set tx_setpoint 24`). Ring sizes stay static; the
+ * settings move the operating point inside them. Telemetry reports what a
+ * setting bought: the ring latencies at the last SOF and the drop rates.
+ * With CONFIG_APP_AUDIO_NOTCH it also carries the adaptive notch telemetry:
+ * the cascade depth and, per section, tracked frequency, depth, lock and
+ * convergence time.
+ *
+ * Settings are not persisted; a reboot restores the build defaults.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#ifdef CONFIG_MODULE_SA818
+
+#include "audio_module.h"
+
+#include "audio_stream.h"
+#include "usb_audio_bridge.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+namespace {
+
+using mod::Capability;
+using mod::FieldSpec;
+using mod::Identity;
+using mod::Module;
+using mod::Range;
+using mod::Result;
+using mod::Setting;
+using mod::Telemetry;
+using mod::ValueType;
+using Snapshot = usb_audio::BridgeStats::Snapshot;
+using usb_audio::BridgeStats;
+
+/* 8 kHz: samples per ms. */
+constexpr double kSamplesPerMs = 8.0;
+
+/* Shell argv token -> integer; the whole token must parse. */
+bool parse_int(const char *s, long *out) {
+  if (s == nullptr || *s == '\0') {
+    return false;
+  }
+  char *end;
+  errno = 0;
+  *out = strtol(s, &end, 10);
+  return *end == '\0' && errno == 0;
+}
+
+const Range SETPOINT_RANGES[] = {{nullptr, 1.0, USB_AUDIO_BRIDGE_RING_FRAMES / 2}};
+/* The bridge further rejects a prebuffer above the current set point. */
+const Range PREBUFFER_RANGES[] = {{nullptr, 0.0, USB_AUDIO_BRIDGE_RING_FRAMES / 2}};
+const Range RX_MAX_RANGES[] = {{nullptr, 16.0, USB_AUDIO_BRIDGE_RING_FRAMES}};
+const Range GAIN_RANGES[] = {{nullptr, AUDIO_STREAM_GAIN_MIN_DB, AUDIO_STREAM_GAIN_MAX_DB}};
+
+const FieldSpec TX_SETPOINT_SPEC{"tx_setpoint", ValueType::Int, "samples", SETPOINT_RANGES, 1};
+const FieldSpec TX_PREBUFFER_SPEC{"tx_prebuffer", ValueType::Int, "samples", PREBUFFER_RANGES, 1};
+const FieldSpec RX_MAX_SPEC{"rx_max", ValueType::Int, "samples", RX_MAX_RANGES, 1};
+const FieldSpec TX_GAIN_SPEC{"tx_gain", ValueType::Int, "dB", GAIN_RANGES, 1};
+const FieldSpec RX_GAIN_SPEC{"rx_gain", ValueType::Int, "dB", GAIN_RANGES, 1};
+const FieldSpec TX_LATENCY_SPEC{"tx_latency", ValueType::Float, "ms", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec RX_LATENCY_SPEC{"rx_latency", ValueType::Float, "ms", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec OUT_DROP_SPEC{"out_drop_ppm", ValueType::Int, "ppm", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec IN_DROP_SPEC{"in_drop_ppm", ValueType::Int, "ppm", nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+/* One field of the bridge tuning; set is read-modify-write of the whole set. */
+class TuningCap : public Setting {
+public:
+  TuningCap(const FieldSpec &spec, uint32_t usb_audio_bridge_tuning::*field) : spec_(spec), field_(field) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onSet(const char *value) override {
+    long v;
+    if (!parse_int(value, &v)) {
+      return Result::err("bad_value");
+    }
+    if (!spec_.inAnyRange(static_cast<double>(v))) {
+      return Result::err("out_of_range");
+    }
+    usb_audio_bridge_tuning t;
+    usb_audio_bridge_get_tuning(&t);
+    t.*field_ = static_cast<uint32_t>(v);
+    if (usb_audio_bridge_set_tuning(&t) != 0) {
+      return Result::err("out_of_range");
+    }
+    return Result::okInt(static_cast<int>(v));
+  }
+
+  Result onGet() override {
+    usb_audio_bridge_tuning t;
+    usb_audio_bridge_get_tuning(&t);
+    return Result::okInt(static_cast<int>(t.*field_));
+  }
+
+private:
+  const FieldSpec &spec_;
+  uint32_t usb_audio_bridge_tuning::*field_;
+};
+
+class GainCap : public Setting {
+public:
+  GainCap(const FieldSpec &spec, audio_stream_dir dir) : spec_(spec), dir_(dir) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onSet(const char *value) override {
+    long v;
+    if (!parse_int(value, &v)) {
+      return Result::err("bad_value");
+    }
+    if (!spec_.inAnyRange(static_cast<double>(v)) || audio_stream_set_gain(dir_, static_cast<int>(v)) != 0) {
+      return Result::err("out_of_range");
+    }
+    return Result::okInt(static_cast<int>(v));
+  }
+
+  Result onGet() override { return Result::okInt(audio_stream_get_gain(dir_)); }
+
+private:
+  const FieldSpec &spec_;
+  audio_stream_dir dir_;
+};
+
+/* Ring latency at the last SOF; 0 while the direction is not streaming. */
+class LatencyCap : public Telemetry {
+public:
+  LatencyCap(const FieldSpec &spec, bool tx) : spec_(spec), tx_(tx) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onGet() override {
+    uint32_t tx;
+    uint32_t rx;
+    usb_audio_bridge_get_fill(&tx, &rx);
+    return Result::okFloat((tx_ ? tx : rx) / kSamplesPerMs);
+  }
+
+private:
+  const FieldSpec &spec_;
+  bool tx_;
+};
+
+/* Bytes dropped at the ring per million offered, since the last `uac2 stats reset`. */
+class DropCap : public Telemetry {
+public:
+  DropCap(const FieldSpec &spec, BridgeStats::Dir dir) : spec_(spec), dir_(dir) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onGet() override {
+    Snapshot s;
+    usb_audio_bridge_stats().snapshot(&s);
+    /* OUT bytes count everything the host sent; IN bytes only what was sent on. */
+    const uint64_t offered = dir_ == BridgeStats::kOut ? s.bytes[dir_] : static_cast<uint64_t>(s.bytes[dir_]) + s.dropped[dir_];
+    return Result::okInt(offered == 0U ? 0 : static_cast<int>(static_cast<uint64_t>(s.dropped[dir_]) * 1000000U / offered));
+  }
+
+private:
+  const FieldSpec &spec_;
+  BridgeStats::Dir dir_;
+};
+
+#ifdef CONFIG_APP_AUDIO_NOTCH
+enum class NotchField : uint8_t { kFreq, kDepth, kLocked, kConverge };
+
+/* One field of audio_stream_get_notch(); section -1 is the whole cascade. */
+class NotchCap : public Telemetry {
+public:
+  NotchCap(const FieldSpec &spec, int section, NotchField field) : spec_(spec), section_(section), field_(field) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onGet() override {
+    audio_stream_notch_status st;
+    audio_stream_get_notch(&st);
+    if (section_ < 0) {
+      return Result::okFloat(st.depth_ddb / 10.0);
+    }
+    const audio_stream_notch_section &sec = st.section[section_];
+    switch (field_) {
+    case NotchField::kFreq:
+      return Result::okFloat(sec.freq_dhz / 10.0);
+    case NotchField::kDepth:
+      return Result::okFloat(sec.depth_ddb / 10.0);
+    case NotchField::kLocked:
+      return Result::okBool(sec.locked);
+    case NotchField::kConverge:
+    default:
+      return Result::okInt(static_cast<int>(sec.converge_ms));
+    }
+  }
+
+private:
+  const FieldSpec &spec_;
+  int section_;
+  NotchField field_;
+};
+
+#define NOTCH_SECTION_SPECS(i)                                                                                                                                 \
+  {                                                                                                                                                            \
+    {"notch" #i "_freq", ValueType::Float, "Hz", nullptr, 0, nullptr, 0, /*readonly=*/true},                                                                   \
+        {"notch" #i "_depth", ValueType::Float, "dB", nullptr, 0, nullptr, 0, /*readonly=*/true},                                                              \
+        {"notch" #i "_locked", ValueType::Bool, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true},                                                           \
+        {"notch" #i "_converge", ValueType::Int, "ms", nullptr, 0, nullptr, 0, /*readonly=*/true},                                                             \
+  }
+
+#define NOTCH_SECTION_CAPS(i)                                                                                                                                  \
+  {                                                                                                                                                            \
+    {NOTCH_SPECS[i][0], i, NotchField::kFreq}, {NOTCH_SPECS[i][1], i, NotchField::kDepth}, {NOTCH_SPECS[i][2], i, NotchField::kLocked},                        \
+        {NOTCH_SPECS[i][3], i, NotchField::kConverge},                                                                                                         \
+  }
+
+#define NOTCH_SECTION_PTRS(i) &g_notch[i][0], &g_notch[i][1], &g_notch[i][2], &g_notch[i][3]
+
+static_assert(AUDIO_STREAM_NOTCH_SECTIONS_MAX == 4, "one spec row per possible section");
+
+const FieldSpec NOTCH_DEPTH_SPEC{"notch_depth", ValueType::Float, "dB", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec NOTCH_SPECS[AUDIO_STREAM_NOTCH_SECTIONS_MAX][4] = {NOTCH_SECTION_SPECS(0), NOTCH_SECTION_SPECS(1), NOTCH_SECTION_SPECS(2),
+                                                                   NOTCH_SECTION_SPECS(3)};
+
+NotchCap g_notch_depth{NOTCH_DEPTH_SPEC, -1, NotchField::kDepth};
+NotchCap g_notch[AUDIO_STREAM_NOTCH_SECTIONS_MAX][4] = {NOTCH_SECTION_CAPS(0), NOTCH_SECTION_CAPS(1), NOTCH_SECTION_CAPS(2), NOTCH_SECTION_CAPS(3)};
+#endif
+
+TuningCap g_tx_setpoint{TX_SETPOINT_SPEC, &usb_audio_bridge_tuning::tx_setpoint};
+TuningCap g_tx_prebuffer{TX_PREBUFFER_SPEC, &usb_audio_bridge_tuning::tx_prebuffer};
+TuningCap g_rx_max{RX_MAX_SPEC, &usb_audio_bridge_tuning::rx_max};
+GainCap g_tx_gain{TX_GAIN_SPEC, AUDIO_STREAM_TX};
+GainCap g_rx_gain{RX_GAIN_SPEC, AUDIO_STREAM_RX};
+LatencyCap g_tx_latency{TX_LATENCY_SPEC, true};
+LatencyCap g_rx_latency{RX_LATENCY_SPEC, false};
+DropCap g_out_drop{OUT_DROP_SPEC, BridgeStats::kOut};
+DropCap g_in_drop{IN_DROP_SPEC, BridgeStats::kIn};
+
+/* Only the sections built in (CONFIG_APP_AUDIO_NOTCH_SECTIONS) are listed. */
+Capability *const g_caps[] = {
+    &g_tx_setpoint, &g_tx_prebuffer, &g_rx_max, &g_tx_gain, &g_rx_gain, &g_tx_latency, &g_rx_latency, &g_out_drop, &g_in_drop,
+#ifdef CONFIG_APP_AUDIO_NOTCH
+    &g_notch_depth, NOTCH_SECTION_PTRS(0),
+#if CONFIG_APP_AUDIO_NOTCH_SECTIONS > 1
+    NOTCH_SECTION_PTRS(1),
+#endif
+#if CONFIG_APP_AUDIO_NOTCH_SECTIONS > 2
+    NOTCH_SECTION_PTRS(2),
+#endif
+#if CONFIG_APP_AUDIO_NOTCH_SECTIONS > 3
+    NOTCH_SECTION_PTRS(3),
+#endif
+#endif
+};
+const Identity g_identity{"audio_pipeline", "uac2_ring", "1"};
+Module g_module{g_identity, "audio", g_caps};
+
+} // namespace
+
+mod::Module &audio_module() { return g_module; }
+
+#endif /* CONFIG_MODULE_SA818 */
@@ -0,0 +1,16 @@
+/**
+ * @file audio_module.h
+ * @brief `audio` module: run-time buffer, latency and gain settings.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_APP_AUDIO_MODULE_H_
+#define OE5XRX_APP_AUDIO_MODULE_H_
+
+#include <oe5xrx/module/iface.h>
+
+/** The `audio` module; listed in mod::app_modules() next to `usb_audio`. */
+mod::Module &audio_module();
+
+#endif /* OE5XRX_APP_AUDIO_MODULE_H_ */
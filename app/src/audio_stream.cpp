@@ -13,10 +13,19 @@
 
 #include "audio_stream.h"
 
+#include "adaptive_notch.h"
+#include "callback_swap.h"
+#include "clock_trim.h"
+#include "emphasis.h"
+#include "pcm_convert.h"
+
 #include <errno.h>
+#include <math.h>
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
 
 /* Require the DT node to be status=okay AND the driver Kconfig on. The device
  * is only instantiated via DT_INST_FOREACH_STATUS_OKAY, so an existing-but-
@@ -32,16 +41,101 @@
 #define AUDIO_STREAM_HAVE_AAO 1
 #endif
 
+/* Playback clocked by the capture's sampling timer (sync-source): the two are
+ * started and stopped together. */
+#if defined(AUDIO_STREAM_HAVE_AAI) && defined(AUDIO_STREAM_HAVE_AAO) && DT_NODE_HAS_PROP(DT_NODELABEL(audio_out), sync_source)
+#include <oe5xrx/audio/analog_audio_sync.h>
+#define AUDIO_STREAM_HAVE_SYNC 1
+#endif
+
+#ifdef CONFIG_AUDIO_DCS
+#include <oe5xrx/audio/dcs.h>
+#endif
+
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+#include "audio_watchdog.h"
+#endif
+
+#ifdef CONFIG_EVENT_BUS
+#include <oe5xrx/events/bus.h>
+#endif
+
+#ifdef CONFIG_AUDIO_LINK
+#include <oe5xrx/audio/audio_link.h>
+#endif
+
+#ifdef CONFIG_VOICE_PROMPT
+#include <oe5xrx/audio/voice_prompt.h>
+#endif
+
+#if defined(CONFIG_APP_AUDIO_SOF_SYNC) && defined(AUDIO_STREAM_HAVE_AAO)
+#define AUDIO_STREAM_HAVE_CLOCK_SYNC 1
+#endif
+
 LOG_MODULE_REGISTER(audio_stream, LOG_LEVEL_INF);
 
 #define AUDIO_STREAM_SAMPLE_SIZE 2 /* 16-bit = 2 bytes */
 
+/* RX samples are const in the capture callback; de-emphasis filters a copy in
+ * chunks of this many samples (the analog-audio-in maximum block). */
+#define AUDIO_STREAM_RX_CHUNK 16
+
+/* Non-native formats are converted through a wire buffer of this many frames
+ * (2 channels x 4 bytes at most). */
+#define AUDIO_STREAM_WIRE_CHUNK 16
+#define AUDIO_STREAM_WIRE_FRAME_MAX 8
+
+/* CallbackSwap reader indices: one per backend thread. */
+enum { AUDIO_STREAM_READER_TX, AUDIO_STREAM_READER_RX, AUDIO_STREAM_READERS };
+
 /** Audio streaming context. */
 struct audio_stream_ctx {
   const struct device *dev;
-  struct audio_stream_callbacks callbacks;
+  /* Pinned by each backend thread for one block; audio_stream_register()
+   * swaps it while streaming without touching the hardware. */
+  audio::CallbackSwap<struct audio_stream_callbacks, AUDIO_STREAM_READERS> callbacks;
   struct audio_format format;
   bool streaming;
+  /* MCU-side FM emphasis. The flag is read once per block by the backend
+   * threads, so audio_stream_set_emphasis() takes effect at the next block
+   * boundary without the stream mutex. Filter state is owned by the TX / RX
+   * backend thread respectively. */
+  atomic_t emphasis;
+  audio::Emphasis tx_pre{audio::Emphasis::Mode::kPre};
+  audio::Emphasis rx_de{audio::Emphasis::Mode::kDe};
+  /* Digital gain per audio_stream_dir: the setting in dB and the Q12 factor
+   * the backend threads read once per block. */
+  atomic_t gain_db[2];
+  atomic_t gain_q12[2] = {ATOMIC_INIT(audio::pcm::kGainUnity), ATOMIC_INIT(audio::pcm::kGainUnity)};
+  /* Callback-side frame format, fixed while streaming (set by start()). The
+   * dither state belongs to the TX backend thread. RX has its own format:
+   * stereo in dual mode (processed + raw), otherwise the same as TX. */
+  audio::pcm::Format wire;
+  audio::pcm::Format rx_wire;
+  bool rx_dual;
+  audio::pcm::Dither tx_dither;
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  /* Adaptive RX notch. Filter state belongs to the RX backend thread, which
+   * publishes a raw status copy under notch_lock after each block; requests
+   * reach it through the two atomics. */
+  atomic_t notch;       /* wanted on/off */
+  atomic_t notch_reset; /* restart adaptation at the next block */
+  audio::AdaptiveNotch rx_notch{{CONFIG_APP_AUDIO_NOTCH_SECTIONS, CONFIG_APP_AUDIO_NOTCH_BANDWIDTH_HZ, CONFIG_APP_AUDIO_NOTCH_MU_SHIFT}};
+  struct k_spinlock notch_lock;
+  audio::AdaptiveNotch::SectionStatus notch_sections[AUDIO_STREAM_NOTCH_SECTIONS_MAX];
+  struct audio_stream_notch_status notch_status; /* cost counters; the rest is filled in by get */
+#endif
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+  /* SOF clock sync. The trim state belongs to the thread calling
+   * audio_stream_clock_sync_sof() (usbd); requests reach it through the two
+   * atomics and its status is published under clock_lock. */
+  atomic_t clock_sync;    /* requested on/off */
+  atomic_t clock_restart; /* stream (re)started: positions begin at 0 again */
+  usb_audio::SofClockTrim trim;
+  bool trim_active;
+  struct k_spinlock clock_lock;
+  struct audio_stream_clock_status clock_status;
+#endif
 };
 
 /*
@@ -66,16 +160,71 @@ static struct audio_stream_ctx audio_ctx;
 static size_t audio_stream_tx_src(int16_t *dst, size_t max, void *user) {
   struct audio_stream_ctx *ctx = static_cast<struct audio_stream_ctx *>(user);
 
-  if (!ctx->callbacks.tx_request) {
-    return 0;
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  audio_watchdog_beat(AUDIO_WDT_PLAYBACK);
+#endif
+
+  const struct audio_stream_callbacks &cbs = ctx->callbacks.acquire(AUDIO_STREAM_READER_TX);
+  size_t count = 0;
+  if (!cbs.tx_request) {
+    /* No consumer: silence. */
+  } else if (audio::pcm::is_native(ctx->wire)) {
+    size_t bytes = cbs.tx_request(ctx->dev, reinterpret_cast<uint8_t *>(dst), max * AUDIO_STREAM_SAMPLE_SIZE, cbs.user_data);
+    /* Defend against a callback that returns more than requested; the division
+     * to whole samples already rounds a stray odd byte down. */
+    if (bytes > max * AUDIO_STREAM_SAMPLE_SIZE) {
+      bytes = max * AUDIO_STREAM_SAMPLE_SIZE;
+    }
+    count = bytes / AUDIO_STREAM_SAMPLE_SIZE;
+  } else {
+    /* Pull wire frames chunk by chunk and narrow them into the block; a short
+     * chunk means the source ran dry, so stop there. */
+    uint8_t wire[AUDIO_STREAM_WIRE_CHUNK * AUDIO_STREAM_WIRE_FRAME_MAX];
+    const size_t frame = audio::pcm::frame_bytes(ctx->wire);
+    while (count < max) {
+      const size_t want = MIN(max - count, (size_t)AUDIO_STREAM_WIRE_CHUNK);
+      size_t bytes = cbs.tx_request(ctx->dev, wire, want * frame, cbs.user_data);
+      if (bytes > want * frame) {
+        bytes = want * frame;
+      }
+      const size_t got = bytes / frame;
+      audio::pcm::from_wire(wire, dst + count, got, ctx->wire, &ctx->tx_dither);
+      count += got;
+      if (got < want) {
+        break;
+      }
+    }
+  }
+  ctx->callbacks.release(AUDIO_STREAM_READER_TX);
+  audio::pcm::apply_gain(dst, count, atomic_get(&ctx->gain_q12[AUDIO_STREAM_TX]));
+#ifdef CONFIG_VOICE_PROMPT
+  /* An announcement replaces the block; the consumer was still drained above. */
+  count = voice_prompt_play(dst, count, max);
+#endif
+  ctx->tx_pre.process(dst, count, atomic_get(&ctx->emphasis) != 0);
+  return count;
+}
+#endif
+
+#if defined(AUDIO_STREAM_HAVE_AAI) && defined(CONFIG_APP_AUDIO_NOTCH)
+/* RX thread, after each block: publish the notch state and what it cost. */
+static void audio_stream_notch_publish(struct audio_stream_ctx *ctx, size_t samples, uint32_t cycles) {
+  audio::AdaptiveNotch::SectionStatus sections[AUDIO_STREAM_NOTCH_SECTIONS_MAX];
+  const size_t n = ctx->rx_notch.sections();
+  for (size_t i = 0; i < n; i++) {
+    sections[i] = ctx->rx_notch.section(i);
   }
-  size_t bytes = ctx->callbacks.tx_request(ctx->dev, reinterpret_cast<uint8_t *>(dst), max * AUDIO_STREAM_SAMPLE_SIZE, ctx->callbacks.user_data);
-  /* Defend against a callback that returns more than requested; the division to
-   * whole samples already rounds a stray odd byte down. */
-  if (bytes > max * AUDIO_STREAM_SAMPLE_SIZE) {
-    bytes = max * AUDIO_STREAM_SAMPLE_SIZE;
+
+  k_spinlock_key_t key = k_spin_lock(&ctx->notch_lock);
+  memcpy(ctx->notch_sections, sections, n * sizeof(sections[0]));
+  struct audio_stream_notch_status &st = ctx->notch_status;
+  st.samples += samples;
+  st.cycles_last = cycles;
+  if (cycles > st.cycles_max) {
+    st.cycles_max = cycles;
   }
-  return bytes / AUDIO_STREAM_SAMPLE_SIZE;
+  st.cycles_total += cycles;
+  k_spin_unlock(&ctx->notch_lock, key);
 }
 #endif
 
@@ -85,10 +234,60 @@ static size_t audio_stream_tx_src(int16_t *dst, size_t max, void *user) {
  * mutex) is safe. */
 static void audio_stream_on_rx_samples(const int16_t *samples, size_t count, void *user) {
   struct audio_stream_ctx *ctx = static_cast<struct audio_stream_ctx *>(user);
+  int16_t chunk[AUDIO_STREAM_RX_CHUNK];
+  uint8_t wire[AUDIO_STREAM_RX_CHUNK * AUDIO_STREAM_WIRE_FRAME_MAX];
+  const bool native = audio::pcm::is_native(ctx->rx_wire);
+  const size_t frame = audio::pcm::frame_bytes(ctx->rx_wire);
+  const bool emphasis = atomic_get(&ctx->emphasis) != 0;
+  const int32_t gain = atomic_get(&ctx->gain_q12[AUDIO_STREAM_RX]);
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  const bool notch = atomic_get(&ctx->notch) != 0;
+  const size_t block = count;
+  uint32_t notch_cycles = 0;
+  if (atomic_cas(&ctx->notch_reset, 1, 0)) {
+    ctx->rx_notch.reset();
+  }
+#endif
+
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  audio_watchdog_beat(AUDIO_WDT_CAPTURE);
+#endif
+
+#ifdef CONFIG_AUDIO_DCS
+  /* Sub-audible DCS sits below the de-emphasis corner: decode the raw capture. */
+  dcs_monitor_feed(samples, count);
+#endif
 
-  if (ctx->callbacks.rx_data) {
-    ctx->callbacks.rx_data(ctx->dev, reinterpret_cast<const uint8_t *>(samples), count * AUDIO_STREAM_SAMPLE_SIZE, ctx->callbacks.user_data);
+  /* One callback set for the whole block, so a swap lands on a block boundary. */
+  const struct audio_stream_callbacks &cbs = ctx->callbacks.acquire(AUDIO_STREAM_READER_RX);
+  while (count > 0) {
+    size_t n = count < AUDIO_STREAM_RX_CHUNK ? count : AUDIO_STREAM_RX_CHUNK;
+    memcpy(chunk, samples, n * AUDIO_STREAM_SAMPLE_SIZE);
+#ifdef CONFIG_APP_AUDIO_NOTCH
+    /* Ahead of de-emphasis, which lifts hum by up to 13 dB. */
+    const uint32_t t0 = k_cycle_get_32();
+    ctx->rx_notch.process(chunk, n, notch);
+    notch_cycles += k_cycle_get_32() - t0;
+#endif
+    ctx->rx_de.process(chunk, n, emphasis);
+    audio::pcm::apply_gain(chunk, n, gain);
+    if (cbs.rx_data && native) {
+      cbs.rx_data(ctx->dev, reinterpret_cast<const uint8_t *>(chunk), n * AUDIO_STREAM_SAMPLE_SIZE, cbs.user_data);
+    } else if (cbs.rx_data && ctx->rx_dual) {
+      /* The untouched capture block is the raw channel: one conversion pass. */
+      audio::pcm::to_wire_pair(chunk, samples, wire, n, ctx->rx_wire.encoding);
+      cbs.rx_data(ctx->dev, wire, n * frame, cbs.user_data);
+    } else if (cbs.rx_data) {
+      audio::pcm::to_wire(chunk, wire, n, ctx->rx_wire);
+      cbs.rx_data(ctx->dev, wire, n * frame, cbs.user_data);
+    }
+    samples += n;
+    count -= n;
   }
+  ctx->callbacks.release(AUDIO_STREAM_READER_RX);
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  audio_stream_notch_publish(ctx, block, notch_cycles);
+#endif
 }
 #endif
 
@@ -97,18 +296,22 @@ int audio_stream_register(const struct device *dev, const struct audio_stream_ca
     return -EINVAL;
   }
 
-  /* Guard the shared context and refuse to swap callbacks under a running
-   * stream (the backend threads read ctx->callbacks/ctx->dev while active). */
+  /* The mutex serializes writers; the backend threads never take it. The
+   * callback set itself may change under a running stream (the backends pin
+   * it per block), but the context handle is the stream's identity and the
+   * backends read it unpinned, so it only changes while stopped. */
   k_mutex_lock(&audio_stream_mutex, K_FOREVER);
-  if (audio_ctx.streaming) {
+  const bool streaming = audio_ctx.streaming;
+  if (streaming && audio_ctx.dev != dev) {
     k_mutex_unlock(&audio_stream_mutex);
     return -EBUSY;
   }
   audio_ctx.dev = dev;
-  audio_ctx.callbacks = *callbacks;
+  /* Waits (on this thread only) for a block still using the old set. */
+  audio_ctx.callbacks.publish(*callbacks, [] { k_sleep(K_TICKS(1)); });
   k_mutex_unlock(&audio_stream_mutex);
 
-  LOG_INF("Audio callbacks registered");
+  LOG_INF("Audio callbacks %s", streaming ? "swapped" : "registered");
   return 0;
 }
 
@@ -116,6 +319,11 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
   if (!dev || !format) {
     return -EINVAL;
   }
+  audio::pcm::Format wire;
+  if (!audio::pcm::format_from(format->bit_depth, format->is_float, format->channels, &wire)) {
+    LOG_ERR("Unsupported audio format: %u-bit%s, %u ch", format->bit_depth, format->is_float ? " float" : "", format->channels);
+    return -EINVAL;
+  }
 
   /* Hold the stream mutex across the whole start sequence — the state flip AND
    * the backend bring-up. Releasing it before starting the backends would open
@@ -138,7 +346,23 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
     return 0;
   }
   audio_ctx.format = *format;
+  audio_ctx.wire = wire;
+  audio_ctx.rx_wire = wire;
+  audio_ctx.rx_dual = format->rx_dual;
+  if (format->rx_dual) {
+    audio_ctx.rx_wire.channels = 2;
+  }
+  audio_ctx.tx_dither.enabled = IS_ENABLED(CONFIG_APP_AUDIO_CONVERT_DITHER);
   audio_ctx.streaming = true;
+  /* Fresh filter history per stream; the emphasis setting itself persists. */
+  audio_ctx.tx_pre.reset();
+  audio_ctx.rx_de.reset();
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  audio_ctx.rx_notch.reset();
+#endif
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+  atomic_set(&audio_ctx.clock_restart, 1);
+#endif
 
   /* Count backends that actually came up. A single backend failing only
    * degrades that direction (RX-only or TX-only is still useful), so we keep
@@ -148,7 +372,28 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
    * -ENODEV. */
   int started = 0;
 
-#ifdef AUDIO_STREAM_HAVE_AAO
+#ifdef AUDIO_STREAM_HAVE_SYNC
+  /* Playback runs off the capture's timer, so one cannot run without the
+   * other: arm both and start them on the same sample edge. */
+  const struct device *aai_dev = DEVICE_DT_GET(DT_NODELABEL(audio_in));
+  const struct device *aao_dev = DEVICE_DT_GET(DT_NODELABEL(audio_out));
+  if (!device_is_ready(aai_dev) || !device_is_ready(aao_dev)) {
+    LOG_ERR("analog-audio-in/out device not ready (audio unavailable)");
+  } else {
+    int sync_ret = analog_audio_sync_start(aai_dev, audio_stream_on_rx_samples, &audio_ctx, aao_dev, audio_stream_tx_src, &audio_ctx);
+    if (sync_ret < 0) {
+      LOG_ERR("synchronised analog audio start failed: %d (audio unavailable)", sync_ret);
+    } else {
+      started += 2;
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+      audio_watchdog_arm(AUDIO_WDT_PLAYBACK, true);
+      audio_watchdog_arm(AUDIO_WDT_CAPTURE, true);
+#endif
+    }
+  }
+#endif
+
+#if defined(AUDIO_STREAM_HAVE_AAO) && !defined(AUDIO_STREAM_HAVE_SYNC)
   /* Start the hardware-timed TX playback module; it pulls PCM via the source
    * callback. A failure only disables TX playback (RX still works), so surface
    * it loudly rather than fail the whole stream. */
@@ -161,11 +406,14 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
       LOG_ERR("analog-audio-out start failed: %d (TX playback unavailable)", aao_ret);
     } else {
       started++;
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+      audio_watchdog_arm(AUDIO_WDT_PLAYBACK, true);
+#endif
     }
   }
 #endif
 
-#ifdef AUDIO_STREAM_HAVE_AAI
+#if defined(AUDIO_STREAM_HAVE_AAI) && !defined(AUDIO_STREAM_HAVE_SYNC)
   /* Start the hardware-timed RX capture module; it delivers PCM via the callback.
    * A failure only disables RX capture (TX still works), so surface it loudly
    * rather than fail the whole stream. Verify the device initialised before use
@@ -180,6 +428,9 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
       LOG_ERR("analog-audio-in start failed: %d (RX capture unavailable)", aai_ret);
     } else {
       started++;
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+      audio_watchdog_arm(AUDIO_WDT_CAPTURE, true);
+#endif
     }
   }
 #endif
@@ -192,7 +443,11 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
   }
 
   k_mutex_unlock(&audio_stream_mutex);
-  LOG_INF("Audio streaming started: %u Hz, %u-bit, %u ch", format->sample_rate, format->bit_depth, format->channels);
+  LOG_INF("Audio streaming started: %u Hz, %u-bit%s, %u ch%s", format->sample_rate, format->bit_depth, format->is_float ? " float" : "", format->channels,
+          format->rx_dual ? ", RX processed + raw" : "");
+#ifdef CONFIG_EVENT_BUS
+  events::publish(events::Type::AudioStream, 1);
+#endif
 
   return 0;
 }
@@ -213,7 +468,20 @@ int audio_stream_stop(const struct device *dev) {
   }
   audio_ctx.streaming = false;
 
-#ifdef AUDIO_STREAM_HAVE_AAO
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  /* Disarm first: a stopped stage is silent on purpose. */
+  audio_watchdog_arm(AUDIO_WDT_PLAYBACK, false);
+  audio_watchdog_arm(AUDIO_WDT_CAPTURE, false);
+#endif
+
+#ifdef AUDIO_STREAM_HAVE_SYNC
+  int sync_stop_ret = analog_audio_sync_stop(DEVICE_DT_GET(DT_NODELABEL(audio_in)), DEVICE_DT_GET(DT_NODELABEL(audio_out)));
+  if (sync_stop_ret < 0) {
+    LOG_WRN("synchronised analog audio stop returned %d", sync_stop_ret);
+  }
+#endif
+
+#if defined(AUDIO_STREAM_HAVE_AAO) && !defined(AUDIO_STREAM_HAVE_SYNC)
   /* Consume the result: the analog_audio_* stop functions are warn_unused_result,
    * and GCC's attribute (unlike [[nodiscard]]) is NOT silenced by a (void) cast. */
   int aao_stop_ret = analog_audio_out_stop(DEVICE_DT_GET(DT_NODELABEL(audio_out)));
@@ -222,7 +490,7 @@ int audio_stream_stop(const struct device *dev) {
   }
 #endif
 
-#ifdef AUDIO_STREAM_HAVE_AAI
+#if defined(AUDIO_STREAM_HAVE_AAI) && !defined(AUDIO_STREAM_HAVE_SYNC)
   int aai_stop_ret = analog_audio_in_stop(DEVICE_DT_GET(DT_NODELABEL(audio_in)));
   if (aai_stop_ret < 0) {
     LOG_WRN("analog-audio-in stop returned %d", aai_stop_ret);
@@ -231,9 +499,32 @@ int audio_stream_stop(const struct device *dev) {
 
   k_mutex_unlock(&audio_stream_mutex);
   LOG_INF("Audio streaming stopped");
+#ifdef CONFIG_EVENT_BUS
+  events::publish(events::Type::AudioStream, 0);
+#endif
   return 0;
 }
 
+int audio_stream_restart(void) {
+  k_mutex_lock(&audio_stream_mutex, K_FOREVER);
+  const struct device *dev = audio_ctx.dev;
+  const bool streaming = audio_ctx.streaming;
+  const struct audio_format format = audio_ctx.format;
+  k_mutex_unlock(&audio_stream_mutex);
+
+  /* A stop()/start() by the owner in between wins: they only act on the same
+   * registered context and either leave it stopped (nothing to restart) or
+   * running again. */
+  if (!dev || !streaming) {
+    return -EAGAIN;
+  }
+  int ret = audio_stream_stop(dev);
+  if (ret < 0) {
+    return ret;
+  }
+  return audio_stream_start(dev, &format);
+}
+
 int audio_stream_get_format(const struct device *dev, struct audio_format *format) {
   if (!dev || !format) {
     return -EINVAL;
@@ -248,3 +539,467 @@ int audio_stream_get_format(const struct device *dev, struct audio_format *forma
   k_mutex_unlock(&audio_stream_mutex);
   return 0;
 }
+
+int audio_stream_set_emphasis(const struct device *dev, bool enable) {
+  if (!dev) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&audio_stream_mutex, K_FOREVER);
+  if (audio_ctx.dev != dev) {
+    k_mutex_unlock(&audio_stream_mutex);
+    return -EINVAL;
+  }
+  atomic_set(&audio_ctx.emphasis, enable ? 1 : 0);
+  k_mutex_unlock(&audio_stream_mutex);
+
+  LOG_INF("MCU emphasis %s", enable ? "on (voice)" : "off (flat)");
+  return 0;
+}
+
+bool audio_stream_get_emphasis(void) {
+  return atomic_get(&audio_ctx.emphasis) != 0;
+}
+
+int audio_stream_set_gain(enum audio_stream_dir dir, int db) {
+  if ((dir != AUDIO_STREAM_TX && dir != AUDIO_STREAM_RX) || db < AUDIO_STREAM_GAIN_MIN_DB || db > AUDIO_STREAM_GAIN_MAX_DB) {
+    return -EINVAL;
+  }
+
+  /* 0 dB gives exactly kGainUnity, which apply_gain() skips. */
+  const int32_t q12 = (int32_t)lroundf(audio::pcm::kGainUnity * powf(10.0f, db / 20.0f));
+  atomic_set(&audio_ctx.gain_db[dir], db);
+  atomic_set(&audio_ctx.gain_q12[dir], q12);
+
+  LOG_INF("%s gain %d dB", dir == AUDIO_STREAM_TX ? "TX" : "RX", db);
+  return 0;
+}
+
+int audio_stream_get_gain(enum audio_stream_dir dir) {
+  if (dir != AUDIO_STREAM_TX && dir != AUDIO_STREAM_RX) {
+    return 0;
+  }
+  return (int)atomic_get(&audio_ctx.gain_db[dir]);
+}
+
+int audio_stream_set_notch(const struct device *dev, bool enable) {
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  if (!dev) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&audio_stream_mutex, K_FOREVER);
+  if (audio_ctx.dev != dev) {
+    k_mutex_unlock(&audio_stream_mutex);
+    return -EINVAL;
+  }
+  atomic_set(&audio_ctx.notch, enable ? 1 : 0);
+  k_mutex_unlock(&audio_stream_mutex);
+
+  LOG_INF("RX notch %s", enable ? "in" : "out");
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(enable);
+  return -ENOTSUP;
+#endif
+}
+
+void audio_stream_reset_notch(void) {
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  atomic_set(&audio_ctx.notch_reset, 1);
+#endif
+}
+
+#ifdef CONFIG_APP_AUDIO_NOTCH
+/* Power ratio in 0.1 dB; 0 with nothing measured yet. */
+static int32_t audio_stream_ratio_ddb(uint64_t num, uint64_t den) {
+  if (num == 0U) {
+    return 0;
+  }
+  return (int32_t)lroundf(100.0f * log10f((float)num / (float)(den != 0U ? den : 1U)));
+}
+#endif
+
+void audio_stream_get_notch(struct audio_stream_notch_status *status) {
+#ifdef CONFIG_APP_AUDIO_NOTCH
+  audio::AdaptiveNotch::SectionStatus sections[AUDIO_STREAM_NOTCH_SECTIONS_MAX];
+  const size_t n = audio_ctx.rx_notch.sections();
+
+  k_spinlock_key_t key = k_spin_lock(&audio_ctx.notch_lock);
+  *status = audio_ctx.notch_status;
+  memcpy(sections, audio_ctx.notch_sections, sizeof(sections));
+  k_spin_unlock(&audio_ctx.notch_lock, key);
+
+  status->enabled = atomic_get(&audio_ctx.notch) != 0;
+  status->sections = (uint8_t)n;
+  for (size_t i = 0; i < n; i++) {
+    const float a = (float)sections[i].a / (float)(1 << audio::AdaptiveNotch::kCoefBits);
+    const float w0 = acosf(-a / 2.0f);
+    struct audio_stream_notch_section &out = status->section[i];
+    out.freq_dhz = (uint32_t)lroundf(w0 * (10.0f * audio::AdaptiveNotch::kSampleRate / (2.0f * 3.14159265f)));
+    out.depth_ddb = audio_stream_ratio_ddb(sections[i].power_in, sections[i].power_out);
+    out.locked = sections[i].locked;
+    out.locks = sections[i].locks;
+    out.converge_ms = sections[i].converge_samples / (audio::AdaptiveNotch::kSampleRate / 1000U);
+  }
+  status->depth_ddb = n > 0 ? audio_stream_ratio_ddb(sections[0].power_in, sections[n - 1].power_out) : 0;
+  status->cycles_per_sec = sys_clock_hw_cycles_per_sec();
+#else
+  *status = {};
+#endif
+}
+
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+/* Apply one period to both sampling timers: they share tim_clk, so the ADC
+ * follows the DAC and the IN stream stays at exactly samples-per-SOF too. */
+static void audio_stream_apply_period(uint32_t period) {
+  int r = analog_audio_out_set_period(DEVICE_DT_GET(DT_NODELABEL(audio_out)), period);
+  if (r < 0 && r != -EAGAIN) {
+    LOG_WRN_ONCE("DAC period trim failed: %d", r);
+  }
+#ifdef AUDIO_STREAM_HAVE_AAI
+  r = analog_audio_in_set_period(DEVICE_DT_GET(DT_NODELABEL(audio_in)), period);
+  if (r < 0 && r != -EAGAIN) {
+    LOG_WRN_ONCE("ADC period trim failed: %d", r);
+  }
+#endif
+}
+
+static void audio_stream_publish_clock(struct audio_stream_ctx *ctx) {
+  k_spinlock_key_t key = k_spin_lock(&ctx->clock_lock);
+  ctx->clock_status.enabled = atomic_get(&ctx->clock_sync) != 0;
+  ctx->clock_status.active = ctx->trim_active;
+  ctx->clock_status.locked = ctx->trim_active && ctx->trim.locked();
+  ctx->clock_status.trim_ppb = ctx->trim_active ? ctx->trim.trim_ppb() : 0;
+  ctx->clock_status.phase_err = ctx->trim_active ? ctx->trim.phase_error() : 0;
+  ctx->clock_status.period = ctx->trim.period();
+  ctx->clock_status.slips = ctx->trim.slips();
+  k_spin_unlock(&ctx->clock_lock, key);
+}
+#endif
+
+int audio_stream_set_clock_sync(const struct device *dev, bool enable) {
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+  if (!dev) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&audio_stream_mutex, K_FOREVER);
+  if (audio_ctx.dev != dev) {
+    k_mutex_unlock(&audio_stream_mutex);
+    return -EINVAL;
+  }
+  atomic_set(&audio_ctx.clock_sync, enable ? 1 : 0);
+  k_mutex_unlock(&audio_stream_mutex);
+
+  LOG_INF("SOF clock sync %s", enable ? "on" : "off");
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(enable);
+  return -ENOTSUP;
+#endif
+}
+
+void audio_stream_clock_sync_sof(void) {
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+  struct audio_stream_ctx *ctx = &audio_ctx;
+
+  if (atomic_clear(&ctx->clock_restart)) {
+    ctx->trim_active = false;
+  }
+  if (atomic_get(&ctx->clock_sync) == 0) {
+    if (ctx->trim_active) {
+      /* Back to the free-running integer divider. */
+      ctx->trim_active = false;
+      audio_stream_apply_period(ctx->trim.nominal_period());
+      ctx->trim.reset();
+      audio_stream_publish_clock(ctx);
+    }
+    return;
+  }
+
+  struct analog_audio_out_clock clk;
+  if (analog_audio_out_get_clock(DEVICE_DT_GET(DT_NODELABEL(audio_out)), &clk) < 0) {
+    return; /* not streaming (or no consistent reading this frame) */
+  }
+  if (!ctx->trim_active) {
+    /* Full-Speed SOF is 1 ms; the rate is fixed for the stream's lifetime. */
+    const uint32_t rate = ctx->format.sample_rate;
+    if (rate == 0 || rate % 1000U != 0) {
+      LOG_WRN_ONCE("SOF clock sync needs a whole number of samples per ms (%u Hz)", rate);
+      return;
+    }
+    ctx->trim.init(clk.tim_hz, rate, static_cast<uint16_t>(rate / 1000U), CONFIG_APP_AUDIO_SOF_SYNC_MAX_PPM);
+    ctx->trim_active = true;
+  }
+  audio_stream_apply_period(ctx->trim.update(clk.position));
+  audio_stream_publish_clock(ctx);
+#endif
+}
+
+void audio_stream_get_clock_sync(struct audio_stream_clock_status *status) {
+#ifdef AUDIO_STREAM_HAVE_CLOCK_SYNC
+  k_spinlock_key_t key = k_spin_lock(&audio_ctx.clock_lock);
+  *status = audio_ctx.clock_status;
+  k_spin_unlock(&audio_ctx.clock_lock, key);
+  status->enabled = atomic_get(&audio_ctx.clock_sync) != 0;
+#else
+  *status = (struct audio_stream_clock_status){};
+#endif
+}
+
+int audio_stream_get_play_position(uint32_t *position) {
+#ifdef AUDIO_STREAM_HAVE_AAO
+  struct analog_audio_out_clock clk;
+  int ret = analog_audio_out_get_clock(DEVICE_DT_GET(DT_NODELABEL(audio_out)), &clk);
+  if (ret < 0) {
+    return ret;
+  }
+  *position = clk.position;
+  return 0;
+#else
+  ARG_UNUSED(position);
+  return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_SHELL
+static int cmd_audio_clock(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    bool enable;
+    if (strcmp(argv[1], "on") == 0) {
+      enable = true;
+    } else if (strcmp(argv[1], "off") == 0) {
+      enable = false;
+    } else {
+      shell_error(sh, "Usage: audio clock [on|off]");
+      return -EINVAL;
+    }
+    int ret = audio_stream_set_clock_sync(audio_ctx.dev, enable);
+    if (ret < 0) {
+      shell_error(sh, ret == -ENOTSUP ? "SOF clock sync not built in" : "No audio stream registered");
+      return ret;
+    }
+  }
+  struct audio_stream_clock_status st;
+  audio_stream_get_clock_sync(&st);
+  /* Phase in thousandths of a sample, keeping integer formatting. */
+  shell_print(sh, "AUDIO-CLOCK sync=%s active=%d locked=%d trim_ppb=%d phase_msamples=%d period=%u slips=%u", st.enabled ? "on" : "off",
+              st.active ? 1 : 0, st.locked ? 1 : 0, st.trim_ppb, (int)((int64_t)st.phase_err * 1000 / 256), st.period, st.slips);
+  return 0;
+}
+
+static int cmd_audio_emphasis(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    bool enable;
+    if (strcmp(argv[1], "on") == 0) {
+      enable = true;
+    } else if (strcmp(argv[1], "off") == 0) {
+      enable = false;
+    } else {
+      shell_error(sh, "Usage: audio emphasis [on|off]");
+      return -EINVAL;
+    }
+    /* The shell has no device handle of its own: act on the registered one. */
+    int ret = audio_stream_set_emphasis(audio_ctx.dev, enable);
+    if (ret < 0) {
+      shell_error(sh, "No audio stream registered");
+      return ret;
+    }
+  }
+  shell_print(sh, "AUDIO-EMPHASIS %s", audio_stream_get_emphasis() ? "on" : "off");
+  return 0;
+}
+
+static int cmd_audio_notch(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    int ret = 0;
+    if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "off") == 0) {
+      ret = audio_stream_set_notch(audio_ctx.dev, strcmp(argv[1], "on") == 0);
+    } else if (strcmp(argv[1], "reset") == 0) {
+      audio_stream_reset_notch();
+    } else {
+      shell_error(sh, "Usage: audio notch [on|off|reset]");
+      return -EINVAL;
+    }
+    if (ret < 0) {
+      shell_error(sh, ret == -ENOTSUP ? "RX notch not built in" : "No audio stream registered");
+      return ret;
+    }
+  }
+  struct audio_stream_notch_status st;
+  audio_stream_get_notch(&st);
+  /* Cost per millisecond of audio (8 samples) against the 1 ms block budget. */
+  const uint32_t cyc_per_ms = st.samples ? (uint32_t)(st.cycles_total * 8U / st.samples) : 0;
+  const uint32_t load_ppm = st.cycles_per_sec ? (uint32_t)((uint64_t)cyc_per_ms * 1000U * 1000000U / st.cycles_per_sec) : 0;
+  shell_print(sh, "AUDIO-NOTCH notch=%s sections=%u depth_ddb=%d samples=%u cyc_per_ms=%u cyc_max=%u load_ppm=%u cyc_hz=%u", st.enabled ? "on" : "off",
+              st.sections, st.depth_ddb, st.samples, cyc_per_ms, st.cycles_max, load_ppm, st.cycles_per_sec);
+  for (uint8_t i = 0; i < st.sections; i++) {
+    const struct audio_stream_notch_section &sec = st.section[i];
+    shell_print(sh, "AUDIO-NOTCH-SECTION idx=%u freq_dhz=%u depth_ddb=%d locked=%d locks=%u converge_ms=%u", i, sec.freq_dhz, sec.depth_ddb,
+                sec.locked ? 1 : 0, sec.locks, sec.converge_ms);
+  }
+  return 0;
+}
+
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+static int cmd_audio_watchdog(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  struct audio_watchdog_stats st;
+  audio_watchdog_get_stats(&st);
+  shell_print(sh,
+              "AUDIO-WDT armed=0x%x stalled=0x%x stalls_capture=%u stalls_playback=%u stalls_sof=%u restarts=%u recoveries=%u mttr_last_ms=%u "
+              "mttr_mean_ms=%u mttr_max_ms=%u",
+              st.armed_mask, st.stalled_mask, st.stalls[AUDIO_WDT_CAPTURE], st.stalls[AUDIO_WDT_PLAYBACK], st.stalls[AUDIO_WDT_SOF], st.restarts,
+              st.recoveries, st.mttr_last_ms, st.mttr_mean_ms, st.mttr_max_ms);
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+static void print_irq_stats(const struct shell *sh, const char *dir, const struct analog_audio_irq_stats &st) {
+  const uint32_t mhz = MAX(st.cpu_hz / 1000000U, 1U);
+  shell_print(sh,
+              "AUDIO-IRQ dir=%s zli=%d count=%u nominal_cyc=%u period_min_cyc=%u period_max_cyc=%u jitter_max_cyc=%u jitter_mean_cyc=%u "
+              "jitter_max_ns=%u overruns=%u",
+              dir, st.zli ? 1 : 0, st.count, st.nominal_cyc, st.period_min_cyc, st.period_max_cyc, st.jitter_max_cyc, st.jitter_mean_cyc,
+              st.jitter_max_cyc * 1000U / mhz, st.overruns);
+}
+
+static int cmd_audio_irq(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  struct analog_audio_irq_stats st;
+#ifdef AUDIO_STREAM_HAVE_AAI
+  if (analog_audio_in_get_irq_stats(DEVICE_DT_GET(DT_NODELABEL(audio_in)), &st) == 0) {
+    print_irq_stats(sh, "capture", st);
+  }
+#endif
+#ifdef AUDIO_STREAM_HAVE_AAO
+  if (analog_audio_out_get_irq_stats(DEVICE_DT_GET(DT_NODELABEL(audio_out)), &st) == 0) {
+    print_irq_stats(sh, "playback", st);
+  }
+#endif
+  ARG_UNUSED(st);
+  return 0;
+}
+#endif
+
+#ifdef AUDIO_STREAM_HAVE_AAI
+static const char *aux_kind_str(enum analog_audio_in_aux_kind kind) {
+  switch (kind) {
+  case ANALOG_AUDIO_IN_AUX_VREFINT:
+    return "vrefint";
+  case ANALOG_AUDIO_IN_AUX_TEMP:
+    return "temp";
+  case ANALOG_AUDIO_IN_AUX_VBAT:
+    return "vbat";
+  default:
+    return "pin";
+  }
+}
+
+/* Auxiliary ADC channels scanned with the capture, one line each. */
+static int cmd_audio_aux(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(audio_in));
+  struct analog_audio_in_aux aux;
+  uint8_t i = 0;
+  int r;
+  while ((r = analog_audio_in_get_aux(dev, i, &aux)) == 0) {
+    shell_print(sh, "AUDIO-AUX index=%u name=%s kind=%s raw_q4=%u mv=%u vdda_mv=%u temp_dc=%d updates=%u", i, aux.name, aux_kind_str(aux.kind),
+                aux.raw_q4, aux.millivolts, aux.vdda_mv, aux.temp_dc, aux.updates);
+    i++;
+  }
+  if (r != -ENOENT) {
+    shell_error(sh, "aux channel %u unavailable: %d", i, r);
+    return r;
+  }
+  if (i == 0U) {
+    shell_print(sh, "AUDIO-AUX none");
+  }
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_AUDIO_LINK
+/* Consumer displaced by `audio link on`, put back by `audio link off`. */
+static struct audio_stream_callbacks link_saved;
+static bool link_routed;
+
+static int cmd_audio_link(const struct shell *sh, size_t argc, char **argv) {
+  if (argc > 1) {
+    bool enable;
+    if (strcmp(argv[1], "on") == 0) {
+      enable = true;
+    } else if (strcmp(argv[1], "off") == 0) {
+      enable = false;
+    } else {
+      shell_error(sh, "Usage: audio link [on|off]");
+      return -EINVAL;
+    }
+
+    k_mutex_lock(&audio_stream_mutex, K_FOREVER);
+    const struct device *dev = audio_ctx.dev;
+    const struct audio_stream_callbacks current = audio_ctx.callbacks.current();
+    const bool native = !audio_ctx.streaming || audio::pcm::is_native(audio_ctx.wire);
+    k_mutex_unlock(&audio_stream_mutex);
+    if (!dev) {
+      shell_error(sh, "No audio stream registered");
+      return -EINVAL;
+    }
+    /* The link codec takes 16-bit mono blocks as they are. */
+    if (enable && !native) {
+      shell_error(sh, "Audio link needs a 16-bit mono stream");
+      return -ENOTSUP;
+    }
+
+    /* Live swap (see audio_stream_register()): the capture/playback hardware
+     * keeps running, only the consumer changes at the next block. */
+    int ret = 0;
+    if (enable && !link_routed) {
+      const struct audio_stream_callbacks link_cbs = {audio_link_tx_request, audio_link_rx_data, NULL};
+      link_saved = current;
+      ret = audio_stream_register(dev, &link_cbs);
+      link_routed = ret == 0;
+    } else if (!enable && link_routed) {
+      ret = audio_stream_register(dev, &link_saved);
+      link_routed = ret != 0;
+    }
+    if (ret < 0) {
+      shell_error(sh, "Callback swap failed: %d", ret);
+      return ret;
+    }
+  }
+  shell_print(sh, "AUDIO-LINK-ROUTE %s", link_routed ? "on" : "off");
+  return 0;
+}
+#endif
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    audio_cmds,
+    SHELL_CMD_ARG(clock, NULL, "Sample clock lock to USB SOF [on|off] and its status", cmd_audio_clock, 1, 1),
+    SHELL_CMD_ARG(emphasis, NULL, "MCU pre-/de-emphasis [on|off] (on = voice, off = flat/data)", cmd_audio_emphasis, 1, 1),
+    SHELL_CMD_ARG(notch, NULL, "Adaptive RX hum/tone notch [on|off|reset], tracked tones and cost", cmd_audio_notch, 1, 1),
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+    SHELL_CMD(watchdog, NULL, "Pipeline watchdog stalls, restarts and time to recovery", cmd_audio_watchdog),
+#endif
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+    SHELL_CMD(irq, NULL, "Audio DMA interrupt entry jitter (cycles) and hand-off overruns", cmd_audio_irq),
+#endif
+#ifdef AUDIO_STREAM_HAVE_AAI
+    SHELL_CMD(aux, NULL, "Auxiliary ADC channels scanned with the RX capture (mV, 0.1 degC)", cmd_audio_aux),
+#endif
+#ifdef CONFIG_AUDIO_LINK
+    SHELL_CMD_ARG(link, NULL, "Route the stream to the serial audio link instead of its consumer [on|off]", cmd_audio_link, 1, 1),
+#endif
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(audio, &audio_cmds, "Audio stream commands", NULL);
+#endif
@@ -20,6 +20,7 @@
 #ifndef OE5XRX_APP_AUDIO_STREAM_H_
 #define OE5XRX_APP_AUDIO_STREAM_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/device.h>
@@ -33,6 +34,9 @@ struct audio_format {
   uint32_t sample_rate; /**< Sample rate in Hz (typically 8000) */
   uint8_t bit_depth;    /**< Bits per sample (typically 16) */
   uint8_t channels;     /**< Number of channels (1=mono, 2=stereo) */
+  bool is_float;        /**< IEEE 754 float samples (bit_depth 32) */
+  bool rx_dual;         /**< RX frames are stereo whatever @ref channels says:
+                             channel 1 processed, channel 2 the raw capture */
 };
 
 /**
@@ -70,15 +74,36 @@ struct audio_stream_callbacks {
 
 /**
  * @brief Register audio streaming callbacks.
+ *
+ * May be called while streaming to swap consumers (e.g. USB bridge ->
+ * recorder) without stopping the capture/playback hardware: the new set takes
+ * effect at the next block boundary of each direction, and once this returns
+ * the previous callbacks are never called again. The caller may block for up
+ * to about one block while an in-flight block finishes; the audio path itself
+ * never waits. Must not be called from inside a tx_request / rx_data callback.
+ *
  * @param dev       Opaque context handle passed back to the callbacks.
  * @param callbacks Callback structure.
- * @return 0 on success, negative errno otherwise.
+ * @return 0 on success, -EINVAL on NULL arguments, -EBUSY if streaming with a
+ *         different @p dev.
  */
 int audio_stream_register(const struct device *dev, const struct audio_stream_callbacks *callbacks);
 
 /**
  * @brief Start audio streaming (starts the capture/playback backend).
- * @return 0 on success, negative errno otherwise.
+ *
+ * The backends run on 16-bit mono; the callbacks see @p format. 16, 24 (packed
+ * 3-byte), 32-bit integer and 32-bit float samples, mono or interleaved
+ * stereo, are converted at the edge (pcm_convert.h): RX is widened and
+ * duplicated to both channels, TX is downmixed and narrowed with rounding
+ * (and TPDF dither with CONFIG_APP_AUDIO_CONVERT_DITHER). With
+ * @ref audio_format.rx_dual, RX instead carries the processed audio (after
+ * de-emphasis) in channel 1 and the unfiltered capture in channel 2, both
+ * from the same capture block.
+ *
+ * @return 0 on success, -EINVAL on NULL arguments, a @p dev other than the
+ *         registered one or an unsupported @p format, -ENODEV if no backend
+ *         started.
  */
 int audio_stream_start(const struct device *dev, const struct audio_format *format);
 
@@ -88,12 +113,150 @@ int audio_stream_start(const struct device *dev, const struct audio_format *form
  */
 int audio_stream_stop(const struct device *dev);
 
+/**
+ * @brief Stop and restart the running stream with its current context and
+ * format, e.g. to recover a stalled backend (see audio_watchdog.h).
+ * @return 0 on success, -EAGAIN if nothing is streaming, negative errno from
+ *         audio_stream_stop()/audio_stream_start() otherwise.
+ */
+int audio_stream_restart(void);
+
 /**
  * @brief Get the current audio format.
  * @return 0 on success, negative errno otherwise.
  */
 int audio_stream_get_format(const struct device *dev, struct audio_format *format);
 
+/**
+ * @brief Enable or disable MCU-side FM emphasis.
+ *
+ * When enabled, TX audio gets 6 dB/oct pre-emphasis before the DAC and RX audio
+ * gets the matching de-emphasis after the ADC (voice). When disabled, audio
+ * passes flat (data modes). The SA818's own emphasis/HPF/LPF are expected to be
+ * bypassed (sa818_at_set_filters() with no flags). The change is applied at the
+ * next block boundary with a one-block crossfade; it may be called while
+ * streaming. Defaults to disabled.
+ *
+ * @return 0 on success, -EINVAL if @p dev is not the registered context.
+ */
+int audio_stream_set_emphasis(const struct device *dev, bool enable);
+
+/** @brief Current MCU emphasis setting (true = on). */
+bool audio_stream_get_emphasis(void);
+
+/** Stream direction for the per-direction settings. */
+enum audio_stream_dir {
+  AUDIO_STREAM_TX, /**< application -> playback (radio TX) */
+  AUDIO_STREAM_RX, /**< capture (radio RX) -> application */
+};
+
+/** Digital gain range, dB. */
+#define AUDIO_STREAM_GAIN_MIN_DB (-20)
+#define AUDIO_STREAM_GAIN_MAX_DB 12
+
+/**
+ * @brief Set the digital gain of one direction.
+ *
+ * A saturating fixed-point gain on the 16-bit core: TX on the application
+ * audio ahead of pre-emphasis (voice prompts keep their own level), RX after
+ * de-emphasis (the raw channel of CONFIG_APP_AUDIO_IN_DUAL stays unscaled).
+ * Takes effect at the next block; may be called while streaming. 0 dB, the
+ * default, bypasses the multiply.
+ *
+ * @return 0 on success, -EINVAL for a direction or @p db out of range
+ */
+int audio_stream_set_gain(enum audio_stream_dir dir, int db);
+
+/** @brief Current digital gain of @p dir, dB (0 for an invalid direction). */
+int audio_stream_get_gain(enum audio_stream_dir dir);
+
+/** Upper bound of CONFIG_APP_AUDIO_NOTCH_SECTIONS. */
+#define AUDIO_STREAM_NOTCH_SECTIONS_MAX 4
+
+/** One adaptive notch section (see audio_stream_set_notch()). */
+struct audio_stream_notch_section {
+  uint32_t freq_dhz;    /**< tracked frequency, 0.1 Hz */
+  int32_t depth_ddb;    /**< power this section takes out, 0.1 dB */
+  bool locked;          /**< settled on a tone */
+  uint32_t locks;       /**< lock events since the stream started */
+  uint32_t converge_ms; /**< start / last unlock to the last lock */
+};
+
+/** Adaptive RX notch status and cost. */
+struct audio_stream_notch_status {
+  bool enabled;     /**< notch applied to the audio (it adapts either way) */
+  uint8_t sections; /**< 0 when not built in */
+  struct audio_stream_notch_section section[AUDIO_STREAM_NOTCH_SECTIONS_MAX];
+  int32_t depth_ddb;    /**< whole cascade, 0.1 dB */
+  uint32_t samples;     /**< samples filtered since boot */
+  uint32_t cycles_last; /**< k_cycle_get_32() ticks for the last capture block */
+  uint32_t cycles_max;  /**< worst capture block since boot */
+  uint64_t cycles_total;
+  uint32_t cycles_per_sec; /**< k_cycle_get_32() rate, for converting to time */
+};
+
+/**
+ * @brief Switch the adaptive RX notch in or out.
+ *
+ * An LMS-adapted notch cascade on the capture, ahead of de-emphasis, that
+ * follows mains hum and stray carrier tones. It adapts while switched out,
+ * so the status shows an interferer before it is removed; switching is
+ * crossfaded over one block. Needs CONFIG_APP_AUDIO_NOTCH. Defaults to out.
+ *
+ * @return 0 on success, -EINVAL if @p dev is not the registered context,
+ *         -ENOTSUP if not built in.
+ */
+int audio_stream_set_notch(const struct device *dev, bool enable);
+
+/** @brief Restart notch adaptation from the mains-hum start frequencies. */
+void audio_stream_reset_notch(void);
+
+/** @brief Snapshot the notch status (any thread). */
+void audio_stream_get_notch(struct audio_stream_notch_status *status);
+
+/** SOF clock sync status (see audio_stream_set_clock_sync()). */
+struct audio_stream_clock_status {
+  bool enabled;      /**< sync requested */
+  bool active;       /**< trim running: streaming and SOFs arriving */
+  bool locked;       /**< phase held within half a frame for ~4 s */
+  int32_t trim_ppb;  /**< sample-rate correction, ppb (+ = sped up) */
+  int32_t phase_err; /**< last phase error vs. the host, Q24.8 samples */
+  uint32_t period;   /**< sampling-timer period last programmed, ticks */
+  uint32_t slips;    /**< phase reference re-anchors (suspend, stalls) */
+};
+
+/**
+ * @brief Lock the capture/playback sample clock to the USB SOF.
+ *
+ * When enabled, audio_stream_clock_sync_sof() trims both sampling timers so
+ * the sample rate tracks the host's frame clock instead of free-running off
+ * the MCU crystal; rings then only need slack for jitter, not for drift.
+ * Needs CONFIG_APP_AUDIO_SOF_SYNC.
+ *
+ * @return 0 on success, -EINVAL if @p dev is not the registered context,
+ *         -ENOTSUP if not built in.
+ */
+int audio_stream_set_clock_sync(const struct device *dev, bool enable);
+
+/**
+ * @brief Run one clock-sync step. Call once per USB SOF, always from the same
+ * thread (the UAC2 sof_cb); a no-op while sync is off or nothing streams.
+ */
+void audio_stream_clock_sync_sof(void);
+
+/** @brief Snapshot the SOF clock sync status (any thread). */
+void audio_stream_get_clock_sync(struct audio_stream_clock_status *status);
+
+/**
+ * @brief Samples played by the DAC so far, Q24.8 (free-running, wraps).
+ *
+ * The OUT feedback rate estimator stamps each SOF with it.
+ *
+ * @return 0 on success, -EAGAIN when playback is not running, -EBUSY if no
+ *         consistent reading was possible, -ENOTSUP without analog-audio-out.
+ */
+int audio_stream_get_play_position(uint32_t *position);
+
 #ifdef __cplusplus
 }
 #endif
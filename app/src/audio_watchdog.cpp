@@ -0,0 +1,192 @@
+/**
+ * @file audio_watchdog.cpp
+ * @brief Audio pipeline watchdog thread. See audio_watchdog.h.
+ *
+ * The detection/escalation policy is audio::PipelineWatchdog (pure logic);
+ * this file supplies the clock, the monitor thread and the two recovery
+ * actions. The thread is preemptible and runs above the audio work, so a
+ * stage stuck in a preemptible thread is still caught. Once the boot-confirm
+ * gate has brought up task_wdt, the monitor also feeds a task_wdt channel of
+ * its own, so a hang of the monitor itself ends in a reset. Built only with
+ * CONFIG_APP_AUDIO_WATCHDOG.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#include "audio_watchdog.h"
+
+#include "audio_stream.h"
+#include "pipeline_watchdog.h"
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/reboot.h>
+
+#ifdef CONFIG_EVENT_BUS
+#include <oe5xrx/events/bus.h>
+#endif
+
+#if defined(CONFIG_TASK_WDT)
+#include <zephyr/task_wdt/task_wdt.h>
+
+/* Set by the boot-confirm gate once task_wdt_init() has succeeded. */
+extern "C" bool boot_confirm_fm_task_wdt_ready(void);
+#endif
+
+LOG_MODULE_REGISTER(audio_wdt, LOG_LEVEL_INF);
+
+namespace {
+
+using audio::PipelineWatchdog;
+
+PipelineWatchdog g_wdt;
+
+#ifdef CONFIG_APP_AUDIO_WATCHDOG_SOF
+constexpr uint32_t kSofTimeoutMs = CONFIG_APP_AUDIO_WATCHDOG_SOF_TIMEOUT_MS;
+#else
+constexpr uint32_t kSofTimeoutMs = 0; /* never armed */
+#endif
+
+/* SOF arming has two inputs: streaming terminals (bridge) and bus suspend. */
+struct k_spinlock g_sof_lock;
+bool g_sof_wanted;
+bool g_bus_suspended;
+
+/* Caller holds g_sof_lock. */
+void arm_sof() {
+  g_wdt.arm(PipelineWatchdog::kSof, IS_ENABLED(CONFIG_APP_AUDIO_WATCHDOG_SOF) && g_sof_wanted && !g_bus_suspended, k_uptime_get_32());
+}
+
+/* Published by the monitor thread for audio_watchdog_get_stats(). */
+struct k_spinlock g_stats_lock;
+struct audio_watchdog_stats g_stats;
+
+const char *const kChannelNames[AUDIO_WDT_CHANNELS] = {"capture", "playback", "sof"};
+
+void publish_stats() {
+  const PipelineWatchdog::Stats &s = g_wdt.stats();
+  struct audio_watchdog_stats out = {};
+  for (size_t ch = 0; ch < AUDIO_WDT_CHANNELS; ch++) {
+    out.stalls[ch] = s.stalls[ch];
+  }
+  out.restarts = s.restarts;
+  out.recoveries = s.recoveries;
+  out.mttr_last_ms = s.mttr_last_ms;
+  out.mttr_mean_ms = s.recoveries ? static_cast<uint32_t>(s.mttr_sum_ms / s.recoveries) : 0U;
+  out.mttr_max_ms = s.mttr_max_ms;
+  out.armed_mask = g_wdt.armed_mask();
+  out.stalled_mask = g_wdt.stalled_mask();
+
+  k_spinlock_key_t key = k_spin_lock(&g_stats_lock);
+  g_stats = out;
+  k_spin_unlock(&g_stats_lock, key);
+}
+
+void log_stalled(uint8_t mask, const char *what) {
+  for (size_t ch = 0; ch < AUDIO_WDT_CHANNELS; ch++) {
+    if (mask & BIT(ch)) {
+      LOG_WRN("%s stalled: %s", kChannelNames[ch], what);
+    }
+  }
+}
+
+void monitor_thread(void *, void *, void *) {
+#if defined(CONFIG_TASK_WDT)
+  int wdt_channel = -1;
+  bool wdt_added = false;
+#endif
+
+  while (true) {
+    k_msleep(CONFIG_APP_AUDIO_WATCHDOG_POLL_MS);
+
+#if defined(CONFIG_TASK_WDT)
+    if (!wdt_added && boot_confirm_fm_task_wdt_ready()) {
+      /* NULL callback: task_wdt resets the system if this thread stops feeding. */
+      wdt_added = true;
+      wdt_channel = task_wdt_add(CONFIG_APP_AUDIO_WATCHDOG_TASK_WDT_MS, NULL, NULL);
+      if (wdt_channel < 0) {
+        LOG_WRN("task_wdt_add failed: %d (monitor itself unguarded)", wdt_channel);
+      }
+    }
+    if (wdt_channel >= 0) {
+      (void)task_wdt_feed(wdt_channel);
+    }
+#endif
+
+    const uint32_t recoveries = g_wdt.stats().recoveries;
+    const PipelineWatchdog::Action action = g_wdt.poll(k_uptime_get_32());
+
+    if (action == PipelineWatchdog::Action::kRestart) {
+      log_stalled(g_wdt.stalled_mask(), "restarting audio stream");
+#ifdef CONFIG_EVENT_BUS
+      events::publish(events::Type::AudioStall, g_wdt.stalled_mask());
+#endif
+      int ret = audio_stream_restart();
+      if (ret < 0 && ret != -EAGAIN) {
+        LOG_ERR("audio stream restart failed: %d; rebooting", ret);
+        sys_reboot(SYS_REBOOT_COLD);
+      }
+    } else if (action == PipelineWatchdog::Action::kReboot) {
+      LOG_ERR("audio pipeline still stalled after %u restarts (mask 0x%x); rebooting", CONFIG_APP_AUDIO_WATCHDOG_MAX_RESTARTS, g_wdt.stalled_mask());
+      sys_reboot(SYS_REBOOT_COLD);
+    } else if (g_wdt.stats().recoveries != recoveries) {
+      const PipelineWatchdog::Stats &s = g_wdt.stats();
+      LOG_INF("audio pipeline recovered in %u ms (MTTR mean %u ms, max %u ms, %u recoveries)", s.mttr_last_ms,
+              static_cast<uint32_t>(s.mttr_sum_ms / s.recoveries), s.mttr_max_ms, s.recoveries);
+#ifdef CONFIG_EVENT_BUS
+      events::publish(events::Type::AudioStall, 0);
+#endif
+    }
+
+    publish_stats();
+  }
+}
+
+} // namespace
+
+/* Before main(), so nothing can be armed yet when init() clears the channels. */
+static int audio_watchdog_init(void) {
+  const PipelineWatchdog::Config cfg = {
+      {CONFIG_APP_AUDIO_WATCHDOG_TIMEOUT_MS, CONFIG_APP_AUDIO_WATCHDOG_TIMEOUT_MS, kSofTimeoutMs},
+      CONFIG_APP_AUDIO_WATCHDOG_MAX_RESTARTS,
+  };
+  g_wdt.init(cfg);
+  return 0;
+}
+
+SYS_INIT(audio_watchdog_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/* Started at boot (before any stage can arm) at a preemptible priority above
+ * the audio work queues. */
+K_THREAD_DEFINE(audio_wdt_tid, CONFIG_APP_AUDIO_WATCHDOG_STACK_SIZE, monitor_thread, NULL, NULL, NULL, CONFIG_APP_AUDIO_WATCHDOG_THREAD_PRIORITY, 0, 0);
+
+extern "C" void audio_watchdog_beat(enum audio_wdt_channel ch) {
+  g_wdt.beat(static_cast<PipelineWatchdog::Channel>(ch), k_uptime_get_32());
+}
+
+extern "C" void audio_watchdog_arm(enum audio_wdt_channel ch, bool on) {
+  if (ch == AUDIO_WDT_SOF) {
+    k_spinlock_key_t key = k_spin_lock(&g_sof_lock);
+    g_sof_wanted = on;
+    arm_sof();
+    k_spin_unlock(&g_sof_lock, key);
+    return;
+  }
+  g_wdt.arm(static_cast<PipelineWatchdog::Channel>(ch), on, k_uptime_get_32());
+}
+
+extern "C" void audio_watchdog_bus_suspended(bool suspended) {
+  k_spinlock_key_t key = k_spin_lock(&g_sof_lock);
+  g_bus_suspended = suspended;
+  arm_sof();
+  k_spin_unlock(&g_sof_lock, key);
+}
+
+extern "C" void audio_watchdog_get_stats(struct audio_watchdog_stats *stats) {
+  k_spinlock_key_t key = k_spin_lock(&g_stats_lock);
+  *stats = g_stats;
+  k_spin_unlock(&g_stats_lock, key);
+}
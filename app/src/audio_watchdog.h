@@ -0,0 +1,64 @@
+/**
+ * @file audio_watchdog.h
+ * @brief Runtime liveness monitor for the audio pipeline.
+ *
+ * The capture delivery, the playback refill and the USB SOF handler each
+ * report a heartbeat per block/frame. A monitor thread restarts the audio
+ * stream (audio_stream_restart()) when an armed stage goes silent for a few
+ * block periods, and reboots if the restarts do not bring it back. Time to
+ * recovery is logged and kept in the stats. Needs CONFIG_APP_AUDIO_WATCHDOG.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#ifndef OE5XRX_APP_AUDIO_WATCHDOG_H_
+#define OE5XRX_APP_AUDIO_WATCHDOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Monitored pipeline stages. */
+enum audio_wdt_channel {
+  AUDIO_WDT_CAPTURE,  /**< ADC block delivered to the consumer */
+  AUDIO_WDT_PLAYBACK, /**< DAC half refilled from the producer */
+  AUDIO_WDT_SOF,      /**< USB SOF handled */
+  AUDIO_WDT_CHANNELS,
+};
+
+/** @brief Heartbeat for @p ch. Any thread, once per block/frame; no locks. */
+void audio_watchdog_beat(enum audio_wdt_channel ch);
+
+/** @brief Start/stop monitoring @p ch (its stage started/stopped on purpose). */
+void audio_watchdog_arm(enum audio_wdt_channel ch, bool on);
+
+/**
+ * @brief Tell the watchdog whether the USB bus is suspended. No SOFs arrive
+ * during suspend, so the SOF channel is only checked while armed and resumed.
+ */
+void audio_watchdog_bus_suspended(bool suspended);
+
+/** Watchdog statistics since boot. */
+struct audio_watchdog_stats {
+  uint32_t stalls[AUDIO_WDT_CHANNELS]; /**< stall detections per channel */
+  uint32_t restarts;                   /**< stream restarts performed */
+  uint32_t recoveries;                 /**< stalls cleared without a reboot */
+  uint32_t mttr_last_ms;               /**< last detection -> flowing again */
+  uint32_t mttr_mean_ms;
+  uint32_t mttr_max_ms;
+  uint8_t armed_mask;   /**< BIT(channel) */
+  uint8_t stalled_mask; /**< channels in the current episode */
+};
+
+/** @brief Snapshot the statistics (any thread). */
+void audio_watchdog_get_stats(struct audio_watchdog_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_APP_AUDIO_WATCHDOG_H_ */
@@ -0,0 +1,101 @@
+/**
+ * @file bench.h
+ * @brief On-target benchmark cases for the `bench` shell command.
+ *
+ * A case is one kernel from the host benchmark suite (tests/host/src), with
+ * the same name and the same per-iteration work, run on the Cortex-M33. The
+ * host numbers miss flash wait states, the cache and the bus contention of
+ * the audio DMA; these don't. Timing comes from the DWT cycle counter, and
+ * `bench run` prints Google Benchmark CSV (see bench_shell.cpp), so a device
+ * run and `fm_host_bench --benchmark_format=csv` join on the name column.
+ *
+ * Cases follow the Google Benchmark shape: setup, then
+ * `while (state.keepRunning()) { ... }`, which is the only part timed.
+ * Needs CONFIG_APP_BENCH.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#ifndef OE5XRX_APP_BENCH_H_
+#define OE5XRX_APP_BENCH_H_
+
+#include <cmsis_core.h>
+#include <span>
+#include <stdint.h>
+
+namespace bench {
+
+/** Start the DWT cycle counter (idempotent). */
+inline void cycles_init() {
+  DCB->DEMCR = DCB->DEMCR | DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+}
+
+inline uint32_t cycles() { return DWT->CYCCNT; }
+
+/** Keep @p value (and what it points to) live across the loop, as benchmark::DoNotOptimize(). */
+template <typename T> inline void doNotOptimize(const T &value) { __asm__ volatile("" : : "r,m"(value) : "memory"); }
+
+inline void clobberMemory() { __asm__ volatile("" : : : "memory"); }
+
+/** Iteration control and timing for one run of a case. */
+class State {
+public:
+  /** @p iterations >= 1. */
+  State(int32_t arg, uint32_t iterations) : arg_(arg), left_(iterations) {}
+
+  /** The case argument, as state.range(0) on the host. */
+  int32_t range() const { return arg_; }
+
+  /**
+   * Loop condition. The clock starts on the first call and stops on the one
+   * returning false. The 32-bit counter is folded into the total every
+   * kLap iterations, so a run may take longer than one counter wrap.
+   */
+  bool keepRunning() {
+    if (!running_) {
+      running_ = true;
+      mark_ = cycles();
+    } else if (left_ == 0U) {
+      lap();
+      return false;
+    } else if ((left_ & (kLap - 1U)) == 0U) {
+      lap();
+    }
+    left_--;
+    return true;
+  }
+
+  /** Cycles spent in the loop. */
+  uint64_t total() const { return total_; }
+
+private:
+  static constexpr uint32_t kLap = 256;
+
+  void lap() {
+    const uint32_t now = cycles();
+    total_ += now - mark_;
+    mark_ = now;
+  }
+
+  int32_t arg_;
+  uint32_t left_;
+  bool running_ = false;
+  uint32_t mark_ = 0;
+  uint64_t total_ = 0;
+};
+
+struct Case {
+  const char *name; /**< host benchmark name, argument included ("BM_EmphasisBlock/8") */
+  int32_t arg;      /**< State::range() */
+  uint32_t items;   /**< items per iteration (items_per_second), 0 for none */
+  void (*run)(State &state);
+};
+
+/** All cases built into this image (bench_cases.cpp). */
+std::span<const Case> cases();
+
+} // namespace bench
+
+#endif /* OE5XRX_APP_BENCH_H_ */
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * The on-target benchmark cases (bench.h). Each mirrors the host benchmark of
+ * the same name in tests/host/src: same data, same block sizes, same items.
+ * Cases for code that is not linked into this image are left out.
+ */
+#include "bench.h"
+
+#include "adaptive_notch.h"
+#include "emphasis.h"
+#include "feedback.h"
+#include "pcm_convert.h"
+#include "rate_feedback.h"
+
+#include <array>
+#include <math.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_MODULE
+#include <oe5xrx/module/iface.h>
+#endif
+#ifdef CONFIG_SA818
+#include <sa818/sa818_at.h>
+#endif
+#ifdef CONFIG_AUDIO_DCS
+#include "dcs_decoder.h"
+#endif
+#ifdef CONFIG_AUDIO_LINK
+#include "ima_adpcm.h"
+#endif
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_IN_ENABLED
+#include "analog_audio_in/adc_pcm.h"
+#endif
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_OUT_ENABLED
+#include "analog_audio_out/dac_pcm.h"
+#endif
+
+namespace bench {
+namespace {
+
+/* ---- PCM format conversion (bench_convert.cpp) ------------------------------ */
+
+constexpr size_t kFrames = 48; /* 1 ms at 48 kHz */
+
+using Encoding = audio::pcm::Encoding;
+
+std::array<int16_t, 2 * kFrames> Ramp() {
+  std::array<int16_t, 2 * kFrames> pcm{};
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>(i * 1499U);
+  }
+  return pcm;
+}
+
+void ToWireStereo(State &state) {
+  const audio::pcm::Format fmt{static_cast<Encoding>(state.range()), 2};
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  while (state.keepRunning()) {
+    audio::pcm::to_wire(pcm.data(), wire.data(), kFrames, fmt);
+    doNotOptimize(wire.data());
+    clobberMemory();
+  }
+}
+
+void FromWireStereo(State &state) {
+  const audio::pcm::Format fmt{static_cast<Encoding>(state.range()), 2};
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  audio::pcm::to_wire(pcm.data(), wire.data(), kFrames, fmt);
+  std::array<int16_t, kFrames> mono{};
+  while (state.keepRunning()) {
+    audio::pcm::from_wire(wire.data(), mono.data(), kFrames, fmt, nullptr);
+    doNotOptimize(mono.data());
+    clobberMemory();
+  }
+}
+
+void Interleave(State &state) {
+  const auto pcm = Ramp();
+  std::array<int16_t, 2 * kFrames> frames{};
+  while (state.keepRunning()) {
+    audio::pcm::interleave(pcm.data(), pcm.data() + kFrames, frames.data(), kFrames);
+    doNotOptimize(frames.data());
+    clobberMemory();
+  }
+}
+
+void Deinterleave(State &state) {
+  const auto pcm = Ramp();
+  std::array<int16_t, kFrames> left{};
+  std::array<int16_t, kFrames> right{};
+  while (state.keepRunning()) {
+    audio::pcm::deinterleave(pcm.data(), left.data(), right.data(), kFrames);
+    doNotOptimize(left.data());
+    doNotOptimize(right.data());
+    clobberMemory();
+  }
+}
+
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_IN_ENABLED
+/* bench_pcm.cpp */
+void AdcToPcm16Block(State &state) {
+  const size_t n = static_cast<size_t>(state.range());
+  std::array<uint16_t, 16> raw{};
+  std::array<int16_t, 16> pcm{};
+  for (size_t i = 0; i < raw.size(); i++) {
+    raw[i] = static_cast<uint16_t>((i * 257U) & 0x0FFFU);
+  }
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < n; i++) {
+      pcm[i] = adc_to_pcm16(raw[i], 12);
+    }
+    doNotOptimize(pcm.data());
+    clobberMemory();
+  }
+}
+#endif
+
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_OUT_ENABLED
+void Pcm16ToDacBlock(State &state) {
+  const size_t n = static_cast<size_t>(state.range());
+  std::array<int16_t, 16> pcm{};
+  std::array<uint16_t, 16> dac{};
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>(i * 4099U);
+  }
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < n; i++) {
+      dac[i] = pcm16_to_dac(pcm[i], 12);
+    }
+    doNotOptimize(dac.data());
+    clobberMemory();
+  }
+}
+#endif
+
+/* ---- Feedback regulators (bench_feedback.cpp) -------------------------------- */
+
+constexpr uint16_t kSamplesPerSof = 8;
+constexpr size_t kCapacity = 256; /* samples */
+
+void FeedbackUpdate(State &state) {
+  usb_audio::BufferFeedback fb;
+  fb.init(kSamplesPerSof);
+  size_t step = 0;
+  while (state.keepRunning()) {
+    fb.update((kCapacity / 2 - 24) + (step++ % 49), kCapacity);
+    doNotOptimize(fb.value());
+  }
+}
+
+void RateFeedbackUpdate(State &state) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  uint32_t position = 0;
+  size_t step = 0;
+  while (state.keepRunning()) {
+    fb.stamp(position);
+    position += kSamplesPerSof << 8;
+    fb.update((kCapacity / 2 - 24) + (step++ % 49), kCapacity);
+    doNotOptimize(fb.value());
+  }
+}
+
+/* ---- Module JSON rendering (bench_iface.cpp) --------------------------------- */
+
+#ifdef CONFIG_MODULE
+const mod::Range kGainRanges[] = {{nullptr, 0.0, 8.0}};
+const mod::FieldSpec kGainSpec{"gain", mod::ValueType::Int, "dB", kGainRanges, 1};
+const mod::FieldSpec kLevelSpec{"level", mod::ValueType::Float, "dBFS", nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+class GainCap : public mod::Setting {
+public:
+  const mod::FieldSpec &spec() const override { return kGainSpec; }
+
+protected:
+  mod::Result onSet(const char *) override { return mod::Result::okInt(gain_); }
+  mod::Result onGet() override { return mod::Result::okInt(gain_); }
+
+private:
+  int gain_ = 4;
+};
+
+class LevelCap : public mod::Telemetry {
+public:
+  const mod::FieldSpec &spec() const override { return kLevelSpec; }
+
+protected:
+  mod::Result onGet() override { return mod::Result::okFloat(-12.5); }
+};
+
+GainCap g_gain;
+LevelCap g_level;
+mod::Capability *const g_caps[] = {&g_gain, &g_level};
+const mod::Identity g_identity{"bench", "host", "0"};
+mod::Module g_module{g_identity, "bench", g_caps};
+
+/* Off the shell thread's stack. */
+char g_json[1024];
+
+void ModuleDescribe(State &state) {
+  while (state.keepRunning()) {
+    mod::JsonWriter w(g_json, sizeof(g_json));
+    g_module.describe(w);
+    doNotOptimize(w.c_str());
+  }
+}
+
+void ModuleExecuteGet(State &state) {
+  while (state.keepRunning()) {
+    mod::JsonWriter w(g_json, 256);
+    g_module.execute(mod::Op::Get, "level", "").render(w, "bench", "level", "get");
+    doNotOptimize(w.c_str());
+  }
+}
+#endif /* CONFIG_MODULE */
+
+/* ---- Tone parsing (SA818 driver, device only) -------------------------------- */
+
+#ifdef CONFIG_SA818
+/* What `module fm set tx_tone` and `sa818 group` parse: CTCSS, DCS, none. */
+const char *const kTones[] = {"67.0", "123.0", "250.3", "023", "754", "none"};
+
+void ToneParse(State &state) {
+  while (state.keepRunning()) {
+    for (const char *tone : kTones) {
+      doNotOptimize(sa818_at_parse_tone(tone));
+    }
+  }
+}
+#endif
+
+/* ---- DSP kernels (bench_emphasis/notch/dcs/audio_link.cpp) ------------------- */
+
+void Fill(std::array<int16_t, 16> &pcm) {
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>((i * 1499U) & 0x1FFFU);
+  }
+}
+
+void EmphasisBlock(State &state) {
+  const size_t n = static_cast<size_t>(state.range());
+  audio::Emphasis f(audio::Emphasis::Mode::kDe, true);
+  std::array<int16_t, 16> pcm{};
+  while (state.keepRunning()) {
+    Fill(pcm);
+    f.process(pcm.data(), n, true);
+    doNotOptimize(pcm.data());
+    clobberMemory();
+  }
+}
+
+void NotchBlock(State &state) {
+  audio::AdaptiveNotch f({static_cast<uint8_t>(state.range()), 10, 7}, true);
+  std::array<int16_t, 8> pcm{};
+  uint32_t phase = 0;
+  while (state.keepRunning()) {
+    for (size_t i = 0; i < pcm.size(); i++) {
+      pcm[i] = static_cast<int16_t>((phase++ * 1499U) & 0x1FFFU);
+    }
+    f.process(pcm.data(), pcm.size(), true);
+    doNotOptimize(pcm.data());
+    clobberMemory();
+  }
+}
+
+#ifdef CONFIG_AUDIO_DCS
+/* 023N NRZ under a square "voice", as on the host but a quarter second long. */
+int16_t g_dcs_signal[2000];
+
+void DcsFeed(State &state) {
+  const uint32_t word = dcs::encode(0023);
+  for (size_t i = 0; i < ARRAY_SIZE(g_dcs_signal); i++) {
+    const size_t bit = (i * dcs::kBitRateMilli / 8000000U) % dcs::kWordBits;
+    const int32_t code = ((word >> bit) & 1U) ? 1500 : -1500;
+    const int32_t voice = ((i / 9) & 1U) ? 4000 : -4000;
+    g_dcs_signal[i] = static_cast<int16_t>(code + voice);
+  }
+  const size_t n = static_cast<size_t>(state.range());
+  dcs::Decoder d;
+  size_t pos = 0;
+  while (state.keepRunning()) {
+    d.feed(&g_dcs_signal[pos], n);
+    pos = (pos + n) % ARRAY_SIZE(g_dcs_signal);
+    doNotOptimize(d.detection());
+  }
+}
+#endif
+
+#ifdef CONFIG_AUDIO_LINK
+constexpr size_t kLinkFrame = 160; /* 20 ms at 8 kHz */
+
+void LinkTone(int16_t *pcm) {
+  for (size_t i = 0; i < kLinkFrame; i++) {
+    pcm[i] = static_cast<int16_t>(8000.0 * sin(2.0 * M_PI * 1000.0 * static_cast<double>(i) / 8000.0));
+  }
+}
+
+void AdpcmEncode(State &state) {
+  int16_t pcm[kLinkFrame];
+  LinkTone(pcm);
+  audio::AdpcmState st{};
+  uint8_t codes[audio::adpcmBytes(kLinkFrame)];
+  while (state.keepRunning()) {
+    audio::adpcmEncode(st, pcm, kLinkFrame, codes);
+    doNotOptimize(codes);
+  }
+}
+
+void AdpcmDecode(State &state) {
+  int16_t pcm[kLinkFrame];
+  LinkTone(pcm);
+  audio::AdpcmState st{};
+  uint8_t codes[audio::adpcmBytes(kLinkFrame)];
+  audio::adpcmEncode(st, pcm, kLinkFrame, codes);
+  while (state.keepRunning()) {
+    audio::AdpcmState dec{};
+    audio::adpcmDecode(dec, codes, kLinkFrame, pcm);
+    doNotOptimize(pcm);
+  }
+}
+#endif
+
+/* name, arg, items, run: in the order of the host suite's files. */
+const Case kCases[] = {
+#ifdef CONFIG_AUDIO_LINK
+    {"BM_AdpcmEncode", 0, kLinkFrame, AdpcmEncode},
+    {"BM_AdpcmDecode", 0, kLinkFrame, AdpcmDecode},
+#endif
+    /* arg: audio::pcm::Encoding, 0 S16 .. 3 F32 */
+    {"BM_ToWireStereo/0", 0, kFrames, ToWireStereo},
+    {"BM_ToWireStereo/1", 1, kFrames, ToWireStereo},
+    {"BM_ToWireStereo/2", 2, kFrames, ToWireStereo},
+    {"BM_ToWireStereo/3", 3, kFrames, ToWireStereo},
+    {"BM_FromWireStereo/0", 0, kFrames, FromWireStereo},
+    {"BM_FromWireStereo/1", 1, kFrames, FromWireStereo},
+    {"BM_FromWireStereo/2", 2, kFrames, FromWireStereo},
+    {"BM_FromWireStereo/3", 3, kFrames, FromWireStereo},
+    {"BM_Interleave", 0, kFrames, Interleave},
+    {"BM_Deinterleave", 0, kFrames, Deinterleave},
+#ifdef CONFIG_AUDIO_DCS
+    {"BM_DcsFeed/8", 8, 8, DcsFeed},
+    {"BM_DcsFeed/16", 16, 16, DcsFeed},
+#endif
+    {"BM_EmphasisBlock/8", 8, 8, EmphasisBlock},
+    {"BM_EmphasisBlock/16", 16, 16, EmphasisBlock},
+    {"BM_FeedbackUpdate", 0, 1, FeedbackUpdate},
+    {"BM_RateFeedbackUpdate", 0, 1, RateFeedbackUpdate},
+#ifdef CONFIG_MODULE
+    {"BM_ModuleDescribe", 0, 0, ModuleDescribe},
+    {"BM_ModuleExecuteGet", 0, 0, ModuleExecuteGet},
+#endif
+    {"BM_NotchBlock/1", 1, 8, NotchBlock},
+    {"BM_NotchBlock/2", 2, 8, NotchBlock},
+    {"BM_NotchBlock/4", 4, 8, NotchBlock},
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_IN_ENABLED
+    {"BM_AdcToPcm16Block/8", 8, 8, AdcToPcm16Block},
+    {"BM_AdcToPcm16Block/16", 16, 16, AdcToPcm16Block},
+#endif
+#ifdef CONFIG_DT_HAS_OE5XRX_ANALOG_AUDIO_OUT_ENABLED
+    {"BM_Pcm16ToDacBlock/8", 8, 8, Pcm16ToDacBlock},
+    {"BM_Pcm16ToDacBlock/16", 16, 16, Pcm16ToDacBlock},
+#endif
+#ifdef CONFIG_SA818
+    {"BM_ToneParse", 0, ARRAY_SIZE(kTones), ToneParse},
+#endif
+};
+
+} // namespace
+
+std::span<const Case> cases() { return kCases; }
+
+} // namespace bench
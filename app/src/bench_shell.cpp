@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * `bench` shell command: runs the cases of bench_cases.cpp on the target and
+ * prints the result as Google Benchmark CSV (the --benchmark_format=csv
+ * columns), one row per case, plus a `cycles` counter column with the DWT
+ * cycles per iteration. scripts/bench_compare.py joins it with a host run.
+ *
+ * Cases run in the shell thread. Interrupts and higher-priority threads keep
+ * running, so with audio streaming the numbers include its bus load and
+ * preemption; for the bare kernel cost run with the stream idle.
+ */
+#include "bench.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/shell/shell.h>
+
+namespace {
+
+/* "123.456": @p milli thousandths. */
+void format_milli(char *buf, size_t len, uint64_t milli) {
+  snprintf(buf, len, "%llu.%03u", static_cast<unsigned long long>(milli / 1000U), static_cast<unsigned>(milli % 1000U));
+}
+
+/* Items per second, or "" (the column stays empty, as on the host). */
+void format_rate(char *buf, size_t len, uint32_t per_iteration, uint64_t cyc_milli) {
+  if (per_iteration == 0U || cyc_milli == 0U) {
+    buf[0] = '\0';
+    return;
+  }
+  snprintf(buf, len, "%llu", static_cast<unsigned long long>(static_cast<uint64_t>(per_iteration) * SystemCoreClock * 1000U / cyc_milli));
+}
+
+void run_case(const struct shell *sh, const bench::Case &c, uint32_t iterations) {
+  bench::State state(c.arg, iterations);
+  c.run(state);
+
+  /* Per iteration, in thousandths: cycles, then ns at the core clock. */
+  const uint64_t cyc_milli = state.total() * 1000U / iterations;
+  const uint64_t ns_milli = cyc_milli * 1000000U / (SystemCoreClock / 1000U);
+  char ns[24];
+  char cyc[24];
+  char items[24];
+  format_milli(ns, sizeof(ns), ns_milli);
+  format_milli(cyc, sizeof(cyc), cyc_milli);
+  format_rate(items, sizeof(items), c.items, cyc_milli);
+  /* One thread: real and CPU time are the same. No case counts bytes. */
+  shell_print(sh, "\"%s\",%u,%s,%s,ns,,%s,,,,%s", c.name, iterations, ns, ns, items, cyc);
+}
+
+int cmd_bench_list(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  for (const bench::Case &c : bench::cases()) {
+    shell_print(sh, "%s", c.name);
+  }
+  return 0;
+}
+
+int cmd_bench_run(const struct shell *sh, size_t argc, char **argv) {
+  const char *filter = argc > 1 && strcmp(argv[1], "all") != 0 ? argv[1] : "";
+  uint32_t iterations = CONFIG_APP_BENCH_ITERATIONS;
+  if (argc > 2) {
+    char *end;
+    const unsigned long n = strtoul(argv[2], &end, 10);
+    if (*end != '\0' || n == 0U) {
+      shell_error(sh, "iterations must be a positive number");
+      return -EINVAL;
+    }
+    iterations = static_cast<uint32_t>(n);
+  }
+
+  bench::cycles_init();
+  shell_print(sh, "name,iterations,real_time,cpu_time,time_unit,bytes_per_second,items_per_second,label,error_occurred,error_message,\"cycles\"");
+  for (const bench::Case &c : bench::cases()) {
+    if (strstr(c.name, filter) != nullptr) {
+      run_case(sh, c, iterations);
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    bench_cmds,
+    SHELL_CMD(list, NULL, "Benchmark case names", cmd_bench_list),
+    SHELL_CMD_ARG(run, NULL, "run [filter|all] [iterations]: cases whose name contains <filter>, as Google Benchmark CSV", cmd_bench_run, 1, 2),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(bench, &bench_cmds, "On-target benchmarks (cycles from DWT)", NULL);
@@ -23,6 +23,10 @@
  * backstop: it fires when the gate is schedulable but all probes stay unhealthy
  * past the deadline.
  *
+ * task_wdt_init() is done here, once; other threads that want a task_wdt
+ * channel (the audio pipeline watchdog) wait for
+ * boot_confirm_fm_task_wdt_ready() before calling task_wdt_add().
+ *
  * task_wdt is compiled in only when CONFIG_TASK_WDT is set (prod/sysbuild
  * build).  In the bare build CONFIG_TASK_WDT is not set, so the watchdog block
  * compiles out; this is safe because in bare CONFIG_BOOTLOADER_MCUBOOT is also
@@ -79,7 +83,8 @@ struct Env {
 Env g_env;
 
 #if defined(CONFIG_TASK_WDT)
-static int g_wdt_channel = -1; /* task_wdt channel id; -1 = not initialised */
+static int g_wdt_channel = -1;               /* task_wdt channel id; -1 = not initialised */
+static std::atomic<bool> g_wdt_ready{false}; /* task_wdt_init() succeeded; other threads may add channels */
 #endif
 
 /* ---- probes ---------------------------------------------------------------- */
@@ -199,6 +204,7 @@ void gate_thread(void *, void *, void *) {
 #endif
     /* Already-confirmed image or bare build: no watchdog revert risk; keep running. */
   } else {
+    g_wdt_ready.store(true);
     g_wdt_channel = task_wdt_add(WDT_PERIOD_MS, wdt_cb, NULL);
     if (g_wdt_channel < 0) {
       LOG_ERR("task_wdt_add rc=%d; HW watchdog NOT armed", g_wdt_channel);
@@ -252,6 +258,14 @@ extern "C" void boot_confirm_fm_usb_configured(void) {
   g_env.usb_configured.store(true);
 }
 
+extern "C" bool boot_confirm_fm_task_wdt_ready(void) {
+#if defined(CONFIG_TASK_WDT)
+  return g_wdt_ready.load();
+#else
+  return false;
+#endif
+}
+
 extern "C" void boot_confirm_fm_start(const struct device *sa818) {
   g_env.sa818 = sa818;
   g_env.usb_configured.store(false);
@@ -0,0 +1,102 @@
+/**
+ * @file bridge_stats.cpp
+ * @brief USB audio bridge counters. See bridge_stats.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "bridge_stats.h"
+
+namespace usb_audio {
+
+namespace {
+
+constexpr auto kRelaxed = std::memory_order_relaxed;
+
+} // namespace
+
+void BridgeStats::in_send_failed(int err) {
+  /* Only the SOF callback sends, so only one thread claims slots. */
+  for (size_t i = 0; i < kErrnoSlots; i++) {
+    const int slot = errno_[i].load(kRelaxed);
+    if (slot == err) {
+      inc(errno_count_[i]);
+      return;
+    }
+    if (slot == 0) {
+      errno_[i].store(err, kRelaxed);
+      inc(errno_count_[i]);
+      return;
+    }
+  }
+  inc(errno_other_);
+}
+
+void BridgeStats::feedback(uint32_t value) {
+  if (value < fb_min_.load(kRelaxed)) {
+    fb_min_.store(value, kRelaxed);
+  }
+  if (value > fb_max_.load(kRelaxed)) {
+    fb_max_.store(value, kRelaxed);
+  }
+  const uint32_t n = fb_count_.load(kRelaxed);
+  fb_count_.store(n + 1U, kRelaxed);
+  if (n % kTraceEvery == 0U) {
+    const uint32_t head = trace_head_.load(kRelaxed);
+    trace_[head % kTraceLen].store(value, kRelaxed);
+    trace_head_.store(head + 1U, std::memory_order_release);
+  }
+}
+
+void BridgeStats::snapshot(Snapshot *out) const {
+  for (size_t d = 0; d < kDirs; d++) {
+    out->bytes[d] = bytes_[d].load(kRelaxed);
+    out->overflows[d] = overflows_[d].load(kRelaxed);
+    out->dropped[d] = dropped_[d].load(kRelaxed);
+    out->underruns[d] = underruns_[d].load(kRelaxed);
+    for (size_t b = 0; b < kFillBins; b++) {
+      out->fill[d][b] = fill_[d][b].load(kRelaxed);
+    }
+  }
+  out->prebuffer_resets = prebuffer_resets_.load(kRelaxed);
+  for (size_t i = 0; i < kErrnoSlots; i++) {
+    out->send_errors[i] = {errno_[i].load(kRelaxed), errno_count_[i].load(kRelaxed)};
+  }
+  out->send_errors_other = errno_other_.load(kRelaxed);
+
+  const uint32_t max = fb_max_.load(kRelaxed);
+  out->feedback_min = max == 0U ? 0U : fb_min_.load(kRelaxed);
+  out->feedback_max = max;
+
+  /* A value traced while copying may overwrite the oldest entry; that only
+   * ever shows one newer value in its place. */
+  const uint32_t head = trace_head_.load(std::memory_order_acquire);
+  out->trace_len = head < kTraceLen ? head : static_cast<uint32_t>(kTraceLen);
+  for (uint32_t i = 0; i < out->trace_len; i++) {
+    out->trace[i] = trace_[(head - out->trace_len + i) % kTraceLen].load(kRelaxed);
+  }
+}
+
+void BridgeStats::reset() {
+  for (size_t d = 0; d < kDirs; d++) {
+    bytes_[d].store(0U, kRelaxed);
+    overflows_[d].store(0U, kRelaxed);
+    dropped_[d].store(0U, kRelaxed);
+    underruns_[d].store(0U, kRelaxed);
+    for (size_t b = 0; b < kFillBins; b++) {
+      fill_[d][b].store(0U, kRelaxed);
+    }
+  }
+  prebuffer_resets_.store(0U, kRelaxed);
+  for (size_t i = 0; i < kErrnoSlots; i++) {
+    errno_[i].store(0, kRelaxed);
+    errno_count_[i].store(0U, kRelaxed);
+  }
+  errno_other_.store(0U, kRelaxed);
+  fb_min_.store(UINT32_MAX, kRelaxed);
+  fb_max_.store(0U, kRelaxed);
+  fb_count_.store(0U, kRelaxed);
+  trace_head_.store(0U, std::memory_order_release);
+}
+
+} // namespace usb_audio
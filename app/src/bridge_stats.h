@@ -0,0 +1,135 @@
+/**
+ * @file bridge_stats.h
+ * @brief Counters for the USB audio bridge: traffic, ring faults, feedback.
+ *
+ * The bridge callbacks record here instead of logging: every hot-path entry
+ * is one or two relaxed atomic read-modify-writes, no formatting, no locks.
+ * Recorded per direction (OUT = host -> radio TX, IN = radio RX -> host):
+ *
+ *  - bytes moved, ring overflows (and bytes dropped), underruns
+ *  - prebuffer resets of the OUT ring
+ *  - usbd_uac2_send() failures, counted per errno in a small table
+ *  - ring fill histograms, one sample per SOF
+ *  - the OUT feedback value: min/max and a decimated trace
+ *
+ * Any thread may record; snapshot() and reset() run from the shell or the
+ * telemetry reader. A reset racing an update may lose or keep that one
+ * update, nothing worse. Counters wrap at 2^32; rates come from deltas.
+ * Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_USB_AUDIO_BRIDGE_STATS_H_
+#define OE5XRX_USB_AUDIO_BRIDGE_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace usb_audio {
+
+class BridgeStats {
+public:
+  enum Dir : uint8_t { kOut, kIn, kDirs };
+
+  /** Fill histogram bins: bin i counts fills in [i, i+1) * capacity / kFillBins. */
+  static constexpr size_t kFillBins = 8;
+  /** Distinct send errnos tracked; later ones count as "other". */
+  static constexpr size_t kErrnoSlots = 4;
+  /** Feedback trace length, oldest first in a snapshot. */
+  static constexpr size_t kTraceLen = 16;
+  /** One feedback value is traced every kTraceEvery SOFs (128 ms at Full-Speed). */
+  static constexpr uint32_t kTraceEvery = 128;
+
+  struct Errno {
+    int err;        /* negative errno, 0 = unused slot */
+    uint32_t count;
+  };
+
+  struct Snapshot {
+    uint32_t bytes[kDirs];     /* OUT received from the host / IN sent to it */
+    uint32_t overflows[kDirs]; /* ring full: writes that dropped data */
+    uint32_t dropped[kDirs];   /* bytes those writes dropped */
+    uint32_t underruns[kDirs]; /* OUT: short reads to the DAC; IN: SOFs with nothing to send */
+    uint32_t prebuffer_resets; /* OUT ring restarted prebuffering */
+    Errno send_errors[kErrnoSlots];
+    uint32_t send_errors_other;
+    uint32_t fill[kDirs][kFillBins];
+    uint32_t feedback_min;         /* Q10.14, 0 until the first value */
+    uint32_t feedback_max;
+    uint32_t trace[kTraceLen];     /* oldest first */
+    uint32_t trace_len;
+  };
+
+  BridgeStats() { reset(); }
+
+  /** OUT: @p size bytes arrived from the host, @p put of them fit the ring. */
+  void out_received(uint32_t size, uint32_t put) {
+    add(bytes_[kOut], size);
+    ring_put(kOut, size, put);
+  }
+
+  /** IN: @p size captured bytes offered to the ring, @p put of them fit. */
+  void in_captured(uint32_t size, uint32_t put) { ring_put(kIn, size, put); }
+
+  /** OUT: the DAC asked for @p wanted bytes and the ring gave @p got. */
+  void out_drained(uint32_t wanted, uint32_t got) {
+    if (got < wanted) {
+      inc(underruns_[kOut]);
+    }
+  }
+
+  /** IN: @p bytes handed to usbd_uac2_send() and accepted. */
+  void in_sent(uint32_t bytes) { add(bytes_[kIn], bytes); }
+
+  /** IN: nothing to send at this SOF while the terminal is enabled. */
+  void in_empty() { inc(underruns_[kIn]); }
+
+  /** IN: usbd_uac2_send() returned @p err (negative errno). */
+  void in_send_failed(int err);
+
+  void prebuffer_reset() { inc(prebuffer_resets_); }
+
+  /** Ring fill at this SOF, @p used out of @p capacity (same unit). */
+  void fill(Dir dir, size_t used, size_t capacity) {
+    size_t bin = capacity == 0U ? 0U : used * kFillBins / capacity;
+    inc(fill_[dir][bin < kFillBins ? bin : kFillBins - 1U]);
+  }
+
+  /** OUT feedback value reported at this SOF (Q10.14). Single writer. */
+  void feedback(uint32_t value);
+
+  void snapshot(Snapshot *out) const;
+  void reset();
+
+private:
+  static void inc(std::atomic<uint32_t> &c) { c.fetch_add(1U, std::memory_order_relaxed); }
+  static void add(std::atomic<uint32_t> &c, uint32_t n) { c.fetch_add(n, std::memory_order_relaxed); }
+
+  void ring_put(Dir dir, uint32_t size, uint32_t put) {
+    if (put < size) {
+      inc(overflows_[dir]);
+      add(dropped_[dir], size - put);
+    }
+  }
+
+  std::atomic<uint32_t> bytes_[kDirs];
+  std::atomic<uint32_t> overflows_[kDirs];
+  std::atomic<uint32_t> dropped_[kDirs];
+  std::atomic<uint32_t> underruns_[kDirs];
+  std::atomic<uint32_t> prebuffer_resets_;
+  std::atomic<int> errno_[kErrnoSlots];
+  std::atomic<uint32_t> errno_count_[kErrnoSlots];
+  std::atomic<uint32_t> errno_other_;
+  std::atomic<uint32_t> fill_[kDirs][kFillBins];
+  std::atomic<uint32_t> fb_min_;
+  std::atomic<uint32_t> fb_max_;
+  std::atomic<uint32_t> fb_count_; /* feedback() calls, drives the decimation */
+  std::atomic<uint32_t> trace_[kTraceLen];
+  std::atomic<uint32_t> trace_head_; /* values traced so far */
+};
+
+} // namespace usb_audio
+
+#endif /* OE5XRX_USB_AUDIO_BRIDGE_STATS_H_ */
@@ -0,0 +1,81 @@
+/**
+ * @file callback_swap.h
+ * @brief Two-slot RCU-style publish/pin of a small value (a callback set).
+ *
+ * Lets a writer replace the value the audio backends consult once per block
+ * without stopping them. Readers (a fixed set, one index each) pin the active
+ * slot for the duration of a block; the writer fills the idle slot, flips the
+ * active index and then waits until no reader still pins the old slot. When
+ * publish() returns, the old value is never used again.
+ *
+ * Reader cost per block: two atomic stores and two loads, no lock and no
+ * waiting, so a swap adds nothing to the audio timeline; all waiting is on the
+ * writer's side. The writer must be serialized by the caller and must not run
+ * inside a reader's pin (it would wait on itself). Pure logic: no Zephyr, no
+ * heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_CALLBACK_SWAP_H_
+#define OE5XRX_AUDIO_CALLBACK_SWAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+template <typename T, size_t kReaders> class CallbackSwap {
+public:
+  /**
+   * Pin and return the active value for reader @p reader (0 .. kReaders-1).
+   * The reference stays valid until release(); call once per block.
+   */
+  const T &acquire(size_t reader) {
+    uint32_t s;
+    /* Pin, then confirm the slot is still active. Everything is seq_cst: if
+     * the confirm saw the old index, the writer's flip comes later in the
+     * total order, so its quiescence scan sees this pin and waits. */
+    do {
+      s = active_.load();
+      pinned_[reader].store(s + 1);
+    } while (active_.load() != s);
+    return slots_[s];
+  }
+
+  /** Drop reader @p reader's pin (end of block). */
+  void release(size_t reader) { pinned_[reader].store(0); }
+
+  /**
+   * Make @p next the active value and return once no reader holds the old
+   * one. @p wait is called while a reader is still inside its block (e.g. a
+   * one-tick sleep); it is never called when all readers are idle or already
+   * on the new value.
+   */
+  template <typename Wait> void publish(const T &next, Wait wait) {
+    const uint32_t old = active_.load();
+    const uint32_t fresh = old ^ 1U;
+    /* No reader can be using the idle slot: the previous publish waited it
+     * out, and a reader that pins it now fails its confirm without reading. */
+    slots_[fresh] = next;
+    active_.store(fresh);
+    for (size_t r = 0; r < kReaders; r++) {
+      while (pinned_[r].load() == old + 1) {
+        wait();
+      }
+    }
+  }
+
+  /** Active value, for the (serialized) writer side only. */
+  const T &current() const { return slots_[active_.load()]; }
+
+private:
+  T slots_[2]{};
+  std::atomic<uint32_t> active_{0};
+  std::atomic<uint32_t> pinned_[kReaders]{}; /* 0 = idle, else slot + 1 */
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_CALLBACK_SWAP_H_ */
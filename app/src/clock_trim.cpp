@@ -0,0 +1,93 @@
+/**
+ * @file clock_trim.cpp
+ * @brief SofClockTrim implementation. See clock_trim.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "clock_trim.h"
+
+namespace usb_audio {
+
+void SofClockTrim::init(uint32_t tim_hz, uint32_t sample_hz, uint16_t samples_per_sof, uint32_t max_ppm) {
+  nominal_q16_ = static_cast<int64_t>((static_cast<uint64_t>(tim_hz) << 16) / sample_hz);
+  /* Lengthening the period by d ticks slows the clock by d/N, i.e. the phase
+   * falls behind by samples_per_sof * d/N samples per SOF. */
+  gain_q16_ = nominal_q16_ / samples_per_sof;
+  max_q16_ = nominal_q16_ * max_ppm / 1000000;
+  integ_limit_ = (max_q16_ << (kPosFracBits + kIShift)) / gain_q16_;
+  step_q8_ = static_cast<uint32_t>(samples_per_sof) << kPosFracBits;
+  slips_ = 0;
+  reset();
+}
+
+void SofClockTrim::reset() {
+  anchored_ = false;
+  integrator_ = 0;
+  trim_q16_ = 0;
+  acc_ = 0;
+  error_ = 0;
+  lock_count_ = 0;
+  period_ = nominal_period();
+}
+
+int32_t SofClockTrim::trim_ppb() const {
+  if (nominal_q16_ == 0) {
+    return 0;
+  }
+  /* A longer period is a slower clock. */
+  return static_cast<int32_t>(-trim_q16_ * 1000000000LL / nominal_q16_);
+}
+
+uint32_t SofClockTrim::update(uint32_t position) {
+  if (!anchored_) {
+    anchored_ = true;
+    expected_ = position;
+  } else {
+    expected_ += step_q8_;
+  }
+
+  /* Wrap-safe: the difference of two free-running positions. */
+  int32_t error = static_cast<int32_t>(position - expected_);
+  if (error > (kSlipSamples << kPosFracBits) || error < -(kSlipSamples << kPosFracBits)) {
+    /* Keep the integrator: it holds the drift estimate, which is still valid. */
+    expected_ = position;
+    error = 0;
+    lock_count_ = 0;
+    slips_++;
+  }
+  error_ = error;
+
+  integrator_ += error;
+  if (integrator_ > integ_limit_) {
+    integrator_ = integ_limit_;
+  } else if (integrator_ < -integ_limit_) {
+    integrator_ = -integ_limit_;
+  }
+
+  /* Ahead (error > 0) => lengthen the period. */
+  int64_t trim = ((error * gain_q16_) >> (kPosFracBits + kPShift)) + ((integrator_ * gain_q16_) >> (kPosFracBits + kIShift));
+  if (trim > max_q16_) {
+    trim = max_q16_;
+  } else if (trim < -max_q16_) {
+    trim = -max_q16_;
+  }
+  trim_q16_ = trim;
+
+  /* Dither: carry the fractional tick from SOF to SOF. */
+  const int64_t target = nominal_q16_ + trim;
+  acc_ += static_cast<uint32_t>(target & 0xFFFF);
+  period_ = static_cast<uint32_t>(target >> 16) + (acc_ >> 16);
+  acc_ &= 0xFFFFU;
+
+  if (error < (kLockSamples << kPosFracBits) && error > -(kLockSamples << kPosFracBits)) {
+    if (lock_count_ < kLockSofs) {
+      lock_count_++;
+    }
+  } else {
+    lock_count_ = 0;
+  }
+  return period_;
+}
+
+} // namespace usb_audio
@@ -0,0 +1,99 @@
+/**
+ * @file clock_trim.h
+ * @brief Locks a timer-driven sample clock to the USB SOF by fractional ARR trim.
+ *
+ * The ADC/DAC sample timers divide tim_clk by an integer, so their rate is off
+ * the host's by the crystal error (and by the division remainder when tim_clk
+ * is not a multiple of fs). Once per SOF this controller compares the samples
+ * actually clocked out with the samples the host clock says should have been
+ * (samples_per_sof per frame), and trims the timer period through a PI loop on
+ * that phase error. The trimmed period is fractional; a first-order rate
+ * accumulator dithers the programmed period between N and N+1 ticks per SOF
+ * so its average is exact. Once locked, the sample clock follows the host and
+ * no drift accumulates in the rings.
+ *
+ * Positions are Q24.8 samples (free-running, wrap-safe). Pure logic: no
+ * Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_USB_AUDIO_CLOCK_TRIM_H_
+#define OE5XRX_USB_AUDIO_CLOCK_TRIM_H_
+
+#include <cstdint>
+
+namespace usb_audio {
+
+class SofClockTrim {
+public:
+  /** Fractional bits of a sample position. */
+  static constexpr int kPosFracBits = 8;
+
+  /**
+   * Configure for a timer clocked at @p tim_hz producing @p sample_hz, with
+   * @p samples_per_sof samples per 1 ms frame, trimming at most @p max_ppm.
+   * Resets the loop.
+   */
+  void init(uint32_t tim_hz, uint32_t sample_hz, uint16_t samples_per_sof, uint32_t max_ppm);
+
+  /** Forget the phase reference and integrator; the next update() re-anchors. */
+  void reset();
+
+  /**
+   * Run one control step. Call once per SOF while the sample clock runs.
+   * @param position samples clocked out so far, Q24.8 (wraps)
+   * @return timer period in ticks (ARR + 1) to program until the next SOF
+   */
+  uint32_t update(uint32_t position);
+
+  /** Untrimmed period for the configured rate, in whole ticks (ARR + 1). */
+  uint32_t nominal_period() const { return static_cast<uint32_t>((nominal_q16_ + (1U << 15)) >> 16); }
+
+  /** Last period returned by update(). */
+  uint32_t period() const { return period_; }
+
+  /** Current sample-rate correction in ppb (+ = clock sped up). */
+  int32_t trim_ppb() const;
+
+  /** Last phase error, Q24.8 samples (+ = sample clock ahead of the host). */
+  int32_t phase_error() const { return error_; }
+
+  /** Phase error stayed within kLockSamples for kLockSofs consecutive frames. */
+  bool locked() const { return lock_count_ >= kLockSofs; }
+
+  /** Times the phase reference was dropped (error beyond kSlipSamples). */
+  uint32_t slips() const { return slips_; }
+
+private:
+  /* Loop gains as shifts, normalised so 2^-kPShift of the phase error is
+   * removed per SOF by the P term: P 1/2048, I 2^-23 (zeta ~0.7, ~3 s). */
+  static constexpr int kPShift = 11;
+  static constexpr int kIShift = 23;
+  /* An error this large is not drift (stalled stream, missed SOFs): re-anchor. */
+  static constexpr int32_t kSlipSamples = 64;
+  /* Lock window: the SOF handler's scheduling jitter alone moves the measured
+   * phase by a sample or two, so "locked" allows half a frame. */
+  static constexpr int32_t kLockSamples = 4;
+  static constexpr uint32_t kLockSofs = 4096; /* > the loop time constant */
+
+  int64_t nominal_q16_ = 0; /* ticks per sample, Q16 */
+  int64_t gain_q16_ = 0;    /* period change (Q16 ticks) for one sample per SOF of rate */
+  int64_t max_q16_ = 0;     /* |trim| bound, Q16 ticks */
+  int64_t integ_limit_ = 0; /* |integrator_| bound so I alone tops out at max_q16_ */
+  uint32_t step_q8_ = 0;    /* samples per SOF, Q24.8 */
+
+  bool anchored_ = false;
+  uint32_t expected_ = 0; /* host-clock position, Q24.8 */
+  int64_t integrator_ = 0;
+  int64_t trim_q16_ = 0;
+  uint32_t acc_ = 0; /* dither accumulator, Q16 fraction */
+  uint32_t period_ = 0;
+  int32_t error_ = 0;
+  uint32_t lock_count_ = 0;
+  uint32_t slips_ = 0;
+};
+
+} // namespace usb_audio
+
+#endif /* OE5XRX_USB_AUDIO_CLOCK_TRIM_H_ */
@@ -0,0 +1,95 @@
+/**
+ * @file emphasis.cpp
+ * @brief Fixed-point pre-/de-emphasis filter implementation. See emphasis.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "emphasis.h"
+
+namespace audio {
+
+namespace {
+
+/* Bilinear transform of (1 + s*t1) / (1 + s*t2), K = 2*fs = 16000, t1 = 750 us,
+ * t2 = 1/(2*pi*3 kHz), numerator scaled by 1/|H(1 kHz)|:
+ *   b0 = 1.4701, b1 = -1.2439, a1 = 0.0818
+ * Response: -12.7 dB @ 100 Hz, -8.8 dB @ 300 Hz, 0 dB @ 1 kHz, +8.5 dB @ 3 kHz.
+ * De-emphasis is 1/H: b0' = 1/b0, b1' = a1/b0, a1' = b1/b0 (pole at 0.846). */
+constexpr int32_t kPreB0 = 24085;
+constexpr int32_t kPreB1 = -20380;
+constexpr int32_t kPreA1 = 1340;
+constexpr int32_t kDeB0 = 11145;
+constexpr int32_t kDeB1 = 911;
+constexpr int32_t kDeA1 = -13863;
+
+/* Worst case |acc| = (24085 + 20380 + 1340) * 32768 + 2^14 < 2^31. */
+static_assert((kPreB0 - kPreB1 + kPreA1) * 32768LL + (1 << 14) < INT32_MAX, "pre-emphasis accumulator overflows int32");
+static_assert((kDeB0 + kDeB1 - kDeA1) * 32768LL + (1 << 14) < INT32_MAX, "de-emphasis accumulator overflows int32");
+
+inline int16_t sat16(int32_t v) {
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(v);
+}
+
+} // namespace
+
+Emphasis::Emphasis(Mode mode, bool enabled)
+    : b0_(mode == Mode::kPre ? kPreB0 : kDeB0), b1_(mode == Mode::kPre ? kPreB1 : kDeB1), a1_(mode == Mode::kPre ? kPreA1 : kDeA1), enabled_(enabled) {}
+
+void Emphasis::reset() {
+  x1_ = 0;
+  y1_ = 0;
+  frac_ = 0;
+}
+
+int16_t Emphasis::step(int16_t x) {
+  int32_t acc = b0_ * x + b1_ * x1_ - a1_ * y1_ + frac_;
+  /* Arithmetic shift floors; carrying the residue into the next sample keeps
+   * the DC gain exact and removes the recursive filter's limit-cycle band. */
+  const int32_t y = acc >> kFracBits;
+  frac_ = acc & ((1 << kFracBits) - 1);
+  x1_ = x;
+  y1_ = sat16(y);
+  return static_cast<int16_t>(y1_);
+}
+
+void Emphasis::process(int16_t *samples, size_t count, bool enabled) {
+  if (count == 0) {
+    return;
+  }
+
+  if (enabled == enabled_) {
+    if (enabled) {
+      for (size_t i = 0; i < count; i++) {
+        samples[i] = step(samples[i]);
+      }
+    } else {
+      /* Bypassed: keep the history tracking the signal for a clean switch-on. */
+      for (size_t i = 0; i < count; i++) {
+        (void)step(samples[i]);
+      }
+    }
+    return;
+  }
+
+  /* Switch block: ramp the wet share 0 -> 1 (enable) or 1 -> 0 (disable). */
+  const int64_t n = static_cast<int64_t>(count);
+  for (size_t i = 0; i < count; i++) {
+    const int32_t dry = samples[i];
+    const int32_t wet = step(samples[i]);
+    int32_t w = static_cast<int32_t>((static_cast<int64_t>(i + 1) << kFadeBits) / n);
+    if (!enabled) {
+      w = (1 << kFadeBits) - w;
+    }
+    samples[i] = sat16(dry + (((wet - dry) * w) >> kFadeBits));
+  }
+  enabled_ = enabled;
+}
+
+} // namespace audio
@@ -0,0 +1,69 @@
+/**
+ * @file emphasis.h
+ * @brief Fixed-point 6 dB/oct FM pre-emphasis (TX) / de-emphasis (RX) filter.
+ *
+ * First-order shelf H(s) = (1 + s*750us) / (1 + s*53us) — the 750 us NBFM
+ * curve, flattened above ~3 kHz — mapped to 8 kHz by the bilinear transform
+ * and normalised to 0 dB at 1 kHz. De-emphasis is the exact inverse, so a
+ * pre -> de round trip is flat. Running these on the MCU lets the SA818's own
+ * emphasis/HPF/LPF stay bypassed and makes voice <-> data (flat) switching a
+ * per-block decision with no AT round trip.
+ *
+ * The filter always runs so its state stays warm; enabling or disabling
+ * crossfades linearly between the dry and filtered signal across one block,
+ * so the switch is click-free. Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_EMPHASIS_H_
+#define OE5XRX_AUDIO_EMPHASIS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+class Emphasis {
+public:
+  enum class Mode : uint8_t {
+    kPre, /* TX: +6 dB/oct */
+    kDe,  /* RX: -6 dB/oct */
+  };
+
+  /** @p enabled is the initial state (no crossfade on the first block). */
+  explicit Emphasis(Mode mode, bool enabled = false);
+
+  /** Clear the filter history; the enabled state is kept. */
+  void reset();
+
+  /**
+   * Filter one block in place. @p enabled is the wanted state for this block;
+   * a change versus the previous block is crossfaded across this block.
+   */
+  void process(int16_t *samples, size_t count, bool enabled);
+
+  /** State reached at the end of the last processed block. */
+  bool enabled() const { return enabled_; }
+
+private:
+  /* Coefficients are Q2.14: y = (b0*x + b1*x1 - a1*y1) >> 14. */
+  static constexpr int kFracBits = 14;
+  /* Crossfade weight resolution (Q14: |wet - dry| * 2^14 fits int32). */
+  static constexpr int kFadeBits = 14;
+
+  int32_t b0_;
+  int32_t b1_;
+  int32_t a1_;
+
+  int32_t x1_ = 0;   /* previous input */
+  int32_t y1_ = 0;   /* previous (saturated) output */
+  int32_t frac_ = 0; /* truncation residue fed back next sample (no dead band) */
+  bool enabled_ = false;
+
+  int16_t step(int16_t x);
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_EMPHASIS_H_ */
@@ -21,6 +21,17 @@ void BufferFeedback::reset() {
   fb_value_ = nominal_;
 }
 
+void BufferFeedback::handover(uint32_t value) {
+  int32_t correction = static_cast<int32_t>(value) - static_cast<int32_t>(nominal_);
+  if (correction > clamp_) {
+    correction = clamp_;
+  } else if (correction < -clamp_) {
+    correction = -clamp_;
+  }
+  integrator_ = correction * kTi;
+  fb_value_ = static_cast<uint32_t>((static_cast<int32_t>(nominal_) + correction) & ~((1 << kLsbZeroBits) - 1));
+}
+
 void BufferFeedback::update(size_t used, size_t capacity) {
   const int32_t set_point = static_cast<int32_t>(capacity / 2);
   /* Positive error => ring emptier than target => host too slow => ask for
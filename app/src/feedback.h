@@ -26,6 +26,12 @@ public:
   /** Reset the integrator and set the reported value back to nominal. */
   void reset();
 
+  /**
+   * Take over from another regulator reporting @p value (Q10.14): preload the
+   * integrator so the loop continues from there instead of from nominal.
+   */
+  void handover(uint32_t value);
+
   /**
    * Run one control step. Call once per SOF while the OUT stream is active.
    * @param used     current ring fill, in samples
@@ -0,0 +1,85 @@
+/**
+ * @file feedback_controller.h
+ * @brief Run-time choice between the UAC2 OUT feedback regulators.
+ *
+ * Holds both BufferFeedback (PI on the ring fill) and RateFeedback (rate
+ * estimator) behind their common interface and forwards to the selected one.
+ * A mode change hands the reported value over to the newly selected
+ * regulator, so the host sees no step; the one left keeps its state until it
+ * is selected again. SOF stamps go to the rate estimator whatever the mode,
+ * so it has a measured rate at hand when selected. Not thread-safe:
+ * the bridge calls everything from the usbd thread.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_USB_AUDIO_FEEDBACK_CONTROLLER_H_
+#define OE5XRX_USB_AUDIO_FEEDBACK_CONTROLLER_H_
+
+#include "feedback.h"
+#include "rate_feedback.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace usb_audio {
+
+enum class FeedbackMode : uint8_t {
+  Pi,   /**< BufferFeedback */
+  Rate, /**< RateFeedback */
+};
+
+class FeedbackController {
+public:
+  void init(uint16_t samples_per_sof, FeedbackMode mode) {
+    pi_.init(samples_per_sof);
+    rate_.init(samples_per_sof);
+    mode_ = mode;
+  }
+
+  void reset() {
+    pi_.reset();
+    rate_.reset();
+  }
+
+  void set_mode(FeedbackMode mode) {
+    if (mode == mode_) {
+      return;
+    }
+    const uint32_t current = value();
+    mode_ = mode;
+    if (mode_ == FeedbackMode::Rate) {
+      rate_.handover(current);
+    } else {
+      pi_.handover(current);
+    }
+  }
+
+  FeedbackMode mode() const { return mode_; }
+
+  void stamp(uint32_t position_q8) { rate_.stamp(position_q8); }
+
+  void update(size_t used, size_t capacity) {
+    if (mode_ == FeedbackMode::Rate) {
+      rate_.update(used, capacity);
+    } else {
+      pi_.update(used, capacity);
+    }
+  }
+
+  uint32_t value() const { return mode_ == FeedbackMode::Rate ? rate_.value() : pi_.value(); }
+
+  uint32_t nominal() const { return pi_.nominal(); }
+
+  /** Rate estimate, Q10.14 (tracks SOF stamps in either mode). */
+  uint32_t rate() const { return rate_.rate(); }
+
+private:
+  BufferFeedback pi_;
+  RateFeedback rate_;
+  FeedbackMode mode_ = FeedbackMode::Pi;
+};
+
+} // namespace usb_audio
+
+#endif /* OE5XRX_USB_AUDIO_FEEDBACK_CONTROLLER_H_ */
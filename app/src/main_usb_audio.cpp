@@ -26,6 +26,23 @@ extern "C" {
 #include "sample_usbd.h"
 }
 
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+#include "audio_watchdog.h"
+#endif
+
+#ifdef CONFIG_MSC_DISK
+#include <oe5xrx/msc/msc_disk.h>
+#endif
+
+#ifdef CONFIG_EVENT_BUS
+#include <oe5xrx/events/bus.h>
+
+/* Radio state changes for the status log; drained by the main loop. */
+static events::Subscriber radio_events("main",
+                                       events::mask(events::Type::Squelch) | events::mask(events::Type::Ptt) | events::mask(events::Type::RadioPower) |
+                                           events::mask(events::Type::AtLink));
+#endif
+
 /* Boot-confirm gate: records USB-configured events and starts the gate thread. */
 extern "C" void boot_confirm_fm_usb_configured(void);
 extern "C" void boot_confirm_fm_start(const struct device *sa818);
@@ -33,7 +50,17 @@ extern "C" void boot_confirm_fm_start(const struct device *sa818);
 static void usbd_msg_cb(struct usbd_context *const ctx, const struct usbd_msg *const msg) {
   if (msg->type == USBD_MSG_CONFIGURATION) {
     boot_confirm_fm_usb_configured();
+#ifdef CONFIG_MSC_DISK
+    /* Fresh file sizes and STATUS.TXT for the host that just mounted us. */
+    msc_disk_refresh();
+#endif
+  }
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  /* No SOFs while the bus is suspended: not a stall. */
+  if (msg->type == USBD_MSG_SUSPEND || msg->type == USBD_MSG_RESUME || msg->type == USBD_MSG_RESET) {
+    audio_watchdog_bus_suspended(msg->type == USBD_MSG_SUSPEND);
   }
+#endif
 #ifdef CONFIG_BOOTLOADER_MCUBOOT
   if (msg->type == USBD_MSG_DFU_APP_DETACH) {
     dfu_mode_switch_to_dfu(ctx);
@@ -46,6 +73,32 @@ static void usbd_msg_cb(struct usbd_context *const ctx, const struct usbd_msg *c
 
 LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
 
+#if defined(CONFIG_AUDIO_LINK) && DT_HAS_CHOSEN(oe5xrx_audio_link)
+#include <oe5xrx/audio/audio_link.h>
+
+/* The far station keys this transmitter through the link's PTT flag. */
+static void audio_link_on_ptt(bool on, void *user_data) {
+  const struct device *sa818 = static_cast<const struct device *>(user_data);
+  if (sa818_set_ptt(sa818, on ? SA818_PTT_ON : SA818_PTT_OFF) != SA818_OK) {
+    LOG_WRN("Link PTT %s failed", on ? "on" : "off");
+  }
+}
+#endif
+
+#ifdef CONFIG_VOICE_PROMPT
+#include <oe5xrx/audio/voice_prompt.h>
+
+/* Announcements key this transmitter for their duration. */
+static bool voice_prompt_on_ptt(bool on, void *user_data) {
+  const struct device *sa818 = static_cast<const struct device *>(user_data);
+  const bool was_on = sa818_get_status(sa818).ptt_state == SA818_PTT_ON;
+  if (sa818_set_ptt(sa818, on ? SA818_PTT_ON : SA818_PTT_OFF) != SA818_OK) {
+    LOG_WRN("Voice prompt PTT %s failed", on ? "on" : "off");
+  }
+  return was_on;
+}
+#endif
+
 /* Device tree node identifiers */
 #define SA818_NODE DT_ALIAS(sa818)
 #define UAC2_NODE DT_NODELABEL(uac2_radio)
@@ -122,6 +175,14 @@ int main(void) {
   LOG_INF("USB Audio Bridge enabled");
 #endif
 
+#ifdef CONFIG_EVENT_BUS
+  /* Before power-up, so the power and AT link events are already seen. */
+  ret = events::subscribe(radio_events);
+  if (ret != 0) {
+    LOG_WRN("Event bus subscribe failed: %d", ret);
+  }
+#endif
+
   /* Power on SA818 */
   ret = sa818_set_power(sa818, SA818_DEVICE_ON);
   if (ret != SA818_OK) {
@@ -131,6 +192,18 @@ int main(void) {
   }
   LOG_INF("SA818 powered on");
 
+#if defined(CONFIG_AUDIO_LINK) && DT_HAS_CHOSEN(oe5xrx_audio_link)
+  /* Link up; the audio is routed to it with `audio link on`. */
+  ret = audio_link_start(DEVICE_DT_GET(DT_CHOSEN(oe5xrx_audio_link)), audio_link_on_ptt, const_cast<struct device *>(sa818));
+  if (ret != 0) {
+    LOG_WRN("Serial audio link start failed: %d", ret);
+  }
+#endif
+
+#ifdef CONFIG_VOICE_PROMPT
+  voice_prompt_init(voice_prompt_on_ptt, const_cast<struct device *>(sa818));
+#endif
+
   /* Start the health-gate confirm thread. It probes USB configured, shell
    * transport (compile-time), and the SA818 AT handshake; then calls
    * boot_write_img_confirmed() once all criteria hold for the dwell period.
@@ -143,6 +216,15 @@ int main(void) {
   LOG_INF("USB UAC2: Audio streaming @ 8kHz");
   LOG_INF("USB DFU: Firmware update (detach to enter DFU mode)");
 
+#ifdef CONFIG_EVENT_BUS
+  /* Log radio state changes as they happen instead of polling the driver. */
+  while (true) {
+    events::Event evt;
+    if (radio_events.wait(evt, K_FOREVER)) {
+      LOG_INF("SA818 %s: %d", events::typeName(evt.type), evt.value);
+    }
+  }
+#else
   while (true) {
     k_sleep(K_SECONDS(10));
 
@@ -151,6 +233,7 @@ int main(void) {
     LOG_INF("SA818 Status - Power: %s, PTT: %s, SQL: %s", status.device_power == SA818_DEVICE_ON ? "ON" : "OFF",
             status.ptt_state == SA818_PTT_ON ? "ON" : "OFF", status.squelch_state == SA818_SQUELCH_OPEN ? "OPEN" : "CLOSED");
   }
+#endif
 
   return 0;
 }
@@ -0,0 +1,279 @@
+/**
+ * @file pcm_convert.cpp
+ * @brief PCM format conversion kernels. See pcm_convert.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "pcm_convert.h"
+
+#include <cstring>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "wire PCM is little-endian and loaded word-wise");
+
+namespace audio::pcm {
+
+namespace {
+
+/* to_wire()/from_wire() stage stereo and narrowed samples through the stack in
+ * chunks of this many frames (two full analog-audio blocks). */
+constexpr size_t kChunkFrames = 32;
+
+uint32_t load32(const void *p) {
+  uint32_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+void store32(void *p, uint32_t w) { memcpy(p, &w, sizeof(w)); }
+
+int16_t sat16(int32_t v) {
+#if defined(__ARM_FEATURE_DSP)
+  return static_cast<int16_t>(__ssat(v, 16));
+#else
+  return static_cast<int16_t>(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+#endif
+}
+
+/* Sum of both halfwords of a packed L/R pair. */
+int32_t pair_sum(uint32_t w) {
+#if defined(__ARM_FEATURE_DSP)
+  return __smuad(static_cast<int32_t>(w), 0x00010001);
+#else
+  return static_cast<int16_t>(w & 0xFFFFU) + static_cast<int16_t>(w >> 16);
+#endif
+}
+
+/* Narrowing works on Q24 (s24 range): one output LSB is 256 units. Rounding
+ * adds half of that before the shift; floor(floor(x / 256) + 128) / 256 equals
+ * floor((x + 32768) / 65536), so going through Q24 loses nothing for s32. */
+constexpr int32_t kQ24Half = 128;
+
+/* TPDF offset in Q24 units: two uniform bytes, -256..254 (+-1 output LSB). */
+int32_t dither_q24(Dither *dither) {
+  dither->state = dither->state * 1664525U + 1013904223U;
+  return static_cast<int8_t>(dither->state >> 24) + static_cast<int8_t>(dither->state >> 16);
+}
+
+int32_t load_s24(const uint8_t *p) {
+  /* Assemble into the top three bytes, then arithmetic shift to sign-extend. */
+  const uint32_t u = (static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 24);
+  return static_cast<int32_t>(u) >> 8;
+}
+
+int32_t f32_to_q24(float f) {
+  float v = f * 8388608.0F; /* 2^23 */
+  /* Clamp in float: converting an out-of-range float to int is undefined. */
+  if (!(v < 8388607.0F)) {
+    v = 8388607.0F;
+  } else if (v < -8388608.0F) {
+    v = -8388608.0F;
+  }
+  return static_cast<int32_t>(v);
+}
+
+template <typename LoadQ24> void narrow_q24(const uint8_t *src, int16_t *dst, size_t n, size_t stride, Dither *dither, LoadQ24 load) {
+  if (dither && dither->enabled) {
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = sat16((load(src + i * stride) + kQ24Half + dither_q24(dither)) >> 8);
+    }
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = sat16((load(src + i * stride) + kQ24Half) >> 8);
+    }
+  }
+}
+
+} // namespace
+
+bool format_from(uint8_t bit_depth, bool is_float, uint8_t channels, Format *out) {
+  if (channels != 1U && channels != 2U) {
+    return false;
+  }
+  if (is_float) {
+    if (bit_depth != 32U) {
+      return false;
+    }
+    out->encoding = Encoding::kF32;
+  } else if (bit_depth == 16U) {
+    out->encoding = Encoding::kS16;
+  } else if (bit_depth == 24U) {
+    out->encoding = Encoding::kS24;
+  } else if (bit_depth == 32U) {
+    out->encoding = Encoding::kS32;
+  } else {
+    return false;
+  }
+  out->channels = channels;
+  return true;
+}
+
+void widen(const int16_t *src, uint8_t *dst, size_t n, Encoding encoding) {
+  switch (encoding) {
+  case Encoding::kS16:
+    memcpy(dst, src, n * sizeof(int16_t));
+    break;
+  case Encoding::kS24:
+    for (size_t i = 0; i < n; i++) {
+      const uint16_t u = static_cast<uint16_t>(src[i]);
+      dst[3 * i] = 0;
+      dst[3 * i + 1] = static_cast<uint8_t>(u);
+      dst[3 * i + 2] = static_cast<uint8_t>(u >> 8);
+    }
+    break;
+  case Encoding::kS32: {
+    /* Two samples per word: the low one shifted up, the high one masked. */
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+      const uint32_t w = load32(&src[i]);
+      store32(dst + 4 * i, w << 16);
+      store32(dst + 4 * i + 4, w & 0xFFFF0000U);
+    }
+    if (i < n) {
+      store32(dst + 4 * i, static_cast<uint32_t>(static_cast<uint16_t>(src[i])) << 16);
+    }
+    break;
+  }
+  case Encoding::kF32:
+    for (size_t i = 0; i < n; i++) {
+      const float f = static_cast<float>(src[i]) * (1.0F / 32768.0F);
+      memcpy(dst + 4 * i, &f, sizeof(f));
+    }
+    break;
+  }
+}
+
+void narrow(const uint8_t *src, int16_t *dst, size_t n, Encoding encoding, Dither *dither) {
+  switch (encoding) {
+  case Encoding::kS16:
+    /* Nothing below the output LSB: no rounding, no dither. */
+    memcpy(dst, src, n * sizeof(int16_t));
+    break;
+  case Encoding::kS24:
+    narrow_q24(src, dst, n, 3, dither, load_s24);
+    break;
+  case Encoding::kS32:
+    narrow_q24(src, dst, n, 4, dither, [](const uint8_t *p) { return static_cast<int32_t>(load32(p)) >> 8; });
+    break;
+  case Encoding::kF32:
+    narrow_q24(src, dst, n, 4, dither, [](const uint8_t *p) {
+      float f;
+      memcpy(&f, p, sizeof(f));
+      return f32_to_q24(f);
+    });
+    break;
+  }
+}
+
+void interleave(const int16_t *left, const int16_t *right, int16_t *dst, size_t frames) {
+  size_t i = 0;
+  for (; i + 2 <= frames; i += 2) {
+    const uint32_t l = load32(&left[i]);
+    const uint32_t r = load32(&right[i]);
+    store32(&dst[2 * i], (l & 0xFFFFU) | (r << 16));
+    store32(&dst[2 * i + 2], (l >> 16) | (r & 0xFFFF0000U));
+  }
+  if (i < frames) {
+    dst[2 * i] = left[i];
+    dst[2 * i + 1] = right[i];
+  }
+}
+
+void deinterleave(const int16_t *src, int16_t *left, int16_t *right, size_t frames) {
+  size_t i = 0;
+  for (; i + 2 <= frames; i += 2) {
+    const uint32_t f0 = load32(&src[2 * i]);
+    const uint32_t f1 = load32(&src[2 * i + 2]);
+    store32(&left[i], (f0 & 0xFFFFU) | (f1 << 16));
+    store32(&right[i], (f0 >> 16) | (f1 & 0xFFFF0000U));
+  }
+  if (i < frames) {
+    left[i] = src[2 * i];
+    right[i] = src[2 * i + 1];
+  }
+}
+
+void downmix(const int16_t *src, int16_t *dst, size_t frames) {
+  /* Frame i is read (bytes 4i..4i+3) before dst[i] (bytes 2i, 2i+1) is
+   * written, so in place is safe. The mean of two s16 never saturates. */
+  for (size_t i = 0; i < frames; i++) {
+    dst[i] = static_cast<int16_t>((pair_sum(load32(&src[2 * i])) + 1) >> 1);
+  }
+}
+
+void duplicate(const int16_t *src, int16_t *dst, size_t frames) {
+  for (size_t i = 0; i < frames; i++) {
+    store32(&dst[2 * i], static_cast<uint32_t>(static_cast<uint16_t>(src[i])) * 0x00010001U);
+  }
+}
+
+void apply_gain(int16_t *samples, size_t n, int32_t gain_q12) {
+  if (gain_q12 == kGainUnity) {
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    samples[i] = sat16((samples[i] * gain_q12 + (kGainUnity >> 1)) >> 12);
+  }
+}
+
+void to_wire(const int16_t *src, uint8_t *dst, size_t frames, const Format &format) {
+  if (format.channels == 1U) {
+    widen(src, dst, frames, format.encoding);
+    return;
+  }
+  if (format.encoding == Encoding::kS16) {
+    duplicate(src, reinterpret_cast<int16_t *>(dst), frames);
+    return;
+  }
+  int16_t stereo[2 * kChunkFrames];
+  const size_t stride = frame_bytes(format);
+  while (frames > 0) {
+    const size_t n = frames < kChunkFrames ? frames : kChunkFrames;
+    duplicate(src, stereo, n);
+    widen(stereo, dst, 2 * n, format.encoding);
+    src += n;
+    dst += n * stride;
+    frames -= n;
+  }
+}
+
+void to_wire_pair(const int16_t *left, const int16_t *right, uint8_t *dst, size_t frames, Encoding encoding) {
+  int16_t stereo[2 * kChunkFrames];
+  const size_t stride = 2 * sample_bytes(encoding);
+  while (frames > 0) {
+    const size_t n = frames < kChunkFrames ? frames : kChunkFrames;
+    interleave(left, right, stereo, n);
+    widen(stereo, dst, 2 * n, encoding);
+    left += n;
+    right += n;
+    dst += n * stride;
+    frames -= n;
+  }
+}
+
+void from_wire(const uint8_t *src, int16_t *dst, size_t frames, const Format &format, Dither *dither) {
+  if (format.channels == 1U) {
+    narrow(src, dst, frames, format.encoding, dither);
+    return;
+  }
+  if (format.encoding == Encoding::kS16) {
+    downmix(reinterpret_cast<const int16_t *>(src), dst, frames);
+    return;
+  }
+  int16_t stereo[2 * kChunkFrames];
+  const size_t stride = frame_bytes(format);
+  while (frames > 0) {
+    const size_t n = frames < kChunkFrames ? frames : kChunkFrames;
+    narrow(src, stereo, 2 * n, format.encoding, dither);
+    downmix(stereo, dst, n);
+    src += n * stride;
+    dst += n;
+    frames -= n;
+  }
+}
+
+} // namespace audio::pcm
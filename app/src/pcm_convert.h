@@ -0,0 +1,124 @@
+/**
+ * @file pcm_convert.h
+ * @brief PCM sample format conversion between the wire and the 16-bit mono core.
+ *
+ * The capture/playback backends and every filter in between run on signed
+ * 16-bit mono. USB hosts may insist on 24/32-bit integer, 32-bit float or
+ * stereo frames instead; these kernels convert at the edge:
+ *
+ *  - widen:   s16 -> s16 / packed s24 / s32 / f32 (exact, MSB-aligned)
+ *  - narrow:  s16 / s24 / s32 / f32 -> s16, rounded to nearest, saturated,
+ *             with optional TPDF dither of +-1 output LSB
+ *  - interleave / deinterleave of two s16 channels
+ *  - stereo -> mono downmix (rounded mean) and mono -> stereo duplication
+ *  - fixed-point gain (Q12, rounded, saturated), in place
+ *
+ * to_wire() / from_wire() chain them for one audio_stream block; to_wire_pair()
+ * builds stereo wire frames from two mono planes (processed + raw RX). The kernels
+ * move two s16 samples per 32-bit word (loads via memcpy, no alignment
+ * requirement), which the compiler maps onto PKHBT/SXTAH on Cortex-M33 and
+ * vectorises on the host; the downmix and the saturation use the ACLE DSP
+ * intrinsics where __ARM_FEATURE_DSP is set. Wire data is little-endian like
+ * the MCU and the USB host.
+ *
+ * Pure logic: no Zephyr, no heap, no exceptions. Only the f32 kernels use
+ * float (single precision, the M33 FPU).
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_PCM_CONVERT_H_
+#define OE5XRX_AUDIO_PCM_CONVERT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace audio::pcm {
+
+/** Sample container on the wire. */
+enum class Encoding : uint8_t {
+  kS16, /**< 2 bytes, signed */
+  kS24, /**< 3 bytes packed, signed */
+  kS32, /**< 4 bytes, signed (also 24-bit resolution in a 4-byte subslot) */
+  kF32, /**< 4 bytes, IEEE 754 single, full scale +-1.0 */
+};
+
+/** Wire frame layout. */
+struct Format {
+  Encoding encoding = Encoding::kS16;
+  uint8_t channels = 1; /**< 1 or 2 (interleaved L/R) */
+};
+
+/** Bytes per sample of @p encoding. */
+constexpr size_t sample_bytes(Encoding encoding) {
+  return encoding == Encoding::kS16 ? 2U : encoding == Encoding::kS24 ? 3U : 4U;
+}
+
+/** Bytes per frame (all channels) of @p format. */
+constexpr size_t frame_bytes(const Format &format) { return sample_bytes(format.encoding) * format.channels; }
+
+/** The core format: nothing to convert. */
+constexpr bool is_native(const Format &format) { return format.encoding == Encoding::kS16 && format.channels == 1; }
+
+/**
+ * Map an audio_stream (bit depth, float flag, channels) triple to a Format.
+ * @return false if there is no kernel for it.
+ */
+bool format_from(uint8_t bit_depth, bool is_float, uint8_t channels, Format *out);
+
+/**
+ * TPDF dither source for narrowing: the sum of two uniform values of +-1/2
+ * output LSB, from a 32-bit LCG (one step per sample). Disabled, narrowing
+ * rounds to nearest without noise.
+ */
+struct Dither {
+  uint32_t state = 0x12345678U;
+  bool enabled = false;
+};
+
+/** Widen @p n s16 samples into @p encoding at @p dst (MSB-aligned, exact). */
+void widen(const int16_t *src, uint8_t *dst, size_t n, Encoding encoding);
+
+/**
+ * Narrow @p n samples of @p encoding at @p src to s16: round to nearest,
+ * saturate, dither when @p dither is non-null and enabled. NaN floats map to
+ * positive full scale. @p src and @p dst must not overlap.
+ */
+void narrow(const uint8_t *src, int16_t *dst, size_t n, Encoding encoding, Dither *dither);
+
+/** L/R planes -> interleaved frames (@p dst holds 2 * @p frames). */
+void interleave(const int16_t *left, const int16_t *right, int16_t *dst, size_t frames);
+
+/** Interleaved frames -> L/R planes. */
+void deinterleave(const int16_t *src, int16_t *left, int16_t *right, size_t frames);
+
+/** Interleaved stereo -> mono, (L + R + 1) >> 1. May run in place (@p dst == @p src). */
+void downmix(const int16_t *src, int16_t *dst, size_t frames);
+
+/** Mono -> interleaved stereo, L = R = sample. */
+void duplicate(const int16_t *src, int16_t *dst, size_t frames);
+
+/** Q12 unity gain: apply_gain() with it leaves the block untouched. */
+constexpr int32_t kGainUnity = 1 << 12;
+
+/**
+ * Scale @p n samples in place by @p gain_q12 (Q12, 0 .. 16 * kGainUnity):
+ * rounded to nearest, saturated. kGainUnity returns without touching them.
+ */
+void apply_gain(int16_t *samples, size_t n, int32_t gain_q12);
+
+/** Core block -> wire: @p frames mono s16 samples to @p dst (frames * frame_bytes()). */
+void to_wire(const int16_t *src, uint8_t *dst, size_t frames, const Format &format);
+
+/**
+ * Two mono planes -> stereo wire frames: @p left is channel 1, @p right channel 2.
+ * Interleave and widen in one pass over @p dst (frames * 2 * sample_bytes()).
+ */
+void to_wire_pair(const int16_t *left, const int16_t *right, uint8_t *dst, size_t frames, Encoding encoding);
+
+/** Wire -> core block: @p frames wire frames to mono s16 (TX, dithered per @p dither). */
+void from_wire(const uint8_t *src, int16_t *dst, size_t frames, const Format &format, Dither *dither);
+
+} // namespace audio::pcm
+
+#endif /* OE5XRX_AUDIO_PCM_CONVERT_H_ */
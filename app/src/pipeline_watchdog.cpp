@@ -0,0 +1,97 @@
+/**
+ * @file pipeline_watchdog.cpp
+ * @brief PipelineWatchdog implementation. See pipeline_watchdog.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "pipeline_watchdog.h"
+
+namespace audio {
+
+void PipelineWatchdog::init(const Config &cfg) {
+  cfg_ = cfg;
+  for (size_t ch = 0; ch < kChannels; ch++) {
+    armed_[ch].store(false);
+    last_[ch].store(0);
+    beats_[ch].store(0);
+    beats_at_restart_[ch] = 0;
+  }
+  in_episode_ = false;
+  episode_mask_ = 0;
+  detected_at_ = 0;
+  episode_restarts_ = 0;
+  stats_ = {};
+}
+
+uint8_t PipelineWatchdog::armed_mask() const {
+  uint8_t mask = 0;
+  for (size_t ch = 0; ch < kChannels; ch++) {
+    if (armed_[ch].load(std::memory_order_acquire)) {
+      mask |= static_cast<uint8_t>(1U << ch);
+    }
+  }
+  return mask;
+}
+
+PipelineWatchdog::Action PipelineWatchdog::restart(uint32_t now) {
+  /* Recovery means a beat after this point; the restart grace is one timeout. */
+  for (size_t ch = 0; ch < kChannels; ch++) {
+    beats_at_restart_[ch] = beats_[ch].load(std::memory_order_relaxed);
+    last_[ch].store(now, std::memory_order_relaxed);
+  }
+  episode_restarts_++;
+  stats_.restarts++;
+  return Action::kRestart;
+}
+
+PipelineWatchdog::Action PipelineWatchdog::poll(uint32_t now) {
+  uint8_t stalled = 0;
+  for (size_t ch = 0; ch < kChannels; ch++) {
+    if (!armed_[ch].load(std::memory_order_acquire)) {
+      continue;
+    }
+    /* Signed age: a beat stamped after `now` was read is not a stall. */
+    const int32_t age = static_cast<int32_t>(now - last_[ch].load(std::memory_order_relaxed));
+    if (age > static_cast<int32_t>(cfg_.timeout_ms[ch])) {
+      stalled |= static_cast<uint8_t>(1U << ch);
+      stats_.stalls[ch]++;
+    }
+  }
+
+  if (stalled != 0) {
+    if (!in_episode_) {
+      in_episode_ = true;
+      detected_at_ = now;
+      episode_mask_ = 0;
+      episode_restarts_ = 0;
+    }
+    episode_mask_ |= stalled;
+    if (episode_restarts_ >= cfg_.max_restarts) {
+      return Action::kReboot;
+    }
+    return restart(now);
+  }
+
+  if (!in_episode_) {
+    return Action::kNone;
+  }
+  for (size_t ch = 0; ch < kChannels; ch++) {
+    if (armed_[ch].load(std::memory_order_acquire) && beats_[ch].load(std::memory_order_relaxed) == beats_at_restart_[ch]) {
+      return Action::kNone; /* restarted, not yet flowing again */
+    }
+  }
+
+  const uint32_t mttr = now - detected_at_;
+  stats_.mttr_last_ms = mttr;
+  if (mttr > stats_.mttr_max_ms) {
+    stats_.mttr_max_ms = mttr;
+  }
+  stats_.mttr_sum_ms += mttr;
+  stats_.recoveries++;
+  in_episode_ = false;
+  episode_mask_ = 0;
+  return Action::kNone;
+}
+
+} // namespace audio
@@ -0,0 +1,95 @@
+/**
+ * @file pipeline_watchdog.h
+ * @brief Heartbeat monitor for the audio pipeline with stream-level recovery.
+ *
+ * Each pipeline stage (capture delivery, playback refill, USB SOF handling)
+ * calls beat() once per block/frame. A monitor thread calls poll(); when an
+ * armed channel has not beaten within its timeout, poll() asks for a stream
+ * restart. The episode ends (and its time to recovery is recorded) once every
+ * armed channel has beaten again after the restart; if a channel stalls again
+ * first, poll() retries up to max_restarts and then asks for a reboot.
+ *
+ * beat() is two relaxed atomic stores and safe from any thread; arm() may be
+ * called from any thread; poll() and the stats belong to the monitor thread.
+ * Times are caller-supplied uint32 milliseconds (wrap-safe). Pure logic: no
+ * Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_PIPELINE_WATCHDOG_H_
+#define OE5XRX_AUDIO_PIPELINE_WATCHDOG_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+class PipelineWatchdog {
+public:
+  enum Channel : uint8_t { kCapture, kPlayback, kSof, kChannels };
+  enum class Action { kNone, kRestart, kReboot };
+
+  struct Config {
+    uint32_t timeout_ms[kChannels]; /* silence that counts as a stall */
+    uint32_t max_restarts;          /* restarts per episode before kReboot */
+  };
+
+  struct Stats {
+    uint32_t stalls[kChannels]; /* stall detections per channel */
+    uint32_t restarts;          /* restarts requested */
+    uint32_t recoveries;        /* episodes that ended without a reboot */
+    uint32_t mttr_last_ms;      /* detection -> all armed channels beating again */
+    uint32_t mttr_max_ms;
+    uint64_t mttr_sum_ms;       /* mean = mttr_sum_ms / recoveries */
+  };
+
+  /** Set timeouts and policy; disarms every channel and clears the stats. */
+  void init(const Config &cfg);
+
+  /** Start or stop monitoring @p ch. Arming restarts its timeout at @p now. */
+  void arm(Channel ch, bool on, uint32_t now) {
+    last_[ch].store(now, std::memory_order_relaxed);
+    armed_[ch].store(on, std::memory_order_release);
+  }
+
+  /** Heartbeat from the stage's own thread, once per block / frame. */
+  void beat(Channel ch, uint32_t now) {
+    last_[ch].store(now, std::memory_order_relaxed);
+    beats_[ch].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Check all armed channels. Call periodically (well below the shortest
+   * timeout) from the monitor thread and carry out the returned action.
+   */
+  Action poll(uint32_t now);
+
+  /** Channels in the current stall episode (bit per Channel), 0 when healthy. */
+  uint8_t stalled_mask() const { return episode_mask_; }
+
+  /** Armed channels (bit per Channel). */
+  uint8_t armed_mask() const;
+
+  const Stats &stats() const { return stats_; }
+
+private:
+  Config cfg_{};
+  std::atomic<uint32_t> last_[kChannels]{};
+  std::atomic<uint32_t> beats_[kChannels]{};
+  std::atomic<bool> armed_[kChannels]{};
+
+  Action restart(uint32_t now);
+
+  bool in_episode_ = false;
+  uint8_t episode_mask_ = 0; /* channels that stalled this episode */
+  uint32_t detected_at_ = 0; /* first stall of the episode */
+  uint32_t episode_restarts_ = 0;
+  uint32_t beats_at_restart_[kChannels]{};
+  Stats stats_{};
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_PIPELINE_WATCHDOG_H_ */
@@ -0,0 +1,125 @@
+/**
+ * @file rate_feedback.cpp
+ * @brief RateFeedback estimator implementation. See rate_feedback.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "rate_feedback.h"
+
+namespace usb_audio {
+
+namespace {
+
+int64_t clamp_around(int64_t v, int64_t centre, int64_t limit) {
+  if (v > centre + limit) {
+    return centre + limit;
+  }
+  if (v < centre - limit) {
+    return centre - limit;
+  }
+  return v;
+}
+
+} // namespace
+
+void RateFeedback::init(uint16_t samples_per_sof) {
+  nominal_ = static_cast<uint32_t>(samples_per_sof) << kFracBits;
+  nominal_q_ = static_cast<int64_t>(samples_per_sof) << kStateFracBits;
+  clamp_ = int64_t{1} << (kStateFracBits - 1); /* ±0.5 sample */
+  reset();
+}
+
+void RateFeedback::reset() {
+  have_fill_ = false;
+  steps_ = 0;
+  fill_ = 0;
+  rate_ = nominal_q_;
+  residual_ = 0;
+  have_pos_ = false;
+  last_pos_ = 0;
+  stamps_ = 0;
+  stamp_sum_ = 0;
+  fb_value_ = nominal_;
+}
+
+void RateFeedback::handover(uint32_t value) {
+  have_fill_ = false;
+  steps_ = 0;
+  fill_ = 0;
+  residual_ = 0;
+  if (stamps_ == 0U) {
+    rate_ = clamp_around(static_cast<int64_t>(value) << (kStateFracBits - kFracBits), nominal_q_, clamp_);
+  }
+  fb_value_ = value;
+}
+
+void RateFeedback::stamp(uint32_t position_q8) {
+  if (have_pos_) {
+    /* Wrap-safe interval; a gap or a stalled DAC just re-anchors. */
+    const int32_t played_q8 = static_cast<int32_t>(position_q8 - last_pos_);
+    const int32_t dev_q8 = played_q8 - static_cast<int32_t>(nominal_q_ >> (kStateFracBits - 8));
+    if (dev_q8 <= (kStampWindow << 8) && dev_q8 >= -(kStampWindow << 8)) {
+      /* Running sum of the intervals; once full, drop one average interval
+       * per new one (an exponential average of the same length). */
+      if (stamps_ < static_cast<uint32_t>(kStampDiv)) {
+        stamps_++;
+      } else {
+        stamp_sum_ -= stamp_sum_ / kStampDiv;
+      }
+      stamp_sum_ += static_cast<int64_t>(played_q8) * (int64_t{1} << (kStateFracBits - 8));
+      rate_ = clamp_around(stamp_sum_ / stamps_, nominal_q_, clamp_);
+    }
+  }
+  last_pos_ = position_q8;
+  have_pos_ = true;
+}
+
+void RateFeedback::update(size_t used, size_t capacity) {
+  const int64_t measured = static_cast<int64_t>(used) << kStateFracBits;
+
+  if (!have_fill_) {
+    /* The sink only starts draining once prebuffered to the set point; until
+     * then the fill says nothing about the device rate. */
+    if (used < capacity / 2) {
+      return;
+    }
+    fill_ = measured;
+    have_fill_ = true;
+    steps_ = 1;
+  } else {
+    /* Predict: since the last SOF the host sent what we reported and the
+     * device played what we estimate. Then correct with the innovation: more
+     * fill than predicted means the device plays slower than estimated. */
+    fill_ += (static_cast<int64_t>(fb_value_) << (kStateFracBits - kFracBits)) - rate_;
+    const int64_t innovation = measured - fill_;
+
+    /* Kalman gains of a constant-rate model started with no prior: the
+     * least-squares alpha = 2(2n-1)/(n(n+1)), beta = 6/(n(n+1)) shrink with
+     * every step until they reach the steady-state kFillDiv / kRateDiv. */
+    steps_ = steps_ < kSettleSteps ? steps_ + 1U : steps_;
+    const int64_t n = steps_;
+    const int64_t den = n * (n + 1);
+    const int64_t fill_num = 2 * (2 * n - 1);
+    fill_ += fill_num * kFillDiv > den ? innovation / den * fill_num : innovation / kFillDiv;
+    /* With stamps the rate is measured; the fill then only sets the phase. */
+    if (stamps_ == 0U) {
+      rate_ -= 6 * kRateDiv > den ? innovation / den * 6 : innovation / kRateDiv;
+      rate_ = clamp_around(rate_, nominal_q_, clamp_);
+    }
+  }
+
+  /* Positive phase error => ring emptier than target => ask for more. */
+  const int64_t set_point = static_cast<int64_t>(capacity / 2) << kStateFracBits;
+  const int64_t out = clamp_around(rate_ + (set_point - fill_) / kPhaseDiv, nominal_q_, clamp_);
+
+  /* Positive and small, as in BufferFeedback; mask like the Zephyr sample,
+   * but carry what the mask drops into the next SOF so the average reported
+   * value is the estimate itself rather than up to 122 ppm below it. */
+  const int64_t wanted = out + residual_;
+  const int64_t val = wanted & ~((int64_t{1} << (kLsbZeroBits + kStateFracBits - kFracBits)) - 1);
+  residual_ = wanted - val;
+  fb_value_ = static_cast<uint32_t>(val >> (kStateFracBits - kFracBits));
+}
+
+} // namespace usb_audio
@@ -0,0 +1,125 @@
+/**
+ * @file rate_feedback.h
+ * @brief Rate-estimating explicit-feedback regulator for the UAC2 OUT sink.
+ *
+ * Alternative to BufferFeedback with the same interface. Instead of a PI on the
+ * ring fill it estimates the device sample rate directly with a two-state
+ * Kalman filter (an alpha-beta tracker, i.e. a second-order PLL) on the fill.
+ * Each SOF it predicts the fill from the samples the host was told to send and
+ * the estimated device consumption; the innovation corrects both the fill and
+ * the rate estimate. The gains start at the least-squares values for a filter
+ * with no prior and shrink to small steady-state gains, so the first estimate
+ * is quick and the settled one ignores the fill sawtooth. The reported value
+ * is the rate estimate plus a weak phase term that holds the fill at the set
+ * point; the bits the Q10.14 LSB mask drops are carried to the next SOF.
+ *
+ * Optionally the DAC sample position at SOF (analog_audio_out_get_clock) is
+ * fed in with stamp(): the rate then comes from the measured samples played
+ * per frame instead of the fill innovation, and the fill only sets the phase.
+ *
+ * Full-Speed only, Q10.14 output. Pure logic: no USB, no Zephyr, no heap, no
+ * float, no exceptions.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_USB_AUDIO_RATE_FEEDBACK_H_
+#define OE5XRX_USB_AUDIO_RATE_FEEDBACK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace usb_audio {
+
+class RateFeedback {
+public:
+  /** Set the nominal value for @p samples_per_sof and reset the filter. */
+  void init(uint16_t samples_per_sof);
+
+  /** Forget the fill, rate and position state; report nominal. */
+  void reset();
+
+  /**
+   * Take over from another regulator reporting @p value (Q10.14): restart the
+   * fill tracking and keep reporting @p value until it has anchored. A rate
+   * measured from stamps is kept; without stamps @p value seeds the rate.
+   */
+  void handover(uint32_t value);
+
+  /**
+   * Optional SOF timestamp: the DAC sample position at this SOF, Q24.8
+   * (free-running, wrap-safe). Call before update() in the same SOF.
+   * Intervals far from nominal (missed SOFs, a stalled DAC) are ignored.
+   */
+  void stamp(uint32_t position_q8);
+
+  /**
+   * Run one filter step. Call once per SOF while the OUT stream is active.
+   * @param used     current ring fill, in samples
+   * @param capacity ring capacity, in samples (set point is capacity/2)
+   */
+  void update(size_t used, size_t capacity);
+
+  /** Current Q10.14 feedback value to report to the host. */
+  uint32_t value() const { return fb_value_; }
+
+  /** Nominal Q10.14 value (no correction). */
+  uint32_t nominal() const { return nominal_; }
+
+  /** Estimated device samples per SOF, Q10.14 (unmasked, no phase term). */
+  uint32_t rate() const { return static_cast<uint32_t>(rate_ / (int64_t{1} << (kStateFracBits - kFracBits))); }
+
+private:
+  /* Full-Speed feedback is Q10.14. */
+  static constexpr int kFracBits = 14;
+  /* Clear the low bits: do not use the optional extra resolution. */
+  static constexpr int kLsbZeroBits = 4;
+  /* Filter state is Q32 samples in int64: with the small steady-state gains
+   * below, a Q16 state would truncate innovations of up to a sample to zero
+   * and leave the estimate stuck that far off. */
+  static constexpr int kStateFracBits = 32;
+  /* Steady-state fill gain (alpha = 1/8192). The fill seen at SOF saws by one
+   * DAC block as the clocks slide, with a beat period of seconds at a few
+   * hundred ppm; the prediction from the reported value carries the fill
+   * between SOFs, so the measurement only has to trim it slowly. */
+  static constexpr int64_t kFillDiv = 8192;
+  /* Steady-state rate gain (beta = 2^-26) from the fill innovation: settles
+   * over tens of seconds, well below the sawtooth beat. The start-up gains
+   * give the first estimate within a second. */
+  static constexpr int64_t kRateDiv = int64_t{1} << 26;
+  /* Stamp averaging: the rate is the running mean of the measured
+   * samples-per-SOF intervals over the first kStampDiv SOFs, an exponential
+   * average of the same length after that. SOF handler jitter makes single
+   * intervals noisy but unbiased. The sum is kept in Q32: a Q24.8 sum would
+   * round the dropped average and settle up to one Q8 step off. */
+  static constexpr int64_t kStampDiv = 8192;
+  /* Phase gain: 1/256 sample per SOF per sample of fill error, the
+   * BufferFeedback P term, but applied to the smoothed fill estimate. The
+   * drift is carried by the rate estimate, so no integrator is needed. */
+  static constexpr int64_t kPhaseDiv = 256;
+  /* Step count at which the start-up gains have long reached the steady
+   * state; the counter stops there. */
+  static constexpr uint32_t kSettleSteps = 65535U;
+  /* A stamp interval further than this from nominal (samples) is a gap:
+   * half a frame, above any SOF handler jitter. */
+  static constexpr int32_t kStampWindow = 4;
+
+  uint32_t nominal_ = 0;  /* samples_per_sof << 14 */
+  uint32_t fb_value_ = 0; /* current reported value (clamped, LSB-masked) */
+  int64_t nominal_q_ = 0; /* samples_per_sof, Q32 */
+  int64_t clamp_ = 0;     /* max deviation from nominal, Q32 (±0.5 sample) */
+
+  bool have_fill_ = false;
+  uint32_t steps_ = 0;   /* filter steps since the sink started draining */
+  int64_t fill_ = 0;     /* estimated ring fill, Q32 samples */
+  int64_t rate_ = 0;     /* estimated device samples per SOF, Q32 */
+  int64_t residual_ = 0; /* value the LSB mask dropped last SOF, Q32 */
+  bool have_pos_ = false;
+  uint32_t last_pos_ = 0; /* previous stamp, Q24.8 */
+  uint32_t stamps_ = 0;   /* intervals in stamp_sum_, up to kStampDiv */
+  int64_t stamp_sum_ = 0; /* sum of the last stamps_ intervals, Q32 */
+};
+
+} // namespace usb_audio
+
+#endif /* OE5XRX_USB_AUDIO_RATE_FEEDBACK_H_ */
@@ -11,13 +11,22 @@
  * @spdx-license-identifier LGPL-3.0-or-later
  */
 
+#include "usb_audio_bridge.h"
+
 #include "audio_stream.h"
-#include "feedback.h"
+#include "bridge_stats.h"
+#include "feedback_controller.h"
+
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+#include "audio_watchdog.h"
+#endif
 
 #include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/ring_buffer.h>
 
 extern "C" {
@@ -27,34 +36,77 @@ extern "C" {
 
 LOG_MODULE_REGISTER(usb_audio_bridge, LOG_LEVEL_INF);
 
-/* Audio configuration */
+/* Audio configuration. The wire format comes from the UAC2 devicetree: sample
+ * container from the streaming interface's subslot-size, channels from the
+ * terminal's spatial locations. audio_stream converts to/from the 16-bit mono
+ * core (pcm_convert.h), so a host that insists on 24-bit or stereo only needs
+ * a devicetree change. Both directions share one format, except that with
+ * CONFIG_APP_AUDIO_IN_DUAL the IN stream is always stereo: processed audio in
+ * channel 1, the raw capture in channel 2. */
 #define AUDIO_SAMPLE_RATE_HZ 8000
-#define AUDIO_SAMPLE_SIZE_BYTES 2 /* 16-bit PCM */
-#define AUDIO_CHANNELS 1          /* Mono */
-#define AUDIO_BYTES_PER_SAMPLE (AUDIO_SAMPLE_SIZE_BYTES * AUDIO_CHANNELS)
+#define UAC2_CHANNELS(node) (DT_PROP(node, front_left) + DT_PROP(node, front_right) + DT_PROP(node, front_center))
+#define AUDIO_SAMPLE_SIZE_BYTES DT_PROP(DT_NODELABEL(as_iso_out), subslot_size)
+#define AUDIO_CHANNELS UAC2_CHANNELS(DT_NODELABEL(usb_out_terminal))
+#define AUDIO_BYTES_PER_SAMPLE (AUDIO_SAMPLE_SIZE_BYTES * AUDIO_CHANNELS) /* one frame, all channels */
+#ifdef CONFIG_APP_AUDIO_IN_DUAL
+#define AUDIO_IN_CHANNELS 2
+#else
+#define AUDIO_IN_CHANNELS AUDIO_CHANNELS
+#endif
+#define AUDIO_IN_BYTES_PER_SAMPLE (AUDIO_SAMPLE_SIZE_BYTES * AUDIO_IN_CHANNELS)
+
+BUILD_ASSERT(AUDIO_SAMPLE_SIZE_BYTES == DT_PROP(DT_NODELABEL(as_iso_in), subslot_size), "UAC2 OUT and IN must use the same subslot size");
+BUILD_ASSERT(AUDIO_IN_CHANNELS == UAC2_CHANNELS(DT_NODELABEL(sa818_rx_input)),
+             "UAC2 IN must have the OUT channel count, or two channels with CONFIG_APP_AUDIO_IN_DUAL");
+BUILD_ASSERT(AUDIO_SAMPLE_SIZE_BYTES >= 2 && AUDIO_SAMPLE_SIZE_BYTES <= 4, "subslot-size must be 2, 3 or 4 bytes");
+BUILD_ASSERT(AUDIO_CHANNELS == 1 || AUDIO_CHANNELS == 2, "UAC2 terminals must be mono or stereo");
 
 /* USB Audio timing (Full-Speed: 1ms SOF, 8 samples/frame @ 8kHz) */
 #define USB_SAMPLES_PER_SOF 8
 #define USB_BYTES_PER_SOF (USB_SAMPLES_PER_SOF * AUDIO_BYTES_PER_SAMPLE)
 
-/* Ring buffer sizes (must be power of 2) */
-#define TX_RING_SIZE 512 /* USB -> SA818 (256 samples = 32ms) */
-#define RX_RING_SIZE 512 /* SA818 -> USB (256 samples = 32ms) */
-
-/* Start draining the TX ring to the SA818 only once it is ~half full, so the
- * feedback loop has slack in both directions from the first consumed sample. */
-#define TX_PREBUFFER_BYTES (TX_RING_SIZE / 2)
+/* Ring buffer sizes: 256 frames = 32ms each way, whatever the frame size */
+#define RING_FRAMES USB_AUDIO_BRIDGE_RING_FRAMES
+#define TX_RING_SIZE (RING_FRAMES * AUDIO_BYTES_PER_SAMPLE)    /* USB -> SA818 */
+#define RX_RING_SIZE (RING_FRAMES * AUDIO_IN_BYTES_PER_SAMPLE) /* SA818 -> USB */
+
+/* TX ring set point at boot, in samples. Free-running, the DAC clock drifts against
+ * the host's, so the ring is held half full to absorb drift both ways. With the
+ * sample clock locked to SOF (CONFIG_APP_AUDIO_SOF_SYNC) only scheduling jitter
+ * remains and the set point (= TX latency) drops to a few ms. */
+#ifdef CONFIG_APP_AUDIO_SOF_SYNC
+#define TX_SETPOINT_SAMPLES CONFIG_APP_AUDIO_SOF_SYNC_TX_SETPOINT
+#else
+#define TX_SETPOINT_SAMPLES (TX_RING_SIZE / AUDIO_BYTES_PER_SAMPLE / 2)
+#endif
+BUILD_ASSERT(TX_SETPOINT_SAMPLES * 2 * AUDIO_BYTES_PER_SAMPLE <= TX_RING_SIZE, "TX set point must leave headroom in the ring");
+
+/* Start draining the TX ring to the SA818 only once it reaches the set point,
+ * so the feedback loop has slack in both directions from the first consumed
+ * sample. */
+#define TX_PREBUFFER_SAMPLES TX_SETPOINT_SAMPLES
+
+/* The IN ring must hold at least two SOF packets. */
+#define RX_MAX_MIN_SAMPLES (2 * USB_SAMPLES_PER_SOF)
+
+/* OUT feedback regulator at boot; "uac2 feedback" switches it at run time. */
+#ifdef CONFIG_APP_AUDIO_FEEDBACK_RATE
+#define FEEDBACK_MODE_DEFAULT usb_audio::FeedbackMode::Rate
+#else
+#define FEEDBACK_MODE_DEFAULT usb_audio::FeedbackMode::Pi
+#endif
 
 /* USB buffer pool */
 #define USB_BUF_COUNT 8
-#define USB_BUF_SIZE 32 /* 16 samples max per SOF */
+#define USB_BUF_SIZE (2 * USB_SAMPLES_PER_SOF * AUDIO_BYTES_PER_SAMPLE)       /* 16 frames max per SOF */
+#define USB_IN_BUF_SIZE (2 * USB_SAMPLES_PER_SOF * AUDIO_IN_BYTES_PER_SAMPLE) /* the same for IN frames */
 
 /* Max bytes for one async IN isochronous packet == the IN endpoint's
  * wMaxPacketSize. The clock is free-running (not SOF-synchronized), so the UAC2
  * class sizes the endpoint for (nominal + 1) samples per frame. The per-SOF send
  * MUST NOT exceed this or the UDC emits an oversized (babble) packet. This caps
- * only the SEND; USB_BUF_SIZE (pool storage) may stay larger. */
-#define USB_IN_MAX_PACKET_BYTES ((USB_SAMPLES_PER_SOF + 1) * AUDIO_BYTES_PER_SAMPLE)
+ * only the SEND; USB_IN_BUF_SIZE (pool storage) may stay larger. */
+#define USB_IN_MAX_PACKET_BYTES ((USB_SAMPLES_PER_SOF + 1) * AUDIO_IN_BYTES_PER_SAMPLE)
 
 /*
  * Terminal IDs the UAC2 class reports to the application callbacks.
@@ -98,8 +150,8 @@ struct usb_audio_bridge_ctx {
   uint8_t rx_ring_buf[RX_RING_SIZE] __aligned(UDC_BUF_ALIGN);
 
   /* USB buffer pools - separate for each direction */
-  uint8_t usb_out_buf_pool[USB_BUF_COUNT][USB_BUF_SIZE] __aligned(UDC_BUF_ALIGN); /* USB OUT (receive) */
-  uint8_t usb_in_buf_pool[USB_BUF_COUNT][USB_BUF_SIZE] __aligned(UDC_BUF_ALIGN);  /* USB IN (transmit) */
+  uint8_t usb_out_buf_pool[USB_BUF_COUNT][USB_BUF_SIZE] __aligned(UDC_BUF_ALIGN);   /* USB OUT (receive) */
+  uint8_t usb_in_buf_pool[USB_BUF_COUNT][USB_IN_BUF_SIZE] __aligned(UDC_BUF_ALIGN); /* USB IN (transmit) */
   uint8_t usb_out_buf_idx;
   uint8_t usb_in_buf_idx;
 
@@ -107,10 +159,29 @@ struct usb_audio_bridge_ctx {
   struct k_mutex lock;
 
   /* Status */
-  bool tx_enabled;                    /* USB OUT terminal active */
-  bool rx_enabled;                    /* USB IN terminal active */
-  bool tx_prebuffered;                /* TX ring reached the prebuffer threshold */
-  usb_audio::BufferFeedback feedback; /* explicit feedback regulator (OUT) */
+  bool tx_enabled;                        /* USB OUT terminal active */
+  bool rx_enabled;                        /* USB IN terminal active */
+  bool tx_prebuffered;                    /* TX ring reached the prebuffer threshold */
+  usb_audio::FeedbackController feedback; /* explicit feedback regulator (OUT), usbd thread only */
+
+  /* Regulator selection and status for the shell: the mode is requested here
+   * and switched by the SOF callback; value and rate estimate are published
+   * back each SOF. */
+  atomic_t feedback_mode_req; /* usb_audio::FeedbackMode */
+  atomic_t feedback_value;    /* last reported value, Q10.14 */
+  atomic_t feedback_rate;     /* rate estimate, Q10.14 */
+
+  /* Counters for "uac2 stats" and the usb_audio module; the hot paths only
+   * record here, they never log. */
+  usb_audio::BridgeStats stats;
+
+  /* Run-time set points (usb_audio_bridge_set_tuning()), in samples, and the
+   * ring fills published each SOF. */
+  atomic_t tx_setpoint;
+  atomic_t tx_prebuffer;
+  atomic_t rx_max;
+  atomic_t tx_fill;
+  atomic_t rx_fill;
 };
 
 static struct usb_audio_bridge_ctx bridge_ctx;
@@ -131,10 +202,10 @@ static size_t sa818_tx_request_cb(const struct device *dev, uint8_t *buffer, siz
 
   k_mutex_lock(&ctx->lock, K_FOREVER);
 
-  /* Hold off draining until the ring has prebuffered ~half full. Until then
-   * emit silence so the loop has slack before the SA818 starts consuming. */
+  /* Hold off draining until the ring has prebuffered to the set point. Until
+   * then emit silence so the loop has slack before the SA818 starts consuming. */
   if (!ctx->tx_prebuffered) {
-    if (ring_buf_size_get(&ctx->tx_ring) >= TX_PREBUFFER_BYTES) {
+    if (ring_buf_size_get(&ctx->tx_ring) >= (uint32_t)atomic_get(&ctx->tx_prebuffer) * AUDIO_BYTES_PER_SAMPLE) {
       ctx->tx_prebuffered = true;
     } else {
       /* Emit real PCM silence (zero samples) rather than a 0-length return:
@@ -150,6 +221,7 @@ static size_t sa818_tx_request_cb(const struct device *dev, uint8_t *buffer, siz
   uint32_t bytes_read = ring_buf_get(&ctx->tx_ring, buffer, size);
   k_mutex_unlock(&ctx->lock);
 
+  ctx->stats.out_drained(size, bytes_read);
   return bytes_read;
 }
 
@@ -167,14 +239,16 @@ static void sa818_rx_data_cb(const struct device *dev, const uint8_t *buffer, si
     return;
   }
 
-  /* Push audio to RX ring buffer (for USB IN) */
+  /* Push audio to RX ring buffer (for USB IN), up to the fill cap. What does
+   * not fit counts as an IN overflow, as with a full ring. */
+  const uint32_t cap = (uint32_t)atomic_get(&ctx->rx_max) * AUDIO_IN_BYTES_PER_SAMPLE;
   k_mutex_lock(&ctx->lock, K_FOREVER);
-  uint32_t bytes_put = ring_buf_put(&ctx->rx_ring, buffer, size);
+  const uint32_t used = ring_buf_size_get(&ctx->rx_ring);
+  const uint32_t room = used < cap ? cap - used : 0;
+  uint32_t bytes_put = ring_buf_put(&ctx->rx_ring, buffer, MIN(size, room - room % AUDIO_IN_BYTES_PER_SAMPLE));
   k_mutex_unlock(&ctx->lock);
 
-  if (bytes_put < size) {
-    LOG_WRN("RX ring buffer overflow: %zu/%zu bytes dropped", size - bytes_put, size);
-  }
+  ctx->stats.in_captured(size, bytes_put);
 }
 
 /**
@@ -188,26 +262,52 @@ static void uac2_sof_cb(const struct device *dev, void *user_data) {
 
   ARG_UNUSED(dev);
 
-  /* OUT explicit feedback: keep the TX ring near half full. */
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  audio_watchdog_beat(AUDIO_WDT_SOF);
+#endif
+
+#ifdef CONFIG_APP_AUDIO_SOF_SYNC
+  /* Trim the sample clock to this frame before the rings are sampled. */
+  audio_stream_clock_sync_sof();
+#endif
+
+  /* OUT explicit feedback: keep the TX ring at the set point. */
+  ctx->feedback.set_mode(static_cast<usb_audio::FeedbackMode>(atomic_get(&ctx->feedback_mode_req)));
+
   k_mutex_lock(&ctx->lock, K_FOREVER);
   bool tx = ctx->tx_enabled;
   size_t tx_used = ring_buf_size_get(&ctx->tx_ring) / AUDIO_BYTES_PER_SAMPLE;
   k_mutex_unlock(&ctx->lock);
 
   if (tx) {
-    ctx->feedback.update(tx_used, TX_RING_SIZE / AUDIO_BYTES_PER_SAMPLE);
+    /* DAC position at this frame for the rate estimator (not while stopped). */
+    uint32_t position;
+    if (audio_stream_get_play_position(&position) == 0) {
+      ctx->feedback.stamp(position);
+    }
+    ctx->feedback.update(tx_used, 2 * (size_t)atomic_get(&ctx->tx_setpoint));
+    ctx->stats.fill(usb_audio::BridgeStats::kOut, tx_used, RING_FRAMES);
+    ctx->stats.feedback(ctx->feedback.value());
   }
+  atomic_set(&ctx->feedback_value, (atomic_val_t)ctx->feedback.value());
+  atomic_set(&ctx->feedback_rate, (atomic_val_t)ctx->feedback.rate());
+  atomic_set(&ctx->tx_fill, tx ? (atomic_val_t)tx_used : 0);
 
   /* IN capture: send whatever whole samples we have this SOF. As an async IN
    * endpoint the variable packet size itself conveys the rate; no feedback. */
   k_mutex_lock(&ctx->lock, K_FOREVER);
   bool rx = ctx->rx_enabled;
   size_t avail = ring_buf_size_get(&ctx->rx_ring);
-  size_t to_send = avail - (avail % AUDIO_BYTES_PER_SAMPLE);
+  size_t to_send = avail - (avail % AUDIO_IN_BYTES_PER_SAMPLE);
   if (to_send > USB_IN_MAX_PACKET_BYTES) {
     to_send = USB_IN_MAX_PACKET_BYTES;
   }
 
+  if (rx) {
+    ctx->stats.fill(usb_audio::BridgeStats::kIn, avail / AUDIO_IN_BYTES_PER_SAMPLE, RING_FRAMES);
+  }
+  atomic_set(&ctx->rx_fill, rx ? (atomic_val_t)(avail / AUDIO_IN_BYTES_PER_SAMPLE) : 0);
+
   if (rx && to_send > 0) {
     uint8_t buf_idx = ctx->usb_in_buf_idx;
     ctx->usb_in_buf_idx = (ctx->usb_in_buf_idx + 1) % USB_BUF_COUNT;
@@ -215,15 +315,20 @@ static void uac2_sof_cb(const struct device *dev, void *user_data) {
     uint32_t bytes_read = ring_buf_get(&ctx->rx_ring, (uint8_t *)buf, to_send);
     k_mutex_unlock(&ctx->lock);
 
-    /* -EAGAIN just means the host has not drained the previous IN packet yet;
-     * drop silently (rate-limited for genuinely unexpected errors) so we never
-     * flood the log and starve the USB thread. */
+    /* -EAGAIN just means the host has not drained the previous IN packet yet.
+     * Failures are only counted per errno ("uac2 stats"): logging from here
+     * would cost the USB thread more than the packet it lost. */
     int ret = usbd_uac2_send(ctx->uac2_dev, USB_IN_TERMINAL_ID, buf, bytes_read);
-    if (ret != 0 && ret != -EAGAIN) {
-      LOG_WRN_RATELIMIT("USB IN send failed: %d", ret);
+    if (ret == 0) {
+      ctx->stats.in_sent(bytes_read);
+    } else {
+      ctx->stats.in_send_failed(ret);
     }
   } else {
     k_mutex_unlock(&ctx->lock);
+    if (rx) {
+      ctx->stats.in_empty();
+    }
   }
 }
 
@@ -240,6 +345,9 @@ static void uac2_terminal_update_cb(const struct device *dev, uint8_t terminal,
 
   if (terminal == USB_OUT_TERMINAL_ID) {
     ctx->tx_enabled = enabled;
+    if (ctx->tx_prebuffered) {
+      ctx->stats.prebuffer_reset();
+    }
     ctx->tx_prebuffered = false;
     ctx->feedback.reset();
     LOG_INF("USB OUT (TX) terminal %s", enabled ? "enabled" : "disabled");
@@ -256,6 +364,11 @@ static void uac2_terminal_update_cb(const struct device *dev, uint8_t terminal,
     }
   }
 
+#ifdef CONFIG_APP_AUDIO_WATCHDOG
+  /* SOF handling only matters (and is only watched) while a terminal streams. */
+  audio_watchdog_arm(AUDIO_WDT_SOF, ctx->tx_enabled || ctx->rx_enabled);
+#endif
+
   k_mutex_unlock(&ctx->lock);
 
   /* The tx_enabled/rx_enabled flags above gate the bridge's own OUT/IN callbacks
@@ -306,11 +419,7 @@ static void uac2_data_recv_cb(const struct device *dev, uint8_t terminal, void *
   uint32_t bytes_put = ring_buf_put(&ctx->tx_ring, (uint8_t *)buf, size);
   k_mutex_unlock(&ctx->lock);
 
-  if (bytes_put < size) {
-    LOG_WRN("TX ring buffer overflow: %u/%u bytes dropped", size - bytes_put, size);
-  }
-
-  LOG_DBG("USB OUT: %u bytes -> TX ring", bytes_put);
+  ctx->stats.out_received(size, bytes_put);
 }
 
 /**
@@ -390,7 +499,13 @@ extern "C" int usb_audio_bridge_register_ops(const struct device *uac2_dev) {
   ctx->usb_out_buf_idx = 0;
   ctx->usb_in_buf_idx = 0;
   ctx->tx_prebuffered = false;
-  ctx->feedback.init(USB_SAMPLES_PER_SOF);
+  ctx->feedback.init(USB_SAMPLES_PER_SOF, FEEDBACK_MODE_DEFAULT);
+  atomic_set(&ctx->feedback_mode_req, (atomic_val_t)FEEDBACK_MODE_DEFAULT);
+  atomic_set(&ctx->feedback_value, (atomic_val_t)ctx->feedback.value());
+  atomic_set(&ctx->feedback_rate, (atomic_val_t)ctx->feedback.rate());
+  atomic_set(&ctx->tx_setpoint, TX_SETPOINT_SAMPLES);
+  atomic_set(&ctx->tx_prebuffer, TX_PREBUFFER_SAMPLES);
+  atomic_set(&ctx->rx_max, RING_FRAMES);
 
   /* Register UAC2 callbacks. This MUST happen before usbd_init(): the UAC2
    * class init hook returns -EINVAL ("Application did not register UAC2 ops")
@@ -442,11 +557,20 @@ extern "C" int usb_audio_bridge_start(const struct device *sa818_dev) {
     return ret;
   }
 
+#ifdef CONFIG_APP_AUDIO_SOF_SYNC
+  ret = audio_stream_set_clock_sync(sa818_dev, true);
+  if (ret != 0) {
+    LOG_WRN("SOF clock sync unavailable (%d), sample clock free-running", ret);
+  }
+#endif
+
   /* Start audio streaming */
   struct audio_format format = {
       .sample_rate = AUDIO_SAMPLE_RATE_HZ,
-      .bit_depth = 16,
-      .channels = 1,
+      .bit_depth = AUDIO_SAMPLE_SIZE_BYTES * 8,
+      .channels = AUDIO_CHANNELS,
+      .is_float = false,
+      .rx_dual = IS_ENABLED(CONFIG_APP_AUDIO_IN_DUAL),
   };
 
   ret = audio_stream_start(sa818_dev, &format);
@@ -458,9 +582,122 @@ extern "C" int usb_audio_bridge_start(const struct device *sa818_dev) {
     return ret;
   }
 
-  LOG_INF("USB Audio Bridge started (8kHz, 16-bit, mono)");
+  LOG_INF("USB Audio Bridge started (8kHz, %u-bit, %u ch)", AUDIO_SAMPLE_SIZE_BYTES * 8, AUDIO_CHANNELS);
   LOG_INF("  USB OUT -> TX Ring (%u bytes) -> SA818 TX", TX_RING_SIZE);
-  LOG_INF("  SA818 RX -> RX Ring (%u bytes) -> USB IN", RX_RING_SIZE);
+  LOG_INF("  SA818 RX -> RX Ring (%u bytes) -> USB IN (%u ch)", RX_RING_SIZE, AUDIO_IN_CHANNELS);
+
+  return 0;
+}
+
+usb_audio::BridgeStats &usb_audio_bridge_stats() { return bridge_ctx.stats; }
+
+int usb_audio_bridge_set_tuning(const struct usb_audio_bridge_tuning *tuning) {
+  struct usb_audio_bridge_ctx *ctx = &bridge_ctx;
+
+  if (tuning == NULL || tuning->tx_setpoint < 1 || tuning->tx_setpoint > RING_FRAMES / 2 || tuning->tx_prebuffer > tuning->tx_setpoint ||
+      tuning->rx_max < RX_MAX_MIN_SAMPLES || tuning->rx_max > RING_FRAMES) {
+    return -EINVAL;
+  }
+
+  atomic_set(&ctx->tx_setpoint, (atomic_val_t)tuning->tx_setpoint);
+  atomic_set(&ctx->tx_prebuffer, (atomic_val_t)tuning->tx_prebuffer);
+  atomic_set(&ctx->rx_max, (atomic_val_t)tuning->rx_max);
+  return 0;
+}
+
+void usb_audio_bridge_get_tuning(struct usb_audio_bridge_tuning *tuning) {
+  tuning->tx_setpoint = (uint32_t)atomic_get(&bridge_ctx.tx_setpoint);
+  tuning->tx_prebuffer = (uint32_t)atomic_get(&bridge_ctx.tx_prebuffer);
+  tuning->rx_max = (uint32_t)atomic_get(&bridge_ctx.rx_max);
+}
+
+void usb_audio_bridge_get_fill(uint32_t *tx, uint32_t *rx) {
+  *tx = (uint32_t)atomic_get(&bridge_ctx.tx_fill);
+  *rx = (uint32_t)atomic_get(&bridge_ctx.rx_fill);
+}
+
+#ifdef CONFIG_SHELL
+static int cmd_uac2_feedback(const struct shell *sh, size_t argc, char **argv) {
+  struct usb_audio_bridge_ctx *ctx = &bridge_ctx;
 
+  if (argc > 1) {
+    usb_audio::FeedbackMode mode;
+    if (strcmp(argv[1], "pi") == 0) {
+      mode = usb_audio::FeedbackMode::Pi;
+    } else if (strcmp(argv[1], "rate") == 0) {
+      mode = usb_audio::FeedbackMode::Rate;
+    } else {
+      shell_error(sh, "Usage: uac2 feedback [pi|rate]");
+      return -EINVAL;
+    }
+    /* Taken over by the next SOF; the new regulator starts from nominal. */
+    atomic_set(&ctx->feedback_mode_req, (atomic_val_t)mode);
+  }
+
+  const bool rate_mode = static_cast<usb_audio::FeedbackMode>(atomic_get(&ctx->feedback_mode_req)) == usb_audio::FeedbackMode::Rate;
+  const int64_t nominal = (int64_t)USB_SAMPLES_PER_SOF << 14;
+  const uint32_t value = (uint32_t)atomic_get(&ctx->feedback_value);
+  const uint32_t rate = (uint32_t)atomic_get(&ctx->feedback_rate);
+  shell_print(sh, "UAC2-FEEDBACK mode=%s value=%u value_ppm=%d rate=%u rate_ppm=%d", rate_mode ? "rate" : "pi", value,
+              (int)(((int64_t)value - nominal) * 1000000 / nominal), rate, (int)(((int64_t)rate - nominal) * 1000000 / nominal));
   return 0;
 }
+
+/* Comma-separated @p n values into @p buf (truncated to fit). */
+static const char *join_u32(char *buf, size_t len, const uint32_t *v, size_t n) {
+  size_t pos = 0;
+  buf[0] = '\0';
+  for (size_t i = 0; i < n && pos < len; i++) {
+    pos += snprintk(buf + pos, len - pos, "%s%u", i ? "," : "", v[i]);
+  }
+  return buf;
+}
+
+static int cmd_uac2_stats(const struct shell *sh, size_t argc, char **argv) {
+  usb_audio::BridgeStats &stats = bridge_ctx.stats;
+
+  if (argc > 1) {
+    if (strcmp(argv[1], "reset") != 0) {
+      shell_error(sh, "Usage: uac2 stats [reset]");
+      return -EINVAL;
+    }
+    stats.reset();
+  }
+
+  usb_audio::BridgeStats::Snapshot s;
+  stats.snapshot(&s);
+  constexpr auto kOut = usb_audio::BridgeStats::kOut;
+  constexpr auto kIn = usb_audio::BridgeStats::kIn;
+
+  shell_print(sh,
+              "UAC2-STATS out_bytes=%u in_bytes=%u out_overflows=%u out_dropped=%u in_overflows=%u in_dropped=%u out_underruns=%u in_underruns=%u "
+              "prebuffer_resets=%u",
+              s.bytes[kOut], s.bytes[kIn], s.overflows[kOut], s.dropped[kOut], s.overflows[kIn], s.dropped[kIn], s.underruns[kOut], s.underruns[kIn],
+              s.prebuffer_resets);
+  for (const auto &e : s.send_errors) {
+    if (e.err != 0) {
+      shell_print(sh, "UAC2-SEND-ERR errno=%d count=%u", e.err, e.count);
+    }
+  }
+  if (s.send_errors_other != 0U) {
+    shell_print(sh, "UAC2-SEND-ERR errno=other count=%u", s.send_errors_other);
+  }
+
+  char buf[160];
+  shell_print(sh, "UAC2-FILL dir=out bins=%s", join_u32(buf, sizeof(buf), s.fill[kOut], usb_audio::BridgeStats::kFillBins));
+  shell_print(sh, "UAC2-FILL dir=in bins=%s", join_u32(buf, sizeof(buf), s.fill[kIn], usb_audio::BridgeStats::kFillBins));
+  shell_print(sh, "UAC2-FB-TRACE min=%u max=%u every_ms=%u trace=%s", s.feedback_min, s.feedback_max, usb_audio::BridgeStats::kTraceEvery,
+              join_u32(buf, sizeof(buf), s.trace, s.trace_len));
+  return 0;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    uac2_cmds,
+    SHELL_CMD_ARG(feedback, NULL, "OUT feedback regulator [pi|rate], reported value and rate estimate (Q10.14)", cmd_uac2_feedback, 1, 1),
+    SHELL_CMD_ARG(stats, NULL, "Bridge counters, ring fill histograms and feedback trace [reset]", cmd_uac2_stats, 1, 1),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(uac2, &uac2_cmds, "USB audio bridge commands", NULL);
+#endif
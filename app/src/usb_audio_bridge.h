@@ -44,6 +44,55 @@ int usb_audio_bridge_start(const struct device *sa818_dev);
 
 #ifdef __cplusplus
 }
+
+#include "bridge_stats.h"
+
+/**
+ * @brief Bridge counters: traffic, ring faults, send errors, feedback trace.
+ *
+ * Read with snapshot(); the shell ("uac2 stats") and the usb_audio module
+ * report from here.
+ */
+usb_audio::BridgeStats &usb_audio_bridge_stats();
+
+/** Capacity of each bridge ring, in samples (32 ms at 8 kHz). */
+#define USB_AUDIO_BRIDGE_RING_FRAMES 256
+
+/**
+ * @brief Ring buffer set points, in samples. Latency = samples / 8 ms.
+ *
+ * The rings are statically sized; these only move the operating point
+ * inside them.
+ */
+struct usb_audio_bridge_tuning {
+  uint32_t tx_setpoint;  /**< TX ring fill the OUT feedback regulates to, 1 .. RING_FRAMES / 2 */
+  uint32_t tx_prebuffer; /**< TX fill before playback starts, 0 .. tx_setpoint */
+  uint32_t rx_max;       /**< IN ring fill cap, capture beyond it is dropped, 16 .. RING_FRAMES */
+};
+
+/**
+ * @brief Apply new set points (any thread).
+ *
+ * The set point and the RX cap act from the next SOF / capture block; the
+ * prebuffer depth from the next time the OUT terminal starts. The prebuffer
+ * may not exceed the set point: playback would start above the fill the
+ * feedback then drains the ring down to, adding latency for nothing. To
+ * lower both, lower the prebuffer first.
+ *
+ * @return 0 on success, -EINVAL if a value is out of range or the prebuffer
+ * exceeds the set point
+ */
+int usb_audio_bridge_set_tuning(const struct usb_audio_bridge_tuning *tuning);
+
+/** @brief Current set points. */
+void usb_audio_bridge_get_tuning(struct usb_audio_bridge_tuning *tuning);
+
+/**
+ * @brief Ring fill at the last SOF, in samples, per direction.
+ *
+ * 0 for a direction whose terminal is not streaming.
+ */
+void usb_audio_bridge_get_fill(uint32_t *tx, uint32_t *rx);
 #endif
 
 #endif /* USB_AUDIO_BRIDGE_H_ */
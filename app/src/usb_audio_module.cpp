@@ -0,0 +1,94 @@
+/**
+ * @file usb_audio_module.cpp
+ * @brief `usb_audio` module: USB audio bridge statistics as module telemetry.
+ *
+ * Read-only counters from usb_audio_bridge_stats(), addressable through the
+ * generic `module` shell (`module usb_audio get out_overflows`). The full
+ * fill histograms and the feedback trace are on `uac2 stats`. The `audio`
+ * module (audio_module.cpp), listed here too, holds the tunable side.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#ifdef CONFIG_MODULE_SA818
+
+#include "audio_module.h"
+#include "usb_audio_bridge.h"
+
+#include <oe5xrx/module/iface.h>
+
+namespace {
+
+using mod::Capability;
+using mod::FieldSpec;
+using mod::Identity;
+using mod::Module;
+using mod::Result;
+using mod::Telemetry;
+using mod::ValueType;
+using Snapshot = usb_audio::BridgeStats::Snapshot;
+using usb_audio::BridgeStats;
+
+/* Counters wrap at 2^32; telemetry is a signed int, so report them mod 2^31. */
+int counter(uint32_t v) { return static_cast<int>(v & 0x7FFFFFFFU); }
+
+/* One snapshot field, selected by @p read. */
+class StatCap : public Telemetry {
+public:
+  StatCap(const FieldSpec &spec, int (*read)(const Snapshot &)) : spec_(spec), read_(read) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onGet() override {
+    Snapshot s;
+    usb_audio_bridge_stats().snapshot(&s);
+    return Result::okInt(read_(s));
+  }
+
+private:
+  const FieldSpec &spec_;
+  int (*read_)(const Snapshot &);
+};
+
+const FieldSpec OUT_KIB_SPEC{"out_kib", ValueType::Int, "KiB", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec IN_KIB_SPEC{"in_kib", ValueType::Int, "KiB", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec OUT_OVERFLOWS_SPEC{"out_overflows", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec IN_OVERFLOWS_SPEC{"in_overflows", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec OUT_UNDERRUNS_SPEC{"out_underruns", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec IN_UNDERRUNS_SPEC{"in_underruns", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec PREBUFFER_RESETS_SPEC{"prebuffer_resets", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec SEND_ERRORS_SPEC{"send_errors", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec FEEDBACK_MIN_SPEC{"feedback_min", ValueType::Int, "Q10.14", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec FEEDBACK_MAX_SPEC{"feedback_max", ValueType::Int, "Q10.14", nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+int send_errors(const Snapshot &s) {
+  uint32_t n = s.send_errors_other;
+  for (const BridgeStats::Errno &e : s.send_errors) {
+    n += e.count;
+  }
+  return counter(n);
+}
+
+StatCap g_out_kib{OUT_KIB_SPEC, [](const Snapshot &s) { return static_cast<int>(s.bytes[BridgeStats::kOut] >> 10); }};
+StatCap g_in_kib{IN_KIB_SPEC, [](const Snapshot &s) { return static_cast<int>(s.bytes[BridgeStats::kIn] >> 10); }};
+StatCap g_out_overflows{OUT_OVERFLOWS_SPEC, [](const Snapshot &s) { return counter(s.overflows[BridgeStats::kOut]); }};
+StatCap g_in_overflows{IN_OVERFLOWS_SPEC, [](const Snapshot &s) { return counter(s.overflows[BridgeStats::kIn]); }};
+StatCap g_out_underruns{OUT_UNDERRUNS_SPEC, [](const Snapshot &s) { return counter(s.underruns[BridgeStats::kOut]); }};
+StatCap g_in_underruns{IN_UNDERRUNS_SPEC, [](const Snapshot &s) { return counter(s.underruns[BridgeStats::kIn]); }};
+StatCap g_prebuffer_resets{PREBUFFER_RESETS_SPEC, [](const Snapshot &s) { return counter(s.prebuffer_resets); }};
+StatCap g_send_errors{SEND_ERRORS_SPEC, send_errors};
+StatCap g_feedback_min{FEEDBACK_MIN_SPEC, [](const Snapshot &s) { return static_cast<int>(s.feedback_min); }};
+StatCap g_feedback_max{FEEDBACK_MAX_SPEC, [](const Snapshot &s) { return static_cast<int>(s.feedback_max); }};
+
+Capability *const g_caps[] = {&g_out_kib, &g_in_kib, &g_out_overflows, &g_in_overflows, &g_out_underruns, &g_in_underruns, &g_prebuffer_resets, &g_send_errors,
+                              &g_feedback_min, &g_feedback_max};
+const Identity g_identity{"usb_audio_bridge", "uac2", "1"};
+Module g_module{g_identity, "usb_audio", g_caps};
+Module *const g_modules[] = {&g_module, &audio_module()};
+
+} // namespace
+
+std::span<mod::Module *const> mod::app_modules() { return g_modules; }
+
+#endif /* CONFIG_MODULE_SA818 */
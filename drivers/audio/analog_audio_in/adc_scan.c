@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+#include "adc_scan.h"
+
+#include "adc_pcm.h"
+
+void adc_scan_split(const uint16_t *src, size_t frames, uint8_t ranks, uint8_t resolution, int16_t *pcm, struct adc_scan_aux *aux) {
+  if (ranks <= 1U) {
+    for (size_t i = 0; i < frames; i++) {
+      pcm[i] = adc_to_pcm16(src[i], resolution);
+    }
+    return;
+  }
+  const uint8_t n_aux = (uint8_t)(ranks - 1U);
+  for (size_t i = 0; i < frames; i++) {
+    const uint16_t *frame = &src[i * ranks];
+    pcm[i] = adc_to_pcm16(frame[0], resolution);
+    for (uint8_t k = 0; k < n_aux; k++) {
+      aux->sum[k] += frame[1 + k];
+    }
+  }
+  aux->count += (uint32_t)frames;
+}
+
+bool adc_scan_take(struct adc_scan_aux *aux, uint8_t n_aux, uint32_t period, uint32_t *avg_q4) {
+  if (aux->count == 0U || aux->count < period) {
+    return false;
+  }
+  for (uint8_t k = 0; k < n_aux; k++) {
+    avg_q4[k] = (uint32_t)((((uint64_t)aux->sum[k] << 4) + aux->count / 2U) / aux->count);
+    aux->sum[k] = 0;
+  }
+  aux->count = 0;
+  return true;
+}
+
+/* Rescale a Q4 reading at @p from bits to Q4 at @p to bits. */
+static uint32_t rescale_q4(uint32_t q4, uint8_t from, uint8_t to) {
+  return from >= to ? q4 >> (from - to) : q4 << (to - from);
+}
+
+uint32_t adc_scan_vdda_mv(uint32_t vrefint_q4, uint8_t resolution, uint16_t cal, uint8_t cal_bits, uint16_t cal_mv) {
+  const uint32_t q4 = rescale_q4(vrefint_q4, resolution, cal_bits);
+  if (q4 == 0U) {
+    return 0;
+  }
+  /* VDDA = cal_mv * cal / reading; cal is Q0, the reading Q4. */
+  return (uint32_t)(((uint64_t)cal_mv * cal * 16U + q4 / 2U) / q4);
+}
+
+uint32_t adc_scan_mv(uint32_t avg_q4, uint8_t resolution, uint32_t vdda_mv) {
+  const uint64_t full_q4 = ((uint64_t)1 << resolution) * 16U - 16U; /* (2^res - 1) in Q4 */
+  return (uint32_t)(((uint64_t)avg_q4 * vdda_mv + full_q4 / 2U) / full_q4);
+}
+
+int32_t adc_scan_temp_dc(uint32_t ts_q4, uint8_t resolution, uint32_t vdda_mv, const struct adc_scan_ts_cal *cal) {
+  if (cal->cal2 == cal->cal1 || cal->vdd_mv == 0U) {
+    return 0;
+  }
+  /* Reading as it would have been at the calibration VDDA and resolution. */
+  const int64_t q4 = (int64_t)rescale_q4(ts_q4, resolution, cal->bits) * vdda_mv / cal->vdd_mv;
+  const int64_t span_dc = (int64_t)(cal->temp2_c - cal->temp1_c) * 10;
+  const int64_t num = (q4 - (int64_t)cal->cal1 * 16) * span_dc;
+  const int64_t den = ((int64_t)cal->cal2 - cal->cal1) * 16;
+  /* Round to nearest, either sign. */
+  const int64_t dc = (num >= 0 ? num + den / 2 : num - den / 2) / den;
+  return (int32_t)(cal->temp1_c * 10 + dc);
+}
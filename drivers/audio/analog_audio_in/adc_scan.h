@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Multi-rank ADC scan helpers for analog-audio-in: split a DMA half of
+ * [audio, aux0, aux1, ...] conversion frames into the PCM block and running
+ * sums of the auxiliary channels, and turn the averages into millivolts and
+ * temperature. Pure logic, unit-tested on native_sim and benchmarked on the
+ * host.
+ */
+#ifndef OE5XRX_ANALOG_AUDIO_IN_ADC_SCAN_H_
+#define OE5XRX_ANALOG_AUDIO_IN_ADC_SCAN_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Auxiliary ranks after the audio one (regular sequence of up to 5). */
+#define ADC_SCAN_AUX_MAX 4
+
+/** Longest averaging period: keeps the sums of 16-bit readings in 32 bits. */
+#define ADC_SCAN_PERIOD_MAX 32768U
+
+/** Running sums of the auxiliary channels (owned by the DMA interrupt). */
+struct adc_scan_aux {
+  uint32_t sum[ADC_SCAN_AUX_MAX];
+  uint32_t count; /* frames summed */
+};
+
+/**
+ * Deinterleave @p frames scan frames of @p ranks conversions each: rank 0
+ * becomes PCM in @p pcm (adc_to_pcm16), ranks 1.. are added to @p aux.
+ */
+void adc_scan_split(const uint16_t *src, size_t frames, uint8_t ranks, uint8_t resolution, int16_t *pcm, struct adc_scan_aux *aux);
+
+/**
+ * Once @p period frames are summed, write the averages of the first @p n_aux
+ * channels to @p avg_q4 (ADC counts, Q4: oversampling keeps the extra bits),
+ * restart the sums and return true; false otherwise.
+ */
+bool adc_scan_take(struct adc_scan_aux *aux, uint8_t n_aux, uint32_t period, uint32_t *avg_q4);
+
+/**
+ * Analog supply from the internal reference: @p vrefint_q4 read at
+ * @p resolution bits against the factory value @p cal taken at @p cal_bits
+ * bits with VDDA = @p cal_mv. 0 if @p vrefint_q4 is 0.
+ */
+uint32_t adc_scan_vdda_mv(uint32_t vrefint_q4, uint8_t resolution, uint16_t cal, uint8_t cal_bits, uint16_t cal_mv);
+
+/** Pin voltage of average @p avg_q4 at @p resolution bits with VDDA = @p vdda_mv. */
+uint32_t adc_scan_mv(uint32_t avg_q4, uint8_t resolution, uint32_t vdda_mv);
+
+/** Two-point factory calibration of the internal temperature sensor. */
+struct adc_scan_ts_cal {
+  uint16_t cal1; /* reading at temp1_c */
+  uint16_t cal2; /* reading at temp2_c */
+  int16_t temp1_c;
+  int16_t temp2_c;
+  uint8_t bits;    /* resolution the readings were taken at */
+  uint16_t vdd_mv; /* VDDA during calibration */
+};
+
+/**
+ * Die temperature in 0.1 degC from sensor average @p ts_q4 at @p resolution
+ * bits and VDDA = @p vdda_mv, interpolated on @p cal. 0 on a degenerate @p cal.
+ */
+int32_t adc_scan_temp_dc(uint32_t ts_q4, uint8_t resolution, uint32_t vdda_mv, const struct adc_scan_ts_cal *cal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_ANALOG_AUDIO_IN_ADC_SCAN_H_ */
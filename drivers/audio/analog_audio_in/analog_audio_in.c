@@ -5,8 +5,19 @@
 #define DT_DRV_COMPAT oe5xrx_analog_audio_in
 
 #include "adc_pcm.h"
+#include "adc_scan.h"
+#include "audio_dma_irq.h"
+#include "audio_workq.h"
+#include "irq_timing.h"
+#include "pcm_ring.h"
+#include "sync_start.h"
 
 #include <oe5xrx/audio/analog_audio_in.h>
+#if DT_HAS_COMPAT_STATUS_OKAY(oe5xrx_analog_audio_out) && IS_ENABLED(CONFIG_ANALOG_AUDIO_OUT)
+#include <oe5xrx/audio/analog_audio_sync.h>
+/* Playback nodes may run off a capture's sampling timer (sync-source). */
+#define AAI_HAVE_SYNC 1
+#endif
 #include <stm32_ll_adc.h>
 #include <stm32_ll_tim.h>
 #include <zephyr/device.h>
@@ -21,14 +32,30 @@ LOG_MODULE_REGISTER(analog_audio_in, CONFIG_ANALOG_AUDIO_IN_LOG_LEVEL);
 
 /* Max samples per DMA half-buffer; the circular buffer is 2x this. */
 #define AAI_MAX_BLOCK 16
-/* Depth of the ISR->thread hand-off queue, in blocks (~1 ms each at 8 kHz). */
-#define AAI_MSGQ_BLOCKS 16
+BUILD_ASSERT(AAI_MAX_BLOCK <= PCM_RING_BLOCK_MAX, "a DMA half must fit a ring block");
+/* Regular sequence: the audio rank plus up to ADC_SCAN_AUX_MAX auxiliary ones. */
+#define AAI_MAX_RANKS (1 + ADC_SCAN_AUX_MAX)
+BUILD_ASSERT(ANALOG_AUDIO_IN_AUX_MAX == ADC_SCAN_AUX_MAX, "public and scan aux limits differ");
+/* ADC clock cycles per conversion: LL_ADC_SAMPLINGTIME_391CYCLES_5 plus the
+ * successive approximation (12.5 at 12 bits, 17.5 at 14), rounded up. */
+#define AAI_CONVERSION_CYCLES 409U
+/* STM32U5 factory calibration (VREFINT, temperature sensor) is taken by ADC1 at 14 bits. */
+#define AAI_CAL_BITS 14U
+#ifndef LL_ADC_DELAY_TEMPSENSOR_STAB_US
+#define LL_ADC_DELAY_TEMPSENSOR_STAB_US 15U
+#endif
 
 struct aai_config {
   uint32_t sampling_frequency;
   uint16_t block_samples;
   uint8_t resolution;
   uint32_t adc_ll_channel; /* LL_ADC_CHANNEL_x derived from io-channels */
+  /* io-channels[1..]: converted after the audio rank on every trigger. */
+  uint8_t n_aux;
+  uint32_t aux_ll_channel[ADC_SCAN_AUX_MAX];
+  const char *aux_name[ADC_SCAN_AUX_MAX];
+  uint32_t aux_period; /* aux-average-samples */
+  uint16_t vref_mv;    /* VDDA assumed without a VREFINT aux channel */
   TIM_TypeDef *tim;
   ADC_TypeDef *adc;
   const struct stm32_pclken *tim_pclken; /* [0]=bus enable, [1]=kernel clock */
@@ -36,6 +63,11 @@ struct aai_config {
   const struct device *dma_dev;
   uint32_t dma_channel;
   uint32_t dma_slot;
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  unsigned int dma_irq;      /* NVIC line of dma_channel */
+  unsigned int doorbell_irq; /* NVIC line pended by the ZLI handler */
+  void (*irq_config)(void);
+#endif
 };
 
 struct aai_data {
@@ -43,13 +75,23 @@ struct aai_data {
   analog_audio_in_cb cb;
   void *user_data;
   atomic_t running;                    /* written from thread (start/stop), read from DMA ISR */
-  uint16_t dma_buf[2 * AAI_MAX_BLOCK]; /* circular: [0..block) | [block..2*block) */
-  /* ISR -> thread hand-off: the DMA callback runs in ISR context but the
-   * consumer callback may block (e.g. take a mutex), so blocks of converted PCM
-   * are queued here and delivered from the system workqueue thread. */
-  struct k_msgq rx_msgq;
-  char msgq_buf[AAI_MSGQ_BLOCKS * AAI_MAX_BLOCK * sizeof(int16_t)] __aligned(sizeof(void *));
+  /* circular: [0..block) | [block..2*block) scan frames of 1 + n_aux ranks */
+  uint16_t dma_buf[2 * AAI_MAX_BLOCK * AAI_MAX_RANKS];
+  /* Auxiliary sums, owned by the DMA interrupt; the averages it publishes
+   * are read by get_aux() in thread context. */
+  struct adc_scan_aux aux_acc;
+  atomic_t aux_q4[ADC_SCAN_AUX_MAX];
+  atomic_t aux_updates;
+  enum analog_audio_in_aux_kind aux_kind[ADC_SCAN_AUX_MAX];
+  /* ISR -> thread hand-off: the DMA interrupt converts into the ring, but the
+   * consumer callback may block (e.g. take a mutex), so the blocks are
+   * delivered from the audio work queue thread. Lock-free, so the producer
+   * may also be the zero-latency handler. */
+  struct pcm_ring ring;
   struct k_work drain_work;
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  struct irq_timing irq_timing;
+#endif
   struct dma_config dma_cfg;
   struct dma_block_config blk;
 };
@@ -65,16 +107,16 @@ struct aai_data {
     (cond) ? 0 : -ETIMEDOUT;                                                                                                                                   \
   })
 
-/* System-workqueue handler: drain queued PCM blocks and deliver them to the
+/* Audio work queue handler: drain queued PCM blocks and deliver them to the
  * consumer in thread context (safe to block/take a mutex). */
 static void aai_drain_work(struct k_work *work) {
   struct aai_data *data = CONTAINER_OF(work, struct aai_data, drain_work);
   const struct aai_config *cfg = data->self->config;
-  int16_t block[AAI_MAX_BLOCK];
+  const int16_t *block;
 
-  while (k_msgq_get(&data->rx_msgq, block, K_NO_WAIT) == 0) {
+  while ((block = pcm_ring_peek(&data->ring)) != NULL) {
     /* Stop delivering as soon as stop() clears running, so at most the block
-     * already dequeued here can reach the consumer after stop() (not the whole
+     * being delivered here can reach the consumer after stop() (not the whole
      * backlog). */
     if (!atomic_get(&data->running)) {
       break;
@@ -87,42 +129,104 @@ static void aai_drain_work(struct k_work *work) {
     if (cb != NULL) {
       cb(block, cfg->block_samples, user);
     }
+    pcm_ring_release(&data->ring);
   }
 }
 
+/* First thing in either DMA handler: stamp the entry for the jitter stats. */
+static inline void aai_irq_mark(struct aai_data *data) {
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  irq_timing_mark(&data->irq_timing, audio_dma_irq_cycles());
+#else
+  ARG_UNUSED(data);
+#endif
+}
+
+/* Convert buffer half @p half (0 = first) into the next ring slot and add its
+ * auxiliary ranks to the running averages. Interrupt context, no kernel calls.
+ * Drops the block if the ring is full (consumer not keeping up; counted)
+ * rather than stall the ISR; its auxiliary readings are dropped with it.
+ * @return true if a block was queued. */
+static bool aai_push_half(const struct device *dev, uint32_t half) {
+  const struct aai_config *cfg = dev->config;
+  struct aai_data *data = dev->data;
+
+  if (!atomic_get(&data->running)) {
+    return false;
+  }
+  int16_t *dst = pcm_ring_claim(&data->ring);
+  if (dst == NULL) {
+    return false;
+  }
+  const uint8_t ranks = 1U + cfg->n_aux;
+  adc_scan_split(&data->dma_buf[half * cfg->block_samples * ranks], cfg->block_samples, ranks, cfg->resolution, dst, &data->aux_acc);
+  pcm_ring_commit(&data->ring);
+
+  uint32_t avg_q4[ADC_SCAN_AUX_MAX];
+  if (cfg->n_aux > 0U && adc_scan_take(&data->aux_acc, cfg->n_aux, cfg->aux_period, avg_q4)) {
+    for (uint8_t k = 0; k < cfg->n_aux; k++) {
+      atomic_set(&data->aux_q4[k], (atomic_val_t)avg_q4[k]);
+    }
+    atomic_inc(&data->aux_updates);
+  }
+  return true;
+}
+
 static void aai_dma_cb(const struct device *dma_dev, void *user, uint32_t channel, int status) {
   const struct device *dev = user;
-  const struct aai_config *cfg = dev->config;
   struct aai_data *data = dev->data;
-  int16_t block[AAI_MAX_BLOCK];
 
   ARG_UNUSED(dma_dev);
   ARG_UNUSED(channel);
 
-  if (!atomic_get(&data->running)) {
-    return;
-  }
+  aai_irq_mark(data);
   /* Only the half/full-transfer completions carry a ready buffer half.
    * DMA_STATUS_BLOCK = first half ready, DMA_STATUS_COMPLETE = second half.
    * Ignore errors (status < 0) and any other/unexpected status so we never
    * read from the wrong half and enqueue corrupted samples. */
-  const uint16_t *src;
+  uint32_t half;
   if (status == DMA_STATUS_BLOCK) {
-    src = &data->dma_buf[0];
+    half = 0;
   } else if (status == DMA_STATUS_COMPLETE) {
-    src = &data->dma_buf[cfg->block_samples];
+    half = 1;
   } else {
     return;
   }
-  for (uint16_t i = 0; i < cfg->block_samples; i++) {
-    block[i] = adc_to_pcm16(src[i], cfg->resolution);
+  if (aai_push_half(dev, half)) {
+    audio_workq_submit(&data->drain_work);
   }
-  /* Hand off to the workqueue thread; drop the block if the queue is full
-   * (consumer not keeping up) rather than block the ISR. */
-  if (k_msgq_put(&data->rx_msgq, block, K_NO_WAIT) == 0) {
-    k_work_submit(&data->drain_work);
+}
+
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+/* Zero-latency DMA handler, installed over the dma_stm32u5 one at start (see
+ * audio_dma_irq.h). Must not enter the kernel: the block goes into the ring
+ * and the doorbell interrupt submits the drain work. Both halves pending means
+ * the handler was held off a whole block; they are queued in buffer order. */
+static void aai_zli_isr(const void *arg) {
+  const struct device *dev = arg;
+  const struct aai_config *cfg = dev->config;
+  struct aai_data *data = dev->data;
+
+  aai_irq_mark(data);
+  const uint32_t ev = audio_dma_irq_ack(cfg->dma_channel);
+  bool queued = false;
+  if ((ev & AUDIO_DMA_IRQ_HALF) != 0U) {
+    queued |= aai_push_half(dev, 0);
   }
+  if ((ev & AUDIO_DMA_IRQ_FULL) != 0U) {
+    queued |= aai_push_half(dev, 1);
+  }
+  if (queued) {
+    NVIC_SetPendingIRQ((IRQn_Type)cfg->doorbell_irq);
+  }
+}
+
+static void aai_doorbell_isr(const struct device *dev) {
+  struct aai_data *data = dev->data;
+
+  audio_workq_submit(&data->drain_work);
 }
+#endif /* CONFIG_ANALOG_AUDIO_DMA_ZLI */
 
 static uint32_t aai_ll_resolution(uint8_t bits) {
   switch (bits) {
@@ -141,8 +245,68 @@ static uint32_t aai_ll_resolution(uint8_t bits) {
   }
 }
 
+/* Sequencer length for @p ranks (1..AAI_MAX_RANKS). */
+static uint32_t aai_ll_seq_length(uint8_t ranks) {
+  static const uint32_t len[AAI_MAX_RANKS] = {LL_ADC_REG_SEQ_SCAN_DISABLE, LL_ADC_REG_SEQ_SCAN_ENABLE_2RANKS, LL_ADC_REG_SEQ_SCAN_ENABLE_3RANKS,
+                                              LL_ADC_REG_SEQ_SCAN_ENABLE_4RANKS, LL_ADC_REG_SEQ_SCAN_ENABLE_5RANKS};
+  return len[ranks - 1U];
+}
+
+static const uint32_t aai_ll_rank[AAI_MAX_RANKS] = {LL_ADC_REG_RANK_1, LL_ADC_REG_RANK_2, LL_ADC_REG_RANK_3, LL_ADC_REG_RANK_4, LL_ADC_REG_RANK_5};
+
+/* Internal measurement path an auxiliary channel needs switched on. */
+static uint32_t aai_aux_path(enum analog_audio_in_aux_kind kind) {
+  switch (kind) {
+  case ANALOG_AUDIO_IN_AUX_VREFINT:
+    return LL_ADC_PATH_INTERNAL_VREFINT;
+  case ANALOG_AUDIO_IN_AUX_TEMP:
+    return LL_ADC_PATH_INTERNAL_TEMPSENSOR;
+  case ANALOG_AUDIO_IN_AUX_VBAT:
+    return LL_ADC_PATH_INTERNAL_VBAT;
+  default:
+    return LL_ADC_PATH_INTERNAL_NONE;
+  }
+}
+
+static enum analog_audio_in_aux_kind aai_aux_kind(uint32_t ll_channel) {
+  const uint32_t nb = __LL_ADC_CHANNEL_TO_DECIMAL_NB(ll_channel);
+
+  if (nb == __LL_ADC_CHANNEL_TO_DECIMAL_NB(LL_ADC_CHANNEL_VREFINT)) {
+    return ANALOG_AUDIO_IN_AUX_VREFINT;
+  }
+  if (nb == __LL_ADC_CHANNEL_TO_DECIMAL_NB(LL_ADC_CHANNEL_TEMPSENSOR)) {
+    return ANALOG_AUDIO_IN_AUX_TEMP;
+  }
+  if (nb == __LL_ADC_CHANNEL_TO_DECIMAL_NB(LL_ADC_CHANNEL_VBAT)) {
+    return ANALOG_AUDIO_IN_AUX_VBAT;
+  }
+  return ANALOG_AUDIO_IN_AUX_PIN;
+}
+
+/* Every rank converts after each trigger, so the whole scan must finish
+ * within one sample period or the next trigger is missed. */
+static int aai_check_scan_time(const struct device *dev) {
+  const struct aai_config *cfg = dev->config;
+  const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
+  const uint8_t ranks = 1U + cfg->n_aux;
+  uint32_t adc_clk = 0;
+
+  if (clock_control_get_rate(clk, (clock_control_subsys_t)&cfg->adc_pclken[1], &adc_clk) < 0 || adc_clk == 0U) {
+    LOG_WRN("adc kernel clock rate unavailable, scan time of %u ranks unchecked", ranks);
+    return 0;
+  }
+  /* LL_ADC_CLOCK_ASYNC_DIV2 (aai_adc_setup). */
+  const uint64_t needed = (uint64_t)ranks * AAI_CONVERSION_CYCLES * cfg->sampling_frequency;
+  if (needed > adc_clk / 2U) {
+    LOG_ERR("%u ranks need %llu ADC cycles/s, have %u", ranks, (unsigned long long)needed, adc_clk / 2U);
+    return -EINVAL;
+  }
+  return 0;
+}
+
 static int aai_adc_setup(const struct device *dev) {
   const struct aai_config *cfg = dev->config;
+  struct aai_data *data = dev->data;
   const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
   ADC_TypeDef *adc = cfg->adc;
   int r;
@@ -168,9 +332,11 @@ static int aai_adc_setup(const struct device *dev) {
     return r;
   }
 
-  /* One-channel regular sequence on the DT-selected channel, TIM6-TRGO triggered. */
+  /* Regular sequence of the audio channel then the auxiliary ones, TIM6-TRGO
+   * triggered: the audio rank converts right at the trigger, so its timing
+   * does not depend on the auxiliary ranks that follow. */
   LL_ADC_SetResolution(adc, aai_ll_resolution(cfg->resolution));
-  LL_ADC_REG_SetSequencerLength(adc, LL_ADC_REG_SEQ_SCAN_DISABLE);
+  LL_ADC_REG_SetSequencerLength(adc, aai_ll_seq_length(1U + cfg->n_aux));
   /* STM32U5: the channel must be enabled in PCSEL to connect the analog input,
    * otherwise conversions return a fixed value instead of the pin voltage. This
    * is set here (not delegated to the co-bound Zephyr adc driver) so capture
@@ -178,6 +344,18 @@ static int aai_adc_setup(const struct device *dev) {
   LL_ADC_SetChannelPreselection(adc, cfg->adc_ll_channel);
   LL_ADC_REG_SetSequencerRanks(adc, LL_ADC_REG_RANK_1, cfg->adc_ll_channel);
   LL_ADC_SetChannelSamplingTime(adc, cfg->adc_ll_channel, LL_ADC_SAMPLINGTIME_391CYCLES_5);
+  uint32_t paths = LL_ADC_PATH_INTERNAL_NONE;
+  for (uint8_t k = 0; k < cfg->n_aux; k++) {
+    LL_ADC_SetChannelPreselection(adc, cfg->aux_ll_channel[k]);
+    LL_ADC_REG_SetSequencerRanks(adc, aai_ll_rank[1 + k], cfg->aux_ll_channel[k]);
+    /* The long sampling time also covers the internal sensors (>= 5 us). */
+    LL_ADC_SetChannelSamplingTime(adc, cfg->aux_ll_channel[k], LL_ADC_SAMPLINGTIME_391CYCLES_5);
+    paths |= aai_aux_path(data->aux_kind[k]);
+  }
+  if (paths != LL_ADC_PATH_INTERNAL_NONE) {
+    LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(adc), paths);
+    k_busy_wait(LL_ADC_DELAY_TEMPSENSOR_STAB_US);
+  }
   LL_ADC_REG_SetTriggerSource(adc, LL_ADC_REG_TRIG_EXT_TIM6_TRGO);
   LL_ADC_REG_SetTriggerEdge(adc, LL_ADC_REG_TRIG_EXT_RISING);
   /* UNLIMITED: keep issuing a DMA request per TRGO-triggered conversion so the
@@ -203,7 +381,7 @@ static int aai_dma_start(const struct device *dev) {
   data->blk = (struct dma_block_config){0};
   data->blk.source_address = LL_ADC_DMA_GetRegAddr(cfg->adc, LL_ADC_DMA_REG_REGULAR_DATA);
   data->blk.dest_address = (uint32_t)(uintptr_t)data->dma_buf;
-  data->blk.block_size = sizeof(uint16_t) * 2U * cfg->block_samples;
+  data->blk.block_size = sizeof(uint16_t) * 2U * cfg->block_samples * (1U + cfg->n_aux);
   data->blk.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
   data->blk.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
   data->blk.source_reload_en = 1; /* GPDMA "emulated circular" */
@@ -226,10 +404,14 @@ static int aai_dma_start(const struct device *dev) {
     LOG_ERR("dma_config: %d", r);
     return r;
   }
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  audio_dma_irq_connect_zli(cfg->dma_irq, aai_zli_isr, dev);
+#endif
   return dma_start(cfg->dma_dev, cfg->dma_channel);
 }
 
-static int aai_timer_start(const struct device *dev) {
+/* Configure the sampling timer; leave it stopped unless @p run. */
+static int aai_timer_start(const struct device *dev, bool run) {
   const struct aai_config *cfg = dev->config;
   const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
   uint32_t tim_clk = 0;
@@ -251,9 +433,14 @@ static int aai_timer_start(const struct device *dev) {
   }
   LL_TIM_SetPrescaler(cfg->tim, 0);
   LL_TIM_SetAutoReload(cfg->tim, div - 1U);
+  /* Buffer ARR so a period trim (analog_audio_in_set_period) only takes
+   * effect at the next update and never cuts a sample period short. */
+  LL_TIM_EnableARRPreload(cfg->tim);
   LL_TIM_SetTriggerOutput(cfg->tim, LL_TIM_TRGO_UPDATE);
   LL_TIM_GenerateEvent_UPDATE(cfg->tim);
-  LL_TIM_EnableCounter(cfg->tim);
+  if (run) {
+    LL_TIM_EnableCounter(cfg->tim);
+  }
   return 0;
 }
 
@@ -261,16 +448,19 @@ static int aai_timer_start(const struct device *dev) {
  * calibrated/clocked behind after a partial bring-up). */
 static void aai_adc_disable(ADC_TypeDef *adc) {
   LL_ADC_Disable(adc);
+  LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(adc), LL_ADC_PATH_INTERNAL_NONE);
   LL_ADC_DisableInternalRegulator(adc);
 }
 
-int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void *user_data) {
+/* Bring up capture; the sampling timer only runs if @p run (else the caller
+ * starts it, see analog_audio_sync_start()). */
+static int aai_start(const struct device *dev, analog_audio_in_cb cb, void *user_data, bool run) {
   const struct aai_config *cfg = dev->config;
   struct aai_data *data = dev->data;
   int r;
 
   /* Guard against a never-initialised device (aai_init failed => not ready):
-   * rx_msgq/drain_work would be uninitialised and purging them is UB. */
+   * drain_work would be uninitialised. */
   if (!device_is_ready(dev)) {
     return -ENODEV;
   }
@@ -282,9 +472,22 @@ int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void
   }
   data->cb = cb;
   data->user_data = user_data;
-  k_msgq_purge(&data->rx_msgq);
+  /* The drain work is the ring's only consumer: let a run left over from the
+   * previous capture finish before the ring is emptied under it. */
+  struct k_work_sync sync;
+  (void)k_work_cancel_sync(&data->drain_work, &sync);
+  pcm_ring_reset(&data->ring);
+  data->aux_acc = (struct adc_scan_aux){0};
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  irq_timing_reset(&data->irq_timing, audio_dma_irq_nominal(cfg->sampling_frequency, cfg->block_samples));
+#endif
   atomic_set(&data->running, 1);
 
+  r = cfg->n_aux > 0U ? aai_check_scan_time(dev) : 0;
+  if (r < 0) {
+    atomic_set(&data->running, 0);
+    return r;
+  }
   r = aai_adc_setup(dev);
   if (r < 0) {
     aai_adc_disable(cfg->adc);
@@ -297,7 +500,7 @@ int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void
     atomic_set(&data->running, 0);
     return r;
   }
-  r = aai_timer_start(dev);
+  r = aai_timer_start(dev, run);
   if (r < 0) {
     dma_stop(cfg->dma_dev, cfg->dma_channel);
     aai_adc_disable(cfg->adc);
@@ -309,13 +512,30 @@ int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void
   return 0;
 }
 
+int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void *user_data) {
+  return aai_start(dev, cb, user_data, true);
+}
+
+int analog_audio_in_set_period(const struct device *dev, uint32_t ticks) {
+  const struct aai_config *cfg = dev->config;
+  struct aai_data *data = dev->data;
+
+  if (!device_is_ready(dev) || ticks == 0U || ticks > 0x10000U) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+  LL_TIM_SetAutoReload(cfg->tim, ticks - 1U);
+  return 0;
+}
+
 int analog_audio_in_stop(const struct device *dev) {
   const struct aai_config *cfg = dev->config;
   struct aai_data *data = dev->data;
 
-  /* Guard against a never-initialised device: rx_msgq is only valid once
-   * aai_init() succeeded, and callers (SA818 stream stop) invoke this
-   * unconditionally, so purging an uninitialised msgq would be UB. */
+  /* Guard against a never-initialised device: callers (SA818 stream stop)
+   * invoke this unconditionally. */
   if (!device_is_ready(dev)) {
     return -ENODEV;
   }
@@ -332,15 +552,164 @@ int analog_audio_in_stop(const struct device *dev) {
     dma_stop(cfg->dma_dev, cfg->dma_channel);
     aai_adc_disable(cfg->adc);
   }
-  /* Drop queued blocks and clear the callback (even if never started). Combined
-   * with the running check in aai_drain_work, at most one already-dequeued block
-   * can still reach the consumer after this returns. */
-  k_msgq_purge(&data->rx_msgq);
+  /* Clear the callback (even if never started); queued blocks are dropped by
+   * the next start(). Combined with the running check in aai_drain_work, at
+   * most the block being delivered can still reach the consumer after this
+   * returns. */
   data->cb = NULL;
   data->user_data = NULL;
   return 0;
 }
 
+int analog_audio_in_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats) {
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  struct aai_data *data = dev->data;
+
+  if (!device_is_ready(dev) || stats == NULL) {
+    return -EINVAL;
+  }
+  audio_dma_irq_stats(&data->irq_timing, pcm_ring_overruns(&data->ring), stats);
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(stats);
+  return -ENOTSUP;
+#endif
+}
+
+int analog_audio_in_get_aux(const struct device *dev, uint8_t index, struct analog_audio_in_aux *aux) {
+  const struct aai_config *cfg = dev->config;
+  struct aai_data *data = dev->data;
+
+  if (!device_is_ready(dev) || aux == NULL) {
+    return -EINVAL;
+  }
+  if (index >= cfg->n_aux) {
+    return -ENOENT;
+  }
+  const uint32_t updates = (uint32_t)atomic_get(&data->aux_updates);
+  if (updates == 0U) {
+    return -EAGAIN;
+  }
+  /* VDDA from the internal reference when it is scanned, else from DT. */
+  uint32_t vdda_mv = cfg->vref_mv;
+  for (uint8_t k = 0; k < cfg->n_aux; k++) {
+    if (data->aux_kind[k] == ANALOG_AUDIO_IN_AUX_VREFINT) {
+      const uint32_t mv = adc_scan_vdda_mv((uint32_t)atomic_get(&data->aux_q4[k]), cfg->resolution, *VREFINT_CAL_ADDR, AAI_CAL_BITS, VREFINT_CAL_VREF);
+      vdda_mv = mv != 0U ? mv : vdda_mv;
+      break;
+    }
+  }
+
+  const uint32_t q4 = (uint32_t)atomic_get(&data->aux_q4[index]);
+  *aux = (struct analog_audio_in_aux){
+      .name = cfg->aux_name[index],
+      .kind = data->aux_kind[index],
+      .raw_q4 = q4,
+      .millivolts = adc_scan_mv(q4, cfg->resolution, vdda_mv),
+      .vdda_mv = vdda_mv,
+      .updates = updates,
+  };
+  if (aux->kind == ANALOG_AUDIO_IN_AUX_VBAT) {
+    aux->millivolts *= 4U; /* internal VBAT/4 bridge */
+  } else if (aux->kind == ANALOG_AUDIO_IN_AUX_TEMP) {
+    const struct adc_scan_ts_cal cal = {
+        .cal1 = *TEMPSENSOR_CAL1_ADDR,
+        .cal2 = *TEMPSENSOR_CAL2_ADDR,
+        .temp1_c = TEMPSENSOR_CAL1_TEMP,
+        .temp2_c = TEMPSENSOR_CAL2_TEMP,
+        .bits = AAI_CAL_BITS,
+        .vdd_mv = TEMPSENSOR_CAL_VREFANALOG,
+    };
+    aux->temp_dc = adc_scan_temp_dc(q4, cfg->resolution, vdda_mv, &cal);
+  }
+  return 0;
+}
+
+#ifdef AAI_HAVE_SYNC
+struct aai_sync_pair {
+  const struct device *in;
+  const struct device *out;
+};
+
+#define AAI_SYNC_PAIR(node) COND_CODE_1(DT_NODE_HAS_PROP(node, sync_source), ({DEVICE_DT_GET(DT_PHANDLE(node, sync_source)), DEVICE_DT_GET(node)}, ), ())
+
+static const struct aai_sync_pair aai_sync_pairs[] = {DT_FOREACH_STATUS_OKAY(oe5xrx_analog_audio_out, AAI_SYNC_PAIR){NULL, NULL}};
+
+static bool aai_sync_paired(const struct device *in, const struct device *out) {
+  for (const struct aai_sync_pair *p = aai_sync_pairs; p->in != NULL; p++) {
+    if (p->in == in && p->out == out) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct aai_sync_ctx {
+  const struct device *in;
+  const struct device *out;
+  analog_audio_in_cb in_cb;
+  void *in_user;
+  analog_audio_out_src out_src;
+  void *out_user;
+};
+
+static int aai_sync_arm_in(void *p) {
+  const struct aai_sync_ctx *c = p;
+  return aai_start(c->in, c->in_cb, c->in_user, false);
+}
+
+static int aai_sync_arm_out(void *p) {
+  const struct aai_sync_ctx *c = p;
+  return analog_audio_out_start(c->out, c->out_src, c->out_user);
+}
+
+static void aai_sync_run(void *p) {
+  const struct aai_sync_ctx *c = p;
+  const struct aai_config *cfg = c->in->config;
+  LL_TIM_EnableCounter(cfg->tim);
+}
+
+static int aai_sync_stop_in(void *p) {
+  const struct aai_sync_ctx *c = p;
+  return analog_audio_in_stop(c->in);
+}
+
+static int aai_sync_stop_out(void *p) {
+  const struct aai_sync_ctx *c = p;
+  return analog_audio_out_stop(c->out);
+}
+
+static const struct sync_start_ops aai_sync_ops = {
+    .arm_in = aai_sync_arm_in,
+    .arm_out = aai_sync_arm_out,
+    .run = aai_sync_run,
+    .stop_in = aai_sync_stop_in,
+    .stop_out = aai_sync_stop_out,
+};
+
+int analog_audio_sync_start(const struct device *in, analog_audio_in_cb in_cb, void *in_user, const struct device *out, analog_audio_out_src out_src,
+                            void *out_user) {
+  if (in == NULL || out == NULL || !aai_sync_paired(in, out)) {
+    return -EINVAL;
+  }
+  struct aai_sync_ctx c = {in, out, in_cb, in_user, out_src, out_user};
+  const int r = sync_start(&aai_sync_ops, &c);
+  if (r == 0) {
+    LOG_INF("capture and playback started on one clock");
+  }
+  return r;
+}
+
+int analog_audio_sync_stop(const struct device *in, const struct device *out) {
+  if (in == NULL || out == NULL || !aai_sync_paired(in, out)) {
+    return -EINVAL;
+  }
+  struct aai_sync_ctx c = {.in = in, .out = out};
+  return sync_stop(&aai_sync_ops, &c);
+}
+#endif /* AAI_HAVE_SYNC */
+
 static int aai_init(const struct device *dev) {
   const struct aai_config *cfg = dev->config;
   struct aai_data *data = dev->data;
@@ -365,18 +734,60 @@ static int aai_init(const struct device *dev) {
     LOG_ERR("unsupported resolution %u (need 6/8/10/12/14)", cfg->resolution);
     return -EINVAL;
   }
+  if (cfg->n_aux > 0U && (cfg->aux_period == 0U || cfg->aux_period > ADC_SCAN_PERIOD_MAX)) {
+    LOG_ERR("aux-average-samples %u out of range (1..%u)", cfg->aux_period, ADC_SCAN_PERIOD_MAX);
+    return -EINVAL;
+  }
   if (!device_is_ready(cfg->dma_dev)) {
     LOG_ERR("dma device not ready");
     return -ENODEV;
   }
+  for (uint8_t k = 0; k < cfg->n_aux; k++) {
+    data->aux_kind[k] = aai_aux_kind(cfg->aux_ll_channel[k]);
+    LOG_INF("aux %u: %s (channel %u)", k, cfg->aux_name[k], __LL_ADC_CHANNEL_TO_DECIMAL_NB(cfg->aux_ll_channel[k]));
+  }
   data->self = dev;
-  /* Size the queue element to the configured block so put()/get() copy exactly
-   * block_samples and never carry uninitialized tail bytes of the ISR buffer. */
-  k_msgq_init(&data->rx_msgq, data->msgq_buf, cfg->block_samples * sizeof(int16_t), AAI_MSGQ_BLOCKS);
   k_work_init(&data->drain_work, aai_drain_work);
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  audio_dma_irq_cycles_init();
+#endif
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  cfg->irq_config();
+#endif
   return 0;
 }
 
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+/* The ZLI handler acks the channel through LL on GPDMA1 and pends the node's
+ * own interrupt as its doorbell; both must exist. */
+#define AAI_ZLI_DEFINE(inst)                                                                                                                                   \
+  BUILD_ASSERT(DT_SAME_NODE(DT_INST_DMAS_CTLR_BY_NAME(inst, rx), DT_NODELABEL(gpdma1)),                                                                        \
+               "CONFIG_ANALOG_AUDIO_DMA_ZLI: analog-audio-in rx DMA controller must be GPDMA1");                                                               \
+  BUILD_ASSERT(DT_INST_IRQ_HAS_IDX(inst, 0), "CONFIG_ANALOG_AUDIO_DMA_ZLI: analog-audio-in needs a doorbell interrupt");                                       \
+  static void aai_irq_config_##inst(void) {                                                                                                                    \
+    IRQ_CONNECT(DT_INST_IRQN(inst), DT_INST_IRQ(inst, priority), aai_doorbell_isr, DEVICE_DT_INST_GET(inst), 0);                                               \
+    irq_enable(DT_INST_IRQN(inst));                                                                                                                            \
+  }
+#define AAI_ZLI_CFG(inst)                                                                                                                                      \
+  .dma_irq = DT_IRQ_BY_IDX(DT_INST_DMAS_CTLR_BY_NAME(inst, rx), DT_INST_DMAS_CELL_BY_NAME(inst, rx, channel), irq),                                            \
+  .doorbell_irq = DT_INST_IRQN(inst), .irq_config = aai_irq_config_##inst,
+#else
+#define AAI_ZLI_DEFINE(inst)
+#define AAI_ZLI_CFG(inst)
+#endif
+
+/* io-channels[1..] and their names; all on the audio channel's ADC. */
+#define AAI_N_AUX(inst) UTIL_DEC(DT_INST_PROP_LEN(inst, io_channels))
+#define AAI_AUX_CHANNEL(idx, inst) [idx] = __LL_ADC_DECIMAL_NB_TO_CHANNEL(DT_INST_IO_CHANNELS_INPUT_BY_IDX(inst, UTIL_INC(idx)))
+#define AAI_AUX_NAME(idx, inst) [idx] = DT_INST_PROP_BY_IDX(inst, io_channel_names, UTIL_INC(idx))
+#define AAI_AUX_SAME_ADC(idx, inst)                                                                                                                            \
+  BUILD_ASSERT(DT_SAME_NODE(DT_INST_IO_CHANNELS_CTLR_BY_IDX(inst, UTIL_INC(idx)), DT_INST_IO_CHANNELS_CTLR(inst)),                                             \
+               "analog-audio-in auxiliary io-channels must be on the audio channel's ADC");
+#define AAI_AUX_CFG(inst)                                                                                                                                      \
+  .n_aux = AAI_N_AUX(inst), .aux_ll_channel = {LISTIFY(AAI_N_AUX(inst), AAI_AUX_CHANNEL, (, ), inst)},                                                         \
+  .aux_name = {LISTIFY(AAI_N_AUX(inst), AAI_AUX_NAME, (, ), inst)}, .aux_period = DT_INST_PROP(inst, aux_average_samples),                                     \
+  .vref_mv = DT_INST_PROP(inst, vref_mv),
+
 #define AAI_INIT(inst)                                                                                                                                         \
   /* The ADC regular trigger is hardcoded to TIM6-TRGO (aai_adc_setup), so the                                                                                 \
    * DT-selected sampling-timer must be TIM6. Enforce at build time via node                                                                                   \
@@ -384,6 +795,11 @@ static int aai_init(const struct device *dev) {
    * because TIM6 aliases to different secure/non-secure addresses on STM32U5). */                                                                             \
   BUILD_ASSERT(DT_SAME_NODE(DT_INST_PHANDLE(inst, sampling_timer), DT_NODELABEL(timers6)),                                                                     \
                "analog-audio-in sampling-timer must be TIM6 (ADC trigger is hardcoded to TIM6-TRGO)");                                                         \
+  BUILD_ASSERT(AAI_N_AUX(inst) <= ADC_SCAN_AUX_MAX, "analog-audio-in supports up to 4 auxiliary io-channels");                                                 \
+  BUILD_ASSERT(AAI_N_AUX(inst) == 0 || DT_INST_PROP_LEN_OR(inst, io_channel_names, 0) == DT_INST_PROP_LEN(inst, io_channels),                                  \
+               "analog-audio-in auxiliary io-channels need io-channel-names");                                                                                 \
+  LISTIFY(AAI_N_AUX(inst), AAI_AUX_SAME_ADC, (), inst)                                                                                                         \
+  AAI_ZLI_DEFINE(inst)                                                                                                                                         \
   static const struct stm32_pclken aai_tim_pclken_##inst[] = STM32_DT_CLOCKS(DT_INST_PHANDLE(inst, sampling_timer));                                           \
   static const struct stm32_pclken aai_adc_pclken_##inst[] = STM32_DT_CLOCKS(DT_INST_IO_CHANNELS_CTLR(inst));                                                  \
   static const struct aai_config aai_cfg_##inst = {                                                                                                            \
@@ -391,6 +807,7 @@ static int aai_init(const struct device *dev) {
       .block_samples = DT_INST_PROP(inst, block_samples),                                                                                                      \
       .resolution = DT_INST_PROP(inst, resolution),                                                                                                            \
       .adc_ll_channel = __LL_ADC_DECIMAL_NB_TO_CHANNEL(DT_INST_IO_CHANNELS_INPUT(inst)),                                                                       \
+      AAI_AUX_CFG(inst)                                                                                                                                        \
       .tim = (TIM_TypeDef *)DT_REG_ADDR(DT_INST_PHANDLE(inst, sampling_timer)),                                                                                \
       .adc = (ADC_TypeDef *)DT_REG_ADDR(DT_INST_IO_CHANNELS_CTLR(inst)),                                                                                       \
       .tim_pclken = aai_tim_pclken_##inst,                                                                                                                     \
@@ -398,7 +815,7 @@ static int aai_init(const struct device *dev) {
       .dma_dev = DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(inst, rx)),                                                                                           \
       .dma_channel = DT_INST_DMAS_CELL_BY_NAME(inst, rx, channel),                                                                                             \
       .dma_slot = DT_INST_DMAS_CELL_BY_NAME(inst, rx, slot),                                                                                                   \
-  };                                                                                                                                                           \
+      AAI_ZLI_CFG(inst)};                                                                                                                                      \
   static struct aai_data aai_data_##inst;                                                                                                                      \
   DEVICE_DT_INST_DEFINE(inst, aai_init, NULL, &aai_data_##inst, &aai_cfg_##inst, POST_KERNEL, CONFIG_ANALOG_AUDIO_IN_INIT_PRIORITY, NULL);
 
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Emulated analog-audio-in for native_sim. A k_timer stands in for TIM6 + the
+ * DMA half-transfer interrupt and the blocks are delivered from the audio
+ * work queue, as on hardware. The capture is silence, or with `loopback` the
+ * output of an analog-audio-out emulator, so a USB host sees its own OUT
+ * stream come back on IN after the full device-side path.
+ */
+#define DT_DRV_COMPAT oe5xrx_analog_audio_in_emul
+
+#include "audio_workq.h"
+
+#include <oe5xrx/audio/analog_audio_in.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+#if DT_HAS_COMPAT_STATUS_OKAY(oe5xrx_analog_audio_out_emul)
+#include <oe5xrx/audio/analog_audio_out_emul.h>
+#define AAI_EMUL_HAVE_LOOPBACK 1
+#endif
+
+LOG_MODULE_REGISTER(analog_audio_in_emul, CONFIG_ANALOG_AUDIO_IN_LOG_LEVEL);
+
+#define AAI_EMUL_MAX_BLOCK 16
+/* Emulated sampling-timer kernel clock (fm_board TIM6). */
+#define AAI_EMUL_TIM_HZ 160000000U
+
+struct aai_emul_config {
+  uint32_t sampling_frequency;
+  uint16_t block_samples;
+  const struct device *loopback; /* analog-audio-out emulator, or NULL */
+};
+
+struct aai_emul_data {
+  const struct device *self;
+  analog_audio_in_cb cb;
+  void *user_data;
+  atomic_t running;
+  atomic_t pending; /* blocks captured, not yet delivered */
+  atomic_t period;
+  atomic_t period_changed;
+  struct k_timer timer;
+  struct k_work drain_work;
+};
+
+static k_timeout_t aai_emul_block_time(const struct aai_emul_config *cfg, uint32_t period) {
+  return K_NSEC((uint64_t)cfg->block_samples * period * NSEC_PER_SEC / AAI_EMUL_TIM_HZ);
+}
+
+static void aai_emul_drain_work(struct k_work *work) {
+  struct aai_emul_data *data = CONTAINER_OF(work, struct aai_emul_data, drain_work);
+  const struct aai_emul_config *cfg = data->self->config;
+  int16_t block[AAI_EMUL_MAX_BLOCK];
+
+  while (atomic_get(&data->pending) > 0) {
+    atomic_dec(&data->pending);
+    if (!atomic_get(&data->running)) {
+      return;
+    }
+    size_t got = 0;
+#ifdef AAI_EMUL_HAVE_LOOPBACK
+    if (cfg->loopback != NULL && device_is_ready(cfg->loopback)) {
+      got = analog_audio_out_emul_read(cfg->loopback, block, cfg->block_samples);
+    }
+#endif
+    for (size_t i = got; i < cfg->block_samples; i++) {
+      block[i] = 0;
+    }
+    analog_audio_in_cb cb = data->cb;
+    if (cb != NULL) {
+      cb(block, cfg->block_samples, data->user_data);
+    }
+  }
+}
+
+static void aai_emul_timer(struct k_timer *timer) {
+  struct aai_emul_data *data = CONTAINER_OF(timer, struct aai_emul_data, timer);
+
+  if (!atomic_get(&data->running)) {
+    return;
+  }
+  if (atomic_clear(&data->period_changed)) {
+    k_timeout_t t = aai_emul_block_time(data->self->config, (uint32_t)atomic_get(&data->period));
+    k_timer_start(&data->timer, t, t);
+  }
+  atomic_inc(&data->pending);
+  audio_workq_submit(&data->drain_work);
+}
+
+int analog_audio_in_start(const struct device *dev, analog_audio_in_cb cb, void *user_data) {
+  const struct aai_emul_config *cfg = dev->config;
+  struct aai_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev)) {
+    return -ENODEV;
+  }
+  if (cb == NULL) {
+    return -EINVAL;
+  }
+  if (atomic_get(&data->running)) {
+    return -EALREADY;
+  }
+  data->cb = cb;
+  data->user_data = user_data;
+  atomic_set(&data->pending, 0);
+  atomic_set(&data->period, AAI_EMUL_TIM_HZ / cfg->sampling_frequency);
+  atomic_set(&data->period_changed, 0);
+  atomic_set(&data->running, 1);
+
+  k_timeout_t t = aai_emul_block_time(cfg, (uint32_t)atomic_get(&data->period));
+  k_timer_start(&data->timer, t, t);
+  LOG_INF("capture started (emulated%s)", cfg->loopback ? ", loopback" : "");
+  return 0;
+}
+
+int analog_audio_in_stop(const struct device *dev) {
+  struct aai_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev)) {
+    return -ENODEV;
+  }
+  if (atomic_get(&data->running)) {
+    atomic_set(&data->running, 0);
+    k_timer_stop(&data->timer);
+  }
+  return 0;
+}
+
+int analog_audio_in_set_period(const struct device *dev, uint32_t ticks) {
+  struct aai_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev) || ticks == 0U || ticks > 0x10000U) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+  if ((uint32_t)atomic_set(&data->period, ticks) != ticks) {
+    atomic_set(&data->period_changed, 1);
+  }
+  return 0;
+}
+
+/* No DMA interrupt to time: the blocks are paced by a kernel timer. */
+int analog_audio_in_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(stats);
+  return -ENOTSUP;
+}
+
+/* Nothing is scanned besides the audio samples. */
+int analog_audio_in_get_aux(const struct device *dev, uint8_t index, struct analog_audio_in_aux *aux) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(index);
+  ARG_UNUSED(aux);
+  return -ENOTSUP;
+}
+
+static int aai_emul_init(const struct device *dev) {
+  const struct aai_emul_config *cfg = dev->config;
+  struct aai_emul_data *data = dev->data;
+
+  if (cfg->block_samples == 0 || cfg->block_samples > AAI_EMUL_MAX_BLOCK) {
+    LOG_ERR("block-samples %u out of range (1..%u)", cfg->block_samples, AAI_EMUL_MAX_BLOCK);
+    return -EINVAL;
+  }
+  if (cfg->sampling_frequency == 0 || AAI_EMUL_TIM_HZ / cfg->sampling_frequency > 0x10000U) {
+    LOG_ERR("sampling-frequency %u unattainable", cfg->sampling_frequency);
+    return -EINVAL;
+  }
+  data->self = dev;
+  k_work_init(&data->drain_work, aai_emul_drain_work);
+  k_timer_init(&data->timer, aai_emul_timer, NULL);
+  LOG_INF("init: %u Hz, block=%u (emulated)", cfg->sampling_frequency, cfg->block_samples);
+  return 0;
+}
+
+#ifdef AAI_EMUL_HAVE_LOOPBACK
+#define AAI_EMUL_LOOPBACK(inst) COND_CODE_1(DT_INST_NODE_HAS_PROP(inst, loopback), (DEVICE_DT_GET(DT_INST_PHANDLE(inst, loopback))), (NULL))
+#else
+#define AAI_EMUL_LOOPBACK(inst) NULL
+#endif
+
+#define AAI_EMUL_INIT(inst)                                                                                                                                    \
+  static const struct aai_emul_config aai_emul_cfg_##inst = {                                                                                                  \
+      .sampling_frequency = DT_INST_PROP(inst, sampling_frequency),                                                                                            \
+      .block_samples = DT_INST_PROP(inst, block_samples),                                                                                                      \
+      .loopback = AAI_EMUL_LOOPBACK(inst),                                                                                                                     \
+  };                                                                                                                                                           \
+  static struct aai_emul_data aai_emul_data_##inst;                                                                                                            \
+  DEVICE_DT_INST_DEFINE(inst, aai_emul_init, NULL, &aai_emul_data_##inst, &aai_emul_cfg_##inst, POST_KERNEL, CONFIG_ANALOG_AUDIO_IN_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(AAI_EMUL_INIT)
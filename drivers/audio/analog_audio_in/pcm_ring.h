@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Single-producer / single-consumer ring of PCM blocks: the capture DMA
+ * interrupt hands converted blocks to the drain work through it.
+ *
+ * Lock-free and kernel-free, so the producer may run as a zero-latency
+ * interrupt (which must not call k_msgq_put() or take any lock): the producer
+ * only ever writes head, the consumer only ever writes tail, and each index is
+ * published with a release store and read with an acquire load. The consumer
+ * reads a block in place (peek) and frees it afterwards (release), so there is
+ * no copy on the thread side. Indices are free-running uint32 counters.
+ *
+ * Pure logic: no Zephyr, no heap, no float.
+ */
+#ifndef OE5XRX_ANALOG_AUDIO_IN_PCM_RING_H_
+#define OE5XRX_ANALOG_AUDIO_IN_PCM_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Depth in blocks (~1 ms each at 8 kHz / 8 samples); power of two. */
+#define PCM_RING_BLOCKS 16U
+/* Max samples per block. */
+#define PCM_RING_BLOCK_MAX 16U
+
+struct pcm_ring {
+  uint32_t head;     /* blocks committed; producer-owned */
+  uint32_t tail;     /* blocks released; consumer-owned */
+  uint32_t overruns; /* blocks dropped because the ring was full; producer-owned */
+  int16_t blocks[PCM_RING_BLOCKS][PCM_RING_BLOCK_MAX];
+};
+
+/** Empty the ring and clear the counter. Only while neither side runs. */
+static inline void pcm_ring_reset(struct pcm_ring *r) {
+  __atomic_store_n(&r->head, 0U, __ATOMIC_RELAXED);
+  __atomic_store_n(&r->tail, 0U, __ATOMIC_RELAXED);
+  __atomic_store_n(&r->overruns, 0U, __ATOMIC_RELAXED);
+}
+
+/**
+ * Producer: the slot for the next block, or NULL (overrun counted) if the
+ * consumer has not freed one. Fill it, then pcm_ring_commit().
+ */
+static inline int16_t *pcm_ring_claim(struct pcm_ring *r) {
+  const uint32_t head = r->head;
+  if (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= PCM_RING_BLOCKS) {
+    __atomic_store_n(&r->overruns, r->overruns + 1U, __ATOMIC_RELAXED);
+    return NULL;
+  }
+  return r->blocks[head % PCM_RING_BLOCKS];
+}
+
+/** Producer: publish the block filled after pcm_ring_claim(). */
+static inline void pcm_ring_commit(struct pcm_ring *r) { __atomic_store_n(&r->head, r->head + 1U, __ATOMIC_RELEASE); }
+
+/** Consumer: the oldest block (valid until pcm_ring_release()), or NULL if empty. */
+static inline const int16_t *pcm_ring_peek(const struct pcm_ring *r) {
+  const uint32_t tail = r->tail;
+  if (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == tail) {
+    return NULL;
+  }
+  return r->blocks[tail % PCM_RING_BLOCKS];
+}
+
+/** Consumer: free the block returned by pcm_ring_peek(). */
+static inline void pcm_ring_release(struct pcm_ring *r) { __atomic_store_n(&r->tail, r->tail + 1U, __ATOMIC_RELEASE); }
+
+/** Blocks dropped at the producer so far (any context). */
+static inline uint32_t pcm_ring_overruns(const struct pcm_ring *r) { return __atomic_load_n(&r->overruns, __ATOMIC_RELAXED); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_ANALOG_AUDIO_IN_PCM_RING_H_ */
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+#include "sync_start.h"
+
+int sync_start(const struct sync_start_ops *ops, void *ctx) {
+  /* The timer's update event at configuration reaches neither side: the ADC
+   * is not converting yet and the DAC is enabled only after it. */
+  int r = ops->arm_in(ctx);
+  if (r < 0) {
+    return r;
+  }
+  r = ops->arm_out(ctx);
+  if (r < 0) {
+    (void)ops->stop_in(ctx);
+    return r;
+  }
+  /* Both armed on the stopped timer: its first update is sample 0 of each. */
+  ops->run(ctx);
+  return 0;
+}
+
+int sync_stop(const struct sync_start_ops *ops, void *ctx) {
+  const int r_in = ops->stop_in(ctx);
+  const int r_out = ops->stop_out(ctx);
+  return r_in < 0 ? r_in : r_out;
+}
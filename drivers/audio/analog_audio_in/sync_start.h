@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Start/stop sequence of a capture/playback pair on one sampling timer (see
+ * <oe5xrx/audio/analog_audio_sync.h>). The hardware steps are callbacks, so
+ * the order and the rollback after a failed start are unit-tested on
+ * native_sim. Pure logic.
+ */
+#ifndef OE5XRX_ANALOG_AUDIO_IN_SYNC_START_H_
+#define OE5XRX_ANALOG_AUDIO_IN_SYNC_START_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sync_start_ops {
+  int (*arm_in)(void *ctx);   /**< capture up, shared timer configured but stopped */
+  int (*arm_out)(void *ctx);  /**< playback up, waiting for the shared timer */
+  void (*run)(void *ctx);     /**< start the shared timer: sample 0 of both */
+  int (*stop_in)(void *ctx);  /**< capture down, which stops the shared timer */
+  int (*stop_out)(void *ctx); /**< playback down */
+};
+
+/**
+ * Arm capture, then playback, then run the timer. If playback fails to arm,
+ * capture is stopped again so nothing is left running.
+ * @return 0, or the error of the arm step that failed.
+ */
+int sync_start(const struct sync_start_ops *ops, void *ctx);
+
+/**
+ * Stop capture first, so the timer stops and both end on the same edge, then
+ * playback. Both are always stopped.
+ * @return 0, or the first error of the two.
+ */
+int sync_stop(const struct sync_start_ops *ops, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_ANALOG_AUDIO_IN_SYNC_START_H_ */
@@ -4,7 +4,10 @@
  */
 #define DT_DRV_COMPAT oe5xrx_analog_audio_out
 
+#include "audio_dma_irq.h"
+#include "audio_workq.h"
 #include "dac_pcm.h"
+#include "irq_timing.h"
 
 #include <oe5xrx/audio/analog_audio_out.h>
 #include <stm32_ll_dac.h>
@@ -29,12 +32,21 @@ struct aao_config {
   uint8_t resolution;
   uint32_t dac_channel_nb; /* DT io-channels output cell (1 or 2) */
   TIM_TypeDef *tim;
+  /* sync-source: the DAC runs off the capture's timer (TIM6), which that
+   * driver configures and starts; this one only reads it. */
+  bool synced;
+  uint32_t dac_trigger; /* LL_DAC_TRIG_EXT_TIMx_TRGO of tim */
   DAC_TypeDef *dac;
   const struct stm32_pclken *tim_pclken; /* [0]=bus enable, [1]=kernel clock */
   const struct stm32_pclken *dac_pclken; /* [0]=bus enable (single cell) */
   const struct device *dma_dev;
   uint32_t dma_channel;
   uint32_t dma_slot;
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  unsigned int dma_irq;      /* NVIC line of dma_channel */
+  unsigned int doorbell_irq; /* NVIC line pended by the ZLI handler */
+  void (*irq_config)(void);
+#endif
 };
 
 struct aao_data {
@@ -44,16 +56,22 @@ struct aao_data {
   atomic_t running;                    /* written from thread (start/stop), read from DMA ISR */
   uint16_t dma_buf[2 * AAO_MAX_BLOCK]; /* circular DAC codes: [0..block) | [block..2*block) */
   atomic_t pending;                    /* bitmask of halves needing refill: BIT(0)=first, BIT(1)=second */
+  atomic_t halves;                     /* DMA halves completed since start (clock position) */
+  atomic_t overruns;                   /* halves that came round again before their refill ran */
+  uint32_t tim_clk;                    /* timer kernel clock, Hz (set at start) */
   struct k_work refill_work;
   struct dma_config dma_cfg;
   struct dma_block_config blk;
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  struct irq_timing irq_timing;
+#endif
 };
 
 static uint32_t aao_ll_channel(uint32_t nb) {
   return (nb == 2) ? LL_DAC_CHANNEL_2 : LL_DAC_CHANNEL_1;
 }
 
-/* System-workqueue handler: refill the just-consumed buffer half by pulling PCM
+/* Audio work queue handler: refill the just-consumed buffer half by pulling PCM
  * from the source (thread context, may block/take a mutex), converting to DAC
  * codes, and padding any shortfall with mid-scale (silence). */
 static void aao_refill_work(struct k_work *work) {
@@ -89,6 +107,30 @@ static void aao_refill_work(struct k_work *work) {
   }
 }
 
+/* First thing in either DMA handler: stamp the entry for the jitter stats. */
+static inline void aao_irq_mark(struct aao_data *data) {
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  irq_timing_mark(&data->irq_timing, audio_dma_irq_cycles());
+#else
+  ARG_UNUSED(data);
+#endif
+}
+
+/* Flag buffer half @p half (0 = first) for refill. Interrupt context, no
+ * kernel calls. @return true if the refill work needs a kick. */
+static bool aao_flag_half(struct aao_data *data, uint32_t half) {
+  if (!atomic_get(&data->running)) {
+    return false;
+  }
+  /* Still pending from its last round: the refill did not keep up and the
+   * half is about to replay its old codes. */
+  if ((atomic_or(&data->pending, BIT(half)) & BIT(half)) != 0) {
+    atomic_inc(&data->overruns);
+  }
+  atomic_inc(&data->halves);
+  return true;
+}
+
 static void aao_dma_cb(const struct device *dma_dev, void *user, uint32_t channel, int status) {
   const struct device *dev = user;
   struct aao_data *data = dev->data;
@@ -96,22 +138,53 @@ static void aao_dma_cb(const struct device *dma_dev, void *user, uint32_t channe
   ARG_UNUSED(dma_dev);
   ARG_UNUSED(channel);
 
-  if (!atomic_get(&data->running)) {
-    return;
-  }
+  aao_irq_mark(data);
   /* Refill only on the expected half/full-transfer completions:
    * DMA_STATUS_BLOCK = first half just played, DMA_STATUS_COMPLETE = second half.
    * Ignore errors (status < 0) and any other/unexpected status. */
+  uint32_t half;
   if (status == DMA_STATUS_BLOCK) {
-    atomic_or(&data->pending, BIT(0));
+    half = 0;
   } else if (status == DMA_STATUS_COMPLETE) {
-    atomic_or(&data->pending, BIT(1));
+    half = 1;
   } else {
     return;
   }
-  k_work_submit(&data->refill_work);
+  if (aao_flag_half(data, half)) {
+    audio_workq_submit(&data->refill_work);
+  }
 }
 
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+/* Zero-latency DMA handler, installed over the dma_stm32u5 one at start (see
+ * audio_dma_irq.h). Must not enter the kernel: the halves are flagged in the
+ * atomic pending mask and the doorbell interrupt submits the refill work. */
+static void aao_zli_isr(const void *arg) {
+  const struct device *dev = arg;
+  const struct aao_config *cfg = dev->config;
+  struct aao_data *data = dev->data;
+
+  aao_irq_mark(data);
+  const uint32_t ev = audio_dma_irq_ack(cfg->dma_channel);
+  bool kick = false;
+  if ((ev & AUDIO_DMA_IRQ_HALF) != 0U) {
+    kick |= aao_flag_half(data, 0);
+  }
+  if ((ev & AUDIO_DMA_IRQ_FULL) != 0U) {
+    kick |= aao_flag_half(data, 1);
+  }
+  if (kick) {
+    NVIC_SetPendingIRQ((IRQn_Type)cfg->doorbell_irq);
+  }
+}
+
+static void aao_doorbell_isr(const struct device *dev) {
+  struct aao_data *data = dev->data;
+
+  audio_workq_submit(&data->refill_work);
+}
+#endif /* CONFIG_ANALOG_AUDIO_DMA_ZLI */
+
 static int aao_dac_setup(const struct device *dev) {
   const struct aao_config *cfg = dev->config;
   const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
@@ -142,7 +215,7 @@ static int aao_dac_setup(const struct device *dev) {
 
   /* Output stage + trigger source must be set while the channel is disabled. */
   LL_DAC_ConfigOutput(dac, ch, LL_DAC_OUTPUT_MODE_NORMAL, LL_DAC_OUTPUT_BUFFER_ENABLE, LL_DAC_OUTPUT_CONNECT_GPIO);
-  LL_DAC_SetTriggerSource(dac, ch, LL_DAC_TRIG_EXT_TIM7_TRGO);
+  LL_DAC_SetTriggerSource(dac, ch, cfg->dac_trigger);
   if (ch == LL_DAC_CHANNEL_1) {
     LL_DAC_ClearFlag_DMAUDR1(dac);
   } else {
@@ -198,11 +271,15 @@ static int aao_dma_start(const struct device *dev) {
    * Zephyr's dma_config() rejects mixed source/dest sizes, so the dest width is
    * overridden here, with the channel disabled between config and start. */
   LL_DMA_SetDestDataWidth(GPDMA1, cfg->dma_channel, LL_DMA_DEST_DATAWIDTH_WORD);
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  audio_dma_irq_connect_zli(cfg->dma_irq, aao_zli_isr, dev);
+#endif
   return dma_start(cfg->dma_dev, cfg->dma_channel);
 }
 
 static int aao_timer_start(const struct device *dev) {
   const struct aao_config *cfg = dev->config;
+  struct aao_data *data = dev->data;
   const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
   uint32_t tim_clk = 0;
 
@@ -221,8 +298,15 @@ static int aao_timer_start(const struct device *dev) {
     LOG_ERR("sample rate %u Hz unattainable from tim_clk %u (divider %u)", cfg->sampling_frequency, tim_clk, div);
     return -EINVAL;
   }
+  data->tim_clk = tim_clk;
+  if (cfg->synced) {
+    return 0;
+  }
   LL_TIM_SetPrescaler(cfg->tim, 0);
   LL_TIM_SetAutoReload(cfg->tim, div - 1U);
+  /* Buffer ARR so a period trim (analog_audio_out_set_period) only takes
+   * effect at the next update and never cuts a sample period short. */
+  LL_TIM_EnableARRPreload(cfg->tim);
   LL_TIM_SetTriggerOutput(cfg->tim, LL_TIM_TRGO_UPDATE);
   LL_TIM_GenerateEvent_UPDATE(cfg->tim);
   LL_TIM_EnableCounter(cfg->tim);
@@ -256,6 +340,11 @@ int analog_audio_out_start(const struct device *dev, analog_audio_out_src src, v
   data->src = src;
   data->user_data = user_data;
   atomic_set(&data->pending, 0);
+  atomic_set(&data->halves, 0);
+  atomic_set(&data->overruns, 0);
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  irq_timing_reset(&data->irq_timing, audio_dma_irq_nominal(cfg->sampling_frequency, cfg->block_samples));
+#endif
   atomic_set(&data->running, 1);
 
   /* Arm the memory->DAC DMA FIRST so it is ready to service the DAC's first
@@ -300,13 +389,87 @@ int analog_audio_out_stop(const struct device *dev) {
    * trigger), mirroring the error-path teardown. */
   if (atomic_get(&data->running)) {
     atomic_set(&data->running, 0);
-    LL_TIM_DisableCounter(cfg->tim);
+    if (!cfg->synced) {
+      LL_TIM_DisableCounter(cfg->tim);
+    }
     aao_dac_disable(cfg->dac, aao_ll_channel(cfg->dac_channel_nb));
     dma_stop(cfg->dma_dev, cfg->dma_channel);
   }
   return 0;
 }
 
+int analog_audio_out_get_clock(const struct device *dev, struct analog_audio_out_clock *clk) {
+  const struct aao_config *cfg = dev->config;
+  struct aao_data *data = dev->data;
+  const uint32_t ring = 2U * cfg->block_samples;
+
+  if (!device_is_ready(dev) || clk == NULL) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+
+  /* Position = halves completed * block + progress past the last counted
+   * half. The progress is taken modulo the ring, so a half-complete the ISR
+   * has not counted yet still yields the right position. The counter is read
+   * around the DMA and timer reads and the whole sample retried if a half or a
+   * sample period ended in between. */
+  for (int tries = 0; tries < 4; tries++) {
+    const atomic_val_t h1 = atomic_get(&data->halves);
+    const uint32_t cnt1 = LL_TIM_GetCounter(cfg->tim);
+    struct dma_status st;
+    int r = dma_get_status(cfg->dma_dev, cfg->dma_channel, &st);
+    if (r < 0) {
+      return r;
+    }
+    const uint32_t cnt2 = LL_TIM_GetCounter(cfg->tim);
+    const uint32_t arr = LL_TIM_GetAutoReload(cfg->tim);
+    const atomic_val_t h2 = atomic_get(&data->halves);
+    if (h1 != h2 || cnt2 < cnt1) {
+      continue;
+    }
+    const uint32_t halves = (uint32_t)h1;
+    const uint32_t idx = ring - st.pending_length / sizeof(uint16_t);
+    const uint32_t progress = (idx + ring - (halves & 1U) * cfg->block_samples) % ring;
+    const uint32_t samples = halves * cfg->block_samples + progress;
+    clk->position = (samples << ANALOG_AUDIO_OUT_POS_FRAC_BITS) + (cnt2 << ANALOG_AUDIO_OUT_POS_FRAC_BITS) / (arr + 1U);
+    clk->tim_hz = data->tim_clk;
+    return 0;
+  }
+  return -EBUSY;
+}
+
+int analog_audio_out_set_period(const struct device *dev, uint32_t ticks) {
+  const struct aao_config *cfg = dev->config;
+  struct aao_data *data = dev->data;
+
+  if (!device_is_ready(dev) || ticks == 0U || ticks > 0x10000U) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+  LL_TIM_SetAutoReload(cfg->tim, ticks - 1U);
+  return 0;
+}
+
+int analog_audio_out_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats) {
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  struct aao_data *data = dev->data;
+
+  if (!device_is_ready(dev) || stats == NULL) {
+    return -EINVAL;
+  }
+  audio_dma_irq_stats(&data->irq_timing, (uint32_t)atomic_get(&data->overruns), stats);
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(stats);
+  return -ENOTSUP;
+#endif
+}
+
 static int aao_init(const struct device *dev) {
   const struct aao_config *cfg = dev->config;
   struct aao_data *data = dev->data;
@@ -330,16 +493,46 @@ static int aao_init(const struct device *dev) {
   }
   data->self = dev;
   k_work_init(&data->refill_work, aao_refill_work);
+#ifdef CONFIG_ANALOG_AUDIO_IRQ_STATS
+  audio_dma_irq_cycles_init();
+#endif
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+  cfg->irq_config();
+#endif
   return 0;
 }
 
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+/* The ZLI handler pends the node's own interrupt as its doorbell. */
+#define AAO_ZLI_DEFINE(inst)                                                                                                                                   \
+  BUILD_ASSERT(DT_INST_IRQ_HAS_IDX(inst, 0), "CONFIG_ANALOG_AUDIO_DMA_ZLI: analog-audio-out needs a doorbell interrupt");                                      \
+  static void aao_irq_config_##inst(void) {                                                                                                                    \
+    IRQ_CONNECT(DT_INST_IRQN(inst), DT_INST_IRQ(inst, priority), aao_doorbell_isr, DEVICE_DT_INST_GET(inst), 0);                                               \
+    irq_enable(DT_INST_IRQN(inst));                                                                                                                            \
+  }
+#define AAO_ZLI_CFG(inst)                                                                                                                                      \
+  .dma_irq = DT_IRQ_BY_IDX(DT_INST_DMAS_CTLR_BY_NAME(inst, tx), DT_INST_DMAS_CELL_BY_NAME(inst, tx, channel), irq),                                            \
+  .doorbell_irq = DT_INST_IRQN(inst), .irq_config = aao_irq_config_##inst,
+#else
+#define AAO_ZLI_DEFINE(inst)
+#define AAO_ZLI_CFG(inst)
+#endif
+
+/* Synchronised playback: the capture's timer and rate (its own BUILD_ASSERT
+ * pins that timer to TIM6). */
+#define AAO_SYNCED(inst) DT_INST_NODE_HAS_PROP(inst, sync_source)
+#define AAO_SYNC_OK(inst)                                                                                                                                      \
+  (DT_SAME_NODE(DT_INST_PHANDLE(inst, sampling_timer), DT_PHANDLE(DT_INST_PHANDLE(inst, sync_source), sampling_timer)) &&                                      \
+   DT_INST_PROP(inst, sampling_frequency) == DT_PROP(DT_INST_PHANDLE(inst, sync_source), sampling_frequency))
+
 #define AAO_INIT(inst)                                                                                                                                         \
-  /* The DAC trigger is hardcoded to TIM7-TRGO (aao_dac_setup), so the DT-selected                                                                             \
-   * sampling-timer must be TIM7. Enforce at build time via node identity                                                                                      \
-   * (security-agnostic; a runtime base-address compare is unreliable because TIM7                                                                             \
-   * aliases to different secure/non-secure addresses on STM32U5). */                                                                                          \
-  BUILD_ASSERT(DT_SAME_NODE(DT_INST_PHANDLE(inst, sampling_timer), DT_NODELABEL(timers7)),                                                                     \
-               "analog-audio-out sampling-timer must be TIM7 (DAC trigger is hardcoded to TIM7-TRGO)");                                                        \
+  /* The DAC trigger is TIM7-TRGO (aao_dac_setup), or TIM6-TRGO when synchronised                                                                              \
+   * to the capture, so the DT-selected sampling-timer must be that timer. Enforce                                                                             \
+   * at build time via node identity (security-agnostic; a runtime base-address                                                                                \
+   * compare is unreliable because the timers alias to different secure/non-secure                                                                             \
+   * addresses on STM32U5). */                                                                                                                                 \
+  BUILD_ASSERT(COND_CODE_1(AAO_SYNCED(inst), (AAO_SYNC_OK(inst)), (DT_SAME_NODE(DT_INST_PHANDLE(inst, sampling_timer), DT_NODELABEL(timers7)))),               \
+               "analog-audio-out sampling-timer must be TIM7, or with sync-source the capture's timer at the capture's sampling-frequency");                   \
   /* aao_dma_start() overrides the dest data width via LL on the hardcoded GPDMA1                                                                              \
    * instance (the STM32U5 word-write DAC fix), so the DT-selected DMA controller                                                                              \
    * must be GPDMA1. Enforce at build time. */                                                                                                                 \
@@ -349,6 +542,7 @@ static int aao_init(const struct device *dev) {
    * any other io-channels output cell at build time instead of silently using                                                                                 \
    * channel 1. */                                                                                                                                             \
   BUILD_ASSERT(DT_INST_IO_CHANNELS_OUTPUT(inst) == 1 || DT_INST_IO_CHANNELS_OUTPUT(inst) == 2, "analog-audio-out io-channels DAC channel must be 1 or 2");     \
+  AAO_ZLI_DEFINE(inst)                                                                                                                                         \
   static const struct stm32_pclken aao_tim_pclken_##inst[] = STM32_DT_CLOCKS(DT_INST_PHANDLE(inst, sampling_timer));                                           \
   static const struct stm32_pclken aao_dac_pclken_##inst[] = STM32_DT_CLOCKS(DT_INST_IO_CHANNELS_CTLR(inst));                                                  \
   static const struct aao_config aao_cfg_##inst = {                                                                                                            \
@@ -357,13 +551,15 @@ static int aao_init(const struct device *dev) {
       .resolution = DT_INST_PROP(inst, resolution),                                                                                                            \
       .dac_channel_nb = DT_INST_IO_CHANNELS_OUTPUT(inst),                                                                                                      \
       .tim = (TIM_TypeDef *)DT_REG_ADDR(DT_INST_PHANDLE(inst, sampling_timer)),                                                                                \
+      .synced = AAO_SYNCED(inst),                                                                                                                              \
+      .dac_trigger = COND_CODE_1(AAO_SYNCED(inst), (LL_DAC_TRIG_EXT_TIM6_TRGO), (LL_DAC_TRIG_EXT_TIM7_TRGO)),                                                  \
       .dac = (DAC_TypeDef *)DT_REG_ADDR(DT_INST_IO_CHANNELS_CTLR(inst)),                                                                                       \
       .tim_pclken = aao_tim_pclken_##inst,                                                                                                                     \
       .dac_pclken = aao_dac_pclken_##inst,                                                                                                                     \
       .dma_dev = DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(inst, tx)),                                                                                           \
       .dma_channel = DT_INST_DMAS_CELL_BY_NAME(inst, tx, channel),                                                                                             \
       .dma_slot = DT_INST_DMAS_CELL_BY_NAME(inst, tx, slot),                                                                                                   \
-  };                                                                                                                                                           \
+      AAO_ZLI_CFG(inst)};                                                                                                                                      \
   static struct aao_data aao_data_##inst;                                                                                                                      \
   DEVICE_DT_INST_DEFINE(inst, aao_init, NULL, &aao_data_##inst, &aao_cfg_##inst, POST_KERNEL, CONFIG_ANALOG_AUDIO_OUT_INIT_PRIORITY, NULL);
 
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Emulated analog-audio-out for native_sim. A k_timer stands in for TIM7 +
+ * the DMA half-transfer interrupt: it fires once per block and the refill runs
+ * on the audio work queue exactly as on hardware, so the application sees the
+ * same thread context and pull cadence. The emulated sampling timer runs at
+ * the fm_board kernel clock, so get_clock()/set_period() speak the same ticks;
+ * a period trim only takes effect to the kernel tick resolution.
+ */
+#define DT_DRV_COMPAT oe5xrx_analog_audio_out_emul
+
+#include "audio_workq.h"
+
+#include <oe5xrx/audio/analog_audio_out.h>
+#include <oe5xrx/audio/analog_audio_out_emul.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+
+LOG_MODULE_REGISTER(analog_audio_out_emul, CONFIG_ANALOG_AUDIO_OUT_LOG_LEVEL);
+
+#define AAO_EMUL_MAX_BLOCK 16
+/* Emulated sampling-timer kernel clock (fm_board TIM7). */
+#define AAO_EMUL_TIM_HZ 160000000U
+/* Loopback FIFO, in samples (power of two; 32 ms at 8 kHz). */
+#define AAO_EMUL_FIFO 256U
+
+struct aao_emul_config {
+  uint32_t sampling_frequency;
+  uint16_t block_samples;
+};
+
+struct aao_emul_data {
+  const struct device *self;
+  analog_audio_out_src src;
+  void *user_data;
+  atomic_t running;
+  atomic_t pending;        /* blocks due for refill */
+  atomic_t halves;         /* blocks clocked out since start (clock position) */
+  atomic_t period;         /* emulated ARR + 1, in AAO_EMUL_TIM_HZ ticks */
+  atomic_t period_changed; /* re-arm the timer at the next expiry */
+  struct k_timer timer;
+  struct k_work refill_work;
+  struct k_spinlock fifo_lock;
+  int16_t fifo[AAO_EMUL_FIFO];
+  uint32_t fifo_wr;
+  uint32_t fifo_rd;
+};
+
+static k_timeout_t aao_emul_block_time(const struct aao_emul_config *cfg, uint32_t period) {
+  return K_NSEC((uint64_t)cfg->block_samples * period * NSEC_PER_SEC / AAO_EMUL_TIM_HZ);
+}
+
+static void aao_emul_refill_work(struct k_work *work) {
+  struct aao_emul_data *data = CONTAINER_OF(work, struct aao_emul_data, refill_work);
+  const struct aao_emul_config *cfg = data->self->config;
+
+  while (atomic_get(&data->pending) > 0) {
+    atomic_dec(&data->pending);
+    if (!atomic_get(&data->running)) {
+      return;
+    }
+    analog_audio_out_src src = data->src;
+    int16_t pcm[AAO_EMUL_MAX_BLOCK];
+    size_t got = src ? src(pcm, cfg->block_samples, data->user_data) : 0;
+    /* Shortfall plays as mid-scale, i.e. PCM silence. */
+    for (size_t i = got; i < cfg->block_samples; i++) {
+      pcm[i] = 0;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->fifo_lock);
+    for (uint16_t i = 0; i < cfg->block_samples; i++) {
+      data->fifo[data->fifo_wr++ % AAO_EMUL_FIFO] = pcm[i];
+    }
+    if (data->fifo_wr - data->fifo_rd > AAO_EMUL_FIFO) {
+      data->fifo_rd = data->fifo_wr - AAO_EMUL_FIFO; /* nobody listening: drop the oldest */
+    }
+    k_spin_unlock(&data->fifo_lock, key);
+  }
+}
+
+static void aao_emul_timer(struct k_timer *timer) {
+  struct aao_emul_data *data = CONTAINER_OF(timer, struct aao_emul_data, timer);
+
+  if (!atomic_get(&data->running)) {
+    return;
+  }
+  if (atomic_clear(&data->period_changed)) {
+    k_timeout_t t = aao_emul_block_time(data->self->config, (uint32_t)atomic_get(&data->period));
+    k_timer_start(&data->timer, t, t);
+  }
+  atomic_inc(&data->halves);
+  atomic_inc(&data->pending);
+  audio_workq_submit(&data->refill_work);
+}
+
+int analog_audio_out_start(const struct device *dev, analog_audio_out_src src, void *user_data) {
+  const struct aao_emul_config *cfg = dev->config;
+  struct aao_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev)) {
+    return -ENODEV;
+  }
+  if (src == NULL) {
+    return -EINVAL;
+  }
+  if (atomic_get(&data->running)) {
+    return -EALREADY;
+  }
+  data->src = src;
+  data->user_data = user_data;
+  atomic_set(&data->pending, 0);
+  atomic_set(&data->halves, 0);
+  atomic_set(&data->period, AAO_EMUL_TIM_HZ / cfg->sampling_frequency);
+  atomic_set(&data->period_changed, 0);
+  k_spinlock_key_t key = k_spin_lock(&data->fifo_lock);
+  data->fifo_rd = data->fifo_wr;
+  k_spin_unlock(&data->fifo_lock, key);
+  atomic_set(&data->running, 1);
+
+  k_timeout_t t = aao_emul_block_time(cfg, (uint32_t)atomic_get(&data->period));
+  k_timer_start(&data->timer, t, t);
+  LOG_INF("playback started (emulated)");
+  return 0;
+}
+
+int analog_audio_out_stop(const struct device *dev) {
+  struct aao_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev)) {
+    return -ENODEV;
+  }
+  if (atomic_get(&data->running)) {
+    atomic_set(&data->running, 0);
+    k_timer_stop(&data->timer);
+  }
+  return 0;
+}
+
+int analog_audio_out_get_clock(const struct device *dev, struct analog_audio_out_clock *clk) {
+  const struct aao_emul_config *cfg = dev->config;
+  struct aao_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev) || clk == NULL) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+  /* Blocks clocked out plus the elapsed part of the current one. */
+  for (int tries = 0; tries < 4; tries++) {
+    const atomic_val_t h1 = atomic_get(&data->halves);
+    const uint64_t block_ns = (uint64_t)cfg->block_samples * (uint32_t)atomic_get(&data->period) * NSEC_PER_SEC / AAO_EMUL_TIM_HZ;
+    uint64_t left_ns = k_ticks_to_ns_floor64(k_timer_remaining_ticks(&data->timer));
+    const atomic_val_t h2 = atomic_get(&data->halves);
+    if (h1 != h2) {
+      continue;
+    }
+    if (left_ns > block_ns) {
+      left_ns = block_ns;
+    }
+    const uint32_t frac = (uint32_t)(((block_ns - left_ns) * ((uint32_t)cfg->block_samples << ANALOG_AUDIO_OUT_POS_FRAC_BITS)) / block_ns);
+    clk->position = (((uint32_t)h1 * cfg->block_samples) << ANALOG_AUDIO_OUT_POS_FRAC_BITS) + frac;
+    clk->tim_hz = AAO_EMUL_TIM_HZ;
+    return 0;
+  }
+  return -EBUSY;
+}
+
+int analog_audio_out_set_period(const struct device *dev, uint32_t ticks) {
+  struct aao_emul_data *data = dev->data;
+
+  if (!device_is_ready(dev) || ticks == 0U || ticks > 0x10000U) {
+    return -EINVAL;
+  }
+  if (!atomic_get(&data->running)) {
+    return -EAGAIN;
+  }
+  if ((uint32_t)atomic_set(&data->period, ticks) != ticks) {
+    atomic_set(&data->period_changed, 1);
+  }
+  return 0;
+}
+
+/* No DMA interrupt to time: the blocks are paced by a kernel timer. */
+int analog_audio_out_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(stats);
+  return -ENOTSUP;
+}
+
+size_t analog_audio_out_emul_read(const struct device *dev, int16_t *dst, size_t max) {
+  struct aao_emul_data *data = dev->data;
+  size_t n = 0;
+
+  k_spinlock_key_t key = k_spin_lock(&data->fifo_lock);
+  while (n < max && data->fifo_rd != data->fifo_wr) {
+    dst[n++] = data->fifo[data->fifo_rd++ % AAO_EMUL_FIFO];
+  }
+  k_spin_unlock(&data->fifo_lock, key);
+  return n;
+}
+
+static int aao_emul_init(const struct device *dev) {
+  const struct aao_emul_config *cfg = dev->config;
+  struct aao_emul_data *data = dev->data;
+
+  if (cfg->block_samples == 0 || cfg->block_samples > AAO_EMUL_MAX_BLOCK) {
+    LOG_ERR("block-samples %u out of range (1..%u)", cfg->block_samples, AAO_EMUL_MAX_BLOCK);
+    return -EINVAL;
+  }
+  if (cfg->sampling_frequency == 0 || AAO_EMUL_TIM_HZ / cfg->sampling_frequency > 0x10000U) {
+    LOG_ERR("sampling-frequency %u unattainable", cfg->sampling_frequency);
+    return -EINVAL;
+  }
+  data->self = dev;
+  k_work_init(&data->refill_work, aao_emul_refill_work);
+  k_timer_init(&data->timer, aao_emul_timer, NULL);
+  LOG_INF("init: %u Hz, block=%u (emulated)", cfg->sampling_frequency, cfg->block_samples);
+  return 0;
+}
+
+#define AAO_EMUL_INIT(inst)                                                                                                                                    \
+  static const struct aao_emul_config aao_emul_cfg_##inst = {                                                                                                  \
+      .sampling_frequency = DT_INST_PROP(inst, sampling_frequency),                                                                                            \
+      .block_samples = DT_INST_PROP(inst, block_samples),                                                                                                      \
+  };                                                                                                                                                           \
+  static struct aao_emul_data aao_emul_data_##inst;                                                                                                            \
+  DEVICE_DT_INST_DEFINE(inst, aao_emul_init, NULL, &aao_emul_data_##inst, &aao_emul_cfg_##inst, POST_KERNEL, CONFIG_ANALOG_AUDIO_OUT_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(AAO_EMUL_INIT)
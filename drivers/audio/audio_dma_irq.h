@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * GPDMA interrupt helpers shared by analog_audio_in and analog_audio_out.
+ *
+ * With CONFIG_ANALOG_AUDIO_DMA_ZLI the drivers take the half/full-transfer
+ * interrupt of their GPDMA1 channel away from dma_stm32u5 and run their own
+ * handler as a zero-latency interrupt: above the BASEPRI mask that irq_lock(),
+ * spinlocks and the USB/UART handlers run under, so its entry latency no
+ * longer depends on them. Such a handler must not call into the kernel; it
+ * acknowledges the channel here, hands its data over lock-free and pends the
+ * driver's doorbell interrupt (a spare NVIC line at normal priority from the
+ * node's `interrupts` property), whose ISR submits the work item.
+ */
+#ifndef OE5XRX_AUDIO_AUDIO_DMA_IRQ_H_
+#define OE5XRX_AUDIO_AUDIO_DMA_IRQ_H_
+
+#include "irq_timing.h"
+
+#include <cmsis_core.h>
+#include <oe5xrx/audio/analog_audio_irq.h>
+#include <stm32_ll_dma.h>
+#include <stdint.h>
+#include <zephyr/irq.h>
+#include <zephyr/sys/util.h>
+
+/* Events returned by audio_dma_irq_ack(). */
+#define AUDIO_DMA_IRQ_HALF BIT(0) /* half transfer: first buffer half done */
+#define AUDIO_DMA_IRQ_FULL BIT(1) /* transfer complete: second half done */
+
+/** Start the DWT cycle counter (idempotent). */
+static inline void audio_dma_irq_cycles_init(void) {
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/** CPU cycle stamp for irq_timing_mark(). */
+static inline uint32_t audio_dma_irq_cycles(void) { return DWT->CYCCNT; }
+
+/** Cycles per block of @p block_samples at @p fs: the nominal ISR interval. */
+static inline uint32_t audio_dma_irq_nominal(uint32_t fs, uint32_t block_samples) {
+  return (uint32_t)((uint64_t)SystemCoreClock * block_samples / fs);
+}
+
+/** Fill the public stats from a consistent snapshot of @p timing. */
+static inline void audio_dma_irq_stats(const struct irq_timing *timing, uint32_t overruns, struct analog_audio_irq_stats *out) {
+  struct irq_timing t;
+
+  irq_timing_read(timing, &t);
+  out->zli = IS_ENABLED(CONFIG_ANALOG_AUDIO_DMA_ZLI);
+  out->cpu_hz = SystemCoreClock;
+  out->count = t.count;
+  out->nominal_cyc = t.nominal;
+  out->period_min_cyc = t.count > 1U ? t.period_min : 0U;
+  out->period_max_cyc = t.period_max;
+  out->jitter_max_cyc = t.jitter_max;
+  out->jitter_mean_cyc = irq_timing_jitter_mean(&t);
+  out->overruns = overruns;
+}
+
+/**
+ * Read and clear the pending events of GPDMA1 @p channel. Error flags are
+ * cleared and dropped: a channel that stops on an error shows up as a stall
+ * (pipeline watchdog), as with the dma_stm32u5 handler.
+ * @return AUDIO_DMA_IRQ_HALF / AUDIO_DMA_IRQ_FULL bits. Both are set when the
+ *         handler was held off for a whole block.
+ */
+static inline uint32_t audio_dma_irq_ack(uint32_t channel) {
+  uint32_t ev = 0;
+
+  if (LL_DMA_IsActiveFlag_HT(GPDMA1, channel)) {
+    LL_DMA_ClearFlag_HT(GPDMA1, channel);
+    ev |= AUDIO_DMA_IRQ_HALF;
+  }
+  if (LL_DMA_IsActiveFlag_TC(GPDMA1, channel)) {
+    LL_DMA_ClearFlag_TC(GPDMA1, channel);
+    ev |= AUDIO_DMA_IRQ_FULL;
+  }
+  if (LL_DMA_IsActiveFlag_DTE(GPDMA1, channel) || LL_DMA_IsActiveFlag_ULE(GPDMA1, channel) || LL_DMA_IsActiveFlag_USE(GPDMA1, channel)) {
+    LL_DMA_ClearFlag_DTE(GPDMA1, channel);
+    LL_DMA_ClearFlag_ULE(GPDMA1, channel);
+    LL_DMA_ClearFlag_USE(GPDMA1, channel);
+  }
+  return ev;
+}
+
+#ifdef CONFIG_ANALOG_AUDIO_DMA_ZLI
+/**
+ * Route DMA interrupt @p irq to @p isr as a zero-latency interrupt, replacing
+ * the dma_stm32u5 entry in the software ISR table. Called after dma_config()
+ * and before dma_start(); the channel is only ever used by the calling driver.
+ */
+static inline void audio_dma_irq_connect_zli(unsigned int irq, void (*isr)(const void *), const void *arg) {
+  (void)irq_connect_dynamic(irq, 0, isr, arg, IRQ_ZERO_LATENCY);
+  irq_enable(irq);
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_AUDIO_DMA_IRQ_H_ */
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * The audio work queue (see audio_workq.h).
+ */
+#include "audio_workq.h"
+
+#include <zephyr/init.h>
+
+static K_THREAD_STACK_DEFINE(audio_workq_stack, CONFIG_ANALOG_AUDIO_WORKQ_STACK_SIZE);
+struct k_work_q audio_workq;
+
+static int audio_workq_init(void) {
+  const struct k_work_queue_config cfg = {
+      .name = "audio_workq",
+  };
+
+  k_work_queue_start(&audio_workq, audio_workq_stack, K_THREAD_STACK_SIZEOF(audio_workq_stack), CONFIG_ANALOG_AUDIO_WORKQ_PRIORITY, &cfg);
+  return 0;
+}
+
+/* Ahead of the drivers (CONFIG_ANALOG_AUDIO_{IN,OUT}_INIT_PRIORITY). */
+SYS_INIT(audio_workq_init, POST_KERNEL, 0);
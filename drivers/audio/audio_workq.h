@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Work queue shared by analog_audio_in and analog_audio_out.
+ *
+ * The capture drain and the playback refill run the application's audio
+ * callbacks once per block. On the system workqueue any unrelated item (a
+ * UART AT round trip, a settings write) would delay them by as long as it
+ * runs; on this queue only audio work competes, and its cooperative priority
+ * (CONFIG_ANALOG_AUDIO_WORKQ_PRIORITY) is above the system workqueue's.
+ * Started at POST_KERNEL before the drivers' init.
+ */
+#ifndef OE5XRX_AUDIO_AUDIO_WORKQ_H_
+#define OE5XRX_AUDIO_AUDIO_WORKQ_H_
+
+#include <zephyr/kernel.h>
+
+extern struct k_work_q audio_workq;
+
+/** Submit @p work to the audio work queue (ISR-safe). */
+static inline void audio_workq_submit(struct k_work *work) { (void)k_work_submit_to_queue(&audio_workq, work); }
+
+#endif /* OE5XRX_AUDIO_AUDIO_WORKQ_H_ */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Apply the devicetree interrupt priority plan (oe5xrx,irq-priority-plan).
+ * Everything is expanded from the devicetree at build time; the IRQ numbers
+ * come from the referenced nodes, never from this file.
+ */
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/irq.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(irq_plan, CONFIG_ANALOG_AUDIO_IRQ_PLAN_LOG_LEVEL);
+
+#define PLAN_DEV(entry) DT_PHANDLE(entry, device)
+
+/* The node's own interrupt @p idx. */
+#define PLAN_SET_IRQ(idx, entry) z_arm_irq_priority_set(DT_IRQ_BY_IDX(PLAN_DEV(entry), idx, irq), DT_PROP(entry, priority), 0)
+
+/* The interrupt of the DMA channel in the node's dmas entry @p idx. */
+#define PLAN_SET_DMA(idx, entry)                                                                                                                               \
+  z_arm_irq_priority_set(DT_IRQ_BY_IDX(DT_DMAS_CTLR_BY_IDX(PLAN_DEV(entry), idx), DT_DMAS_CELL_BY_IDX(PLAN_DEV(entry), idx, channel), irq),                    \
+                         DT_PROP(entry, priority), 0)
+
+#define PLAN_ENTRY(entry)                                                                                                                                      \
+  COND_CODE_1(DT_PROP(entry, dma_channels), (LISTIFY(DT_PROP_LEN(PLAN_DEV(entry), dmas), PLAN_SET_DMA, (;), entry)),                                           \
+              (LISTIFY(DT_NUM_IRQS(PLAN_DEV(entry)), PLAN_SET_IRQ, (;), entry)));                                                                              \
+  LOG_DBG("%s: %s -> %d", DT_NODE_FULL_NAME(entry), DT_NODE_FULL_NAME(PLAN_DEV(entry)), DT_PROP(entry, priority));
+
+#define PLAN(node) DT_FOREACH_CHILD(node, PLAN_ENTRY)
+
+/* Runs after every driver has done its IRQ_CONNECT (which sets the priority
+ * from the interrupts cells), so the plan has the last word. */
+static int irq_plan_apply(void) {
+  DT_FOREACH_STATUS_OKAY(oe5xrx_irq_priority_plan, PLAN)
+  return 0;
+}
+
+SYS_INIT(irq_plan_apply, APPLICATION, 99);
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Interrupt entry timing for the audio DMA channels.
+ *
+ * The ISR calls irq_timing_mark() first thing with a cycle-counter stamp; the
+ * interval to the previous entry is compared with the nominal block period, so
+ * the worst and mean deviation are the ISR entry jitter (latency variation
+ * from other interrupts, IRQ locks and tail-chaining, since the DMA half/full
+ * events themselves are exactly periodic). Single writer (the ISR), any number
+ * of readers: the record is published under a sequence counter, so a reader
+ * never sees a torn update and the writer never waits, which keeps it usable
+ * from a zero-latency interrupt.
+ *
+ * Pure logic: no Zephyr, no heap, no float.
+ */
+#ifndef OE5XRX_AUDIO_IRQ_TIMING_H_
+#define OE5XRX_AUDIO_IRQ_TIMING_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct irq_timing {
+  uint32_t seq;        /* odd while the writer updates */
+  uint32_t nominal;    /* expected interval, cycles */
+  uint32_t last;       /* stamp of the previous entry */
+  uint32_t count;      /* entries since reset */
+  uint32_t period_min; /* shortest interval seen, cycles */
+  uint32_t period_max; /* longest interval seen, cycles */
+  uint32_t jitter_max; /* largest |interval - nominal|, cycles */
+  uint64_t jitter_sum; /* sum of |interval - nominal| over count - 1 intervals */
+};
+
+/** Start over with a nominal interval of @p nominal cycles. Writer idle only. */
+static inline void irq_timing_reset(struct irq_timing *t, uint32_t nominal) {
+  t->nominal = nominal;
+  t->last = 0;
+  t->count = 0;
+  t->period_min = UINT32_MAX;
+  t->period_max = 0;
+  t->jitter_max = 0;
+  t->jitter_sum = 0;
+  __atomic_store_n(&t->seq, 0U, __ATOMIC_RELEASE);
+}
+
+/** Writer: record an entry at cycle stamp @p now (wrap-safe). */
+static inline void irq_timing_mark(struct irq_timing *t, uint32_t now) {
+  const uint32_t seq = t->seq;
+  __atomic_store_n(&t->seq, seq + 1U, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  if (t->count > 0U) {
+    const uint32_t period = now - t->last;
+    const uint32_t dev = period > t->nominal ? period - t->nominal : t->nominal - period;
+    t->period_min = period < t->period_min ? period : t->period_min;
+    t->period_max = period > t->period_max ? period : t->period_max;
+    t->jitter_max = dev > t->jitter_max ? dev : t->jitter_max;
+    t->jitter_sum += dev;
+  }
+  t->last = now;
+  t->count++;
+  __atomic_store_n(&t->seq, seq + 2U, __ATOMIC_RELEASE);
+}
+
+/** Reader: consistent copy of @p t into @p out (spins only while a mark is in flight). */
+static inline void irq_timing_read(const struct irq_timing *t, struct irq_timing *out) {
+  uint32_t seq;
+  do {
+    seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+    out->nominal = t->nominal;
+    out->last = t->last;
+    out->count = t->count;
+    out->period_min = t->period_min;
+    out->period_max = t->period_max;
+    out->jitter_max = t->jitter_max;
+    out->jitter_sum = t->jitter_sum;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while ((seq & 1U) != 0U || seq != __atomic_load_n(&t->seq, __ATOMIC_RELAXED));
+  out->seq = seq;
+}
+
+/** Mean |interval - nominal| in cycles (0 before the second entry). */
+static inline uint32_t irq_timing_jitter_mean(const struct irq_timing *t) {
+  return t->count > 1U ? (uint32_t)(t->jitter_sum / (t->count - 1U)) : 0U;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_IRQ_TIMING_H_ */
@@ -70,8 +70,12 @@ enum sa818_device_power {
  * @brief Set device power state
  *
  * Controls the module's power state via the nPOWER_DOWN GPIO pin.
- * When powered on, the module requires ~100ms to initialize before
- * AT commands can be sent.
+ * Powering on returns once the module answers AT+DMOCONNECT, polled every
+ * CONFIG_SA818_READY_POLL_MS up to CONFIG_SA818_READY_TIMEOUT_MS. The driver
+ * lock is not held while waiting, so other threads keep using the driver.
+ * Hitting the ceiling is not an error: the module stays powered and the miss
+ * is counted in sa818_get_ready_stats(). Powering on an already powered
+ * module returns immediately.
  *
  * @param dev Pointer to the SA818 device structure
  * @param power_state Desired power state (ON or OFF)
@@ -80,10 +84,33 @@ enum sa818_device_power {
  * @return SA818_ERROR_INVALID_DEVICE if device pointer is invalid
  * @return SA818_ERROR_GPIO if GPIO operation failed
  *
- * @note After power-on, wait for module initialization before sending commands
  */
 [[nodiscard]] enum sa818_result sa818_set_power(const struct device *dev, enum sa818_device_power power_state);
 
+/**
+ * @brief Power-up readiness statistics
+ *
+ * Time from releasing PD to the first AT+DMOCONNECT reply, per power-up, to
+ * see the real distribution across units (and how much margin the ceiling has).
+ */
+struct sa818_ready_stats {
+  uint32_t last_ms;       /**< Last power-up's ready time (0 if it timed out) */
+  uint32_t min_ms;        /**< Fastest ready time seen */
+  uint32_t max_ms;        /**< Slowest ready time seen */
+  uint32_t sum_ms;        /**< Sum of ready times (mean = sum_ms / count) */
+  uint32_t count;         /**< Power-ups that became ready */
+  uint32_t timeouts;      /**< Power-ups that hit the ceiling */
+  uint32_t last_attempts; /**< AT+DMOCONNECT probes sent in the last power-up */
+};
+
+/**
+ * @brief Get power-up readiness statistics (thread-safe)
+ *
+ * @param dev Pointer to the SA818 device structure
+ * @return Snapshot of the readiness statistics since boot
+ */
+struct sa818_ready_stats sa818_get_ready_stats(const struct device *dev);
+
 /**
  * @brief PTT (Push-To-Talk) states
  *
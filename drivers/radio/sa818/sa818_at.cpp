@@ -223,6 +223,47 @@ sa818_result sa818_at_send_command(const struct device *dev, const char *cmd, ch
   return SA818_OK;
 }
 
+sa818_result sa818_at_probe(const struct device *dev, bool restart, uint32_t window_ms) {
+  static constexpr std::string_view kReady = "+DMOCONNECT:0";
+  const struct sa818_config *cfg = static_cast<const struct sa818_config *>(dev->config);
+  struct sa818_data *data = static_cast<struct sa818_data *>(dev->data);
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  if (restart) {
+    uart_flush_rx(data);
+    data->probe_match = 0;
+  }
+  (void)uart_write_command(cfg->uart, "AT+DMOCONNECT");
+
+  /* Byte-wise match so a reply split across two windows still counts. The
+   * pattern's first character does not recur, so a mismatch only needs to
+   * re-test that byte as a fresh start. */
+  const int64_t start = k_uptime_get();
+  while (true) {
+    uint8_t c;
+    while (ring_buf_get(&data->at_rx_rb, &c, 1) == 1) {
+      if (c == static_cast<uint8_t>(kReady[data->probe_match])) {
+        data->probe_match++;
+      } else {
+        data->probe_match = (c == static_cast<uint8_t>(kReady[0])) ? 1 : 0;
+      }
+      if (data->probe_match == kReady.size()) {
+        data->probe_match = 0;
+        k_mutex_unlock(&data->lock);
+        return SA818_OK;
+      }
+    }
+    int32_t remaining = static_cast<int32_t>(window_ms) - static_cast<int32_t>(k_uptime_get() - start);
+    if (remaining <= 0 || k_sem_take(&data->at_rx_sem, K_MSEC(remaining)) != 0) {
+      break;
+    }
+  }
+
+  k_mutex_unlock(&data->lock);
+  return SA818_ERROR_TIMEOUT;
+}
+
 /**
  * @brief Establish connection handshake with SA818 module
  *
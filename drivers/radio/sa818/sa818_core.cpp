@@ -22,6 +22,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#ifdef CONFIG_EVENT_BUS
+#include <oe5xrx/events/bus.h>
+#endif
+
 LOG_MODULE_REGISTER(sa818_core, LOG_LEVEL_INF);
 
 /* GPIO Initialization */
@@ -39,6 +43,30 @@ int sa818_gpio_init(const struct sa818_config *cfg) {
   return 0;
 }
 
+#ifdef CONFIG_EVENT_BUS
+/* Both SQL edges, straight from the GPIO ISR: subscribers learn about a carrier
+ * without anyone polling sa818_get_squelch(). */
+static void sa818_squelch_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins) {
+  ARG_UNUSED(port);
+  ARG_UNUSED(pins);
+  struct sa818_data *data = CONTAINER_OF(cb, struct sa818_data, squelch_cb);
+  /* SQL high = squelch open = no signal */
+  events::publish(events::Type::Squelch, gpio_pin_get_dt(data->nsquelch) > 0 ? 0 : 1);
+}
+
+static void sa818_squelch_irq_init(const struct sa818_config *cfg, struct sa818_data *data) {
+  data->nsquelch = &cfg->nsquelch;
+  gpio_init_callback(&data->squelch_cb, sa818_squelch_isr, BIT(cfg->nsquelch.pin));
+  int ret = gpio_add_callback_dt(&cfg->nsquelch, &data->squelch_cb);
+  if (ret == 0) {
+    ret = gpio_pin_interrupt_configure_dt(&cfg->nsquelch, GPIO_INT_EDGE_BOTH);
+  }
+  if (ret != 0) {
+    LOG_WRN("SQL interrupt unavailable (%d), no squelch events", ret);
+  }
+}
+#endif
+
 /* Device Initialization */
 static int sa818_init(const struct device *dev) {
   const struct sa818_config *cfg = static_cast<const struct sa818_config *>(dev->config);
@@ -86,6 +114,9 @@ static int sa818_init(const struct device *dev) {
   data->squelch = false;
   data->current_volume = 4; // Default mid-level
   data->at_rx_overrun = false;
+  data->power_gen = 0;
+  data->probe_match = 0;
+  data->ready_stats = {};
 
   ret = sa818_at_uart_init(dev);
   if (ret != 0) {
@@ -93,6 +124,10 @@ static int sa818_init(const struct device *dev) {
     return ret;
   }
 
+#ifdef CONFIG_EVENT_BUS
+  sa818_squelch_irq_init(cfg, data);
+#endif
+
   /* Give hardware time to stabilize */
   k_msleep(SA818_INIT_DELAY_MS);
 
@@ -100,6 +135,71 @@ static int sa818_init(const struct device *dev) {
   return 0;
 }
 
+/* Record one power-up outcome; @p ready_ms < 0 means the ceiling was hit. */
+static void sa818_record_ready(struct sa818_data *data, int32_t ready_ms, uint32_t attempts) {
+  k_mutex_lock(&data->lock, K_FOREVER);
+  struct sa818_ready_stats *st = &data->ready_stats;
+  st->last_attempts = attempts;
+  if (ready_ms < 0) {
+    st->last_ms = 0;
+    st->timeouts++;
+  } else {
+    const uint32_t ms = static_cast<uint32_t>(ready_ms);
+    st->last_ms = ms;
+    if (st->count == 0 || ms < st->min_ms) {
+      st->min_ms = ms;
+    }
+    if (ms > st->max_ms) {
+      st->max_ms = ms;
+    }
+    st->sum_ms += ms;
+    st->count++;
+  }
+  k_mutex_unlock(&data->lock);
+}
+
+/* Poll AT+DMOCONNECT until the module answers. The driver lock is only held
+ * per attempt, so status/PTT/AT users are never stuck behind a power-up. */
+static void sa818_wait_ready(const struct device *dev, uint32_t gen, int64_t t0) {
+  struct sa818_data *data = static_cast<struct sa818_data *>(dev->data);
+  uint32_t attempts = 0;
+
+  while (true) {
+    const int64_t attempt_start = k_uptime_get();
+    attempts++;
+    if (sa818_at_probe(dev, attempts == 1, CONFIG_SA818_READY_POLL_MS) == SA818_OK) {
+      const int32_t ms = static_cast<int32_t>(k_uptime_get() - t0);
+      sa818_record_ready(data, ms, attempts);
+      LOG_INF("SA818 powered ON, ready after %d ms (%u probes)", ms, attempts);
+#ifdef CONFIG_EVENT_BUS
+      events::publish(events::Type::AtLink, ms);
+#endif
+      return;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    const bool stale = data->power_gen != gen;
+    k_mutex_unlock(&data->lock);
+    if (stale) {
+      return; /* powered off (or re-powered) meanwhile; that caller owns it now */
+    }
+
+    const int64_t now = k_uptime_get();
+    if (now - t0 >= CONFIG_SA818_READY_TIMEOUT_MS) {
+      sa818_record_ready(data, -1, attempts);
+      LOG_WRN("SA818 powered ON, no AT reply within %d ms (%u probes)", CONFIG_SA818_READY_TIMEOUT_MS, attempts);
+#ifdef CONFIG_EVENT_BUS
+      events::publish(events::Type::AtLink, -1);
+#endif
+      return;
+    }
+    const int32_t rest = CONFIG_SA818_READY_POLL_MS - static_cast<int32_t>(now - attempt_start);
+    if (rest > 0) {
+      k_msleep(rest);
+    }
+  }
+}
+
 /* Power Control */
 sa818_result sa818_set_power(const struct device *dev, sa818_device_power power_state) {
   const struct sa818_config *cfg = static_cast<const struct sa818_config *>(dev->config);
@@ -107,21 +207,43 @@ sa818_result sa818_set_power(const struct device *dev, sa818_device_power power_
 
   k_mutex_lock(&data->lock, K_FOREVER);
 
+  if (power_state == SA818_DEVICE_ON && data->device_power == SA818_DEVICE_ON) {
+    k_mutex_unlock(&data->lock);
+    return SA818_OK; /* already up; no new power-up to wait for */
+  }
+
   if (power_state == SA818_DEVICE_ON) {
     gpio_pin_set_dt(&cfg->npower_down, 0); // Active LOW
-    k_msleep(SA818_POWER_ON_DELAY_MS);     // Wait for module to power up
-    LOG_INF("SA818 powered ON");
   } else {
     gpio_pin_set_dt(&cfg->npower_down, 1);
     LOG_INF("SA818 powered OFF");
   }
 
   data->device_power = power_state;
+  const uint32_t gen = ++data->power_gen;
+  const int64_t t0 = k_uptime_get();
   k_mutex_unlock(&data->lock);
+#ifdef CONFIG_EVENT_BUS
+  events::publish(events::Type::RadioPower, power_state == SA818_DEVICE_ON ? 1 : 0);
+#endif
+
+  if (power_state == SA818_DEVICE_ON) {
+    sa818_wait_ready(dev, gen, t0);
+  }
 
   return SA818_OK;
 }
 
+sa818_ready_stats sa818_get_ready_stats(const struct device *dev) {
+  struct sa818_data *data = static_cast<struct sa818_data *>(dev->data);
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  sa818_ready_stats st = data->ready_stats;
+  k_mutex_unlock(&data->lock);
+
+  return st;
+}
+
 /* PTT Control */
 sa818_result sa818_set_ptt(const struct device *dev, sa818_ptt_state ptt_state) {
   const struct sa818_config *cfg = static_cast<const struct sa818_config *>(dev->config);
@@ -140,6 +262,9 @@ sa818_result sa818_set_ptt(const struct device *dev, sa818_ptt_state ptt_state)
 
   data->ptt_state = ptt_state;
   k_mutex_unlock(&data->lock);
+#ifdef CONFIG_EVENT_BUS
+  events::publish(events::Type::Ptt, ptt_state == SA818_PTT_ON ? 1 : 0);
+#endif
 
   return SA818_OK;
 }
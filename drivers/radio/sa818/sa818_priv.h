@@ -39,11 +39,10 @@ extern "C" {
 
 /* Initialization delays */
 #define SA818_INIT_DELAY_MS 10
-/* SA818 needs a few hundred ms after PD is released before it accepts AT
- * commands; 500 ms is a safe margin. (The earlier 1500 ms was a red herring
- * from debugging the swapped PD GPIO, which is the real reason the module
- * used to stay silent.) */
-#define SA818_POWER_ON_DELAY_MS 500
+/* The SA818 needs a few hundred ms after PD is released before it accepts AT
+ * commands. Instead of sleeping a fixed worst case, power-up polls with
+ * AT+DMOCONNECT every CONFIG_SA818_READY_POLL_MS until it answers or
+ * CONFIG_SA818_READY_TIMEOUT_MS passes (see sa818_set_power()). */
 
 /**
  * @brief SA818 device configuration (from devicetree)
@@ -79,6 +78,17 @@ struct sa818_data {
 
   /* SA818 AT volume setting (AT+DMOSETVOLUME), reported in sa818_status */
   uint8_t current_volume;
+
+  /* Power-up readiness polling (under lock) */
+  uint32_t power_gen;                   /* bumped on every power transition; a stale poll stops */
+  uint8_t probe_match;                  /* bytes of "+DMOCONNECT:0" matched so far */
+  struct sa818_ready_stats ready_stats; /* reported by sa818_get_ready_stats() */
+
+#ifdef CONFIG_EVENT_BUS
+  /* Squelch edges are published from the GPIO ISR (events::Type::Squelch) */
+  struct gpio_callback squelch_cb;
+  const struct gpio_dt_spec *nsquelch;
+#endif
 };
 
 /**
@@ -91,6 +101,18 @@ int sa818_gpio_init(const struct sa818_config *cfg);
 
 int sa818_at_uart_init(const struct device *dev);
 
+/**
+ * @brief One power-up readiness probe: send AT+DMOCONNECT and scan the RX
+ * stream for "+DMOCONNECT:0" for up to @p window_ms.
+ *
+ * Unlike sa818_at_send_command() the RX ring is only flushed when @p restart
+ * is set (first attempt), so a reply that lands after its own window is still
+ * matched by the next attempt. Timeouts are expected and not logged.
+ *
+ * @return SA818_OK when the module answered, SA818_ERROR_TIMEOUT otherwise.
+ */
+enum sa818_result sa818_at_probe(const struct device *dev, bool restart, uint32_t window_ms);
+
 #ifdef __cplusplus
 }
 #endif
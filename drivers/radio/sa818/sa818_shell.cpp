@@ -66,6 +66,19 @@ static int cmd_sa818_power(const struct shell *shell, size_t argc, char **argv)
   return 0;
 }
 
+static int cmd_sa818_ready(const struct shell *shell, size_t, char **) {
+  const struct device *dev = sa818_dev();
+  if (!dev || !device_is_ready(dev)) {
+    shell_error(shell, "sa818 not ready");
+    return -ENODEV;
+  }
+
+  sa818_ready_stats st = sa818_get_ready_stats(dev);
+  shell_print(shell, "SA818-READY last_ms=%u min_ms=%u max_ms=%u mean_ms=%u count=%u timeouts=%u probes=%u", st.last_ms, st.min_ms, st.max_ms,
+              st.count ? st.sum_ms / st.count : 0U, st.count, st.timeouts, st.last_attempts);
+  return 0;
+}
+
 static int cmd_sa818_ptt(const struct shell *shell, size_t argc, char **argv) {
   if (argc < 2) {
     shell_error(shell, "usage: sa818 ptt on|off");
@@ -382,6 +395,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
     sa818_cmds,
     SHELL_CMD(status, NULL, "Show SA818 status", cmd_sa818_status),
     SHELL_CMD(power, NULL, "Power on/off", cmd_sa818_power),
+    SHELL_CMD(ready, NULL, "Power-up readiness statistics", cmd_sa818_ready),
     SHELL_CMD(ptt, NULL, "PTT on/off", cmd_sa818_ptt),
     SHELL_CMD(powerlevel, NULL, "Power level", cmd_sa818_powerlevel),
     SHELL_COND_CMD(CONFIG_GPIO_EMUL, sim_squelch, NULL, "Simulate squelch (sim only)", cmd_sa818_squelch_sim),
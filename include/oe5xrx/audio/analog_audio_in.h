@@ -5,6 +5,7 @@
 #ifndef OE5XRX_AUDIO_ANALOG_AUDIO_IN_H_
 #define OE5XRX_AUDIO_ANALOG_AUDIO_IN_H_
 
+#include <oe5xrx/audio/analog_audio_irq.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/device.h>
@@ -23,8 +24,8 @@ extern "C" {
 #endif
 
 /**
- * Delivers a batch of converted 16-bit PCM samples. Invoked from the system
- * workqueue thread (not IRQ context), so the consumer may block / take a mutex.
+ * Delivers a batch of converted 16-bit PCM samples. Invoked from the audio
+ * work queue thread (not IRQ context), so the consumer may block / take a mutex.
  */
 typedef void (*analog_audio_in_cb)(const int16_t *samples, size_t count, void *user_data);
 
@@ -34,6 +35,53 @@ ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_in_start(const struct device *dev, a
 /** Stop capture. */
 ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_in_stop(const struct device *dev);
 
+/**
+ * Set the sampling-timer period to @p ticks (ARR + 1) of the timer clock.
+ * Takes effect at the next sample (ARR is preloaded).
+ * @return 0 on success, -EAGAIN when not running, -EINVAL if out of range.
+ */
+ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_in_set_period(const struct device *dev, uint32_t ticks);
+
+/**
+ * DMA interrupt entry timing since the last start (see analog_audio_irq.h).
+ * @return 0 on success, -ENOTSUP without CONFIG_ANALOG_AUDIO_IRQ_STATS (and on
+ *         the native_sim emulator), -EINVAL on a bad argument.
+ */
+ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_in_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats);
+
+/** Auxiliary io-channels converted along with the audio one. */
+#define ANALOG_AUDIO_IN_AUX_MAX 4
+
+/** What an auxiliary channel measures (detected from its ADC channel number). */
+enum analog_audio_in_aux_kind {
+  ANALOG_AUDIO_IN_AUX_PIN,     /**< external input pin */
+  ANALOG_AUDIO_IN_AUX_VREFINT, /**< internal reference; gives VDDA */
+  ANALOG_AUDIO_IN_AUX_TEMP,    /**< internal temperature sensor */
+  ANALOG_AUDIO_IN_AUX_VBAT,    /**< backup supply through the internal bridge */
+};
+
+/** Latest average of one auxiliary channel. */
+struct analog_audio_in_aux {
+  const char *name;                   /**< io-channel-names entry */
+  enum analog_audio_in_aux_kind kind;
+  uint32_t raw_q4;     /**< average ADC reading, Q4 */
+  uint32_t millivolts; /**< input voltage (VBAT: the supply, bridge undone) */
+  uint32_t vdda_mv;    /**< reference used: measured via VREFINT or vref-mv */
+  int32_t temp_dc;     /**< die temperature in 0.1 degC (TEMP only, else 0) */
+  uint32_t updates;    /**< averages published since boot */
+};
+
+/**
+ * Latest average of auxiliary channel @p index (io-channels[index + 1]). The
+ * auxiliary ranks convert after the audio one on every trigger and are
+ * averaged over aux-average-samples triggers; the value stays at the last
+ * average while capture is stopped.
+ * @return 0 on success, -ENOENT if @p index is past the last channel, -EAGAIN
+ *         before the first average, -ENOTSUP on the native_sim emulator,
+ *         -EINVAL on a bad argument.
+ */
+ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_in_get_aux(const struct device *dev, uint8_t index, struct analog_audio_in_aux *aux);
+
 #ifdef __cplusplus
 }
 #endif
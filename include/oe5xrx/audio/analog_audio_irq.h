@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * DMA interrupt timing of the analog audio drivers, shared by
+ * analog_audio_in_get_irq_stats() and analog_audio_out_get_irq_stats().
+ */
+#ifndef OE5XRX_AUDIO_ANALOG_AUDIO_IRQ_H_
+#define OE5XRX_AUDIO_ANALOG_AUDIO_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Entry timing of the DMA half/full-transfer interrupt since the last start,
+ * in CPU cycles (DWT cycle counter). The DMA events are exactly one block
+ * apart, so any deviation of the interval between ISR entries from
+ * @c nominal_cyc is ISR entry jitter.
+ */
+struct analog_audio_irq_stats {
+  bool zli;                 /**< handler runs as a zero-latency interrupt (CONFIG_ANALOG_AUDIO_DMA_ZLI) */
+  uint32_t cpu_hz;          /**< cycle counter rate */
+  uint32_t count;           /**< interrupts since start */
+  uint32_t nominal_cyc;     /**< one block at the nominal sample rate */
+  uint32_t period_min_cyc;  /**< shortest interval between entries */
+  uint32_t period_max_cyc;  /**< longest interval between entries */
+  uint32_t jitter_max_cyc;  /**< largest |interval - nominal| */
+  uint32_t jitter_mean_cyc; /**< mean |interval - nominal| */
+  uint32_t overruns;        /**< blocks the thread side did not take in time */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_ANALOG_AUDIO_IRQ_H_ */
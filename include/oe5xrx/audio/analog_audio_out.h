@@ -5,6 +5,7 @@
 #ifndef OE5XRX_AUDIO_ANALOG_AUDIO_OUT_H_
 #define OE5XRX_AUDIO_ANALOG_AUDIO_OUT_H_
 
+#include <oe5xrx/audio/analog_audio_irq.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/device.h>
@@ -23,7 +24,7 @@ extern "C" {
 #endif
 
 /** Fill up to @p max PCM samples into @p dst; return the count provided (0..max).
- *  Runs in thread context (system workqueue); may take a mutex. */
+ *  Runs in thread context (the audio work queue); may take a mutex. */
 typedef size_t (*analog_audio_out_src)(int16_t *dst, size_t max, void *user_data);
 
 /** Start hardware-timed playback; @p src is polled to refill each DMA block. */
@@ -32,6 +33,37 @@ ANALOG_AUDIO_OUT_MUST_CHECK int analog_audio_out_start(const struct device *dev,
 /** Stop playback. */
 ANALOG_AUDIO_OUT_MUST_CHECK int analog_audio_out_stop(const struct device *dev);
 
+/** Fractional bits of analog_audio_out_clock::position. */
+#define ANALOG_AUDIO_OUT_POS_FRAC_BITS 8
+
+/** Sample clock state, for locking the sample rate to an external reference. */
+struct analog_audio_out_clock {
+  uint32_t tim_hz;   /**< sampling-timer kernel clock, Hz */
+  uint32_t position; /**< samples clocked out since start, Q24.8 (wraps) */
+};
+
+/**
+ * Read the playback position. Any thread; not from the DMA ISR.
+ * @return 0 on success, -EAGAIN when not running, -EBUSY if no consistent
+ *         reading was possible, -EINVAL on bad arguments.
+ */
+ANALOG_AUDIO_OUT_MUST_CHECK int analog_audio_out_get_clock(const struct device *dev, struct analog_audio_out_clock *clk);
+
+/**
+ * Set the sampling-timer period to @p ticks (ARR + 1) of tim_hz. Takes effect
+ * at the next sample (ARR is preloaded). Used to trim the rate fractionally by
+ * alternating neighbouring periods.
+ * @return 0 on success, -EAGAIN when not running, -EINVAL if out of range.
+ */
+ANALOG_AUDIO_OUT_MUST_CHECK int analog_audio_out_set_period(const struct device *dev, uint32_t ticks);
+
+/**
+ * DMA interrupt entry timing since the last start (see analog_audio_irq.h).
+ * @return 0 on success, -ENOTSUP without CONFIG_ANALOG_AUDIO_IRQ_STATS (and on
+ *         the native_sim emulator), -EINVAL on a bad argument.
+ */
+ANALOG_AUDIO_OUT_MUST_CHECK int analog_audio_out_get_irq_stats(const struct device *dev, struct analog_audio_irq_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_ANALOG_AUDIO_OUT_EMUL_H_
+#define OE5XRX_AUDIO_ANALOG_AUDIO_OUT_EMUL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Take up to @p max of the oldest samples played by an analog-audio-out
+ * emulator (the loopback "cable"). Any context.
+ * @return Samples copied to @p dst (0 when nothing was played since).
+ */
+size_t analog_audio_out_emul_read(const struct device *dev, int16_t *dst, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_ANALOG_AUDIO_OUT_EMUL_H_ */
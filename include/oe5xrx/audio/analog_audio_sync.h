@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_ANALOG_AUDIO_SYNC_H_
+#define OE5XRX_AUDIO_ANALOG_AUDIO_SYNC_H_
+
+#include <oe5xrx/audio/analog_audio_in.h>
+#include <oe5xrx/audio/analog_audio_out.h>
+#include <zephyr/device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Capture and playback on one sample clock. An analog-audio-out node with
+ * `sync-source = <&audio_in>` has its DAC triggered by the capture's
+ * sampling-timer TRGO instead of a timer of its own, so both directions share
+ * every sample edge and every period trim (set_period on either reloads the
+ * shared timer). The capture owns that timer: playback only advances while
+ * capture runs, so start and stop the pair with the functions below.
+ */
+
+/**
+ * Samples between the edge that captures ADC sample n and the one that puts
+ * DAC sample n on the pin: a triggered DAC outputs the value the DMA wrote
+ * after the previous trigger. In a DAC->ADC loopback, capture sample n + 1 is
+ * the first to see playback sample n (plus the analog path).
+ */
+#define ANALOG_AUDIO_SYNC_DAC_DELAY 1
+
+/**
+ * Start capture on @p in and playback on @p out (synchronised to @p in) from
+ * the same edge: both are armed with the timer stopped, then the timer is
+ * started, so capture sample 0 and playback sample 0 belong to its first
+ * update. With equal block-samples the DMA blocks of both directions then
+ * cover the same edges.
+ * @return 0 on success, -EINVAL if @p out is not synchronised to @p in, or
+ *         the start() error of either side (nothing is left running).
+ */
+ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_sync_start(const struct device *in, analog_audio_in_cb in_cb, void *in_user, const struct device *out,
+                                                       analog_audio_out_src out_src, void *out_user);
+
+/**
+ * Stop both. Stopping the capture stops the shared timer first, so both
+ * directions end on the same edge.
+ * @return 0, or the first error of the two stop() calls.
+ */
+ANALOG_AUDIO_IN_MUST_CHECK int analog_audio_sync_stop(const struct device *in, const struct device *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_ANALOG_AUDIO_SYNC_H_ */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Serial audio link: compressed audio plus PTT/COS over a plain UART or
+ * CDC-ACM stream, for linking two stations (or a station and a PC) without
+ * USB audio.
+ *
+ * audio_link_rx_data() and audio_link_tx_request() have the audio_stream
+ * rx_data / tx_request callback signatures, so the link plugs straight into
+ * audio_stream_register() on both ends:
+ *
+ *   capture  -> audio_link_rx_data    -> IMA-ADPCM frames -> UART
+ *   UART     -> [link thread] -> jitter buffer -> audio_link_tx_request -> playback
+ *
+ * Every frame carries a sequence number, the sender's sample clock and the
+ * ADPCM state, so losses, reordering and jitter are handled per frame (see
+ * the framing in subsys/audio_link/link_frame.h). Frames also carry two
+ * flags: COS (the sender's receiver has a carrier) and PTT (the sender asks
+ * the far end to transmit), delivered through the PTT callback.
+ */
+#ifndef OE5XRX_AUDIO_AUDIO_LINK_H_
+#define OE5XRX_AUDIO_AUDIO_LINK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Far end's PTT request changed. Runs in the link thread (may block, e.g. to
+ * key the transmitter). Also called with @p on = false when frames stop
+ * arriving for CONFIG_AUDIO_LINK_PTT_HANG_MS.
+ */
+typedef void (*audio_link_ptt_cb)(bool on, void *user_data);
+
+/** Link, jitter buffer and latency-probe counters. */
+struct audio_link_stats {
+  uint32_t tx_frames;
+  uint32_t tx_overruns;   /**< frames dropped: UART could not keep up */
+  uint32_t rx_frames;     /**< valid frames received */
+  uint32_t rx_crc_errors; /**< frame candidates rejected by CRC/version */
+  uint32_t rx_skipped;    /**< bytes skipped while hunting for sync */
+  uint32_t rx_overruns;   /**< bytes lost: link thread fell behind the UART */
+  uint32_t rx_bad_length; /**< frames with a different frame duration */
+  uint32_t played;        /**< frames played out */
+  uint32_t concealed;     /**< frames missing at playout, concealed */
+  uint32_t late;          /**< frames arriving after their playout time */
+  uint32_t duplicates;
+  uint32_t underruns; /**< jitter buffer ran dry and rebuffered */
+  uint32_t resyncs;   /**< sequence jumps that flushed the buffer */
+  uint32_t shrinks;   /**< frames dropped to cut excess delay */
+  uint32_t jitter_us; /**< interarrival jitter estimate */
+  uint32_t target_ms; /**< jitter buffer target depth */
+  uint32_t depth_ms;  /**< jitter buffer current depth */
+  bool cos;           /**< local carrier, sent in every frame */
+  bool ptt;           /**< PTT flag sent in every frame */
+  bool remote_cos;
+  bool remote_ptt;
+  uint32_t probes;        /**< latency probes answered */
+  uint32_t probes_lost;   /**< latency probes that never came back */
+  uint32_t probe_last_us; /**< last probe round trip */
+  uint32_t probe_min_us;
+  uint32_t probe_max_us;
+};
+
+/**
+ * Start the link on @p uart (interrupt-driven UART API).
+ * @param on_ptt Far-end PTT requests (may be NULL).
+ * @return 0 on success, -EALREADY if running, -ENODEV if @p uart is not
+ *         ready, negative errno from the UART driver otherwise.
+ */
+int audio_link_start(const struct device *uart, audio_link_ptt_cb on_ptt, void *user_data);
+
+/** Stop the link; a far-end PTT request still held is released. */
+int audio_link_stop(void);
+
+/** audio_stream rx_data callback: frame, encode and send captured PCM. */
+void audio_link_rx_data(const struct device *dev, const uint8_t *buffer, size_t size, void *user_data);
+
+/** audio_stream tx_request callback: play out received audio (silence while buffering). */
+size_t audio_link_tx_request(const struct device *dev, uint8_t *buffer, size_t size, void *user_data);
+
+/** Set the local carrier state sent as COS (fed from squelch events with CONFIG_EVENT_BUS). */
+void audio_link_set_cos(bool carrier);
+
+/** Ask the far end to transmit (e.g. from a PC-side PTT), independent of COS. */
+void audio_link_set_ptt(bool on);
+
+/**
+ * Diagnostic loop mode: send back what is played out instead of the capture,
+ * so the far end can measure its mouth-to-ear round trip with
+ * audio_link_probe().
+ */
+void audio_link_set_echo(bool on);
+
+/**
+ * Measure the round trip through a far end in echo mode: replace the next
+ * outgoing frame with a 1 kHz marker and wait until it is played out here.
+ * Blocks the caller for up to @p timeout_ms.
+ * @return round trip in microseconds, -ETIMEDOUT if the marker never came
+ *         back, -EAGAIN if the link is stopped, -EBUSY if a probe is running.
+ */
+int32_t audio_link_probe(uint32_t timeout_ms);
+
+/** Snapshot the counters. */
+void audio_link_get_stats(struct audio_link_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_AUDIO_LINK_H_ */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * DCS monitor: decodes the sub-audible Digital-Coded Squelch code from the RX
+ * capture (see subsys/dcs/dcs_decoder.h for the signal chain).
+ *
+ * audio_stream feeds every captured block through dcs_monitor_feed(), before
+ * de-emphasis; any thread may read the result with dcs_monitor_get().
+ */
+#ifndef OE5XRX_AUDIO_DCS_H_
+#define OE5XRX_AUDIO_DCS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Decoder state snapshot. Codes are octal values (print with %03o). */
+struct dcs_status {
+  bool locked;          /**< a code is currently confirmed */
+  uint16_t code;        /**< detected code, valid while locked */
+  bool inverted;        /**< polarity: false = "N", true = "I" */
+  bool has_alias;       /**< the same bit stream is also alias_code, opposite polarity */
+  uint16_t alias_code;  /**< e.g. 023 while 047N is locked (047N == 023I on air) */
+  uint32_t words;       /**< codeword periods matched since lock */
+  uint32_t corrected;   /**< bit errors corrected over those words */
+  uint32_t locks;       /**< lock events since boot */
+  uint32_t samples;     /**< samples decoded since boot */
+  uint32_t cycles_last; /**< k_cycle_get_32() ticks for the last fed block */
+  uint32_t cycles_max;  /**< worst fed block since boot */
+  uint64_t cycles_total;
+  uint32_t cycles_per_sec; /**< k_cycle_get_32() rate, for converting to time */
+};
+
+/** Decode one block of 8 kHz signed 16-bit PCM (single caller: the capture path). */
+void dcs_monitor_feed(const int16_t *samples, size_t count);
+
+/** Snapshot the decoder state and cost counters. */
+void dcs_monitor_get(struct dcs_status *status);
+
+/**
+ * Format a code as "023N" / "023I" into @p buf (at least 5 bytes).
+ * @return @p buf
+ */
+char *dcs_code_str(uint16_t code, bool inverted, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_DCS_H_ */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Voice prompts: spoken frequency and status announcements on the TX audio,
+ * built from pre-encoded word clips in flash (see subsys/voice/voice_prompt.h
+ * for the vocabulary and how text becomes words).
+ *
+ * audio_stream offers every playback block to voice_prompt_play(); while an
+ * announcement runs it replaces the host audio there, which is still pulled
+ * and discarded so the USB feedback loop does not notice. An announcement
+ * keys the transmitter through the PTT callback, waits
+ * CONFIG_VOICE_PROMPT_PTT_LEAD_MS, plays, and unkeys
+ * CONFIG_VOICE_PROMPT_PTT_TAIL_MS after the last sample. A transmitter that
+ * was keyed already is left keyed, without the lead.
+ */
+#ifndef OE5XRX_AUDIO_VOICE_PROMPT_H_
+#define OE5XRX_AUDIO_VOICE_PROMPT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key (@p on) or unkey the transmitter. Runs in the voice prompt work queue
+ * and may block on the radio.
+ * @return whether the transmitter was keyed before the call.
+ */
+typedef bool (*voice_prompt_ptt_cb)(bool on, void *user_data);
+
+struct voice_prompt_status {
+  bool busy;            /**< an announcement is keying, playing or in its tail */
+  uint32_t prompts;     /**< announcements played to the end */
+  uint32_t aborted;     /**< announcements cut off (cancelled, or playback stalled) */
+  uint32_t missing;     /**< words skipped: no clip in the pack */
+  uint32_t samples;     /**< samples played since boot */
+  uint32_t cycles_last; /**< k_cycle_get_32() ticks for the last playback block */
+  uint32_t cycles_max;  /**< worst playback block since boot */
+  uint64_t cycles_total;
+  uint32_t cycles_per_sec; /**< k_cycle_get_32() rate, for converting to time */
+};
+
+/** Set the PTT callback (NULL: play without keying, e.g. into a local speaker). */
+void voice_prompt_init(voice_prompt_ptt_cb on_ptt, void *user_data);
+
+/**
+ * Announce @p text, e.g. "433.5 MHz" or "OE5XRX".
+ * @return utterance length in ms, -EINVAL if there is nothing to say or it is
+ *         too long, -EBUSY while another announcement runs.
+ */
+int voice_prompt_say(const char *text);
+
+/**
+ * Announce the current value of a module capability with its unit, e.g.
+ * ("fm", "rx_frequency") -> "4 3 3 point 5 megahertz". Needs
+ * CONFIG_VOICE_PROMPT_MODULE.
+ * @return as voice_prompt_say(); -ENOENT for an unknown module or capability,
+ *         -EIO if reading it failed, -ENOTSUP if not built in.
+ */
+int voice_prompt_announce(const char *module, const char *cap);
+
+/** Cut the running announcement short (its tail and unkeying still follow). */
+void voice_prompt_cancel(void);
+
+/**
+ * Playback hook: @p dst holds @p count samples from the regular source in a
+ * block of @p max. While an announcement holds the transmitter (lead, play
+ * and tail), overwrites the block and returns @p max; when idle, returns
+ * @p count untouched. Single caller: the playback thread.
+ */
+size_t voice_prompt_play(int16_t *dst, size_t count, size_t max);
+
+/** Snapshot the engine state and cost counters. */
+void voice_prompt_get(struct voice_prompt_status *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_AUDIO_VOICE_PROMPT_H_ */
@@ -0,0 +1,123 @@
+/**
+ * @file bus.h
+ * @brief Internal publish/subscribe bus for radio and audio state changes.
+ *
+ * Drivers and the audio pipeline publish typed events (squelch, PTT, power,
+ * AT link health, stream start/stop, stalls) with publish(), which is ISR-safe
+ * and never blocks: the event goes into a fixed-capacity lock-free ring and the
+ * bus thread is woken. The bus thread fans every event out to the per-
+ * subscriber queues of the subscribers whose mask matches, then runs the
+ * subscribers' handlers. Subscribers without a handler drain their queue from
+ * their own thread with Subscriber::wait() instead of polling drivers.
+ *
+ * Everything is static: the subscriber table and all queues are ETL
+ * containers sized by Kconfig. Each event is stamped with the cycle counter at
+ * publish(); the publish-to-delivery latency is accounted against
+ * CONFIG_EVENT_BUS_LATENCY_BUDGET_US (`events stats`).
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#ifndef OE5XRX_EVENTS_BUS_H_
+#define OE5XRX_EVENTS_BUS_H_
+
+#ifndef __cplusplus
+#error "oe5xrx/events/bus.h is a C++ header (namespaces/classes); include it only from C++."
+#endif
+
+#include <etl/queue_spsc_atomic.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+namespace events {
+
+enum class Type : uint8_t {
+  Squelch,     /**< value: 1 = carrier (receiver unmuted), 0 = no carrier */
+  Ptt,         /**< value: 1 = transmitting */
+  RadioPower,  /**< value: 1 = powered on */
+  AtLink,      /**< value: ms until the module answered AT after power-up, -1 = no reply */
+  AudioStream, /**< value: 1 = started, 0 = stopped */
+  AudioStall,  /**< value: stalled watchdog channel mask, 0 = recovered */
+  Count,
+};
+
+constexpr uint32_t mask(Type t) { return 1U << static_cast<uint8_t>(t); }
+constexpr uint32_t kAllTypes = (1U << static_cast<uint8_t>(Type::Count)) - 1U;
+
+/** Printable name of @p t ("squelch", "ptt", ...). */
+const char *typeName(Type t);
+
+struct Event {
+  Type type;
+  int32_t value;
+  uint32_t stamp; /**< k_cycle_get_32() at publish() */
+};
+
+/**
+ * Publish an event. Any thread or ISR; never blocks.
+ * @return false if the ingress ring was full (the event is dropped and counted).
+ */
+bool publish(Type type, int32_t value);
+
+class Subscriber {
+public:
+  using Handler = void (*)(const Event &evt, void *user_data);
+
+  /**
+   * @param name      Shown by `events stats`.
+   * @param type_mask Events to receive (bit per Type, see mask()).
+   * @param handler   Called on the bus thread for each event; keep it short and
+   *                  non-blocking. nullptr: the owner calls wait() instead.
+   */
+  Subscriber(const char *name, uint32_t type_mask, Handler handler = nullptr, void *user_data = nullptr)
+      : name_(name), mask_(type_mask), handler_(handler), user_data_(user_data) {}
+
+  /**
+   * Take the next event (handler-less subscribers, from the owning thread).
+   * @return false on timeout.
+   */
+  bool wait(Event &out, k_timeout_t timeout);
+
+  const char *name() const { return name_; }
+  uint32_t typeMask() const { return mask_; }
+  uint32_t delivered() const { return delivered_; }
+  uint32_t lost() const { return lost_; }
+
+private:
+  friend class Bus;
+
+  const char *name_;
+  uint32_t mask_;
+  Handler handler_;
+  void *user_data_;
+  etl::queue_spsc_atomic<Event, CONFIG_EVENT_BUS_SUBSCRIBER_QUEUE_DEPTH> queue_;
+  struct k_sem ready_;
+  uint32_t delivered_ = 0;
+  uint32_t lost_ = 0; /* queue full at fan-out */
+};
+
+/**
+ * Add @p sub to the subscriber table. Thread context; @p sub must outlive the
+ * bus (static storage).
+ * @return 0 on success, -ENOMEM if the table is full, -EALREADY if present.
+ */
+int subscribe(Subscriber &sub);
+
+struct Stats {
+  uint32_t published;   /**< accepted by publish() */
+  uint32_t dropped;     /**< rejected by publish(): ingress ring full */
+  uint32_t delivered;   /**< handler calls + wait() returns */
+  uint32_t lost;        /**< fan-out into a full subscriber queue */
+  uint32_t lat_last_us; /**< publish -> delivery */
+  uint32_t lat_max_us;
+  uint64_t lat_sum_us;  /**< mean = lat_sum_us / delivered */
+  uint32_t over_budget; /**< deliveries later than CONFIG_EVENT_BUS_LATENCY_BUDGET_US */
+};
+
+/** Snapshot the bus counters (any thread). */
+void getStats(Stats &out);
+
+} // namespace events
+
+#endif /* OE5XRX_EVENTS_BUS_H_ */
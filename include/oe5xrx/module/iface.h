@@ -26,6 +26,7 @@
 #endif
 
 #include <etl/string.h>
+#include <initializer_list>
 #include <math.h>
 #include <span>
 #include <stddef.h>
@@ -229,6 +230,10 @@ public:
     return r;
   }
 
+  bool ok() const { return ok_; }
+  /** Error code of a failed result; nullptr on success. */
+  const char *error() const { return ok_ ? nullptr : err_; }
+
   /** Render `{"ok":..,"module":..,"cap":..,"op":..,"value"|"error":..}` into @p w. */
   void render(JsonWriter &w, const char *module, const char *cap, const char *op) const {
     w.ch('{');
@@ -249,12 +254,7 @@ public:
     w.ch('}');
   }
 
-private:
-  static constexpr size_t kStrCap = 15;
-
-  explicit Result(bool ok) : ok_(ok) {}
-
-  /** Render the value arm as JSON: integer for Int, always-decimal for Float. */
+  /** Render the value arm alone as JSON: integer for Int, always-decimal for Float. */
   void renderValue(JsonWriter &w) const {
     char b[32];
     if (const int *i = std::get_if<int>(&value_)) {
@@ -277,6 +277,11 @@ private:
     }
   }
 
+private:
+  static constexpr size_t kStrCap = 15;
+
+  explicit Result(bool ok) : ok_(ok) {}
+
   bool ok_;
   std::variant<std::monostate, int, double, bool, etl::string<kStrCap>> value_{};
   const char *err_ = nullptr;
@@ -493,6 +498,8 @@ public:
     w.ch('}');
   }
 
+  std::span<Capability *const> capabilities() const { return caps_; }
+
   /** Look up @p cap and dispatch @p op; unknown capability -> `unknown_capability`. */
   Result execute(Op op, const char *cap, const char *value) const {
     Capability *c = find(cap);
@@ -505,31 +512,47 @@ private:
   std::span<Capability *const> caps_;
 };
 
-/** @brief A fixed set of modules addressable by id. */
+/**
+ * @brief A fixed set of modules addressable by id: the device's own, then any the
+ * application contributes (see @ref app_modules).
+ */
 class ModuleRegistry {
 public:
-  explicit ModuleRegistry(std::span<Module *const> modules) : modules_(modules) {}
+  explicit ModuleRegistry(std::span<Module *const> modules, std::span<Module *const> extra = {}) : modules_(modules), extra_(extra) {}
 
   Module *find(const char *id) const {
-    for (Module *m : modules_) {
-      if (strcmp(m->moduleId(), id) == 0) {
-        return m;
+    for (std::span<Module *const> set : {modules_, extra_}) {
+      for (Module *m : set) {
+        if (strcmp(m->moduleId(), id) == 0) {
+          return m;
+        }
       }
     }
     return nullptr;
   }
 
+  /** Call @p f on every module, the device's own first. */
+  template <typename F> void forEach(F &&f) const {
+    for (std::span<Module *const> set : {modules_, extra_}) {
+      for (Module *m : set) {
+        f(*m);
+      }
+    }
+  }
+
   void list(JsonWriter &w) const {
     w.ch('{');
     w.key("modules");
     w.ch('[');
     bool first = true;
-    for (Module *m : modules_) {
-      if (!first) {
-        w.ch(',');
+    for (std::span<Module *const> set : {modules_, extra_}) {
+      for (Module *m : set) {
+        if (!first) {
+          w.ch(',');
+        }
+        first = false;
+        w.quoted(m->moduleId());
       }
-      first = false;
-      w.quoted(m->moduleId());
     }
     w.ch(']');
     w.ch('}');
@@ -537,8 +560,19 @@ public:
 
 private:
   std::span<Module *const> modules_;
+  std::span<Module *const> extra_;
 };
 
+/**
+ * @brief Modules defined by the application rather than a device driver (e.g. the USB
+ * audio bridge). The shell registry appends them; the device TU provides a weak
+ * default returning none, an application TU overrides it.
+ */
+std::span<Module *const> app_modules();
+
+/** The registry behind the `module` shell, for code that issues module operations itself. */
+ModuleRegistry &registry();
+
 } // namespace mod
 
 #endif // OE5XRX_MODULE_IFACE_H_
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Module action scheduler: runs `module <id> set|get|do <cap> <value>`
+ * operations once after a delay or periodically, on the device itself (see
+ * subsys/module/scheduler/action_scheduler.h for the timer wheel).
+ *
+ * The table is edited through its own module, `sched`, and persisted with the
+ * settings subsystem when CONFIG_MODULE_SCHED_PERSIST is set.
+ */
+#ifndef OE5XRX_MODULE_SCHEDULER_H_
+#define OE5XRX_MODULE_SCHEDULER_H_
+
+#include <oe5xrx/module/iface.h>
+
+namespace mod {
+
+/** The `sched` module; the `module` shell registry lists it next to the device modules. */
+Module &scheduler_module();
+
+} // namespace mod
+
+#endif /* OE5XRX_MODULE_SCHEDULER_H_ */
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Voice prompt module: `say` and `announce` actions on the announcement
+ * engine (see <oe5xrx/audio/voice_prompt.h>), so agents and the action
+ * scheduler can trigger spoken IDs and frequency announcements.
+ */
+#ifndef OE5XRX_MODULE_VOICE_H_
+#define OE5XRX_MODULE_VOICE_H_
+
+#include <oe5xrx/module/iface.h>
+
+namespace mod {
+
+/** The `voice` module; registered next to the device modules. */
+Module &voice_module();
+
+} // namespace mod
+
+#endif /* OE5XRX_MODULE_VOICE_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Read-only USB drive: a FAT volume synthesized on the fly (see
+ * subsys/msc_disk/virtual_fat.h) and exported through the USB mass-storage
+ * class in the composite. Its files are whatever subsystems register here.
+ * Built in are LOG.TXT, the retained log ring (the log before the last reset
+ * included), and STATUS.TXT, every module value at snapshot time.
+ *
+ * File sizes and STATUS.TXT are fixed at a snapshot: at boot, whenever the
+ * host configures the device, and on msc_disk_refresh(). The host caches
+ * the directory, so a refresh shows after the drive is re-mounted.
+ */
+#ifndef OE5XRX_MSC_MSC_DISK_H_
+#define OE5XRX_MSC_MSC_DISK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct msc_disk_file {
+  /** 8.3 name, e.g. "RX0001.WAV". */
+  const char *name;
+  /**
+   * Stage the next content aside from the one being read; returns its size
+   * in bytes. msc_disk work queue, without the drive lock: may block, but
+   * must leave what read() serves untouched.
+   */
+  uint32_t (*snapshot)(void *user_data);
+  /** Make the staged content the one read() serves. Under the drive lock: must not block. */
+  void (*commit)(void *user_data);
+  /** Produce @p len bytes at @p offset of the committed content. USB thread, under the drive lock. */
+  void (*read)(uint32_t offset, uint8_t *dst, uint32_t len, void *user_data);
+  void *user_data;
+};
+
+/**
+ * Add @p file to the drive from the next snapshot on. @p file must stay valid.
+ * @return 0, -ENOMEM if CONFIG_MSC_DISK_MAX_FILES are registered.
+ */
+int msc_disk_add_file(const struct msc_disk_file *file);
+
+/** Snapshot all files again (runs on a low-priority msc_disk work queue). */
+void msc_disk_refresh(void);
+
+struct msc_disk_stats {
+  uint32_t files;        /**< files in the current snapshot */
+  uint32_t snapshots;
+  uint32_t sectors_read; /**< sectors served to the host since boot */
+  uint32_t log_boots;    /**< resets the log ring survived (0: cold start) */
+  uint32_t log_bytes;    /**< text currently held by the log ring */
+};
+
+void msc_disk_get_stats(struct msc_disk_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OE5XRX_MSC_MSC_DISK_H_ */
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 OE5XRX
+# SPDX-License-Identifier: LGPL-3.0-or-later
+#
+# Sets on-target benchmark numbers against the host suite. Both sides are
+# Google Benchmark CSV: the host from
+#   ./build-host/fm_host_bench --benchmark_format=csv > host.csv
+# and the target from `bench run all` on the fm_board shell, captured to a
+# file (prompt lines and colour codes are skipped). Rows join on the name;
+# names only one side has (device-only cases like BM_ToneParse, host cases
+# the image leaves out) are listed with a dash for the other side.
+#
+# Usage:
+#   scripts/bench_compare.py host.csv target.log
+import argparse
+import csv
+import re
+import sys
+
+ANSI = re.compile(r"\x1b\[[0-9;]*[A-Za-z]")
+
+# Google Benchmark reports in the unit of each row; compare in ns.
+NS_PER = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def read_rows(path):
+    """Rows of the Google Benchmark CSV in @p path, by name."""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        lines = [ANSI.sub("", line).strip() for line in f]
+    start = next((i for i, line in enumerate(lines) if line.startswith("name,iterations,")), None)
+    if start is None:
+        sys.exit(f"{path}: no Google Benchmark CSV header")
+    table = [lines[start]] + [line for line in lines[start + 1 :] if line.startswith('"')]
+    rows = {}
+    for row in csv.DictReader(table):
+        if row.get("error_occurred") == "true":
+            continue
+        row["ns"] = float(row["cpu_time"]) * NS_PER[row["time_unit"]]
+        rows[row["name"]] = row
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare on-target and host benchmark CSV.")
+    parser.add_argument("host", help="fm_host_bench --benchmark_format=csv output")
+    parser.add_argument("target", help="captured `bench run` output from the board")
+    args = parser.parse_args()
+
+    host = read_rows(args.host)
+    target = read_rows(args.target)
+    names = [n for n in target if n in host] + [n for n in target if n not in host] + [n for n in host if n not in target]
+
+    width = max(len(n) for n in names)
+    print(f"{'name':<{width}}  {'host_ns':>10}  {'target_ns':>10}  {'cycles':>10}  {'ratio':>7}")
+    for name in names:
+        h = host.get(name)
+        t = target.get(name)
+        host_ns = f"{h['ns']:.1f}" if h else "-"
+        target_ns = f"{t['ns']:.1f}" if t else "-"
+        cycles = f"{float(t['cycles']):.0f}" if t and t.get("cycles") else "-"
+        ratio = f"{t['ns'] / h['ns']:.1f}" if h and t and h["ns"] > 0 else "-"
+        print(f"{name:<{width}}  {host_ns:>10}  {target_ns:>10}  {cycles:>10}  {ratio:>7}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 OE5XRX
+# SPDX-License-Identifier: LGPL-3.0-or-later
+#
+# ALSA-level measurements against the native_sim USB/IP build, whose emulated
+# DAC is looped back into the ADC, so what goes out on UAC2 OUT returns on IN:
+#   latency  - OUT -> IN delay of a marker burst (includes the aplay/arecord
+#              start skew, a few ms; use `alsabat --roundtriplatency` for a
+#              tighter figure)
+#   drift    - device capture clock vs. host, from the marker spacing (ppm)
+#   underrun - runs of digital silence inside the continuous tone
+#
+# Usage (after `usbip attach -r 127.0.0.1 -b <busid>`):
+#   scripts/usbip_audio_measure.py -D plughw:CARD=Board --seconds 60
+# Prints one machine-readable USBIP-AUDIO line; exit 1 if any underrun was seen
+# or the markers were not found.
+import argparse
+import array
+import math
+import subprocess
+import sys
+import tempfile
+import wave
+
+RATE = 8000
+MARK_EVERY = RATE          # one marker per second
+MARK_LEN = 80              # 10 ms full-scale burst
+TONE_AMP = 3000            # continuous 500 Hz tone between markers
+TONE_HZ = 500
+MARK_THRESHOLD = 16000
+GAP_SAMPLES = 4            # zero run that counts as an underrun
+
+
+def make_signal(seconds):
+    pcm = array.array("h")
+    for n in range(seconds * RATE):
+        if n % MARK_EVERY < MARK_LEN:
+            pcm.append(30000 if (n // 4) % 2 == 0 else -30000)
+        else:
+            pcm.append(int(TONE_AMP * math.sin(2 * math.pi * TONE_HZ * n / RATE)))
+    return pcm
+
+
+def write_wav(path, pcm):
+    with wave.open(path, "wb") as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(pcm.tobytes())
+
+
+def read_wav(path):
+    with wave.open(path, "rb") as w:
+        pcm = array.array("h")
+        pcm.frombytes(w.readframes(w.getnframes()))
+        return pcm
+
+
+def marker_onsets(pcm):
+    onsets, n = [], 0
+    while n < len(pcm):
+        if abs(pcm[n]) >= MARK_THRESHOLD:
+            onsets.append(n)
+            n += MARK_EVERY // 2
+        else:
+            n += 1
+    return onsets
+
+
+def underruns(pcm, first, last):
+    count, run = 0, 0
+    for n in range(first, last):
+        if pcm[n] == 0:
+            run += 1
+            if run == GAP_SAMPLES:
+                count += 1
+        else:
+            run = 0
+    return count
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Latency, drift and underrun check over the native_sim USB/IP loopback")
+    ap.add_argument("-D", "--device", required=True, help="ALSA device of the attached board")
+    ap.add_argument("--seconds", type=int, default=30)
+    args = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        out_wav, in_wav = f"{tmp}/out.wav", f"{tmp}/in.wav"
+        write_wav(out_wav, make_signal(args.seconds))
+        fmt = ["-D", args.device, "-f", "S16_LE", "-c", "1", "-r", str(RATE)]
+        rec = subprocess.Popen(["arecord", *fmt, "-d", str(args.seconds + 2), in_wav])
+        subprocess.run(["aplay", *fmt, out_wav], check=True)
+        rec.wait()
+        pcm = read_wav(in_wav)
+
+    onsets = marker_onsets(pcm)
+    if len(onsets) < 2:
+        print(f"USBIP-AUDIO markers={len(onsets)} error=no_loopback")
+        return 1
+    latency_ms = onsets[0] * 1000.0 / RATE
+    span = onsets[-1] - onsets[0]
+    expected = (len(onsets) - 1) * MARK_EVERY
+    drift_ppm = (span - expected) * 1e6 / expected
+    gaps = underruns(pcm, onsets[0], onsets[-1])
+    print(f"USBIP-AUDIO markers={len(onsets)} latency_ms={latency_ms:.1f} drift_ppm={drift_ppm:.1f} underruns={gaps}")
+    return 1 if gaps else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 OE5XRX
+# SPDX-License-Identifier: LGPL-3.0-or-later
+#
+# Builds the voice prompt pack (subsys/voice/voice_prompt.h) as a C++ source:
+# one IMA-ADPCM clip per vocabulary word, in Word order.
+#
+# Clips come from <wav-dir>/<word>.wav (8 kHz, mono, 16 bit; e.g. 7.wav,
+# point.wav, megahertz.wav, x.wav for "x-ray"). Each recording is trimmed to
+# its first and last sample above the silence threshold, faded in and out
+# over 2 ms (so any clip joins any other without a click), normalised to the
+# peak level and encoded exactly like audio::adpcmEncode(). Words without a
+# recording, or all of them without --wav-dir, fall back to Morse code at
+# --wpm on a --tone-hz tone ("point" is R, the CW decimal separator), which
+# makes the CW pack a legal station identification out of the box.
+#
+# Usage:
+#   scripts/voice_pack.py --out voice_pack.cpp [--wav-dir prompts/en]
+import argparse
+import array
+import math
+import os
+import sys
+import wave
+
+RATE = 8000
+
+WORDS = ["0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "point", "minus", "megahertz", "kilohertz", "on", "off"] + [chr(c) for c in range(ord("a"), ord("z") + 1)]
+
+MORSE = {
+    "a": ".-", "b": "-...", "c": "-.-.", "d": "-..", "e": ".", "f": "..-.", "g": "--.", "h": "....", "i": "..", "j": ".---", "k": "-.-",
+    "l": ".-..", "m": "--", "n": "-.", "o": "---", "p": ".--.", "q": "--.-", "r": ".-.", "s": "...", "t": "-", "u": "..-", "v": "...-",
+    "w": ".--", "x": "-..-", "y": "-.--", "z": "--..", "0": "-----", "1": ".----", "2": "..---", "3": "...--", "4": "....-", "5": ".....",
+    "6": "-....", "7": "--...", "8": "---..", "9": "----.", "-": "-....-",
+}
+# Characters keyed for the words that are not a single character.
+CW_TEXT = {"point": "r", "minus": "-", "megahertz": "mhz", "kilohertz": "khz", "on": "on", "off": "off"}
+
+VOICE_PAUSE_MS = 250
+SILENCE_DBFS = -40.0
+FADE_SAMPLES = RATE * 2 // 1000
+
+STEP = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173,
+    190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289,
+    16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+INDEX_ADJUST = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def adpcm_step(state, code):
+    predictor, index = state
+    st = STEP[index]
+    delta = st >> 3
+    if code & 4:
+        delta += st
+    if code & 2:
+        delta += st >> 1
+    if code & 1:
+        delta += st >> 2
+    predictor += -delta if code & 8 else delta
+    predictor = max(-32768, min(32767, predictor))
+    index = max(0, min(88, index + INDEX_ADJUST[code & 7]))
+    return predictor, index
+
+
+def adpcm_encode(pcm, state):
+    """Codes for @pcm from @state, the same decisions as audio::adpcmEncode()."""
+    codes = []
+    for sample in pcm:
+        diff = sample - state[0]
+        code = 0
+        if diff < 0:
+            code = 8
+            diff = -diff
+        st = STEP[state[1]]
+        if diff >= st:
+            code |= 4
+            diff -= st
+        st >>= 1
+        if diff >= st:
+            code |= 2
+            diff -= st
+        st >>= 1
+        if diff >= st:
+            code |= 1
+        state = adpcm_step(state, code)
+        codes.append(code)
+    return codes
+
+
+def read_wav(path):
+    with wave.open(path, "rb") as w:
+        if w.getframerate() != RATE or w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit(f"{path}: need {RATE} Hz mono 16-bit, got {w.getframerate()} Hz, {w.getnchannels()} ch, {8 * w.getsampwidth()}-bit")
+        pcm = array.array("h")
+        pcm.frombytes(w.readframes(w.getnframes()))
+        if sys.byteorder == "big":
+            pcm.byteswap()
+        return list(pcm)
+
+
+def shape_recording(pcm, peak_dbfs):
+    threshold = 32768 * 10 ** (SILENCE_DBFS / 20)
+    loud = [i for i, s in enumerate(pcm) if abs(s) > threshold]
+    if not loud:
+        return []
+    pcm = pcm[loud[0]:loud[-1] + 1]
+    gain = 32767 * 10 ** (peak_dbfs / 20) / max(abs(s) for s in pcm)
+    out = []
+    for i, s in enumerate(pcm):
+        edge = min(i, len(pcm) - 1 - i)
+        fade = min(1.0, edge / FADE_SAMPLES)
+        out.append(int(round(s * gain * fade)))
+    return out
+
+
+def morse(text, wpm, tone_hz, peak_dbfs):
+    """Keyed tone for @text, ending with the 3-dit gap that follows a character."""
+    dit = RATE * 1200 // (wpm * 1000)
+    ramp = RATE * 5 // 1000  # raised-cosine edges: no key clicks
+    amp = 32767 * 10 ** (peak_dbfs / 20)
+    out = []
+    for ci, ch in enumerate(text):
+        if ci:
+            out += [0] * (2 * dit)  # 3-dit character gap after the element gap
+        for ei, el in enumerate(MORSE[ch]):
+            if ei:
+                out += [0] * dit
+            n = dit * (3 if el == "-" else 1)
+            for i in range(n):
+                edge = min(i, n - 1 - i)
+                env = 0.5 - 0.5 * math.cos(math.pi * edge / ramp) if edge < ramp else 1.0
+                out.append(int(round(amp * env * math.sin(2 * math.pi * tone_hz * len(out) / RATE))))
+    return out + [0] * (3 * dit)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("--out", required=True)
+    ap.add_argument("--wav-dir", default="")
+    ap.add_argument("--wpm", type=int, default=20)
+    ap.add_argument("--tone-hz", type=int, default=800)
+    ap.add_argument("--peak-dbfs", type=float, default=-6.0)
+    args = ap.parse_args()
+
+    clips = []
+    voiced = 0
+    for word in WORDS:
+        path = os.path.join(args.wav_dir, word + ".wav") if args.wav_dir else ""
+        if path and os.path.exists(path):
+            pcm = shape_recording(read_wav(path), args.peak_dbfs)
+            voiced += 1
+        else:
+            pcm = morse(CW_TEXT.get(word, word), args.wpm, args.tone_hz, args.peak_dbfs)
+        clips.append((word, pcm))
+
+    dit = RATE * 1200 // (args.wpm * 1000)
+    pause = RATE * VOICE_PAUSE_MS // 1000 if voiced else 4 * dit  # CW: 7-dit word gap
+
+    codes = []
+    table = []
+    for word, pcm in clips:
+        state = (0, 0)
+        table.append((word, len(codes), len(pcm), state))
+        codes += adpcm_encode(pcm, state)
+    if len(codes) % 2:
+        codes.append(0)
+    data = [codes[i] | (codes[i + 1] << 4) for i in range(0, len(codes), 2)]
+
+    lines = [
+        "/* Generated by scripts/voice_pack.py; do not edit. */",
+        f"/* {voiced} of {len(WORDS)} words recorded, the rest Morse at {args.wpm} wpm. {len(data)} bytes. */",
+        '#include "voice_prompt.h"',
+        "",
+        "namespace voice {",
+        "",
+        "namespace {",
+        "",
+        "const uint8_t kData[] = {",
+    ]
+    for i in range(0, len(data), 20):
+        lines.append("    " + " ".join(f"0x{b:02x}," for b in data[i:i + 20]))
+    lines += ["};", "", "const Clip kClips[kClipCount] = {"]
+    for word, offset, samples, state in table:
+        lines.append(f"    {{{offset}, {samples}, {{{state[0]}, {state[1]}}}}}, /* {word} */")
+    lines += ["};", "", "} // namespace", "", f"const Pack builtin_pack{{kData, kClips, {pause}}};", "", "} // namespace voice", ""]
+
+    with open(args.out, "w") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Serial audio link. See <oe5xrx/audio/audio_link.h>.
+ */
+#include "ima_adpcm.h"
+#include "jitter_buffer.h"
+#include "link_frame.h"
+
+#include <errno.h>
+#include <oe5xrx/audio/audio_link.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#ifdef CONFIG_EVENT_BUS
+#include <oe5xrx/events/bus.h>
+#endif
+
+LOG_MODULE_REGISTER(audio_link, CONFIG_AUDIO_LINK_LOG_LEVEL);
+
+#define AL_RATE 8000U
+#define AL_FRAME_SAMPLES (CONFIG_AUDIO_LINK_FRAME_MS * AL_RATE / 1000U)
+#define AL_PAYLOAD_BYTES audio::adpcmBytes(AL_FRAME_SAMPLES)
+#define AL_FRAME_BYTES (audio::kLinkHeaderBytes + AL_PAYLOAD_BYTES + audio::kLinkCrcBytes)
+
+static_assert(AL_PAYLOAD_BYTES <= audio::kLinkMaxPayload, "CONFIG_AUDIO_LINK_FRAME_MS too long for one frame");
+static_assert(CONFIG_AUDIO_LINK_TX_BUFFER >= 2 * AL_FRAME_BYTES, "TX buffer must hold two frames");
+
+/* Latency probe marker: 1 kHz at -6 dBFS (kTone), found by a level threshold. */
+#define AL_PROBE_THRESHOLD 8192
+enum { AL_PROBE_IDLE, AL_PROBE_ARMED, AL_PROBE_IN_FLIGHT };
+
+struct al_link {
+  const struct device *uart;
+  atomic_t running;
+  audio_link_ptt_cb on_ptt;
+  void *user_data;
+
+  /* Encoder side, owned by the capture callback (audio workqueue). Frames go
+   * through tx_rb to the UART ISR; the lock covers the ring's two ends. */
+  int16_t enc_pcm[AL_FRAME_SAMPLES];
+  size_t enc_fill;
+  audio::AdpcmState enc_state;
+  uint16_t tx_seq;
+  uint32_t tx_clock; /* samples captured */
+  struct ring_buf tx_rb;
+  uint8_t tx_rb_buf[CONFIG_AUDIO_LINK_TX_BUFFER];
+  struct k_spinlock tx_lock;
+
+  /* Decoder side. The UART ISR feeds rx_rb (single producer/consumer, no
+   * lock); the link thread parses and decodes into the jitter buffer, which
+   * the playback callback drains under jb_lock. */
+  struct ring_buf rx_rb;
+  uint8_t rx_rb_buf[CONFIG_AUDIO_LINK_RX_BUFFER];
+  audio::LinkFrameParser parser;
+  audio::JitterBuffer<CONFIG_AUDIO_LINK_JITTER_SLOTS, AL_FRAME_SAMPLES> jb;
+  struct k_spinlock jb_lock;
+  int64_t last_rx_ms;
+
+  atomic_t cos;
+  atomic_t ptt_req;
+  atomic_t remote_cos;
+  atomic_t remote_ptt;
+
+  /* Echo mode: playback -> encoder input. */
+  atomic_t echo;
+  struct ring_buf echo_rb;
+  uint8_t echo_rb_buf[4 * AL_FRAME_SAMPLES * sizeof(int16_t)];
+
+  /* Latency probe: armed by audio_link_probe(), injected by the encoder,
+   * detected by the playback callback. */
+  atomic_t probe_state;
+  uint32_t probe_t0;
+  uint32_t probe_rtt_us;
+
+  struct audio_link_stats stats;
+};
+
+static struct al_link al;
+
+/* Static: the link thread waits on rx_sem from boot, before any start(). */
+K_SEM_DEFINE(al_rx_sem, 0, 1);
+K_SEM_DEFINE(al_probe_done, 0, 1);
+
+#ifdef CONFIG_EVENT_BUS
+static void al_on_event(const events::Event &evt, void *user_data) {
+  ARG_UNUSED(user_data);
+  audio_link_set_cos(evt.value != 0);
+}
+
+/* COS follows the SA818 squelch without anyone polling it. */
+static events::Subscriber al_events("audio_link", events::mask(events::Type::Squelch), al_on_event);
+#endif
+
+/* Local sample clock, for the jitter estimate (same unit as the timestamps). */
+static uint32_t al_now_samples(void) { return static_cast<uint32_t>(k_uptime_ticks() * AL_RATE / CONFIG_SYS_CLOCK_TICKS_PER_SEC); }
+
+static void al_uart_isr(const struct device *uart, void *user_data) {
+  struct al_link *l = static_cast<struct al_link *>(user_data);
+
+  while (true) {
+    uart_irq_update(uart);
+    if (!uart_irq_is_pending(uart)) {
+      break;
+    }
+    if (uart_irq_rx_ready(uart)) {
+      uint8_t buf[32];
+      int n = uart_fifo_read(uart, buf, sizeof(buf));
+      if (n > 0) {
+        if (ring_buf_put(&l->rx_rb, buf, n) < static_cast<uint32_t>(n)) {
+          l->stats.rx_overruns++;
+        }
+        k_sem_give(&al_rx_sem);
+      }
+    }
+    if (uart_irq_tx_ready(uart)) {
+      k_spinlock_key_t key = k_spin_lock(&l->tx_lock);
+      uint8_t *p;
+      uint32_t avail = ring_buf_get_claim(&l->tx_rb, &p, 64);
+      if (avail == 0) {
+        uart_irq_tx_disable(uart);
+      } else {
+        int sent = uart_fifo_fill(uart, p, static_cast<int>(avail));
+        (void)ring_buf_get_finish(&l->tx_rb, sent > 0 ? static_cast<uint32_t>(sent) : 0U);
+      }
+      k_spin_unlock(&l->tx_lock, key);
+    }
+  }
+}
+
+static void al_set_remote_ptt(bool on) {
+  if (atomic_set(&al.remote_ptt, on ? 1 : 0) == (on ? 1 : 0)) {
+    return;
+  }
+  LOG_INF("far end PTT %s", on ? "on" : "off");
+  if (al.on_ptt) {
+    al.on_ptt(on, al.user_data);
+  }
+}
+
+/* One complete frame of captured PCM in enc_pcm: encode and queue it. */
+static void al_send_frame(void) {
+  if (atomic_cas(&al.probe_state, AL_PROBE_ARMED, AL_PROBE_IN_FLIGHT)) {
+    static const int16_t kTone[8] = {0, 11585, 16384, 11585, 0, -11585, -16384, -11585};
+    for (size_t i = 0; i < AL_FRAME_SAMPLES; i++) {
+      al.enc_pcm[i] = kTone[i % 8];
+    }
+    al.probe_t0 = k_cycle_get_32();
+  }
+
+  const bool cos = atomic_get(&al.cos) != 0;
+  const bool ptt = atomic_get(&al.ptt_req) != 0 || (IS_ENABLED(CONFIG_AUDIO_LINK_COS_KEYS_REMOTE) && cos);
+  audio::LinkFrameHeader hdr{};
+  hdr.flags = (ptt ? audio::LinkFrameHeader::kPtt : 0) | (cos ? audio::LinkFrameHeader::kCos : 0);
+  hdr.seq = al.tx_seq++;
+  hdr.timestamp = al.tx_clock;
+  hdr.adpcm = al.enc_state;
+  hdr.length = AL_PAYLOAD_BYTES;
+  al.tx_clock += AL_FRAME_SAMPLES;
+
+  uint8_t payload[AL_PAYLOAD_BYTES];
+  audio::adpcmEncode(al.enc_state, al.enc_pcm, AL_FRAME_SAMPLES, payload);
+  uint8_t frame[AL_FRAME_BYTES];
+  const size_t len = audio::linkFrameEncode(hdr, payload, frame, sizeof(frame));
+
+  k_spinlock_key_t key = k_spin_lock(&al.tx_lock);
+  const bool fits = ring_buf_space_get(&al.tx_rb) >= len;
+  if (fits) {
+    ring_buf_put(&al.tx_rb, frame, len);
+  }
+  k_spin_unlock(&al.tx_lock, key);
+
+  if (fits) {
+    al.stats.tx_frames++;
+    uart_irq_tx_enable(al.uart);
+  } else {
+    al.stats.tx_overruns++;
+  }
+}
+
+static void al_on_frame(const audio::LinkFrameHeader &hdr, const uint8_t *payload) {
+  if (hdr.length != AL_PAYLOAD_BYTES) {
+    al.stats.rx_bad_length++;
+    return;
+  }
+  int16_t pcm[AL_FRAME_SAMPLES];
+  audio::AdpcmState st = hdr.adpcm;
+  audio::adpcmDecode(st, payload, AL_FRAME_SAMPLES, pcm);
+
+  const uint32_t now = al_now_samples();
+  k_spinlock_key_t key = k_spin_lock(&al.jb_lock);
+  al.jb.put(hdr.seq, hdr.timestamp, now, pcm);
+  k_spin_unlock(&al.jb_lock, key);
+
+  al.last_rx_ms = k_uptime_get();
+  atomic_set(&al.remote_cos, (hdr.flags & audio::LinkFrameHeader::kCos) ? 1 : 0);
+  al_set_remote_ptt((hdr.flags & audio::LinkFrameHeader::kPtt) != 0);
+}
+
+static void al_thread(void *, void *, void *) {
+  while (true) {
+    (void)k_sem_take(&al_rx_sem, K_MSEC(CONFIG_AUDIO_LINK_PTT_HANG_MS));
+    if (!atomic_get(&al.running)) {
+      continue;
+    }
+
+    uint8_t chunk[64];
+    uint32_t n;
+    while ((n = ring_buf_get(&al.rx_rb, chunk, sizeof(chunk))) > 0) {
+      al.parser.feed(chunk, n, al_on_frame);
+    }
+
+    /* Frames stopped: do not leave the far end's transmitter keyed here. */
+    if (atomic_get(&al.remote_ptt) && k_uptime_get() - al.last_rx_ms > CONFIG_AUDIO_LINK_PTT_HANG_MS) {
+      al_set_remote_ptt(false);
+    }
+  }
+}
+
+K_THREAD_DEFINE(audio_link_tid, CONFIG_AUDIO_LINK_THREAD_STACK_SIZE, al_thread, NULL, NULL, NULL, CONFIG_AUDIO_LINK_THREAD_PRIORITY, 0, 0);
+
+int audio_link_start(const struct device *uart, audio_link_ptt_cb on_ptt, void *user_data) {
+  if (atomic_get(&al.running)) {
+    return -EALREADY;
+  }
+  if (uart == NULL || !device_is_ready(uart)) {
+    return -ENODEV;
+  }
+
+  al.uart = uart;
+  al.on_ptt = on_ptt;
+  al.user_data = user_data;
+  al.enc_fill = 0;
+  al.enc_state = {};
+  al.tx_seq = 0;
+  al.tx_clock = 0;
+  ring_buf_init(&al.tx_rb, sizeof(al.tx_rb_buf), al.tx_rb_buf);
+  ring_buf_init(&al.rx_rb, sizeof(al.rx_rb_buf), al.rx_rb_buf);
+  ring_buf_init(&al.echo_rb, sizeof(al.echo_rb_buf), al.echo_rb_buf);
+  al.parser.reset();
+  al.jb.init({CONFIG_AUDIO_LINK_JITTER_MIN_FRAMES, CONFIG_AUDIO_LINK_JITTER_MAX_FRAMES});
+  atomic_set(&al.remote_ptt, 0);
+  atomic_set(&al.remote_cos, 0);
+  atomic_set(&al.probe_state, AL_PROBE_IDLE);
+  al.stats = {};
+
+  int ret = uart_irq_callback_user_data_set(uart, al_uart_isr, &al);
+  if (ret != 0) {
+    LOG_ERR("UART IRQ callback registration failed: %d", ret);
+    return ret;
+  }
+
+#ifdef CONFIG_EVENT_BUS
+  ret = events::subscribe(al_events);
+  if (ret != 0 && ret != -EALREADY) {
+    LOG_WRN("no squelch events (%d); COS only via audio_link_set_cos()", ret);
+  }
+#endif
+
+  atomic_set(&al.running, 1);
+  uart_irq_rx_enable(uart);
+  LOG_INF("audio link up on %s: %u ms frames, %u bytes each", uart->name, CONFIG_AUDIO_LINK_FRAME_MS, (unsigned)AL_FRAME_BYTES);
+  return 0;
+}
+
+int audio_link_stop(void) {
+  if (!atomic_cas(&al.running, 1, 0)) {
+    return 0;
+  }
+  uart_irq_rx_disable(al.uart);
+  uart_irq_tx_disable(al.uart);
+  al_set_remote_ptt(false);
+  LOG_INF("audio link down");
+  return 0;
+}
+
+void audio_link_rx_data(const struct device *dev, const uint8_t *buffer, size_t size, void *user_data) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(user_data);
+  if (!atomic_get(&al.running)) {
+    return;
+  }
+
+  const int16_t *pcm = reinterpret_cast<const int16_t *>(buffer);
+  size_t count = size / sizeof(int16_t);
+  const bool echo = atomic_get(&al.echo) != 0;
+  while (count > 0) {
+    size_t n = AL_FRAME_SAMPLES - al.enc_fill;
+    n = n < count ? n : count;
+    int16_t *dst = &al.enc_pcm[al.enc_fill];
+    if (echo) {
+      /* Send what was played out instead; the capture only sets the pace. */
+      const uint32_t got = ring_buf_get(&al.echo_rb, reinterpret_cast<uint8_t *>(dst), n * sizeof(int16_t));
+      memset(reinterpret_cast<uint8_t *>(dst) + got, 0, n * sizeof(int16_t) - got);
+    } else {
+      memcpy(dst, pcm, n * sizeof(int16_t));
+    }
+    al.enc_fill += n;
+    pcm += n;
+    count -= n;
+    if (al.enc_fill == AL_FRAME_SAMPLES) {
+      al_send_frame();
+      al.enc_fill = 0;
+    }
+  }
+}
+
+size_t audio_link_tx_request(const struct device *dev, uint8_t *buffer, size_t size, void *user_data) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(user_data);
+  if (!atomic_get(&al.running)) {
+    return 0;
+  }
+
+  int16_t *pcm = reinterpret_cast<int16_t *>(buffer);
+  const size_t count = size / sizeof(int16_t);
+  k_spinlock_key_t key = k_spin_lock(&al.jb_lock);
+  al.jb.get(pcm, count);
+  k_spin_unlock(&al.jb_lock, key);
+
+  if (atomic_get(&al.echo)) {
+    (void)ring_buf_put(&al.echo_rb, buffer, count * sizeof(int16_t));
+  }
+
+  if (atomic_get(&al.probe_state) == AL_PROBE_IN_FLIGHT) {
+    for (size_t i = 0; i < count; i++) {
+      if (abs(pcm[i]) >= AL_PROBE_THRESHOLD) {
+        al.probe_rtt_us = k_cyc_to_us_floor32(k_cycle_get_32() - al.probe_t0);
+        if (atomic_cas(&al.probe_state, AL_PROBE_IN_FLIGHT, AL_PROBE_IDLE)) {
+          k_sem_give(&al_probe_done);
+        }
+        break;
+      }
+    }
+  }
+  return count * sizeof(int16_t);
+}
+
+void audio_link_set_cos(bool carrier) { atomic_set(&al.cos, carrier ? 1 : 0); }
+
+void audio_link_set_ptt(bool on) { atomic_set(&al.ptt_req, on ? 1 : 0); }
+
+void audio_link_set_echo(bool on) {
+  atomic_set(&al.echo, on ? 1 : 0);
+  LOG_INF("echo %s", on ? "on" : "off");
+}
+
+int32_t audio_link_probe(uint32_t timeout_ms) {
+  if (!atomic_get(&al.running)) {
+    return -EAGAIN;
+  }
+  k_sem_reset(&al_probe_done);
+  if (!atomic_cas(&al.probe_state, AL_PROBE_IDLE, AL_PROBE_ARMED)) {
+    return -EBUSY;
+  }
+
+  if (k_sem_take(&al_probe_done, K_MSEC(timeout_ms)) != 0) {
+    /* Withdraw it whether it was still armed or already in flight. */
+    if (!atomic_cas(&al.probe_state, AL_PROBE_ARMED, AL_PROBE_IDLE)) {
+      atomic_cas(&al.probe_state, AL_PROBE_IN_FLIGHT, AL_PROBE_IDLE);
+    }
+    al.stats.probes_lost++;
+    return -ETIMEDOUT;
+  }
+
+  const uint32_t us = al.probe_rtt_us;
+  struct audio_link_stats *s = &al.stats;
+  s->probe_last_us = us;
+  s->probe_min_us = (s->probes == 0 || us < s->probe_min_us) ? us : s->probe_min_us;
+  s->probe_max_us = MAX(s->probe_max_us, us);
+  s->probes++;
+  return static_cast<int32_t>(us);
+}
+
+void audio_link_get_stats(struct audio_link_stats *stats) {
+  k_spinlock_key_t key = k_spin_lock(&al.jb_lock);
+  const auto jb = al.jb.stats();
+  k_spin_unlock(&al.jb_lock, key);
+
+  *stats = al.stats;
+  const audio::LinkFrameParser::Stats &ps = al.parser.stats();
+  stats->rx_frames = ps.frames;
+  stats->rx_crc_errors = ps.crc_errors;
+  stats->rx_skipped = ps.skipped;
+  stats->played = jb.played;
+  stats->concealed = jb.concealed;
+  stats->late = jb.late;
+  stats->duplicates = jb.duplicates;
+  stats->underruns = jb.underruns;
+  stats->resyncs = jb.resyncs;
+  stats->shrinks = jb.shrinks;
+  stats->jitter_us = (jb.jitter_q4 >> 4) * 1000000U / AL_RATE;
+  stats->target_ms = jb.target * CONFIG_AUDIO_LINK_FRAME_MS;
+  stats->depth_ms = jb.depth * CONFIG_AUDIO_LINK_FRAME_MS;
+  stats->cos = atomic_get(&al.cos) != 0;
+  stats->ptt = atomic_get(&al.ptt_req) != 0 || (IS_ENABLED(CONFIG_AUDIO_LINK_COS_KEYS_REMOTE) && stats->cos);
+  stats->remote_cos = atomic_get(&al.remote_cos) != 0;
+  stats->remote_ptt = atomic_get(&al.remote_ptt) != 0;
+}
+
+#ifdef CONFIG_AUDIO_LINK_SHELL
+
+static int cmd_link_stats(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  struct audio_link_stats s;
+  audio_link_get_stats(&s);
+
+  shell_print(sh,
+              "AUDIO-LINK-STATS running=%d tx_frames=%u tx_overruns=%u rx_frames=%u crc_errors=%u skipped=%u rx_overruns=%u bad_length=%u played=%u "
+              "concealed=%u late=%u duplicates=%u underruns=%u resyncs=%u shrinks=%u jitter_us=%u target_ms=%u depth_ms=%u cos=%d ptt=%d "
+              "remote_cos=%d remote_ptt=%d probes=%u probes_lost=%u probe_min_us=%u probe_max_us=%u",
+              (int)atomic_get(&al.running), s.tx_frames, s.tx_overruns, s.rx_frames, s.rx_crc_errors, s.rx_skipped, s.rx_overruns, s.rx_bad_length,
+              s.played, s.concealed, s.late, s.duplicates, s.underruns, s.resyncs, s.shrinks, s.jitter_us, s.target_ms, s.depth_ms, s.cos, s.ptt,
+              s.remote_cos, s.remote_ptt, s.probes, s.probes_lost, s.probe_min_us, s.probe_max_us);
+  return 0;
+}
+
+static int cmd_link_probe(const struct shell *sh, size_t argc, char **argv) {
+  const uint32_t timeout_ms = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], NULL, 0)) : 2000U;
+  const int32_t rtt = audio_link_probe(timeout_ms);
+  if (rtt < 0) {
+    shell_print(sh, "AUDIO-LINK-PROBE result=%s", rtt == -ETIMEDOUT ? "lost" : "error");
+    return rtt == -ETIMEDOUT ? 0 : rtt;
+  }
+  /* The far end loops playout straight back into its encoder, so one way
+   * (mouth to ear) is half the round trip. */
+  shell_print(sh, "AUDIO-LINK-PROBE result=ok rtt_us=%d m2e_us=%d", rtt, rtt / 2);
+  return 0;
+}
+
+static int cmd_link_onoff(const struct shell *sh, size_t argc, char **argv, void (*set)(bool)) {
+  ARG_UNUSED(argc);
+  if (strcmp(argv[1], "on") == 0) {
+    set(true);
+  } else if (strcmp(argv[1], "off") == 0) {
+    set(false);
+  } else {
+    shell_error(sh, "expected on|off");
+    return -EINVAL;
+  }
+  return 0;
+}
+
+static int cmd_link_ptt(const struct shell *sh, size_t argc, char **argv) { return cmd_link_onoff(sh, argc, argv, audio_link_set_ptt); }
+
+static int cmd_link_echo(const struct shell *sh, size_t argc, char **argv) { return cmd_link_onoff(sh, argc, argv, audio_link_set_echo); }
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    link_cmds,
+    SHELL_CMD(stats, NULL, "Frame, loss, jitter buffer and probe counters", cmd_link_stats),
+    SHELL_CMD_ARG(probe, NULL, "Round trip through a far end in echo mode: probe [timeout_ms]", cmd_link_probe, 1, 1),
+    SHELL_CMD_ARG(ptt, NULL, "Ask the far end to transmit: ptt on|off", cmd_link_ptt, 2, 0),
+    SHELL_CMD_ARG(echo, NULL, "Loop played-out audio back to the far end: echo on|off", cmd_link_echo, 2, 0),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(link, &link_cmds, "Serial audio link", NULL);
+
+#endif /* CONFIG_AUDIO_LINK_SHELL */
@@ -0,0 +1,100 @@
+/**
+ * @file ima_adpcm.cpp
+ * @brief IMA/DVI ADPCM codec implementation. See ima_adpcm.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "ima_adpcm.h"
+
+namespace audio {
+
+namespace {
+
+constexpr int16_t kStep[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,    34,    37,
+    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,
+    230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,   1060,  1166,
+    1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+    7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+constexpr int8_t kIndexAdjust[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+constexpr int kMaxIndex = 88;
+
+/* Apply one code to the state; shared by both directions so the encoder
+ * tracks exactly what the decoder will reconstruct. */
+inline void step(AdpcmState &s, uint8_t code) {
+  const int32_t st = kStep[s.index];
+  int32_t delta = st >> 3;
+  if (code & 4) {
+    delta += st;
+  }
+  if (code & 2) {
+    delta += st >> 1;
+  }
+  if (code & 1) {
+    delta += st >> 2;
+  }
+  int32_t p = s.predictor + ((code & 8) ? -delta : delta);
+  p = p > INT16_MAX ? INT16_MAX : (p < INT16_MIN ? INT16_MIN : p);
+  s.predictor = static_cast<int16_t>(p);
+
+  int idx = s.index + kIndexAdjust[code & 7];
+  s.index = static_cast<uint8_t>(idx < 0 ? 0 : (idx > kMaxIndex ? kMaxIndex : idx));
+}
+
+inline uint8_t encodeOne(AdpcmState &s, int16_t sample) {
+  int32_t diff = static_cast<int32_t>(sample) - s.predictor;
+  uint8_t code = 0;
+  if (diff < 0) {
+    code = 8;
+    diff = -diff;
+  }
+  int32_t st = kStep[s.index];
+  if (diff >= st) {
+    code |= 4;
+    diff -= st;
+  }
+  st >>= 1;
+  if (diff >= st) {
+    code |= 2;
+    diff -= st;
+  }
+  st >>= 1;
+  if (diff >= st) {
+    code |= 1;
+  }
+  step(s, code);
+  return code;
+}
+
+} // namespace
+
+void adpcmEncode(AdpcmState &state, const int16_t *pcm, size_t count, uint8_t *out) {
+  if (state.index > kMaxIndex) {
+    state.index = kMaxIndex;
+  }
+  for (size_t i = 0; i < count; i += 2) {
+    uint8_t b = encodeOne(state, pcm[i]);
+    if (i + 1 < count) {
+      b |= static_cast<uint8_t>(encodeOne(state, pcm[i + 1]) << 4);
+    }
+    out[i / 2] = b;
+  }
+}
+
+void adpcmDecode(AdpcmState &state, const uint8_t *in, size_t count, int16_t *pcm) { adpcmDecode(state, in, 0, count, pcm); }
+
+void adpcmDecode(AdpcmState &state, const uint8_t *in, size_t first, size_t count, int16_t *pcm) {
+  if (state.index > kMaxIndex) {
+    state.index = kMaxIndex; /* from the wire: never index past the table */
+  }
+  for (size_t i = 0; i < count; i++) {
+    const size_t n = first + i;
+    const uint8_t code = (n & 1) ? (in[n / 2] >> 4) : (in[n / 2] & 0x0F);
+    step(state, code);
+    pcm[i] = state.predictor;
+  }
+}
+
+} // namespace audio
@@ -0,0 +1,49 @@
+/**
+ * @file ima_adpcm.h
+ * @brief IMA/DVI ADPCM (4 bit per sample) encoder and decoder.
+ *
+ * 16-bit PCM at 8 kHz becomes 32 kbit/s, cheap enough to run per block on
+ * the audio workqueue. The codec state (predictor and step index) is two
+ * values; the audio link sends the state at the start of every frame, so a
+ * lost frame costs exactly that frame and the next one decodes cleanly.
+ *
+ * Codes are packed two per byte, first sample in the low nibble (the WAV
+ * IMA-ADPCM order). Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_IMA_ADPCM_H_
+#define OE5XRX_AUDIO_IMA_ADPCM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+struct AdpcmState {
+  int16_t predictor;
+  uint8_t index; /* step table index, 0..88 */
+};
+
+/** Encoded size of @p samples samples, in bytes. */
+constexpr size_t adpcmBytes(size_t samples) { return (samples + 1) / 2; }
+
+/**
+ * Encode @p count samples into @p out (adpcmBytes(count) bytes), advancing
+ * @p state. An odd trailing code leaves the high nibble zero.
+ */
+void adpcmEncode(AdpcmState &state, const int16_t *pcm, size_t count, uint8_t *out);
+
+/** Decode @p count samples from @p in, advancing @p state. */
+void adpcmDecode(AdpcmState &state, const uint8_t *in, size_t count, int16_t *pcm);
+
+/**
+ * Decode codes @p first .. @p first + @p count - 1 of the stream at @p in,
+ * advancing @p state; for resuming mid-stream at any sample, odd ones too.
+ */
+void adpcmDecode(AdpcmState &state, const uint8_t *in, size_t first, size_t count, int16_t *pcm);
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_IMA_ADPCM_H_ */
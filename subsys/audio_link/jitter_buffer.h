@@ -0,0 +1,272 @@
+/**
+ * @file jitter_buffer.h
+ * @brief Adaptive playout buffer for audio frames arriving over a link.
+ *
+ * Frames are filed by sequence number, so reordering and duplicates are
+ * absorbed, and played out at the local sample rate. Playout starts once the
+ * target depth is buffered. The target follows the RFC 3550 interarrival
+ * jitter estimate (three times the jitter, rounded up to frames, on top of
+ * min_frames), plus one extra frame per underrun that decays again after a
+ * clean stretch. A buffer that stays more than a frame above target drops
+ * one frame to bring the delay back down.
+ *
+ * A frame that is missing at its playout time is concealed: the previous
+ * frame repeats at half the level per consecutive loss, fading to silence.
+ * If nothing at all is buffered the buffer underruns, plays silence and
+ * rebuffers to the (now larger) target.
+ *
+ * put() and get() must be serialized by the caller. Times are in samples of
+ * the local clock (uint32, wrap-safe). Pure logic: no Zephyr, no heap, no
+ * float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_JITTER_BUFFER_H_
+#define OE5XRX_AUDIO_JITTER_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace audio {
+
+template <size_t kSlots, size_t kFrameSamples> class JitterBuffer {
+  static_assert(kSlots >= 2 && kSlots <= 64, "slot count out of range");
+  /* seq % kSlots stays collision-free across the uint16 wrap only then. */
+  static_assert((kSlots & (kSlots - 1)) == 0, "slot count must be a power of two");
+
+public:
+  struct Config {
+    uint8_t min_frames; /* target floor, >= 1 */
+    uint8_t max_frames; /* target ceiling, < kSlots */
+  };
+
+  struct Stats {
+    uint32_t received;  /* frames accepted by put() */
+    uint32_t played;    /* frames played out */
+    uint32_t concealed; /* frames missing at their playout time */
+    uint32_t late;      /* arrived after their playout time */
+    uint32_t duplicates;
+    uint32_t resyncs;   /* sequence jumped beyond the window: flushed */
+    uint32_t underruns; /* ran dry, rebuffered */
+    uint32_t shrinks;   /* frames dropped to cut excess delay */
+    uint32_t jitter_q4; /* interarrival jitter, samples * 16 */
+    uint8_t target;     /* current target depth, frames */
+    uint8_t depth;      /* frames buffered */
+  };
+
+  void init(const Config &cfg) {
+    cfg_ = cfg;
+    if (cfg_.min_frames < 1) {
+      cfg_.min_frames = 1;
+    }
+    if (cfg_.max_frames >= kSlots) {
+      cfg_.max_frames = kSlots - 1;
+    }
+    if (cfg_.max_frames < cfg_.min_frames) {
+      cfg_.max_frames = cfg_.min_frames;
+    }
+    flush();
+    started_ = false;
+    have_transit_ = false;
+    extra_ = 0;
+    stats_ = {};
+    stats_.target = cfg_.min_frames;
+  }
+
+  /**
+   * File one frame of kFrameSamples samples.
+   * @param timestamp sender's sample clock at the frame's first sample
+   * @param arrival   local sample clock now
+   */
+  void put(uint16_t seq, uint32_t timestamp, uint32_t arrival, const int16_t *pcm) {
+    const int32_t transit = static_cast<int32_t>(arrival - timestamp);
+    if (have_transit_) {
+      int32_t d = transit - last_transit_;
+      d = d < 0 ? -d : d;
+      const int32_t j = static_cast<int32_t>(stats_.jitter_q4);
+      stats_.jitter_q4 = static_cast<uint32_t>(j + d - (j >> 4));
+    }
+    last_transit_ = transit;
+    have_transit_ = true;
+
+    if (!started_) {
+      started_ = true;
+      next_seq_ = seq;
+      high_seq_ = seq;
+    }
+    const int16_t ahead = static_cast<int16_t>(seq - next_seq_);
+    if (ahead < 0) {
+      if (static_cast<int16_t>(high_seq_ - seq) >= static_cast<int16_t>(kSlots)) {
+        /* Far behind the newest frame (the sender restarted its count). */
+        resync(seq);
+      } else if (!playing_) {
+        /* Still buffering and it fits in front: start playout earlier. */
+        next_seq_ = seq;
+      } else {
+        stats_.late++;
+        return;
+      }
+    } else if (ahead >= static_cast<int16_t>(kSlots)) {
+      /* Far ahead of playout (outage, or the sender restarted): start over. */
+      resync(seq);
+    }
+
+    const size_t slot = seq % kSlots;
+    if (valid_[slot] && seqs_[slot] == seq) {
+      stats_.duplicates++;
+      return;
+    }
+    if (!valid_[slot]) {
+      count_++;
+    }
+    valid_[slot] = true;
+    seqs_[slot] = seq;
+    memcpy(frames_[slot], pcm, sizeof(frames_[slot]));
+    if (static_cast<int16_t>(seq - high_seq_) > 0) {
+      high_seq_ = seq;
+    }
+    stats_.received++;
+    updateTarget();
+  }
+
+  /** Play out @p count samples; always fills @p out (silence while buffering). */
+  void get(int16_t *out, size_t count) {
+    while (count > 0) {
+      if (!playing_) {
+        if (count_ == 0 || count_ < stats_.target) {
+          memset(out, 0, count * sizeof(int16_t));
+          return;
+        }
+        playing_ = true;
+        pos_ = 0;
+      }
+      if (pos_ == 0 && !startFrame()) {
+        continue; /* underran: back to buffering */
+      }
+      size_t n = kFrameSamples - pos_;
+      n = n < count ? n : count;
+      memcpy(out, &cur_[pos_], n * sizeof(int16_t));
+      out += n;
+      count -= n;
+      pos_ = (pos_ + n) % kFrameSamples;
+    }
+  }
+
+  bool playing() const { return playing_; }
+
+  const Stats &stats() const { return stats_; }
+
+private:
+  /* Frames above target before one is dropped (~1 s of 20 ms frames). */
+  static constexpr uint32_t kShrinkAfter = 50;
+  /* Clean frames before an underrun's extra frame of delay is given back. */
+  static constexpr uint32_t kDecayAfter = 500;
+  /* Consecutive concealed frames before the repeat has faded to silence. */
+  static constexpr uint32_t kConcealFade = 3;
+
+  void flush() {
+    memset(valid_, 0, sizeof(valid_));
+    count_ = 0;
+    playing_ = false;
+    pos_ = 0;
+    deep_run_ = 0;
+    stats_.depth = 0;
+  }
+
+  void resync(uint16_t seq) {
+    stats_.resyncs++;
+    flush();
+    next_seq_ = seq;
+    high_seq_ = seq;
+  }
+
+  void updateTarget() {
+    const uint32_t jitter = stats_.jitter_q4 >> 4;
+    uint32_t t = cfg_.min_frames + (3 * jitter + kFrameSamples - 1) / kFrameSamples + extra_;
+    t = t > cfg_.max_frames ? cfg_.max_frames : t;
+    stats_.target = static_cast<uint8_t>(t);
+    stats_.depth = static_cast<uint8_t>(count_);
+  }
+
+  /* Load the frame due now into cur_. False if the buffer ran dry. */
+  bool startFrame() {
+    const size_t slot = next_seq_ % kSlots;
+    if (valid_[slot] && seqs_[slot] == next_seq_) {
+      memcpy(cur_, frames_[slot], sizeof(cur_));
+      valid_[slot] = false;
+      count_--;
+      conceal_run_ = 0;
+      stats_.played++;
+    } else if (count_ == 0) {
+      /* Nothing to play or conceal from: rebuffer with a deeper target. The
+       * missing frame stays expected, it may still be on its way. */
+      playing_ = false;
+      stats_.underruns++;
+      clean_run_ = 0;
+      if (extra_ < cfg_.max_frames) {
+        extra_++;
+      }
+      updateTarget();
+      return false;
+    } else {
+      /* Lost (or not here yet while later ones are): conceal. */
+      conceal_run_++;
+      for (size_t i = 0; i < kFrameSamples; i++) {
+        cur_[i] = conceal_run_ >= kConcealFade ? 0 : static_cast<int16_t>(cur_[i] / 2);
+      }
+      stats_.concealed++;
+    }
+    next_seq_++;
+
+    if (++clean_run_ >= kDecayAfter && extra_ > 0) {
+      extra_--;
+      clean_run_ = 0;
+    }
+    updateTarget();
+
+    /* Persistently deeper than needed: skip the oldest buffered frame. */
+    if (count_ > static_cast<size_t>(stats_.target) + 1) {
+      if (++deep_run_ >= kShrinkAfter) {
+        const size_t s = next_seq_ % kSlots;
+        if (valid_[s] && seqs_[s] == next_seq_) {
+          valid_[s] = false;
+          count_--;
+        }
+        next_seq_++;
+        deep_run_ = 0;
+        stats_.shrinks++;
+        updateTarget();
+      }
+    } else {
+      deep_run_ = 0;
+    }
+    return true;
+  }
+
+  Config cfg_{1, 1};
+  int16_t frames_[kSlots][kFrameSamples]{};
+  uint16_t seqs_[kSlots]{};
+  bool valid_[kSlots]{};
+  size_t count_ = 0;
+
+  int16_t cur_[kFrameSamples]{};
+  size_t pos_ = 0;
+  uint16_t next_seq_ = 0;
+  uint16_t high_seq_ = 0;
+  bool started_ = false;
+  bool playing_ = false;
+
+  int32_t last_transit_ = 0;
+  bool have_transit_ = false;
+  uint32_t extra_ = 0;
+  uint32_t clean_run_ = 0;
+  uint32_t conceal_run_ = 0;
+  uint32_t deep_run_ = 0;
+  Stats stats_{};
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_JITTER_BUFFER_H_ */
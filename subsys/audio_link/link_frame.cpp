@@ -0,0 +1,105 @@
+/**
+ * @file link_frame.cpp
+ * @brief Serial audio link framing. See link_frame.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "link_frame.h"
+
+#include <string.h>
+
+namespace audio {
+
+namespace {
+
+constexpr uint8_t kSync0 = 0xA5;
+constexpr uint8_t kSync1 = 0x5A;
+constexpr uint8_t kVersion = 1;
+constexpr uint8_t kVersionShift = 6;
+constexpr uint8_t kFlagMask = LinkFrameHeader::kPtt | LinkFrameHeader::kCos;
+
+inline void put16(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline uint16_t get16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+} // namespace
+
+uint16_t linkCrc16(const uint8_t *data, size_t len, uint16_t crc) {
+  for (size_t i = 0; i < len; i++) {
+    crc ^= static_cast<uint16_t>(data[i] << 8);
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t linkFrameEncode(const LinkFrameHeader &hdr, const uint8_t *payload, uint8_t *out, size_t cap) {
+  const size_t total = kLinkHeaderBytes + hdr.length + kLinkCrcBytes;
+  if (cap < total) {
+    return 0;
+  }
+  out[0] = kSync0;
+  out[1] = kSync1;
+  out[2] = static_cast<uint8_t>((kVersion << kVersionShift) | (hdr.flags & kFlagMask));
+  put16(&out[3], hdr.seq);
+  put16(&out[5], static_cast<uint16_t>(hdr.timestamp));
+  put16(&out[7], static_cast<uint16_t>(hdr.timestamp >> 16));
+  put16(&out[9], static_cast<uint16_t>(hdr.adpcm.predictor));
+  out[11] = hdr.adpcm.index;
+  out[12] = hdr.length;
+  memcpy(&out[kLinkHeaderBytes], payload, hdr.length);
+  put16(&out[kLinkHeaderBytes + hdr.length], linkCrc16(&out[2], kLinkHeaderBytes - 2 + hdr.length));
+  return total;
+}
+
+bool LinkFrameParser::scan() {
+  for (;;) {
+    /* Hunt: the buffer must start with the sync word. */
+    if (fill_ >= 1 && buf_[0] != kSync0) {
+      stats_.skipped++;
+      consume(1);
+      continue;
+    }
+    if (fill_ >= 2 && buf_[1] != kSync1) {
+      stats_.skipped++;
+      consume(1);
+      continue;
+    }
+    if (fill_ < kLinkHeaderBytes) {
+      return false;
+    }
+    const size_t len = buf_[12];
+    const size_t total = kLinkHeaderBytes + len + kLinkCrcBytes;
+    if (fill_ < total) {
+      return false;
+    }
+    const bool crc_ok = linkCrc16(&buf_[2], kLinkHeaderBytes - 2 + len) == get16(&buf_[kLinkHeaderBytes + len]);
+    if (!crc_ok || (buf_[2] >> kVersionShift) != kVersion) {
+      /* Not a frame after all (or a damaged one): resync one byte later,
+       * inside the bytes already buffered. */
+      stats_.crc_errors++;
+      consume(1);
+      continue;
+    }
+    hdr_.flags = buf_[2] & kFlagMask;
+    hdr_.seq = get16(&buf_[3]);
+    hdr_.timestamp = get16(&buf_[5]) | (static_cast<uint32_t>(get16(&buf_[7])) << 16);
+    hdr_.adpcm.predictor = static_cast<int16_t>(get16(&buf_[9]));
+    hdr_.adpcm.index = buf_[11];
+    hdr_.length = static_cast<uint8_t>(len);
+    stats_.frames++;
+    return true;
+  }
+}
+
+void LinkFrameParser::consume(size_t n) {
+  fill_ -= n;
+  memmove(buf_, &buf_[n], fill_);
+}
+
+} // namespace audio
@@ -0,0 +1,99 @@
+/**
+ * @file link_frame.h
+ * @brief Framing for the serial audio link (byte stream -> frames and back).
+ *
+ * One frame per audio packet, little-endian:
+ *
+ *   0  0xA5 0x5A   sync
+ *   2  flags       bits 7..6 version (1), bit 1 COS, bit 0 PTT
+ *   3  seq         uint16, +1 per frame
+ *   5  timestamp   uint32, sender's sample clock at the first sample
+ *   9  predictor   int16  } ADPCM state at the first sample, so every
+ *  11  index       uint8  } frame decodes on its own
+ *  12  length      uint8, payload bytes
+ *  13  payload     ADPCM codes
+ *   .  crc         uint16 CRC-16/CCITT-FALSE over flags .. payload
+ *
+ * LinkFrameParser takes the stream in arbitrary pieces. A frame that fails its
+ * CRC is not skipped wholesale: the parser drops one byte and hunts for the
+ * next sync inside what it already has, so a corrupted or truncated frame
+ * costs only itself. Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_AUDIO_LINK_FRAME_H_
+#define OE5XRX_AUDIO_LINK_FRAME_H_
+
+#include "ima_adpcm.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+struct LinkFrameHeader {
+  static constexpr uint8_t kPtt = 0x01; /* sender asks the far end to transmit */
+  static constexpr uint8_t kCos = 0x02; /* sender's receiver has a carrier */
+
+  uint8_t flags;
+  uint16_t seq;
+  uint32_t timestamp;
+  AdpcmState adpcm;
+  uint8_t length;
+};
+
+constexpr size_t kLinkHeaderBytes = 13;
+constexpr size_t kLinkCrcBytes = 2;
+constexpr size_t kLinkMaxPayload = 255;
+constexpr size_t kLinkMaxFrameBytes = kLinkHeaderBytes + kLinkMaxPayload + kLinkCrcBytes;
+
+/** CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). */
+uint16_t linkCrc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF);
+
+/**
+ * Serialize @p hdr (hdr.length payload bytes) into @p out.
+ * @return frame size in bytes, or 0 if @p cap is too small.
+ */
+size_t linkFrameEncode(const LinkFrameHeader &hdr, const uint8_t *payload, uint8_t *out, size_t cap);
+
+class LinkFrameParser {
+public:
+  struct Stats {
+    uint32_t frames;     /* valid frames delivered */
+    uint32_t crc_errors; /* candidates rejected (corrupt, truncated, bad version) */
+    uint32_t skipped;    /* bytes discarded while hunting for sync */
+  };
+
+  /**
+   * Consume @p len bytes; for every valid frame call
+   * @p on_frame(const LinkFrameHeader &, const uint8_t *payload).
+   */
+  template <typename F> void feed(const uint8_t *data, size_t len, F on_frame) {
+    for (size_t i = 0; i < len; i++) {
+      buf_[fill_++] = data[i];
+      while (scan()) {
+        on_frame(hdr_, &buf_[kLinkHeaderBytes]);
+        consume(kLinkHeaderBytes + hdr_.length + kLinkCrcBytes);
+      }
+    }
+  }
+
+  void reset() { fill_ = 0; }
+
+  const Stats &stats() const { return stats_; }
+
+private:
+  /* True when buf_ starts with a complete valid frame (parsed into hdr_). */
+  bool scan();
+  void consume(size_t n);
+
+  uint8_t buf_[kLinkMaxFrameBytes];
+  size_t fill_ = 0;
+  LinkFrameHeader hdr_{};
+  Stats stats_{};
+};
+
+} // namespace audio
+
+#endif /* OE5XRX_AUDIO_LINK_FRAME_H_ */
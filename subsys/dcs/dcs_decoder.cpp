@@ -0,0 +1,287 @@
+/**
+ * @file dcs_decoder.cpp
+ * @brief DCS decoder implementation. See dcs_decoder.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "dcs_decoder.h"
+
+#include <array>
+
+namespace dcs {
+
+namespace {
+
+/* The 83 codes the SA818 accepts (same set and order as its DCS_TABLE), as
+ * octal literals. */
+constexpr uint16_t kCodes[kCodeCount] = {
+    // clang-format off
+    0023, 0025, 0026, 0031, 0032, 0036, 0043, 0047, 0051, 0053, 0054, 0065, 0071, 0072, 0073, 0074,
+    0114, 0115, 0116, 0122, 0125, 0131, 0132, 0134, 0143, 0145, 0152, 0155, 0156, 0162, 0165, 0172,
+    0174, 0205, 0212, 0223, 0225, 0226, 0243, 0244, 0245, 0246, 0251, 0252, 0255, 0261, 0263, 0265,
+    0266, 0271, 0274, 0306, 0311, 0315, 0325, 0331, 0332, 0343, 0346, 0351, 0356, 0364, 0365, 0371,
+    0411, 0412, 0413, 0423, 0431, 0432, 0445, 0446, 0452, 0454, 0455, 0462, 0464, 0465, 0466, 0503,
+    0506, 0516, 0523,
+    // clang-format on
+};
+
+constexpr uint32_t kWordMask = (1U << kWordBits) - 1U;
+constexpr uint32_t kGolayPoly = 0xC75; /* x^11 + x^10 + x^6 + x^5 + x^4 + x^2 + 1 */
+constexpr int kParityBits = 11;
+constexpr uint32_t kDataMask = 0xFFF;
+constexpr uint32_t kMarkerMask = 0xE00; /* bits 9-11 */
+constexpr uint32_t kMarker = 0x800;     /* bits 9-11 = 0,0,1 */
+constexpr uint32_t kCodeMask = 0x1FF;
+
+/* Golay (23,12) corrects up to 3; 2 keeps the false-match rate on noise low
+ * enough that the two-word confirmation rejects it reliably. */
+constexpr int kMaxErrors = 2;
+
+/* 1 kHz biquad low-pass, Butterworth, fc = 200 Hz (Q2.14). DC gain 1. */
+constexpr int32_t kLpB0 = 3384;
+constexpr int32_t kLpB1 = 6769;
+constexpr int32_t kLpB2 = 3384;
+constexpr int32_t kLpA1 = -6054;
+constexpr int32_t kLpA2 = 3208;
+
+/* CIC2 by 8 has DC gain 8^2 = 64. */
+constexpr int kCicGainBits = 6;
+/* Slicer mean time constant: 2^9 samples at 1 kHz (~0.5 s, ~3 codewords). */
+constexpr int kDcShift = 9;
+/* NCO: 134.4 bit/s at 1 kHz in 1/65536-bit steps, and the loop's phase gain. */
+constexpr uint16_t kNcoStep = static_cast<uint16_t>((kBitRateMilli * 65536ULL + 500000ULL) / 1000000ULL);
+constexpr int kNcoGainShift = 3;
+/* Missing this many codeword periods drops the lock. */
+constexpr uint32_t kLossWords = 2;
+
+constexpr uint32_t mod_golay(uint32_t v) {
+  for (int i = kWordBits - 1; i >= kParityBits; i--) {
+    if (v & (1U << i)) {
+      v ^= kGolayPoly << (i - kParityBits);
+    }
+  }
+  return v;
+}
+
+constexpr uint32_t encode_data(uint32_t data) {
+  /* c(x) = d(x) + x^12 p(x) with p = x^11 d mod g: since x^23 == 1 (mod g),
+   * x^12 p == d, so c is a multiple of g and every rotation is a codeword. */
+  return (data & kDataMask) | (mod_golay((data & kDataMask) << kParityBits) << 12);
+}
+
+struct Correction {
+  uint16_t syndrome;
+  uint32_t pattern;
+};
+
+constexpr size_t kCorrections = kWordBits + kWordBits * (kWordBits - 1) / 2; /* weight 1 and 2 */
+
+constexpr std::array<Correction, kCorrections> make_corrections() {
+  std::array<Correction, kCorrections> t{};
+  size_t n = 0;
+  for (int i = 0; i < kWordBits; i++) {
+    t[n++] = {static_cast<uint16_t>(mod_golay(1U << i)), 1U << i};
+  }
+  for (int i = 0; i < kWordBits; i++) {
+    for (int j = i + 1; j < kWordBits; j++) {
+      uint32_t e = (1U << i) | (1U << j);
+      t[n++] = {static_cast<uint16_t>(mod_golay(e)), e};
+    }
+  }
+  return t;
+}
+
+constexpr std::array<Correction, kCorrections> kCorrectionTable = make_corrections();
+
+constexpr std::array<uint32_t, 16> make_code_bitmap() {
+  std::array<uint32_t, 16> m{};
+  for (uint16_t c : kCodes) {
+    m[c >> 5] |= 1U << (c & 31);
+  }
+  return m;
+}
+
+constexpr std::array<uint32_t, 16> kCodeBitmap = make_code_bitmap();
+
+constexpr bool is_code(uint32_t c) {
+  return (kCodeBitmap[c >> 5] >> (c & 31)) & 1U;
+}
+
+static_assert(mod_golay(encode_data(kMarker | 0023)) == 0, "Golay encode broken");
+/* Minimum distance 7: every weight <= 2 pattern has a distinct syndrome, so
+ * the first table hit is the only one. */
+static_assert(kMaxErrors == 2, "kCorrectionTable holds the weight-1 and weight-2 patterns");
+
+inline int popcount23(uint32_t v) {
+  return __builtin_popcount(v);
+}
+
+inline uint32_t rotate_right(uint32_t w, int r) {
+  return r == 0 ? w : ((w >> r) | (w << (kWordBits - r))) & kWordMask;
+}
+
+/* The other (code, polarity) that produces the same bit stream, if any: some
+ * complemented codewords are rotations of another code's codeword (e.g. 023I
+ * is 047N on air), so the two cannot be told apart. */
+bool find_alias(uint16_t code, bool inverted, uint16_t *alias) {
+  const uint32_t comp = ~(inverted ? ~encode(code) : encode(code)) & kWordMask;
+  for (int r = 0; r < kWordBits; r++) {
+    const uint32_t w = rotate_right(comp, r);
+    if ((w & kMarkerMask) == kMarker && is_code(w & kCodeMask)) {
+      *alias = static_cast<uint16_t>(w & kCodeMask);
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+uint16_t code_at(size_t index) {
+  return index < kCodeCount ? kCodes[index] : 0;
+}
+
+uint32_t encode(uint16_t code) {
+  return encode_data(kMarker | (code & kCodeMask));
+}
+
+void Decoder::reset() {
+  *this = Decoder();
+}
+
+void Decoder::feed(const int16_t *samples, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    int1_ += static_cast<uint32_t>(static_cast<int32_t>(samples[i]));
+    int2_ += int1_;
+    if (++phase8_ < kDecimation) {
+      continue;
+    }
+    phase8_ = 0;
+    uint32_t c1 = int2_ - comb1_;
+    comb1_ = int2_;
+    uint32_t c2 = c1 - comb2_;
+    comb2_ = c1;
+    on_decimated(static_cast<int32_t>(c2) >> kCicGainBits);
+  }
+}
+
+void Decoder::on_decimated(int32_t x) {
+  int32_t y = (kLpB0 * x + kLpB1 * x1_ + kLpB2 * x2_ - kLpA1 * y1_ - kLpA2 * y2_) >> kCoefBits;
+  x2_ = x1_;
+  x1_ = x;
+  y2_ = y1_;
+  y1_ = y;
+
+  /* Slice against the slow mean so ADC offset and level do not matter. */
+  dc_ += y - (dc_ >> kDcShift);
+  const bool level = y > (dc_ >> kDcShift);
+
+  const uint16_t prev = nco_;
+  nco_ = static_cast<uint16_t>(nco_ + kNcoStep);
+  if (level != level_) {
+    /* A transition marks a bit boundary (phase 0): pull the NCO toward it. */
+    nco_ = static_cast<uint16_t>(nco_ - (static_cast<int16_t>(nco_) >> kNcoGainShift));
+    level_ = level;
+  }
+  /* Sample mid-bit: the NCO crossed half a bit on this step. */
+  if (prev < 0x8000U && nco_ >= 0x8000U) {
+    on_bit(level_);
+  }
+}
+
+bool Decoder::match(uint32_t word, uint16_t *code, bool *inverted, uint32_t *errors) const {
+  uint32_t fixed = word;
+  uint32_t corrected = 0;
+  const uint32_t syndrome = mod_golay(word);
+  if (syndrome != 0) {
+    bool found = false;
+    for (const Correction &c : kCorrectionTable) {
+      if (c.syndrome == syndrome) {
+        fixed = word ^ c.pattern;
+        corrected = static_cast<uint32_t>(popcount23(c.pattern));
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+
+  /* Only the current alignment is tested: the window slides one bit per call,
+   * so an aligned codeword shows up once per 23 bits. The all-ones word is a
+   * Golay codeword, so the complement of a corrected word is one too. */
+  for (int pol = 0; pol < 2; pol++) {
+    const uint32_t w = pol ? (~fixed & kWordMask) : fixed;
+    if ((w & kMarkerMask) == kMarker && is_code(w & kCodeMask)) {
+      *code = static_cast<uint16_t>(w & kCodeMask);
+      *inverted = pol != 0;
+      *errors = corrected;
+      return true;
+    }
+  }
+  return false;
+}
+
+void Decoder::on_bit(bool bit) {
+  shift_ = (shift_ >> 1) | (static_cast<uint32_t>(bit) << (kWordBits - 1));
+  bits_++;
+  if (bits_ < static_cast<uint32_t>(kWordBits)) {
+    return;
+  }
+
+  uint16_t code = 0;
+  bool inverted = false;
+  uint32_t errors = 0;
+  if (match(shift_, &code, &inverted, &errors)) {
+    /* Some codes are rotations of others (or of their complements), so one
+     * signal can match several codes at different offsets. Track each
+     * candidate separately; a candidate confirms when it re-matches a whole
+     * number of codewords later. */
+    Candidate *slot = nullptr;
+    Candidate *oldest = &cands_[0];
+    for (Candidate &c : cands_) {
+      if (c.valid && c.code == code && c.inverted == inverted) {
+        slot = &c;
+        break;
+      }
+      if (!c.valid || c.last_bit < oldest->last_bit) {
+        oldest = &c;
+      }
+    }
+
+    const uint32_t since = slot != nullptr ? bits_ - slot->last_bit : 0;
+    if (slot != nullptr && since % kWordBits == 0 && since <= kLossWords * kWordBits) {
+      /* Stay on the current code while it is alive; a normal-polarity alias
+       * wins over an inverted lock. */
+      const bool current = det_.locked && det_.code == code && det_.inverted == inverted;
+      const bool takeover = !det_.locked || (det_.inverted && !inverted);
+      if (!current && takeover) {
+        det_ = Detection{};
+        det_.locked = true;
+        det_.code = code;
+        det_.inverted = inverted;
+        det_.has_alias = find_alias(code, inverted, &det_.alias_code);
+        locks_++;
+      }
+      if (det_.locked && det_.code == code && det_.inverted == inverted) {
+        det_.words++;
+        det_.corrected += errors;
+        last_lock_bit_ = bits_;
+      }
+    } else if (slot == nullptr) {
+      slot = oldest;
+      slot->valid = true;
+      slot->code = code;
+      slot->inverted = inverted;
+    }
+    slot->last_bit = bits_;
+  }
+
+  if (det_.locked && bits_ - last_lock_bit_ > kLossWords * kWordBits) {
+    det_.locked = false;
+  }
+}
+
+} // namespace dcs
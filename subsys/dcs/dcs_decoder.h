@@ -0,0 +1,115 @@
+/**
+ * @file dcs_decoder.h
+ * @brief DCS (Digital-Coded Squelch / DPL) decoder for 8 kHz RX audio.
+ *
+ * DCS sends a 23-bit Golay (23,12) codeword as sub-audible 134.4 bit/s NRZ,
+ * repeated back to back. The receiver therefore sees the codeword at an
+ * arbitrary rotation, and inverted ("I" codes) when the polarity is flipped.
+ *
+ * Signal chain (the per-8-kHz-sample cost is two integrator adds):
+ *   8 kHz --CIC2 /8--> 1 kHz --biquad LPF 200 Hz--> DC-tracking slicer
+ *         --> NCO clock recovery (phase nudged at each transition)
+ *         --> 23-bit shift register --> Golay syndrome correction (<= 2 bit
+ *             errors) and a check of the aligned window against the 83 SA818
+ *             codes, normal first then inverted.
+ *
+ * Where an inverted code is on air identical to a normal one (023I == 047N),
+ * the normal code is reported and the inverted one is given as its alias.
+ *
+ * A code is reported once it has matched again a whole number of codeword
+ * periods later (at most two), and dropped after two periods with no match.
+ * Pure logic: no Zephyr, no heap, no float.
+ *
+ * Codeword layout (bit 0 sent first): bits 0-8 the code's three octal digits
+ * (last digit in bits 0-2), bits 9-11 = 0,0,1, bits 12-22 the Golay parity
+ * for generator 0xC75.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_DCS_DECODER_H_
+#define OE5XRX_DCS_DECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcs {
+
+/** Number of DCS codes the SA818 supports (023 .. 523). */
+constexpr size_t kCodeCount = 83;
+/** Bits per DCS codeword. */
+constexpr int kWordBits = 23;
+/** DCS bit rate in milli-bits per second (134.4 bit/s). */
+constexpr uint32_t kBitRateMilli = 134400;
+
+/** Code @p index (0 .. kCodeCount-1) as its octal value, e.g. 023 -> 0023. */
+uint16_t code_at(size_t index);
+
+/** The 23-bit codeword (normal polarity) for octal code @p code. */
+uint32_t encode(uint16_t code);
+
+struct Detection {
+  bool locked = false;   /* a code is currently confirmed */
+  uint16_t code = 0;     /* octal value, valid while locked (print with %03o) */
+  bool inverted = false; /* matched the complemented codeword ("I") */
+  bool has_alias = false; /* the same bit stream is also code alias_code with the
+                             opposite polarity (e.g. 047N == 023I) */
+  uint16_t alias_code = 0;
+  uint32_t words = 0;     /* codeword periods matched since lock */
+  uint32_t corrected = 0; /* bit errors corrected over those words */
+};
+
+class Decoder {
+public:
+  /** Clear filter, clock and lock state. */
+  void reset();
+
+  /** Feed signed 16-bit PCM at 8 kHz. */
+  void feed(const int16_t *samples, size_t count);
+
+  const Detection &detection() const { return det_; }
+
+  /** Number of lock events since reset (a new code or a reacquire). */
+  uint32_t locks() const { return locks_; }
+
+private:
+  static constexpr int kDecimation = 8;
+  static constexpr int kCoefBits = 14;
+
+  void on_decimated(int32_t x);
+  void on_bit(bool bit);
+  bool match(uint32_t word, uint16_t *code, bool *inverted, uint32_t *errors) const;
+
+  /* CIC2 decimator: modular (wrapping) arithmetic is intended. */
+  uint32_t int1_ = 0, int2_ = 0, comb1_ = 0, comb2_ = 0;
+  int phase8_ = 0;
+
+  /* Biquad LPF state (1 kHz). */
+  int32_t x1_ = 0, x2_ = 0, y1_ = 0, y2_ = 0;
+
+  /* Slicer + clock recovery. */
+  int32_t dc_ = 0;     /* slow mean, Q8 */
+  bool level_ = false; /* last sliced level */
+  uint16_t nco_ = 0;   /* bit phase, 0x10000 == one bit; boundary at 0 */
+
+  /* Framing. */
+  struct Candidate {
+    bool valid = false;
+    bool inverted = false;
+    uint16_t code = 0;
+    uint32_t last_bit = 0; /* bits_ at its last match */
+  };
+  static constexpr size_t kCandidates = 4;
+
+  uint32_t shift_ = 0;
+  uint32_t bits_ = 0;          /* bits since reset */
+  uint32_t last_lock_bit_ = 0; /* bits_ at the locked code's last match */
+  Candidate cands_[kCandidates];
+
+  Detection det_;
+  uint32_t locks_ = 0;
+};
+
+} // namespace dcs
+
+#endif /* OE5XRX_DCS_DECODER_H_ */
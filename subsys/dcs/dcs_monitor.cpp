@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * DCS monitor. See <oe5xrx/audio/dcs.h>.
+ */
+#include "dcs_decoder.h"
+
+#include <oe5xrx/audio/dcs.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_REGISTER(dcs, CONFIG_AUDIO_DCS_LOG_LEVEL);
+
+namespace {
+
+/* The decoder itself is only touched by the feeding thread; readers get the
+ * copy published under the spinlock after each block. */
+dcs::Decoder decoder;
+struct k_spinlock status_lock;
+struct dcs_status status;
+
+} // namespace
+
+void dcs_monitor_feed(const int16_t *samples, size_t count) {
+  const uint32_t t0 = k_cycle_get_32();
+  decoder.feed(samples, count);
+  const uint32_t cycles = k_cycle_get_32() - t0;
+
+  const dcs::Detection &det = decoder.detection();
+  bool changed;
+
+  k_spinlock_key_t key = k_spin_lock(&status_lock);
+  changed = status.locked != det.locked || (det.locked && (status.code != det.code || status.inverted != det.inverted));
+  status.locked = det.locked;
+  status.code = det.code;
+  status.inverted = det.inverted;
+  status.has_alias = det.has_alias;
+  status.alias_code = det.alias_code;
+  status.words = det.words;
+  status.corrected = det.corrected;
+  status.locks = decoder.locks();
+  status.samples += count;
+  status.cycles_last = cycles;
+  if (cycles > status.cycles_max) {
+    status.cycles_max = cycles;
+  }
+  status.cycles_total += cycles;
+  k_spin_unlock(&status_lock, key);
+
+  if (changed) {
+    char buf[8];
+    if (det.locked) {
+      LOG_DBG("locked %s", dcs_code_str(det.code, det.inverted, buf));
+    } else {
+      LOG_DBG("lost");
+    }
+  }
+}
+
+void dcs_monitor_get(struct dcs_status *out) {
+  k_spinlock_key_t key = k_spin_lock(&status_lock);
+  *out = status;
+  k_spin_unlock(&status_lock, key);
+  out->cycles_per_sec = sys_clock_hw_cycles_per_sec();
+}
+
+char *dcs_code_str(uint16_t code, bool inverted, char *buf) {
+  snprintf(buf, 5, "%03o%c", code & 0777, inverted ? 'I' : 'N');
+  return buf;
+}
+
+#ifdef CONFIG_AUDIO_DCS_SHELL
+
+static int cmd_dcs_status(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  struct dcs_status st;
+  char code[8] = "none";
+  char alias[8] = "none";
+
+  dcs_monitor_get(&st);
+  if (st.locked) {
+    dcs_code_str(st.code, st.inverted, code);
+    if (st.has_alias) {
+      dcs_code_str(st.alias_code, !st.inverted, alias);
+    }
+  }
+  /* Cost in cycles per 1000 samples keeps the integer resolution. */
+  const uint32_t milli_cyc = st.samples ? static_cast<uint32_t>(st.cycles_total * 1000U / st.samples) : 0;
+  shell_print(sh, "DCS-STATUS locked=%d code=%s alias=%s words=%u corrected=%u locks=%u samples=%u cyc_per_ksample=%u cyc_max=%u cyc_hz=%u",
+              st.locked ? 1 : 0, code, alias, st.words, st.corrected, st.locks, st.samples, milli_cyc, st.cycles_max, st.cycles_per_sec);
+  return 0;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    dcs_cmds,
+    SHELL_CMD(status, NULL, "Detected DCS code and decoder cost", cmd_dcs_status),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(dcs, &dcs_cmds, "DCS (Digital-Coded Squelch) monitor", NULL);
+
+#endif /* CONFIG_AUDIO_DCS_SHELL */
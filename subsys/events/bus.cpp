@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Event bus: lock-free ingress ring, static subscriber table, delivery thread.
+ * See <oe5xrx/events/bus.h>.
+ */
+#include "event_ring.h"
+
+#include <errno.h>
+#include <etl/vector.h>
+#include <oe5xrx/events/bus.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+LOG_MODULE_REGISTER(events, CONFIG_EVENT_BUS_LOG_LEVEL);
+
+K_SEM_DEFINE(bus_wake, 0, K_SEM_MAX_LIMIT);
+K_MUTEX_DEFINE(bus_lock); /* subscriber table vs. the bus thread */
+
+namespace events {
+
+BUILD_ASSERT((CONFIG_EVENT_BUS_QUEUE_DEPTH & (CONFIG_EVENT_BUS_QUEUE_DEPTH - 1)) == 0, "CONFIG_EVENT_BUS_QUEUE_DEPTH must be a power of two");
+
+/* Constant-initialized: drivers may publish from their init functions, before
+ * the C++ constructors run. */
+constinit static EventRing<Event, CONFIG_EVENT_BUS_QUEUE_DEPTH> ingress;
+static atomic_t published_count;
+static atomic_t dropped_count;
+static etl::vector<Subscriber *, CONFIG_EVENT_BUS_MAX_SUBSCRIBERS> table;
+
+/* Latency accounting; handler deliveries run on the bus thread, wait()
+ * deliveries on the subscribers' own threads. */
+static struct k_spinlock stats_lock;
+static Stats stats;
+
+/* The bus side of Subscriber (queue, semaphore, counters). */
+class Bus {
+public:
+  static int add(Subscriber &sub);
+  static void fanOut(const Event &evt);
+  static void runHandlers();
+  static void account(Subscriber &sub, const Event &evt);
+};
+
+const char *typeName(Type t) {
+  switch (t) {
+  case Type::Squelch:
+    return "squelch";
+  case Type::Ptt:
+    return "ptt";
+  case Type::RadioPower:
+    return "power";
+  case Type::AtLink:
+    return "at_link";
+  case Type::AudioStream:
+    return "audio_stream";
+  case Type::AudioStall:
+    return "audio_stall";
+  case Type::Count:
+    break;
+  }
+  return "?";
+}
+
+bool publish(Type type, int32_t value) {
+  if (!ingress.push(Event{type, value, k_cycle_get_32()})) {
+    atomic_inc(&dropped_count);
+    return false;
+  }
+  atomic_inc(&published_count);
+  k_sem_give(&bus_wake);
+  return true;
+}
+
+void Bus::account(Subscriber &sub, const Event &evt) {
+  const uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - evt.stamp);
+
+  sub.delivered_++;
+  k_spinlock_key_t key = k_spin_lock(&stats_lock);
+  stats.delivered++;
+  stats.lat_last_us = us;
+  stats.lat_max_us = MAX(stats.lat_max_us, us);
+  stats.lat_sum_us += us;
+  if (us > CONFIG_EVENT_BUS_LATENCY_BUDGET_US) {
+    stats.over_budget++;
+  }
+  k_spin_unlock(&stats_lock, key);
+}
+
+int Bus::add(Subscriber &sub) {
+  k_mutex_lock(&bus_lock, K_FOREVER);
+  for (Subscriber *s : table) {
+    if (s == &sub) {
+      k_mutex_unlock(&bus_lock);
+      return -EALREADY;
+    }
+  }
+  if (table.full()) {
+    k_mutex_unlock(&bus_lock);
+    LOG_ERR("subscriber table full, '%s' not added", sub.name());
+    return -ENOMEM;
+  }
+  k_sem_init(&sub.ready_, 0, CONFIG_EVENT_BUS_SUBSCRIBER_QUEUE_DEPTH);
+  table.push_back(&sub);
+  k_mutex_unlock(&bus_lock);
+  return 0;
+}
+
+void Bus::fanOut(const Event &evt) {
+  for (Subscriber *s : table) {
+    if ((s->mask_ & mask(evt.type)) == 0U) {
+      continue;
+    }
+    if (!s->queue_.push(evt)) {
+      s->lost_++;
+      k_spinlock_key_t key = k_spin_lock(&stats_lock);
+      stats.lost++;
+      k_spin_unlock(&stats_lock, key);
+      continue;
+    }
+    if (s->handler_ == nullptr) {
+      k_sem_give(&s->ready_);
+    }
+  }
+}
+
+void Bus::runHandlers() {
+  for (Subscriber *s : table) {
+    if (s->handler_ == nullptr) {
+      continue;
+    }
+    Event evt;
+    while (s->queue_.pop(evt)) {
+      account(*s, evt);
+      s->handler_(evt, s->user_data_);
+    }
+  }
+}
+
+int subscribe(Subscriber &sub) { return Bus::add(sub); }
+
+bool Subscriber::wait(Event &out, k_timeout_t timeout) {
+  if (k_sem_take(&ready_, timeout) != 0 || !queue_.pop(out)) {
+    return false;
+  }
+  Bus::account(*this, out);
+  return true;
+}
+
+void getStats(Stats &out) {
+  k_spinlock_key_t key = k_spin_lock(&stats_lock);
+  out = stats;
+  k_spin_unlock(&stats_lock, key);
+  out.published = static_cast<uint32_t>(atomic_get(&published_count));
+  out.dropped = static_cast<uint32_t>(atomic_get(&dropped_count));
+}
+
+/* Drain the ingress ring into the subscriber queues, then run the handlers for
+ * everything fanned out in this round. */
+static void busThread() {
+  while (true) {
+    k_sem_take(&bus_wake, K_FOREVER);
+
+    k_mutex_lock(&bus_lock, K_FOREVER);
+    Event evt;
+    while (ingress.pop(evt)) {
+      Bus::fanOut(evt);
+    }
+    Bus::runHandlers();
+    k_mutex_unlock(&bus_lock);
+  }
+}
+
+} // namespace events
+
+static void event_bus_thread(void *, void *, void *) { events::busThread(); }
+
+K_THREAD_DEFINE(event_bus_tid, CONFIG_EVENT_BUS_THREAD_STACK_SIZE, event_bus_thread, NULL, NULL, NULL, CONFIG_EVENT_BUS_THREAD_PRIORITY, 0, 0);
+
+#ifdef CONFIG_EVENT_BUS_SHELL
+
+static int cmd_events_stats(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  events::Stats s;
+  events::getStats(s);
+
+  shell_print(sh,
+              "EVENTS-STATS published=%u dropped=%u delivered=%u lost=%u lat_last_us=%u lat_avg_us=%u lat_max_us=%u budget_us=%u "
+              "over_budget=%u",
+              s.published, s.dropped, s.delivered, s.lost, s.lat_last_us, s.delivered ? (uint32_t)(s.lat_sum_us / s.delivered) : 0U,
+              s.lat_max_us, (unsigned)CONFIG_EVENT_BUS_LATENCY_BUDGET_US, s.over_budget);
+
+  k_mutex_lock(&bus_lock, K_FOREVER);
+  for (const events::Subscriber *sub : events::table) {
+    shell_print(sh, "  %-16s mask=0x%02x delivered=%u lost=%u", sub->name(), sub->typeMask(), sub->delivered(), sub->lost());
+  }
+  k_mutex_unlock(&bus_lock);
+  return 0;
+}
+
+static int cmd_events_publish(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  for (uint8_t t = 0; t < static_cast<uint8_t>(events::Type::Count); t++) {
+    const auto type = static_cast<events::Type>(t);
+    if (strcmp(argv[1], events::typeName(type)) == 0) {
+      if (!events::publish(type, static_cast<int32_t>(strtol(argv[2], NULL, 0)))) {
+        shell_error(sh, "ingress full");
+        return -ENOSPC;
+      }
+      return 0;
+    }
+  }
+  shell_error(sh, "unknown event type: %s", argv[1]);
+  return -EINVAL;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    events_cmds,
+    SHELL_CMD(stats, NULL, "Published/dropped counts, delivery latency, subscribers", cmd_events_stats),
+    SHELL_CMD_ARG(publish, NULL, "Inject an event: publish <type> <value>", cmd_events_publish, 3, 0),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(events, &events_cmds, "Internal event bus", NULL);
+
+#endif /* CONFIG_EVENT_BUS_SHELL */
@@ -0,0 +1,95 @@
+/**
+ * @file event_ring.h
+ * @brief Bounded lock-free multi-producer / single-consumer ring.
+ *
+ * The ingress of the event bus: any thread or ISR pushes, the bus thread pops.
+ * Each cell carries a sequence number (Vyukov's bounded queue), so a producer
+ * claims a cell with one CAS on the tail and publishes it with one release
+ * store; nobody ever waits on a lock. push() never blocks: when the ring is
+ * full it returns false and the caller counts the drop.
+ *
+ * A producer preempted between claiming and publishing its cell only holds up
+ * the consumer at that cell (pop() reports empty until the producer resumes);
+ * later producers, including ISRs, still get their own cells. The CAS retries
+ * only when another producer preempted this one, so push() is bounded by the
+ * interrupt nesting depth.
+ *
+ * Cells store their sequence relative to their index, so the all-zero state is
+ * the empty ring: a static instance is constant-initialized and may be pushed
+ * to from driver init, before C++ constructors have run. Pure logic: no
+ * Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_EVENTS_EVENT_RING_H_
+#define OE5XRX_EVENTS_EVENT_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace events {
+
+template <typename T, size_t N> class EventRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+  static_assert(N <= (1U << 30), "capacity must leave room for sequence wrap");
+
+public:
+  /** Enqueue @p v from any thread or ISR. @return false if the ring is full. */
+  bool push(const T &v) {
+    uint32_t pos = tail_.load(std::memory_order_relaxed);
+    Cell *c;
+    for (;;) {
+      c = &cells_[pos & kMask];
+      const int32_t dif = static_cast<int32_t>(seq(*c, pos) - pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false; /* the consumer has not freed this cell yet: full */
+      } else {
+        pos = tail_.load(std::memory_order_relaxed); /* another producer took it */
+      }
+    }
+    c->value = v;
+    c->seq.store(pos + 1 - (pos & kMask), std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Dequeue into @p out. Single consumer only.
+   * @return false if empty (or the oldest cell is still being written).
+   */
+  bool pop(T &out) {
+    Cell &c = cells_[head_ & kMask];
+    if (seq(c, head_) != head_ + 1) {
+      return false;
+    }
+    out = c.value;
+    c.seq.store(head_ + N - (head_ & kMask), std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  static constexpr uint32_t kMask = N - 1;
+
+  struct Cell {
+    std::atomic<uint32_t> seq{0}; /* Vyukov sequence minus the cell index */
+    T value{};
+  };
+
+  static uint32_t seq(const Cell &c, uint32_t pos) { return c.seq.load(std::memory_order_acquire) + (pos & kMask); }
+
+  Cell cells_[N]{};
+  std::atomic<uint32_t> tail_{0};
+  uint32_t head_ = 0; /* consumer-owned */
+};
+
+} // namespace events
+
+#endif /* OE5XRX_EVENTS_EVENT_RING_H_ */
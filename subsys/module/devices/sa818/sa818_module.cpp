@@ -17,7 +17,16 @@
 #include <etl/string_view.h>
 #include <etl/to_arithmetic.h>
 #include <math.h>
+#ifdef CONFIG_AUDIO_DCS
+#include <oe5xrx/audio/dcs.h>
+#endif
 #include <oe5xrx/module/iface.h>
+#ifdef CONFIG_MODULE_SCHED
+#include <oe5xrx/module/scheduler.h>
+#endif
+#ifdef CONFIG_VOICE_PROMPT_MODULE
+#include <oe5xrx/module/voice.h>
+#endif
 #include <optional>
 #include <sa818/sa818.h>
 #include <sa818/sa818_at.h>
@@ -26,6 +35,15 @@
 #include <zephyr/shell/shell.h>
 #include <zephyr/sys/util.h>
 
+#if DT_NODE_HAS_COMPAT_STATUS(DT_NODELABEL(audio_in), oe5xrx_analog_audio_in, okay) && IS_ENABLED(CONFIG_ANALOG_AUDIO_IN)
+#if DT_PROP_LEN(DT_NODELABEL(audio_in), io_channels) > 1
+#include <oe5xrx/audio/analog_audio_in.h>
+/* Auxiliary ADC channels scanned along with the RX audio (io-channels[1..]). */
+#define FM_AAI_NODE DT_NODELABEL(audio_in)
+#define FM_ADC_AUX_COUNT UTIL_DEC(DT_PROP_LEN(FM_AAI_NODE, io_channels))
+#endif
+#endif
+
 namespace {
 
 using mod::Action;
@@ -120,9 +138,11 @@ constexpr float BAND_DEFAULT_FREQ = 145.500f; // within 134-174 MHz (2m)
 const Range VOLUME_RANGES[] = {{nullptr, 1.0, 8.0}};
 const Range SQUELCH_RANGES[] = {{nullptr, 0.0, 8.0}};
 
-/* Output buffer sizes (bounded by CONFIG_SHELL_CMD_BUFF_SIZE on the input side). */
+/* Output buffer sizes (bounded by CONFIG_SHELL_CMD_BUFF_SIZE on the input side).
+ * The describe buffer fits the largest module, `audio` with four notch sections
+ * (about 2.9 KiB); it is static, so it costs the shell thread no stack. */
 constexpr size_t RESULT_BUF_SIZE = 768;
-constexpr size_t DESCRIBE_BUF_SIZE = 2048;
+constexpr size_t DESCRIBE_BUF_SIZE = 4096;
 
 /* Enum value strings: defined once, used for BOTH the descriptor tables below and the
  * parse/serialize logic in the capabilities, so the advertised enum and the accepted
@@ -147,6 +167,16 @@ const FieldSpec SQUELCH_SPEC{"squelch", ValueType::Int, nullptr, SQUELCH_RANGES,
 const FieldSpec TXTONE_SPEC{"tx_tone", ValueType::String};
 const FieldSpec RXTONE_SPEC{"rx_tone", ValueType::String};
 const FieldSpec BAND_SPEC{"band", ValueType::String, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec READY_SPEC{"ready_ms", ValueType::Int, "ms", nullptr, 0, nullptr, 0, /*readonly=*/true};
+#ifdef CONFIG_AUDIO_DCS
+const FieldSpec RX_DCS_SPEC{"rx_dcs", ValueType::String, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+#endif
+#ifdef FM_ADC_AUX_COUNT
+#define FM_AUX_SPEC(i, _) {"aux_" DT_PROP_BY_IDX(FM_AAI_NODE, io_channel_names, UTIL_INC(i)), ValueType::Int, "mV", nullptr, 0, nullptr, 0, /*readonly=*/true}
+const FieldSpec AUX_SPECS[] = {LISTIFY(FM_ADC_AUX_COUNT, FM_AUX_SPEC, (, ))};
+const FieldSpec VDDA_SPEC{"vdda", ValueType::Int, "mV", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec MCU_TEMP_SPEC{"mcu_temp", ValueType::Float, "degC", nullptr, 0, nullptr, 0, /*readonly=*/true};
+#endif
 
 class FrequencyCap : public Setting {
 public:
@@ -437,6 +467,114 @@ private:
   Sa818Context &ctx_;
 };
 
+/* Last power-up's PD-release-to-AT-reply time; null before the first power-up
+ * or when it hit the readiness ceiling. */
+class ReadyCap : public Telemetry {
+public:
+  explicit ReadyCap(Sa818Context &ctx) : ctx_(ctx) {}
+  const FieldSpec &spec() const override { return READY_SPEC; }
+
+protected:
+  Result onGet() override {
+    if (!ctx_.ready()) {
+      return Result::err("driver_error");
+    }
+    sa818_ready_stats st = sa818_get_ready_stats(ctx_.dev);
+    if (st.count == 0 || st.last_ms == 0) {
+      return Result::okNull();
+    }
+    return Result::okInt(static_cast<int>(st.last_ms));
+  }
+
+private:
+  Sa818Context &ctx_;
+};
+
+#ifdef CONFIG_AUDIO_DCS
+/* DCS code decoded from the RX audio by the MCU ("023N"), null while none is locked.
+ * Independent of the SA818's own rx_tone squelch setting. */
+class RxDcsCap : public Telemetry {
+public:
+  const FieldSpec &spec() const override { return RX_DCS_SPEC; }
+
+protected:
+  Result onGet() override {
+    struct dcs_status st;
+    dcs_monitor_get(&st);
+    if (!st.locked) {
+      return Result::okNull();
+    }
+    char buf[8];
+    return Result::okStr(dcs_code_str(st.code, st.inverted, buf));
+  }
+};
+#endif
+
+#ifdef FM_ADC_AUX_COUNT
+/* First auxiliary channel of @p kind; false if none is scanned or it has no average yet. */
+bool find_aux(enum analog_audio_in_aux_kind kind, struct analog_audio_in_aux *aux) {
+  for (uint8_t i = 0; i < FM_ADC_AUX_COUNT; ++i) {
+    if (analog_audio_in_get_aux(DEVICE_DT_GET(FM_AAI_NODE), i, aux) == 0 && aux->kind == kind) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Averaged voltage of one auxiliary channel, null until the first average. */
+class AdcAuxCap : public Telemetry {
+public:
+  explicit AdcAuxCap(uint8_t index) : index_(index) {}
+  const FieldSpec &spec() const override { return AUX_SPECS[index_]; }
+
+protected:
+  Result onGet() override {
+    struct analog_audio_in_aux aux;
+    const int r = analog_audio_in_get_aux(DEVICE_DT_GET(FM_AAI_NODE), index_, &aux);
+    if (r == -EAGAIN) {
+      return Result::okNull();
+    }
+    if (r < 0) {
+      return Result::err("driver_error");
+    }
+    return Result::okInt(static_cast<int>(aux.millivolts));
+  }
+
+private:
+  uint8_t index_;
+};
+
+/* Analog supply measured through VREFINT; null unless VREFINT is scanned. */
+class VddaCap : public Telemetry {
+public:
+  const FieldSpec &spec() const override { return VDDA_SPEC; }
+
+protected:
+  Result onGet() override {
+    struct analog_audio_in_aux aux;
+    if (!find_aux(ANALOG_AUDIO_IN_AUX_VREFINT, &aux)) {
+      return Result::okNull();
+    }
+    return Result::okInt(static_cast<int>(aux.vdda_mv));
+  }
+};
+
+/* Die temperature; null unless the temperature sensor is scanned. */
+class McuTempCap : public Telemetry {
+public:
+  const FieldSpec &spec() const override { return MCU_TEMP_SPEC; }
+
+protected:
+  Result onGet() override {
+    struct analog_audio_in_aux aux;
+    if (!find_aux(ANALOG_AUDIO_IN_AUX_TEMP, &aux)) {
+      return Result::okNull();
+    }
+    return Result::okFloat(aux.temp_dc / 10.0);
+  }
+};
+#endif
+
 /* "none"/"off" are the only strings that legitimately mean "no tone". Any other string
  * that parses to SA818_TONE_NONE is unrecognized (garbage / out-of-range code) and must be
  * rejected as bad_value rather than silently clearing the tone. */
@@ -566,12 +704,38 @@ SquelchCap g_squelch{g_ctx};
 TxToneCap g_txtone{g_ctx};
 RxToneCap g_rxtone{g_ctx};
 BandCap g_band{g_ctx};
+ReadyCap g_ready{g_ctx};
+#ifdef CONFIG_AUDIO_DCS
+RxDcsCap g_rxdcs;
+#endif
+#ifdef FM_ADC_AUX_COUNT
+#define FM_AUX_CAP(i, _) AdcAuxCap{i}
+#define FM_AUX_CAP_REF(i, _) &g_aux[i]
+AdcAuxCap g_aux[] = {LISTIFY(FM_ADC_AUX_COUNT, FM_AUX_CAP, (, ))};
+VddaCap g_vdda;
+McuTempCap g_mcu_temp;
+#endif
 
-Capability *const g_caps[] = {&g_freq, &g_txfreq, &g_rxfreq, &g_ptt, &g_power, &g_rssi, &g_volume, &g_bandwidth, &g_squelch, &g_txtone, &g_rxtone, &g_band};
+Capability *const g_caps[] = {&g_freq, &g_txfreq, &g_rxfreq, &g_ptt, &g_power, &g_rssi, &g_volume, &g_bandwidth, &g_squelch, &g_txtone, &g_rxtone, &g_band,
+                              &g_ready,
+#ifdef CONFIG_AUDIO_DCS
+                              &g_rxdcs,
+#endif
+#ifdef FM_ADC_AUX_COUNT
+                              LISTIFY(FM_ADC_AUX_COUNT, FM_AUX_CAP_REF, (, )), &g_vdda, &g_mcu_temp,
+#endif
+};
 const Identity g_identity{"fm_transceiver", BAND_MODEL, BAND_NAME};
 Module g_module{g_identity, "fm", g_caps};
-Module *const g_modules[] = {&g_module};
-ModuleRegistry g_registry{g_modules};
+Module *const g_modules[] = {&g_module,
+#ifdef CONFIG_MODULE_SCHED
+                             &mod::scheduler_module(),
+#endif
+#ifdef CONFIG_VOICE_PROMPT_MODULE
+                             &mod::voice_module(),
+#endif
+};
+ModuleRegistry g_registry{g_modules, mod::app_modules()};
 
 void emit_result(const struct shell *sh, const Result &r, const char *module, const char *cap, const char *op) {
   char buf[RESULT_BUF_SIZE];
@@ -614,7 +778,7 @@ int cmd_module(const struct shell *sh, size_t argc, char **argv) {
       emit_result(sh, Result::err("unknown_module"), id, "", "describe");
       return 0;
     }
-    char buf[DESCRIBE_BUF_SIZE];
+    static char buf[DESCRIBE_BUF_SIZE]; /* shell thread only */
     mod::JsonWriter w(buf, sizeof(buf));
     w.raw("MODULE-DESCRIBE ");
     m->describe(w);
@@ -671,6 +835,11 @@ int cmd_module(const struct shell *sh, size_t argc, char **argv) {
 
 } // namespace
 
+mod::ModuleRegistry &mod::registry() { return g_registry; }
+
+/* No application modules unless the app links its own mod::app_modules(). */
+__weak std::span<mod::Module *const> mod::app_modules() { return {}; }
+
 SHELL_CMD_REGISTER(module, NULL, "module list | module <id> describe|set|get|do <cap> [value]", cmd_module);
 
 #endif /* CONFIG_MODULE_SA818 */
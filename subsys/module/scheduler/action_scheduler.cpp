@@ -0,0 +1,306 @@
+/**
+ * @file action_scheduler.cpp
+ * @brief Timed module actions on a hashed timer wheel. See action_scheduler.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "action_scheduler.h"
+
+#include <cstring>
+
+namespace sched {
+
+namespace {
+
+constexpr const char *kOpNames[] = {"set", "get", "do"};
+
+/* Decimal digits in [s, end) as uint32; false on anything else or overflow. */
+bool parse_u32(const char *s, const char *end, uint32_t *out) {
+  if (s == end) {
+    return false;
+  }
+  uint64_t v = 0;
+  for (; s < end; s++) {
+    if (*s < '0' || *s > '9') {
+      return false;
+    }
+    v = v * 10U + static_cast<uint64_t>(*s - '0');
+    if (v > UINT32_MAX) {
+      return false;
+    }
+  }
+  *out = static_cast<uint32_t>(v);
+  return true;
+}
+
+/* Copy [s, end) into a NUL-terminated field of @p cap bytes. */
+bool copy_field(const char *s, const char *end, char *dst, size_t cap) {
+  const size_t len = static_cast<size_t>(end - s);
+  if (len >= cap) {
+    return false;
+  }
+  memcpy(dst, s, len);
+  dst[len] = '\0';
+  return true;
+}
+
+/* Next ':'-separated field of @p text starting at @p *pos. */
+bool next_field(const char **pos, const char **start, const char **end) {
+  if (*pos == nullptr) {
+    return false;
+  }
+  *start = *pos;
+  const char *colon = strchr(*pos, ':');
+  *end = colon != nullptr ? colon : *pos + strlen(*pos);
+  *pos = colon != nullptr ? colon + 1 : nullptr;
+  return true;
+}
+
+uint64_t isqrt64(uint64_t v) {
+  uint64_t root = 0;
+  uint64_t bit = uint64_t{1} << 62;
+  while (bit > v) {
+    bit >>= 2;
+  }
+  while (bit != 0U) {
+    if (v >= root + bit) {
+      v -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+uint32_t clamp_u32(uint64_t v) { return v > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(v); }
+
+} // namespace
+
+const char *op_name(Op op) { return kOpNames[static_cast<size_t>(op)]; }
+
+bool parse(const char *text, uint32_t *slot, Spec *out) {
+  const char *pos = text;
+  const char *s;
+  const char *e;
+  Spec spec{};
+
+  if (!next_field(&pos, &s, &e) || !parse_u32(s, e, slot)) {
+    return false;
+  }
+  if (!next_field(&pos, &s, &e) || !parse_u32(s, e, &spec.delay_ms)) {
+    return false;
+  }
+  if (!next_field(&pos, &s, &e) || !parse_u32(s, e, &spec.period_ms)) {
+    return false;
+  }
+  if (!next_field(&pos, &s, &e) || s == e || !copy_field(s, e, spec.action.module, sizeof(spec.action.module))) {
+    return false;
+  }
+  if (!next_field(&pos, &s, &e)) {
+    return false;
+  }
+  bool known = false;
+  for (size_t i = 0; i < sizeof(kOpNames) / sizeof(kOpNames[0]); i++) {
+    if (strlen(kOpNames[i]) == static_cast<size_t>(e - s) && strncmp(kOpNames[i], s, e - s) == 0) {
+      spec.action.op = static_cast<Op>(i);
+      known = true;
+    }
+  }
+  if (!known) {
+    return false;
+  }
+  if (!next_field(&pos, &s, &e) || s == e || !copy_field(s, e, spec.action.cap, sizeof(spec.action.cap))) {
+    return false;
+  }
+  /* The value is everything after the capability, colons included. */
+  if (pos != nullptr && !copy_field(pos, pos + strlen(pos), spec.action.value, sizeof(spec.action.value))) {
+    return false;
+  }
+  *out = spec;
+  return true;
+}
+
+uint32_t ActionScheduler::Stats::late_rms_us() const { return runs == 0U ? 0U : clamp_u32(isqrt64(late_sq_sum / runs)); }
+
+ActionScheduler::ActionScheduler(std::span<Entry> entries) : entries_(entries.first(entries.size() < kMaxEntries ? entries.size() : kMaxEntries)) {
+  for (Entry &e : entries_) {
+    e = Entry{};
+  }
+  clear();
+}
+
+bool ActionScheduler::set(size_t slot, const Spec &spec, uint64_t now_us) {
+  if (slot >= entries_.size()) {
+    return false;
+  }
+  remove(slot);
+  Entry &e = entries_[slot];
+  e = Entry{};
+  e.spec = spec;
+  e.used = true;
+  e.due_us = now_us + uint64_t{spec.delay_ms} * 1000U;
+  /* Never behind the wheel cursor, or the bucket would only be seen a revolution later. */
+  if (e.due_us < cursor_tick_ * kTickUs) {
+    e.due_us = cursor_tick_ * kTickUs;
+  }
+  link(slot);
+  return true;
+}
+
+bool ActionScheduler::remove(size_t slot) {
+  if (slot >= entries_.size() || !entries_[slot].used) {
+    return false;
+  }
+  unlink(slot);
+  entries_[slot].used = false;
+  return true;
+}
+
+void ActionScheduler::clear() {
+  for (Entry &e : entries_) {
+    e.used = false;
+    e.next = kNone;
+  }
+  memset(heads_, kNone, sizeof(heads_));
+}
+
+size_t ActionScheduler::used() const {
+  size_t n = 0;
+  for (const Entry &e : entries_) {
+    n += e.used ? 1U : 0U;
+  }
+  return n;
+}
+
+bool ActionScheduler::next_due(uint64_t *due_us) const {
+  /* One revolution from the cursor: the first bucket holding an entry of
+   * that revolution has the earliest due time. */
+  for (size_t k = 0; k < kWheelSlots; k++) {
+    const uint64_t tick = cursor_tick_ + k;
+    bool found = false;
+    uint64_t best = 0;
+    for (uint8_t i = heads_[tick % kWheelSlots]; i != kNone; i = entries_[i].next) {
+      const uint64_t due = entries_[i].due_us;
+      if (due / kTickUs <= tick && (!found || due < best)) {
+        best = due;
+        found = true;
+      }
+    }
+    if (found) {
+      *due_us = best;
+      return true;
+    }
+  }
+  /* Nothing within a revolution: the next wakeup is far out, take the minimum. */
+  bool found = false;
+  for (const Entry &e : entries_) {
+    if (e.used && (!found || e.due_us < *due_us)) {
+      *due_us = e.due_us;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void ActionScheduler::reset_stats() {
+  stats_ = {};
+  for (Entry &e : entries_) {
+    e.runs = 0;
+    e.failures = 0;
+    e.skipped = 0;
+    e.late_last_us = 0;
+    e.late_max_us = 0;
+  }
+}
+
+void ActionScheduler::link(size_t slot) {
+  const size_t b = bucket(entries_[slot].due_us);
+  entries_[slot].next = heads_[b];
+  heads_[b] = static_cast<uint8_t>(slot);
+}
+
+void ActionScheduler::unlink(size_t slot) {
+  uint8_t *link = &heads_[bucket(entries_[slot].due_us)];
+  while (*link != kNone) {
+    if (*link == slot) {
+      *link = entries_[slot].next;
+      entries_[slot].next = kNone;
+      return;
+    }
+    link = &entries_[*link].next;
+  }
+}
+
+uint32_t ActionScheduler::collect_due(uint64_t now_us) {
+  const uint64_t now_tick = now_us / kTickUs;
+  if (now_tick < cursor_tick_) {
+    return 0;
+  }
+  /* Walk the buckets passed since the last call (all of them after a long
+   * gap); the cursor bucket is walked again since the last call may have
+   * stopped mid-tick. */
+  const uint64_t span = now_tick - cursor_tick_ + 1U;
+  const size_t buckets = span < kWheelSlots ? static_cast<size_t>(span) : kWheelSlots;
+  uint32_t due = 0;
+  for (size_t k = 0; k < buckets; k++) {
+    for (uint8_t i = heads_[(cursor_tick_ + k) % kWheelSlots]; i != kNone; i = entries_[i].next) {
+      if (entries_[i].due_us <= now_us) {
+        due |= 1U << i;
+      }
+    }
+  }
+  cursor_tick_ = now_tick;
+  return due;
+}
+
+size_t ActionScheduler::earliest(uint32_t mask) const {
+  size_t best = kNone;
+  for (size_t i = 0; i < entries_.size(); i++) {
+    if ((mask & (1U << i)) != 0U && (best == kNone || entries_[i].due_us < entries_[best].due_us)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void ActionScheduler::complete(size_t slot, uint64_t started_us, bool ok) {
+  Entry &e = entries_[slot];
+  const uint32_t late = clamp_u32(started_us > e.due_us ? started_us - e.due_us : 0U);
+
+  e.runs++;
+  e.late_last_us = late;
+  if (late > e.late_max_us) {
+    e.late_max_us = late;
+  }
+  stats_.runs++;
+  stats_.late_last_us = late;
+  if (late > stats_.late_max_us) {
+    stats_.late_max_us = late;
+  }
+  stats_.late_sum_us += late;
+  stats_.late_sq_sum += uint64_t{late} * late;
+  if (!ok) {
+    e.failures++;
+    stats_.failures++;
+  }
+
+  unlink(slot);
+  if (e.spec.period_ms == 0U) {
+    e.used = false;
+    return;
+  }
+  const uint64_t period = uint64_t{e.spec.period_ms} * 1000U;
+  e.due_us += period;
+  if (e.due_us <= started_us) {
+    const uint64_t missed = (started_us - e.due_us) / period + 1U;
+    e.due_us += missed * period;
+    e.skipped += clamp_u32(missed);
+    stats_.skipped += clamp_u32(missed);
+  }
+  link(slot);
+}
+
+} // namespace sched
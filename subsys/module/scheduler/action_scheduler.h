@@ -0,0 +1,163 @@
+/**
+ * @file action_scheduler.h
+ * @brief Fixed table of timed module actions on a hashed timer wheel.
+ *
+ * Each entry is one module operation (module id, set/get/do, capability,
+ * value) that runs once after a delay or periodically. Entries hang in a
+ * wheel of kWheelSlots buckets, one per kTickUs tick, hashed by due time;
+ * entries further out than one revolution simply stay in their bucket until
+ * their revolution comes round. Per wakeup the caller
+ *
+ *  - runs run_due(now): only the buckets passed since the last call are
+ *    walked, due entries execute in due order;
+ *  - arms a single timer for next_due().
+ *
+ * So the device wakes exactly once per distinct due time, never on an idle
+ * tick. Periodic entries advance from their previous due time, not from the
+ * execution time, so lateness never accumulates into drift; periods missed
+ * entirely (the executor was blocked) are skipped and counted.
+ *
+ * Lateness (execution start minus due time) is the jitter measure: last, max,
+ * mean and RMS over all runs, plus last/max per entry.
+ *
+ * Times are microseconds on a caller-supplied monotonic uint64 clock. Not
+ * thread-safe: the caller serializes all calls. Pure logic: no Zephyr, no
+ * heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_MODULE_ACTION_SCHEDULER_H_
+#define OE5XRX_MODULE_ACTION_SCHEDULER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace sched {
+
+/** The module operation of an entry (mirrors mod::Op). */
+enum class Op : uint8_t { kSet, kGet, kDo };
+
+/** One module operation: `module <module> <op> <cap> <value>`. */
+struct Action {
+  static constexpr size_t kModuleLen = 16;
+  static constexpr size_t kCapLen = 24;
+  static constexpr size_t kValueLen = 32;
+
+  Op op;
+  char module[kModuleLen];
+  char cap[kCapLen];
+  char value[kValueLen]; /* may be empty */
+};
+
+struct Spec {
+  uint32_t delay_ms;  /* first run this long after set() */
+  uint32_t period_ms; /* 0 = one-shot */
+  Action action;
+};
+
+/**
+ * Parse `<slot>:<delay_ms>:<period_ms>:<module>:<op>:<cap>[:<value>]`, e.g.
+ * `0:5000:600000:fm:do:ptt:on`. The value is the rest of the string and may
+ * itself contain ':'. False on a malformed number, an unknown op or a field
+ * that does not fit.
+ */
+bool parse(const char *text, uint32_t *slot, Spec *out);
+
+/** Lowercase op name as the module shell spells it. */
+const char *op_name(Op op);
+
+class ActionScheduler {
+public:
+  /** Wheel resolution. */
+  static constexpr uint32_t kTickUs = 1000;
+  /** Wheel buckets; one revolution is kWheelSlots ticks. */
+  static constexpr size_t kWheelSlots = 32;
+  /** Table size limit (due entries are collected in a 32-bit mask). */
+  static constexpr size_t kMaxEntries = 32;
+
+  struct Entry {
+    Spec spec;
+    bool used;
+    uint64_t due_us;
+    uint32_t runs;
+    uint32_t failures; /* runs whose operation returned an error */
+    uint32_t skipped;  /* whole periods missed */
+    uint32_t late_last_us;
+    uint32_t late_max_us;
+    uint8_t next;          /* wheel bucket chain */
+  };
+
+  struct Stats {
+    uint32_t runs;
+    uint32_t failures;
+    uint32_t skipped;
+    uint32_t late_last_us;
+    uint32_t late_max_us;
+    uint64_t late_sum_us;
+    uint64_t late_sq_sum; /* us^2 */
+
+    uint32_t late_mean_us() const { return runs == 0U ? 0U : static_cast<uint32_t>(late_sum_us / runs); }
+    uint32_t late_rms_us() const;
+  };
+
+  /** @p entries is the table, at most kMaxEntries long. */
+  explicit ActionScheduler(std::span<Entry> entries);
+
+  /** Put @p spec into @p slot (replacing what was there), due delay_ms after @p now_us. */
+  bool set(size_t slot, const Spec &spec, uint64_t now_us);
+  bool remove(size_t slot);
+  void clear();
+
+  size_t capacity() const { return entries_.size(); }
+  size_t used() const;
+  const Entry &entry(size_t slot) const { return entries_[slot]; }
+
+  /** Earliest due time, possibly already past; false if the table is empty. */
+  bool next_due(uint64_t *due_us) const;
+
+  /**
+   * Execute every entry due at @p now_us, earliest first. @p clock returns
+   * the current time (read again before each execution, so a slow operation
+   * shows up as lateness of the next); @p exec(slot, action) runs the
+   * operation and returns whether it succeeded. One-shots are freed after
+   * their run. Returns the number of entries executed.
+   */
+  template <typename Clock, typename Exec> size_t run_due(uint64_t now_us, Clock &&clock, Exec &&exec) {
+    uint32_t due = collect_due(now_us);
+    size_t ran = 0;
+    while (due != 0U) {
+      const size_t slot = earliest(due);
+      due &= ~(1U << slot);
+      const uint64_t started = clock();
+      const bool ok = exec(slot, static_cast<const Action &>(entries_[slot].spec.action));
+      complete(slot, started, ok);
+      ran++;
+    }
+    return ran;
+  }
+
+  const Stats &stats() const { return stats_; }
+  void reset_stats();
+
+private:
+  static constexpr uint8_t kNone = 0xFF;
+
+  static size_t bucket(uint64_t due_us) { return static_cast<size_t>((due_us / kTickUs) % kWheelSlots); }
+
+  void link(size_t slot);
+  void unlink(size_t slot);
+  uint32_t collect_due(uint64_t now_us);
+  size_t earliest(uint32_t mask) const;
+  void complete(size_t slot, uint64_t started_us, bool ok);
+
+  std::span<Entry> entries_;
+  uint8_t heads_[kWheelSlots];
+  uint64_t cursor_tick_ = 0; /* first tick not yet fully collected */
+  Stats stats_{};
+};
+
+} // namespace sched
+
+#endif /* OE5XRX_MODULE_ACTION_SCHEDULER_H_ */
@@ -0,0 +1,381 @@
+/**
+ * @file scheduler.cpp
+ * @brief Module action scheduler: timer, executor thread, `sched` module, persistence.
+ *
+ * One k_timer is armed for the earliest due time of the table (absolute
+ * deadline, rounded up to the next kernel tick) and wakes the executor thread,
+ * which runs every due entry through the `module` shell registry and re-arms
+ * the timer. Nothing runs on an idle tick.
+ *
+ * The table lock is held while entries execute, so `sched` edits wait for a
+ * running action; an entry may therefore not target the `sched` module itself.
+ *
+ * With CONFIG_MODULE_SCHED_PERSIST each slot is stored as settings key
+ * `sched/<slot>`. After a reset every stored entry is due delay_ms after boot;
+ * a one-shot's key is deleted once it has run.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#include "action_scheduler.h"
+
+#include <errno.h>
+#include <oe5xrx/module/scheduler.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#ifdef CONFIG_MODULE_SCHED_PERSIST
+#include <zephyr/settings/settings.h>
+#endif
+
+LOG_MODULE_REGISTER(module_sched, CONFIG_MODULE_SCHED_LOG_LEVEL);
+
+namespace {
+
+using mod::Capability;
+using mod::FieldSpec;
+using mod::Identity;
+using mod::Module;
+using mod::Result;
+using mod::ValueType;
+using sched::ActionScheduler;
+
+constexpr const char *kModuleId = "sched";
+constexpr mod::Op kOps[] = {mod::Op::Set, mod::Op::Get, mod::Op::Do};
+
+ActionScheduler::Entry g_table[CONFIG_MODULE_SCHED_ENTRIES];
+ActionScheduler g_sched{g_table};
+uint32_t g_wakeups; /* executor wakeups since boot */
+uint32_t g_idle;    /* of those, wakeups that found nothing due */
+
+K_MUTEX_DEFINE(sched_lock);
+K_SEM_DEFINE(sched_wake, 0, 1);
+
+void sched_timer_expiry(struct k_timer *) { k_sem_give(&sched_wake); }
+
+K_TIMER_DEFINE(sched_timer, sched_timer_expiry, NULL);
+
+uint64_t now_us() { return k_ticks_to_us_floor64(k_uptime_ticks()); }
+
+/* Lock held. */
+void rearm() {
+  uint64_t due;
+  if (g_sched.next_due(&due)) {
+    k_timer_start(&sched_timer, K_TIMEOUT_ABS_US(due), K_NO_WAIT);
+  } else {
+    k_timer_stop(&sched_timer);
+  }
+}
+
+#ifdef CONFIG_MODULE_SCHED_PERSIST
+
+/* Bump when sched::Spec changes layout; older records are ignored. */
+constexpr uint8_t kRecordVersion = 1;
+
+struct Record {
+  uint8_t version;
+  sched::Spec spec;
+};
+
+void persist_key(size_t slot, char *key, size_t len) { snprintf(key, len, "%s/%u", kModuleId, static_cast<unsigned>(slot)); }
+
+void persist_save(size_t slot) {
+  char key[16];
+  persist_key(slot, key, sizeof(key));
+  const Record rec{kRecordVersion, g_sched.entry(slot).spec};
+  const int err = settings_save_one(key, &rec, sizeof(rec));
+  if (err != 0) {
+    LOG_WRN("save %s failed (%d)", key, err);
+  }
+}
+
+void persist_delete(size_t slot) {
+  char key[16];
+  persist_key(slot, key, sizeof(key));
+  const int err = settings_delete(key);
+  if (err != 0) {
+    LOG_WRN("delete %s failed (%d)", key, err);
+  }
+}
+
+int persist_load(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
+  char *end;
+  const unsigned long slot = strtoul(name, &end, 10);
+  Record rec;
+  if (end == name || *end != '\0' || len != sizeof(rec)) {
+    return -EINVAL;
+  }
+  if (read_cb(cb_arg, &rec, sizeof(rec)) != static_cast<ssize_t>(sizeof(rec)) || rec.version != kRecordVersion) {
+    return -EINVAL;
+  }
+  sched::Action &a = rec.spec.action;
+  a.module[sizeof(a.module) - 1] = '\0';
+  a.cap[sizeof(a.cap) - 1] = '\0';
+  a.value[sizeof(a.value) - 1] = '\0';
+  if (static_cast<size_t>(a.op) >= ARRAY_SIZE(kOps) || !g_sched.set(slot, rec.spec, now_us())) {
+    return -EINVAL;
+  }
+  return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(module_sched, kModuleId, NULL, persist_load, NULL, NULL);
+
+#else
+
+void persist_save(size_t) {}
+void persist_delete(size_t) {}
+
+#endif /* CONFIG_MODULE_SCHED_PERSIST */
+
+bool execute(size_t slot, const sched::Action &a) {
+  const Module *m = mod::registry().find(a.module);
+  const Result r = m != nullptr ? m->execute(kOps[static_cast<size_t>(a.op)], a.cap, a.value) : Result::err("unknown_module");
+  if (!r.ok()) {
+    LOG_WRN("slot %u: %s %s %s %s: %s", static_cast<unsigned>(slot), a.module, sched::op_name(a.op), a.cap, a.value, r.error());
+  }
+  if (g_sched.entry(slot).spec.period_ms == 0U) {
+    persist_delete(slot);
+  }
+  return r.ok();
+}
+
+void sched_thread(void *, void *, void *) {
+  k_mutex_lock(&sched_lock, K_FOREVER);
+#ifdef CONFIG_MODULE_SCHED_PERSIST
+  int err = settings_subsys_init();
+  if (err == 0) {
+    err = settings_load_subtree(kModuleId);
+  }
+  if (err != 0) {
+    LOG_ERR("settings load failed (%d)", err);
+  }
+  LOG_INF("%u entries restored", static_cast<unsigned>(g_sched.used()));
+#endif
+  rearm();
+  k_mutex_unlock(&sched_lock);
+
+  for (;;) {
+    k_sem_take(&sched_wake, K_FOREVER);
+    k_mutex_lock(&sched_lock, K_FOREVER);
+    g_wakeups++;
+    if (g_sched.run_due(now_us(), now_us, execute) == 0U) {
+      g_idle++;
+    }
+    rearm();
+    k_mutex_unlock(&sched_lock);
+  }
+}
+
+K_THREAD_DEFINE(module_sched_tid, CONFIG_MODULE_SCHED_THREAD_STACK_SIZE, sched_thread, NULL, NULL, NULL, CONFIG_MODULE_SCHED_THREAD_PRIORITY, 0, 0);
+
+/* ---- `sched` module ------------------------------------------------------- */
+
+/* Counters wrap at 2^32; telemetry is a signed int, so report them mod 2^31. */
+int counter(uint32_t v) { return static_cast<int>(v & 0x7FFFFFFFU); }
+
+int used_entries() {
+  k_mutex_lock(&sched_lock, K_FOREVER);
+  const int n = static_cast<int>(g_sched.used());
+  k_mutex_unlock(&sched_lock);
+  return n;
+}
+
+const FieldSpec ADD_SPEC{"add", ValueType::String};
+const FieldSpec REMOVE_SPEC{"remove", ValueType::String};
+const FieldSpec RESET_STATS_SPEC{"reset_stats", ValueType::Bool};
+
+/* `do add <slot>:<delay_ms>:<period_ms>:<module>:<op>:<cap>[:<value>]` -> slot. */
+class AddCap : public mod::Action {
+public:
+  const FieldSpec &spec() const override { return ADD_SPEC; }
+
+protected:
+  Result onDo(const char *value) override {
+    uint32_t slot;
+    sched::Spec spec;
+    if (!sched::parse(value, &slot, &spec) || strcmp(spec.action.module, kModuleId) == 0) {
+      return Result::err("bad_value");
+    }
+    k_mutex_lock(&sched_lock, K_FOREVER);
+    const bool ok = g_sched.set(slot, spec, now_us());
+    if (ok) {
+      persist_save(slot);
+      rearm();
+    }
+    k_mutex_unlock(&sched_lock);
+    return ok ? Result::okInt(static_cast<int>(slot)) : Result::err("out_of_range");
+  }
+
+  Result onGet() override { return Result::okInt(used_entries()); }
+};
+
+/* `do remove <slot>|all` -> entries left. */
+class RemoveCap : public mod::Action {
+public:
+  const FieldSpec &spec() const override { return REMOVE_SPEC; }
+
+protected:
+  Result onDo(const char *value) override {
+    const bool all = strcmp(value, "all") == 0;
+    char *end;
+    const unsigned long slot = strtoul(value, &end, 10);
+    if (!all && (end == value || *end != '\0')) {
+      return Result::err("bad_value");
+    }
+    k_mutex_lock(&sched_lock, K_FOREVER);
+    bool ok = true;
+    if (all) {
+      for (size_t i = 0; i < g_sched.capacity(); i++) {
+        if (g_sched.remove(i)) {
+          persist_delete(i);
+        }
+      }
+    } else {
+      ok = g_sched.remove(slot);
+      if (ok) {
+        persist_delete(slot);
+      }
+    }
+    rearm();
+    const int left = static_cast<int>(g_sched.used());
+    k_mutex_unlock(&sched_lock);
+    return ok ? Result::okInt(left) : Result::err("not_found");
+  }
+
+  Result onGet() override { return Result::okInt(used_entries()); }
+};
+
+/* `do reset_stats <any>`: clear runs, failures and lateness. */
+class ResetStatsCap : public mod::Action {
+public:
+  const FieldSpec &spec() const override { return RESET_STATS_SPEC; }
+
+protected:
+  Result onDo(const char *) override {
+    k_mutex_lock(&sched_lock, K_FOREVER);
+    g_sched.reset_stats();
+    g_wakeups = 0;
+    g_idle = 0;
+    k_mutex_unlock(&sched_lock);
+    return Result::okNull();
+  }
+};
+
+/* One statistics field, selected by @p read. */
+class StatCap : public mod::Telemetry {
+public:
+  StatCap(const FieldSpec &spec, int (*read)(const ActionScheduler::Stats &)) : spec_(spec), read_(read) {}
+  const FieldSpec &spec() const override { return spec_; }
+
+protected:
+  Result onGet() override {
+    k_mutex_lock(&sched_lock, K_FOREVER);
+    const ActionScheduler::Stats st = g_sched.stats();
+    k_mutex_unlock(&sched_lock);
+    return Result::okInt(read_(st));
+  }
+
+private:
+  const FieldSpec &spec_;
+  int (*read_)(const ActionScheduler::Stats &);
+};
+
+const FieldSpec ENTRIES_SPEC{"entries", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec RUNS_SPEC{"runs", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec FAILURES_SPEC{"failures", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec SKIPPED_SPEC{"skipped", ValueType::Int, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec JITTER_LAST_SPEC{"jitter_last_us", ValueType::Int, "us", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec JITTER_MAX_SPEC{"jitter_max_us", ValueType::Int, "us", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec JITTER_MEAN_SPEC{"jitter_mean_us", ValueType::Int, "us", nullptr, 0, nullptr, 0, /*readonly=*/true};
+const FieldSpec JITTER_RMS_SPEC{"jitter_rms_us", ValueType::Int, "us", nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+class EntriesCap : public mod::Telemetry {
+public:
+  const FieldSpec &spec() const override { return ENTRIES_SPEC; }
+
+protected:
+  Result onGet() override { return Result::okInt(used_entries()); }
+};
+
+using Stats = ActionScheduler::Stats;
+
+AddCap g_add;
+RemoveCap g_remove;
+ResetStatsCap g_reset_stats;
+EntriesCap g_entries;
+StatCap g_runs{RUNS_SPEC, [](const Stats &s) { return counter(s.runs); }};
+StatCap g_failures{FAILURES_SPEC, [](const Stats &s) { return counter(s.failures); }};
+StatCap g_skipped{SKIPPED_SPEC, [](const Stats &s) { return counter(s.skipped); }};
+StatCap g_jitter_last{JITTER_LAST_SPEC, [](const Stats &s) { return counter(s.late_last_us); }};
+StatCap g_jitter_max{JITTER_MAX_SPEC, [](const Stats &s) { return counter(s.late_max_us); }};
+StatCap g_jitter_mean{JITTER_MEAN_SPEC, [](const Stats &s) { return counter(s.late_mean_us()); }};
+StatCap g_jitter_rms{JITTER_RMS_SPEC, [](const Stats &s) { return counter(s.late_rms_us()); }};
+
+Capability *const g_caps[] = {&g_add, &g_remove, &g_reset_stats, &g_entries, &g_runs, &g_failures, &g_skipped, &g_jitter_last, &g_jitter_max, &g_jitter_mean,
+                              &g_jitter_rms};
+const Identity g_identity{"action_scheduler", "timer_wheel", "1"};
+Module g_module{g_identity, kModuleId, g_caps};
+
+} // namespace
+
+mod::Module &mod::scheduler_module() { return g_module; }
+
+/* ---- `sched` shell ------------------------------------------------------- */
+
+#ifdef CONFIG_MODULE_SCHED_SHELL
+
+static int cmd_sched_list(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  k_mutex_lock(&sched_lock, K_FOREVER);
+  const uint64_t now = now_us();
+  for (size_t i = 0; i < g_sched.capacity(); i++) {
+    const ActionScheduler::Entry &e = g_sched.entry(i);
+    if (!e.used) {
+      continue;
+    }
+    const sched::Action &a = e.spec.action;
+    const uint64_t due_in_ms = e.due_us > now ? (e.due_us - now) / 1000U : 0U;
+    shell_print(sh, "SCHED-ENTRY slot=%u module=%s op=%s cap=%s value=%s delay_ms=%u period_ms=%u due_in_ms=%llu", static_cast<unsigned>(i), a.module,
+                sched::op_name(a.op), a.cap, a.value, e.spec.delay_ms, e.spec.period_ms, static_cast<unsigned long long>(due_in_ms));
+    shell_print(sh, "SCHED-ENTRY-STATS slot=%u runs=%u failures=%u skipped=%u late_last_us=%u late_max_us=%u", static_cast<unsigned>(i), e.runs, e.failures,
+                e.skipped, e.late_last_us, e.late_max_us);
+  }
+  k_mutex_unlock(&sched_lock);
+  return 0;
+}
+
+static int cmd_sched_stats(const struct shell *sh, size_t argc, char **argv) {
+  k_mutex_lock(&sched_lock, K_FOREVER);
+  if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+    g_sched.reset_stats();
+    g_wakeups = 0;
+    g_idle = 0;
+  }
+  const Stats st = g_sched.stats();
+  const size_t used = g_sched.used();
+  const uint32_t wakeups = g_wakeups;
+  const uint32_t idle = g_idle;
+  k_mutex_unlock(&sched_lock);
+
+  shell_print(sh, "SCHED-STATS entries=%u capacity=%u wakeups=%u idle_wakeups=%u runs=%u failures=%u skipped=%u", static_cast<unsigned>(used),
+              static_cast<unsigned>(g_sched.capacity()), wakeups, idle, st.runs, st.failures, st.skipped);
+  shell_print(sh, "SCHED-JITTER last_us=%u max_us=%u mean_us=%u rms_us=%u", st.late_last_us, st.late_max_us, st.late_mean_us(), st.late_rms_us());
+  return 0;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sched_cmds,
+    SHELL_CMD(list, NULL, "Scheduled entries with their next due time and lateness", cmd_sched_list),
+    SHELL_CMD_ARG(stats, NULL, "Wakeups, runs and execution jitter: stats [reset]", cmd_sched_stats, 1, 1),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(sched, &sched_cmds, "Module action scheduler (edit via `module sched do add|remove`)", NULL);
+
+#endif /* CONFIG_MODULE_SCHED_SHELL */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Log backend feeding the retained log ring behind LOG.TXT (msc_disk.cpp).
+ * Messages are formatted as on the UART: level, timestamp, no colours. In
+ * panic mode the log core calls process() directly from the fault path. A
+ * write is only a memcpy, so the fault report reaches the ring before the
+ * reset and can be read after it.
+ */
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+
+void msc_disk_log_attach(void);
+void msc_disk_log_write(const uint8_t *data, size_t len);
+
+static int ring_out(uint8_t *data, size_t length, void *ctx) {
+  ARG_UNUSED(ctx);
+  msc_disk_log_write(data, length);
+  return (int)length;
+}
+
+static uint8_t ring_buf[64];
+LOG_OUTPUT_DEFINE(ring_output, ring_out, ring_buf, sizeof(ring_buf));
+
+static void ring_process(const struct log_backend *const backend, union log_msg_generic *msg) {
+  ARG_UNUSED(backend);
+  log_output_msg_process(&ring_output, &msg->log, LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP);
+}
+
+static void ring_dropped(const struct log_backend *const backend, uint32_t cnt) {
+  ARG_UNUSED(backend);
+  log_output_dropped_process(&ring_output, cnt);
+}
+
+static void ring_panic(const struct log_backend *const backend) {
+  ARG_UNUSED(backend);
+  log_output_flush(&ring_output);
+}
+
+static void ring_init(const struct log_backend *const backend) {
+  ARG_UNUSED(backend);
+  msc_disk_log_attach();
+}
+
+static const struct log_backend_api ring_api = {
+    .process = ring_process,
+    .dropped = ring_dropped,
+    .panic = ring_panic,
+    .init = ring_init,
+};
+
+LOG_BACKEND_DEFINE(log_backend_msc_ring, ring_api, true);
@@ -0,0 +1,113 @@
+/**
+ * @file log_ring.h
+ * @brief Byte ring for log text that survives a warm reset.
+ *
+ * The ring keeps the newest bytes written. Its control block and data live in
+ * memory the caller provides, normally a no-init RAM section. After a reset,
+ * attach() checks the control block and keeps the old text: the log leading
+ * up to a fault or watchdog reset can be read after the reboot. A cold start
+ * leaves garbage, which fails the check, and the ring starts empty.
+ *
+ * Reading works on a snapshot, the write position at snapshot time. The
+ * reader sees a fixed-length file while logging continues. Bytes the writer
+ * has overwritten since the snapshot read as spaces.
+ *
+ * One writer (the log thread, or the panic path once it has stopped). Reads
+ * may race with it, which can garble text but never reads out of bounds.
+ * Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_MSC_DISK_LOG_RING_H_
+#define OE5XRX_MSC_DISK_LOG_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace msc {
+
+class LogRing {
+public:
+  /** Control block, kept next to the data in retained memory. */
+  struct Control {
+    uint32_t magic;
+    uint32_t head;  /* bytes ever written (mod 2^32) */
+    uint32_t boots; /* attach() calls that found the ring intact */
+    uint32_t check; /* ties the fields above to the magic */
+  };
+
+  /** A fixed view of the ring for reading. */
+  struct Snapshot {
+    uint32_t head;
+    uint32_t size;
+  };
+
+  constexpr LogRing(Control &ctl, uint8_t *data, uint32_t capacity) : ctl_(ctl), data_(data), capacity_(capacity) {}
+
+  /** Take over the memory after a reset. @return true if its text survived. */
+  bool attach() {
+    if (ctl_.magic == kMagic && ctl_.check == seal()) {
+      ctl_.boots++;
+      ctl_.check = seal();
+      return true;
+    }
+    ctl_.magic = kMagic;
+    ctl_.head = 0;
+    ctl_.boots = 0;
+    ctl_.check = seal();
+    return false;
+  }
+
+  void write(const uint8_t *p, size_t n) {
+    uint32_t head = ctl_.head;
+    if (n > capacity_) {
+      head += static_cast<uint32_t>(n - capacity_);
+      p += n - capacity_;
+      n = capacity_;
+    }
+    const uint32_t at = head % capacity_;
+    const size_t first = n < capacity_ - at ? n : capacity_ - at;
+    memcpy(data_ + at, p, first);
+    memcpy(data_, p + first, n - first);
+    ctl_.head = head + static_cast<uint32_t>(n);
+    ctl_.check = seal();
+  }
+
+  /** Bytes held: everything written, up to the capacity. */
+  uint32_t size() const { return ctl_.head < capacity_ ? ctl_.head : capacity_; }
+  uint32_t boots() const { return ctl_.boots; }
+
+  Snapshot snapshot() const { return {ctl_.head, size()}; }
+
+  /** Copy @p len bytes at @p offset of @p snap into @p dst (offset + len <= snap.size). */
+  void read(const Snapshot &snap, uint32_t offset, uint8_t *dst, uint32_t len) const {
+    uint32_t pos = snap.head - snap.size + offset;
+    /* Bytes more than a capacity behind the live head are gone. */
+    const uint32_t behind = ctl_.head - pos;
+    const uint32_t lost = behind > capacity_ ? (behind - capacity_ < len ? behind - capacity_ : len) : 0U;
+    memset(dst, ' ', lost);
+    pos += lost;
+    for (uint32_t done = lost; done < len;) {
+      const uint32_t at = pos % capacity_;
+      const uint32_t n = len - done < capacity_ - at ? len - done : capacity_ - at;
+      memcpy(dst + done, data_ + at, n);
+      done += n;
+      pos += n;
+    }
+  }
+
+private:
+  static constexpr uint32_t kMagic = 0x4C4F4752; /* "LOGR" */
+
+  uint32_t seal() const { return kMagic ^ ctl_.head ^ (ctl_.boots * 0x9E3779B9U) ^ capacity_; }
+
+  Control &ctl_;
+  uint8_t *data_;
+  uint32_t capacity_;
+};
+
+} // namespace msc
+
+#endif /* OE5XRX_MSC_DISK_LOG_RING_H_ */
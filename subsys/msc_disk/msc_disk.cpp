@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Read-only USB drive: disk-access driver over the synthesized FAT volume,
+ * its mass-storage LUN, the file table and the built-in files. See
+ * <oe5xrx/msc/msc_disk.h>.
+ *
+ * The USB stack reads sectors from its own thread; a snapshot (sizes and
+ * frozen content) is rebuilt on a low-priority work queue of its own, as
+ * STATUS.TXT reads every module value and some of those are radio round
+ * trips (fm.rssi: an SA818 AT command, up to 2 s). The files stage their
+ * content without the lock; only committing it and rebuilding the table
+ * take the one mutex, so a sector read never waits on a module Get and the
+ * host never sees a half-built table. Sector reads cost a memset and a
+ * memcpy each; the host reads at what Full-Speed bulk allows.
+ */
+#include "log_ring.h"
+#include "virtual_fat.h"
+
+#include <errno.h>
+#include <oe5xrx/msc/msc_disk.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/usb/class/usbd_msc.h>
+#ifdef CONFIG_MSC_DISK_STATUS
+#include <oe5xrx/module/iface.h>
+#endif
+
+LOG_MODULE_REGISTER(msc_disk, CONFIG_MSC_DISK_LOG_LEVEL);
+
+namespace {
+
+using msc::VirtualFat;
+
+#define MSC_DISK_NAME "FMDISK"
+
+K_MUTEX_DEFINE(lock);
+VirtualFat vfat{"OE5XRX FM", 0x0E5C0001};
+const struct msc_disk_file *files[CONFIG_MSC_DISK_MAX_FILES];
+uint32_t sizes[CONFIG_MSC_DISK_MAX_FILES]; /* at the last snapshot */
+size_t file_count;
+struct msc_disk_stats stats;
+
+void snapshot_handler(struct k_work *) {
+  /* The table only grows, and only this work item reads it unlocked. */
+  k_mutex_lock(&lock, K_FOREVER);
+  const size_t count = file_count;
+  k_mutex_unlock(&lock);
+
+  uint32_t staged[CONFIG_MSC_DISK_MAX_FILES];
+  for (size_t i = 0; i < count; i++) {
+    staged[i] = files[i]->snapshot(files[i]->user_data);
+  }
+
+  k_mutex_lock(&lock, K_FOREVER);
+  vfat.clear();
+  for (size_t i = 0; i < count; i++) {
+    const struct msc_disk_file *f = files[i];
+    if (f->commit != nullptr) {
+      f->commit(f->user_data);
+    }
+    sizes[i] = staged[i];
+    if (!vfat.add(f->name, sizes[i], f->read, f->user_data)) {
+      LOG_WRN("%s (%u bytes) left off the drive", f->name, sizes[i]);
+    }
+  }
+  stats.files = static_cast<uint32_t>(vfat.files());
+  stats.snapshots++;
+  k_mutex_unlock(&lock);
+}
+
+K_WORK_DEFINE(snapshot_work, snapshot_handler);
+K_THREAD_STACK_DEFINE(snapshot_stack, CONFIG_MSC_DISK_WORKQ_STACK_SIZE);
+struct k_work_q snapshot_workq;
+
+/* ---- disk-access driver ---------------------------------------------------- */
+
+int vdisk_init(struct disk_info *) { return 0; }
+
+int vdisk_status(struct disk_info *) { return DISK_STATUS_WR_PROTECT; }
+
+int vdisk_read(struct disk_info *, uint8_t *buf, uint32_t sector, uint32_t count) {
+  k_mutex_lock(&lock, K_FOREVER);
+  for (uint32_t i = 0; i < count; i++) {
+    vfat.read(sector + i, buf + i * VirtualFat::kSectorSize);
+  }
+  stats.sectors_read += count;
+  k_mutex_unlock(&lock);
+  return 0;
+}
+
+int vdisk_write(struct disk_info *, const uint8_t *, uint32_t, uint32_t) { return -EROFS; }
+
+int vdisk_ioctl(struct disk_info *, uint8_t cmd, void *buf) {
+  switch (cmd) {
+  case DISK_IOCTL_GET_SECTOR_COUNT:
+    *static_cast<uint32_t *>(buf) = VirtualFat::kSectorCount;
+    return 0;
+  case DISK_IOCTL_GET_SECTOR_SIZE:
+    *static_cast<uint32_t *>(buf) = VirtualFat::kSectorSize;
+    return 0;
+  case DISK_IOCTL_GET_ERASE_BLOCK_SZ:
+    *static_cast<uint32_t *>(buf) = 1;
+    return 0;
+  case DISK_IOCTL_CTRL_SYNC:
+  case DISK_IOCTL_CTRL_INIT:
+  case DISK_IOCTL_CTRL_DEINIT:
+    return 0;
+  default:
+    return -EINVAL;
+  }
+}
+
+const struct disk_operations disk_ops = {
+    .init = vdisk_init,
+    .status = vdisk_status,
+    .read = vdisk_read,
+    .write = vdisk_write,
+    .ioctl = vdisk_ioctl,
+};
+
+char disk_name[] = MSC_DISK_NAME;
+struct disk_info disk = {
+    .name = disk_name,
+    .ops = &disk_ops,
+};
+
+/* ---- LOG.TXT: the retained log ring ----------------------------------------- */
+
+#ifdef CONFIG_MSC_DISK_LOG
+
+/* Not cleared at startup: the text before a reset is still here after it. */
+struct Retained {
+  msc::LogRing::Control ctl;
+  uint8_t data[CONFIG_MSC_DISK_LOG_SIZE];
+};
+__noinit Retained retained;
+msc::LogRing log_ring{retained.ctl, retained.data, sizeof(retained.data)};
+msc::LogRing::Snapshot log_snap;
+msc::LogRing::Snapshot log_staged;
+
+uint32_t log_snapshot(void *) {
+  log_staged = log_ring.snapshot();
+  return log_staged.size;
+}
+
+void log_commit(void *) { log_snap = log_staged; }
+
+void log_read(uint32_t offset, uint8_t *dst, uint32_t len, void *) { log_ring.read(log_snap, offset, dst, len); }
+
+const struct msc_disk_file log_file = {"LOG.TXT", log_snapshot, log_commit, log_read, nullptr};
+
+#endif /* CONFIG_MSC_DISK_LOG */
+
+/* ---- STATUS.TXT: every module value ----------------------------------------- */
+
+#ifdef CONFIG_MSC_DISK_STATUS
+
+/* Two buffers: the snapshot renders into the one USB is not reading. */
+char status_text[2][CONFIG_MSC_DISK_STATUS_SIZE];
+size_t status_shown; /* index read() serves; flipped under the lock */
+uint32_t status_len;
+
+__printf_like(1, 2) void status_append(const char *fmt, ...) {
+  char *const text = status_text[status_shown ^ 1U];
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = vsnprintf(text + status_len, CONFIG_MSC_DISK_STATUS_SIZE - status_len, fmt, ap);
+  va_end(ap);
+  if (n > 0) {
+    status_len += MIN(static_cast<uint32_t>(n), CONFIG_MSC_DISK_STATUS_SIZE - 1U - status_len);
+  }
+}
+
+/* `module.cap = value unit`, one line per setting and telemetry value. */
+uint32_t status_snapshot(void *) {
+  status_len = 0;
+  status_append("# module values at uptime %u s\r\n", static_cast<uint32_t>(k_uptime_get() / 1000));
+  mod::registry().forEach([](const mod::Module &m) {
+    for (mod::Capability *c : m.capabilities()) {
+      if (c->kind() == mod::Kind::Action) {
+        continue;
+      }
+      const mod::Result r = c->handle(mod::Op::Get, "");
+      char value[48];
+      mod::JsonWriter w(value, sizeof(value));
+      if (r.ok()) {
+        r.renderValue(w);
+      } else {
+        w.raw("error");
+      }
+      const char *unit = c->spec().unit;
+      status_append("%s.%s = %s%s%s\r\n", m.moduleId(), c->name(), value, unit != nullptr ? " " : "", unit != nullptr ? unit : "");
+    }
+  });
+  return status_len;
+}
+
+void status_commit(void *) { status_shown ^= 1U; }
+
+void status_read(uint32_t offset, uint8_t *dst, uint32_t len, void *) { memcpy(dst, status_text[status_shown] + offset, len); }
+
+const struct msc_disk_file status_file = {"STATUS.TXT", status_snapshot, status_commit, status_read, nullptr};
+
+#endif /* CONFIG_MSC_DISK_STATUS */
+
+} // namespace
+
+USBD_DEFINE_MSC_LUN(fm_disk, MSC_DISK_NAME, "OE5XRX", "FM Station", "1.00");
+
+#ifdef CONFIG_MSC_DISK_LOG
+/* Called by the log backend (log_backend_ring.c). */
+extern "C" void msc_disk_log_attach(void) {
+  const bool kept = log_ring.attach();
+  static const char kColdMarker[] = "\r\n--- cold start ---\r\n";
+  static const char kWarmMarker[] = "\r\n--- reset ---\r\n";
+  const char *marker = kept ? kWarmMarker : kColdMarker;
+  log_ring.write(reinterpret_cast<const uint8_t *>(marker), strlen(marker));
+}
+
+extern "C" void msc_disk_log_write(const uint8_t *data, size_t len) { log_ring.write(data, len); }
+#endif
+
+int msc_disk_add_file(const struct msc_disk_file *file) {
+  k_mutex_lock(&lock, K_FOREVER);
+  if (file_count == ARRAY_SIZE(files)) {
+    k_mutex_unlock(&lock);
+    return -ENOMEM;
+  }
+  files[file_count++] = file;
+  k_mutex_unlock(&lock);
+  return 0;
+}
+
+void msc_disk_refresh(void) { (void)k_work_submit_to_queue(&snapshot_workq, &snapshot_work); }
+
+void msc_disk_get_stats(struct msc_disk_stats *out) {
+  k_mutex_lock(&lock, K_FOREVER);
+  *out = stats;
+#ifdef CONFIG_MSC_DISK_LOG
+  out->log_boots = log_ring.boots();
+  out->log_bytes = log_ring.size();
+#endif
+  k_mutex_unlock(&lock);
+}
+
+/* Before main() brings USB up: the LUN's disk must exist by then. */
+static int msc_disk_init(void) {
+  const struct k_work_queue_config cfg = {
+      .name = "msc_workq",
+  };
+  k_work_queue_start(&snapshot_workq, snapshot_stack, K_THREAD_STACK_SIZEOF(snapshot_stack), CONFIG_MSC_DISK_WORKQ_PRIORITY, &cfg);
+
+  const int ret = disk_access_register(&disk);
+  if (ret != 0) {
+    LOG_ERR("disk register failed: %d", ret);
+    return ret;
+  }
+#ifdef CONFIG_MSC_DISK_LOG
+  (void)msc_disk_add_file(&log_file);
+#endif
+#ifdef CONFIG_MSC_DISK_STATUS
+  (void)msc_disk_add_file(&status_file);
+#endif
+  msc_disk_refresh();
+  return 0;
+}
+
+SYS_INIT(msc_disk_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/* ---- `msc` shell ------------------------------------------------------------ */
+
+#ifdef CONFIG_MSC_DISK_SHELL
+
+static int cmd_msc_status(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  struct msc_disk_stats st;
+  msc_disk_get_stats(&st);
+  shell_print(sh, "MSC-STATUS files=%u snapshots=%u sectors_read=%u log_boots=%u log_bytes=%u", st.files, st.snapshots, st.sectors_read,
+              st.log_boots, st.log_bytes);
+  k_mutex_lock(&lock, K_FOREVER);
+  for (size_t i = 0; i < file_count; i++) {
+    shell_print(sh, "MSC-FILE name=%s size=%u", files[i]->name, sizes[i]);
+  }
+  k_mutex_unlock(&lock);
+  return 0;
+}
+
+static int cmd_msc_refresh(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  msc_disk_refresh();
+  shell_print(sh, "Snapshot queued; re-mount the drive to see it");
+  return 0;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    msc_cmds,
+    SHELL_CMD(status, NULL, "Files on the USB drive and sectors served", cmd_msc_status),
+    SHELL_CMD(refresh, NULL, "Snapshot the files again (sizes, STATUS.TXT)", cmd_msc_refresh),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(msc, &msc_cmds, "Read-only USB drive (logs, status)", NULL);
+
+#endif /* CONFIG_MSC_DISK_SHELL */
@@ -0,0 +1,185 @@
+/**
+ * @file virtual_fat.cpp
+ * @brief Synthesized read-only FAT16 volume. See virtual_fat.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "virtual_fat.h"
+
+#include <cstring>
+
+namespace msc {
+
+namespace {
+
+/* No clock on the board: every entry is stamped 2026-01-01 00:00. */
+constexpr uint16_t kDate = ((2026 - 1980) << 9) | (1 << 5) | 1;
+
+constexpr uint8_t kAttrReadOnly = 0x01;
+constexpr uint8_t kAttrVolumeId = 0x08;
+constexpr uint8_t kAttrArchive = 0x20;
+
+void put16(uint8_t *p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void put32(uint8_t *p, uint32_t v) {
+  put16(p, v);
+  put16(p + 2, v >> 16);
+}
+
+char upper(char c) { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c; }
+
+bool valid_char(char c) { return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-'; }
+
+/* "log.txt" -> "LOG     TXT". */
+bool short_name(const char *name, char out[11]) {
+  memset(out, ' ', 11);
+  size_t i = 0;
+  size_t n = 0;
+  for (; name[i] != '\0' && name[i] != '.'; i++, n++) {
+    if (n == 8 || !valid_char(upper(name[i]))) {
+      return false;
+    }
+    out[n] = upper(name[i]);
+  }
+  if (n == 0) {
+    return false;
+  }
+  if (name[i] == '.') {
+    for (i++, n = 8; name[i] != '\0'; i++, n++) {
+      if (n == 11 || !valid_char(upper(name[i]))) {
+        return false;
+      }
+      out[n] = upper(name[i]);
+    }
+  }
+  return true;
+}
+
+void dir_entry(uint8_t *e, const char name[11], uint8_t attr, uint32_t cluster, uint32_t size) {
+  memcpy(e, name, 11);
+  e[11] = attr;
+  put16(e + 16, kDate); /* created */
+  put16(e + 18, kDate); /* accessed */
+  put16(e + 24, kDate); /* written */
+  put16(e + 26, cluster);
+  put32(e + 28, size);
+}
+
+} // namespace
+
+VirtualFat::VirtualFat(const char *label, uint32_t volume_id) : volume_id_(volume_id) {
+  memset(label_, ' ', sizeof(label_));
+  for (size_t i = 0; i < sizeof(label_) && label[i] != '\0'; i++) {
+    label_[i] = upper(label[i]);
+  }
+}
+
+bool VirtualFat::add(const char *name, uint32_t size, ReadFn read, void *user) {
+  File f{};
+  if (count_ == kMaxFiles || read == nullptr || !short_name(name, f.name)) {
+    return false;
+  }
+  f.clusters = static_cast<uint32_t>((static_cast<uint64_t>(size) + kClusterSize - 1) / kClusterSize);
+  if (f.clusters > kClusterCount + 2 - next_cluster_) {
+    return false;
+  }
+  f.size = size;
+  f.first_cluster = f.clusters != 0U ? next_cluster_ : 0U;
+  f.read = read;
+  f.user = user;
+  next_cluster_ += f.clusters;
+  files_[count_++] = f;
+  return true;
+}
+
+void VirtualFat::read(uint32_t sector, uint8_t *dst) const {
+  memset(dst, 0, kSectorSize);
+  if (sector == 0U) {
+    boot_sector(dst);
+  } else if (sector < kFirstRootSector) {
+    fat_sector((sector - kReservedSectors) % kFatSectors, dst);
+  } else if (sector < kFirstDataSector) {
+    root_sector(sector - kFirstRootSector, dst);
+  } else if (sector < kSectorCount) {
+    data_sector(sector - kFirstDataSector, dst);
+  }
+}
+
+void VirtualFat::boot_sector(uint8_t *dst) const {
+  static constexpr uint8_t kJump[3] = {0xEB, 0x3C, 0x90};
+  memcpy(dst, kJump, sizeof(kJump));
+  memcpy(dst + 3, "MSWIN4.1", 8);
+  put16(dst + 11, kSectorSize);
+  dst[13] = kSectorsPerCluster;
+  put16(dst + 14, kReservedSectors);
+  dst[16] = kFatCount;
+  put16(dst + 17, kRootEntries);
+  put16(dst + 19, kSectorCount);
+  dst[21] = 0xF8; /* fixed media */
+  put16(dst + 22, kFatSectors);
+  put16(dst + 24, 63); /* CHS geometry: only for BIOS, any sane value */
+  put16(dst + 26, 255);
+  dst[36] = 0x80;
+  dst[38] = 0x29; /* the next three fields are valid */
+  put32(dst + 39, volume_id_);
+  memcpy(dst + 43, label_, sizeof(label_));
+  memcpy(dst + 54, "FAT16   ", 8);
+  dst[510] = 0x55;
+  dst[511] = 0xAA;
+}
+
+void VirtualFat::fat_sector(uint32_t index, uint8_t *dst) const {
+  constexpr uint32_t kPerSector = kSectorSize / 2;
+  const uint32_t first = index * kPerSector;
+  if (first == 0U) {
+    put16(dst, 0xFFF8); /* media byte */
+    put16(dst + 2, 0xFFFF);
+  }
+  for (size_t i = 0; i < count_; i++) {
+    const File &f = files_[i];
+    if (f.clusters == 0U) {
+      continue;
+    }
+    const uint32_t last = f.first_cluster + f.clusters - 1U;
+    const uint32_t lo = f.first_cluster > first ? f.first_cluster : first;
+    const uint32_t hi = last < first + kPerSector - 1U ? last : first + kPerSector - 1U;
+    for (uint32_t c = lo; c <= hi; c++) {
+      put16(dst + 2 * (c - first), c == last ? 0xFFFFU : c + 1U);
+    }
+  }
+}
+
+void VirtualFat::root_sector(uint32_t index, uint8_t *dst) const {
+  constexpr uint32_t kPerSector = kSectorSize / 32;
+  for (uint32_t e = index * kPerSector; e < (index + 1U) * kPerSector; e++) {
+    uint8_t *out = dst + 32 * (e % kPerSector);
+    if (e == 0U) {
+      dir_entry(out, label_, kAttrVolumeId, 0, 0);
+    } else if (e <= count_) {
+      const File &f = files_[e - 1U];
+      dir_entry(out, f.name, kAttrReadOnly | kAttrArchive, f.first_cluster, f.size);
+    }
+  }
+}
+
+void VirtualFat::data_sector(uint32_t index, uint8_t *dst) const {
+  const uint32_t cluster = index / kSectorsPerCluster + 2U;
+  for (size_t i = 0; i < count_; i++) {
+    const File &f = files_[i];
+    if (f.clusters == 0U || cluster < f.first_cluster || cluster >= f.first_cluster + f.clusters) {
+      continue;
+    }
+    const uint32_t offset = (cluster - f.first_cluster) * kClusterSize + (index % kSectorsPerCluster) * kSectorSize;
+    if (offset < f.size) {
+      const uint32_t left = f.size - offset;
+      f.read(offset, dst, left < kSectorSize ? left : kSectorSize, f.user);
+    }
+    return;
+  }
+}
+
+} // namespace msc
@@ -0,0 +1,100 @@
+/**
+ * @file virtual_fat.h
+ * @brief Read-only FAT16 volume synthesized sector by sector.
+ *
+ * The USB drive is not backed by a filesystem image: every sector the host
+ * reads is generated on the spot from a short file table. The boot sector,
+ * both FAT copies and the root directory follow from the table; a data sector
+ * is handed to the file's read callback, which produces the bytes from
+ * wherever they live (a RAM ring, a status snapshot, flash).
+ *
+ * The layout is a 16 MiB superfloppy (no partition table) with 2 KiB
+ * clusters, which makes it FAT16 for every host. Files are allocated one
+ * after the other from cluster 2, each contiguous, so a sector maps to its
+ * file and offset by arithmetic alone. The table, and with it every size and
+ * cluster, is fixed between clear() and the next clear(): the host caches
+ * the FAT, so a changing size is only seen after it re-mounts.
+ *
+ * Pure logic: no Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_MSC_DISK_VIRTUAL_FAT_H_
+#define OE5XRX_MSC_DISK_VIRTUAL_FAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace msc {
+
+class VirtualFat {
+public:
+  static constexpr uint32_t kSectorSize = 512;
+  static constexpr uint32_t kSectorCount = 32768; /* 16 MiB */
+  static constexpr uint32_t kSectorsPerCluster = 4;
+  static constexpr uint32_t kClusterSize = kSectorSize * kSectorsPerCluster;
+  static constexpr uint32_t kReservedSectors = 1; /* the boot sector */
+  static constexpr uint32_t kFatCount = 2;
+  static constexpr uint32_t kRootEntries = 512;
+  static constexpr uint32_t kRootSectors = kRootEntries * 32 / kSectorSize;
+  /* FAT size by the FAT specification's formula (a sector or so generous). */
+  static constexpr uint32_t kFatSectors =
+      (kSectorCount - kReservedSectors - kRootSectors + 256 * kSectorsPerCluster + kFatCount - 1) / (256 * kSectorsPerCluster + kFatCount);
+  static constexpr uint32_t kFirstRootSector = kReservedSectors + kFatCount * kFatSectors;
+  static constexpr uint32_t kFirstDataSector = kFirstRootSector + kRootSectors;
+  static constexpr uint32_t kClusterCount = (kSectorCount - kFirstDataSector) / kSectorsPerCluster;
+  static_assert(kClusterCount >= 4085 && kClusterCount < 65525, "geometry must be FAT16");
+
+  /** Files on the volume; the volume label takes one more root entry. */
+  static constexpr size_t kMaxFiles = 16;
+
+  /** Produce @p len bytes of the file at @p offset (offset + len <= its size). */
+  using ReadFn = void (*)(uint32_t offset, uint8_t *dst, uint32_t len, void *user);
+
+  /**
+   * @param label     volume label, up to 11 characters
+   * @param volume_id serial number hosts use to tell volumes apart
+   */
+  VirtualFat(const char *label, uint32_t volume_id);
+
+  /** Drop all files. */
+  void clear() { count_ = 0; next_cluster_ = 2; }
+
+  /**
+   * Append a read-only file. @p name is 8.3 ("LOG.TXT"): letters, digits,
+   * '_' and '-', stored upper case. Empty files are allowed.
+   * @return false for a bad name, a full table or no space left.
+   */
+  bool add(const char *name, uint32_t size, ReadFn read, void *user);
+
+  size_t files() const { return count_; }
+
+  /** Fill @p dst with sector @p sector (kSectorSize bytes); past the end reads zeros. */
+  void read(uint32_t sector, uint8_t *dst) const;
+
+private:
+  struct File {
+    char name[11]; /* 8.3, space padded, no dot */
+    uint32_t size;
+    uint32_t first_cluster; /* 0 for an empty file */
+    uint32_t clusters;
+    ReadFn read;
+    void *user;
+  };
+
+  void boot_sector(uint8_t *dst) const;
+  void fat_sector(uint32_t index, uint8_t *dst) const;
+  void root_sector(uint32_t index, uint8_t *dst) const;
+  void data_sector(uint32_t index, uint8_t *dst) const;
+
+  char label_[11];
+  uint32_t volume_id_;
+  File files_[kMaxFiles];
+  size_t count_ = 0;
+  uint32_t next_cluster_ = 2;
+};
+
+} // namespace msc
+
+#endif /* OE5XRX_MSC_DISK_VIRTUAL_FAT_H_ */
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Voice prompt engine: announcement sequencing, PTT, playback hook, `voice`
+ * module and shell. See <oe5xrx/audio/voice_prompt.h>.
+ *
+ * An announcement walks Idle -> Keying -> Lead -> Playing -> Tail -> Idle.
+ * Keying, Lead and Tail are one delayable work item on a work queue of its
+ * own, since the PTT callback may block on the radio (an SA818 AT round trip
+ * holds its driver for up to 2 s) and must not stall the system workqueue.
+ * Playing is driven by the playback thread through voice_prompt_play(),
+ * which alone touches the player while in that state; outside Idle it
+ * replaces the host audio with silence. The same work item is
+ * re-armed as a guard while playing: if the playback thread stops pulling
+ * (audio stream stopped), the announcement is aborted and the transmitter
+ * released anyway.
+ *
+ * The transmitter is left as the announcement found it: if it was already
+ * keyed (host or audio link transmitting), the tail does not unkey it.
+ */
+#include "voice_prompt.h"
+
+#include <errno.h>
+#include <oe5xrx/audio/voice_prompt.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#ifdef CONFIG_VOICE_PROMPT_MODULE
+#include <oe5xrx/module/voice.h>
+#endif
+
+LOG_MODULE_REGISTER(voice, CONFIG_VOICE_PROMPT_LOG_LEVEL);
+
+namespace {
+
+enum State : atomic_val_t { kIdle, kKeying, kLead, kPlaying, kTail };
+
+/* Grace beyond the utterance length before a stalled playback is aborted. */
+constexpr uint32_t kGuardMs = 1000;
+
+voice::Player player{voice::builtin_pack};
+atomic_t state = ATOMIC_INIT(kIdle);
+uint32_t length_ms; /* of the running announcement */
+K_MUTEX_DEFINE(say_lock);
+
+voice_prompt_ptt_cb on_ptt;
+void *ptt_user;
+/* The announcement keyed the transmitter from off. Work queue only. */
+bool unkey_at_tail;
+
+K_THREAD_STACK_DEFINE(workq_stack, CONFIG_VOICE_PROMPT_WORKQ_STACK_SIZE);
+struct k_work_q workq;
+
+struct k_spinlock status_lock;
+struct voice_prompt_status status;
+
+/* @return whether the transmitter was keyed before. */
+bool set_ptt(bool on) {
+  return on_ptt != nullptr ? on_ptt(on, ptt_user) : on;
+}
+
+void bump(uint32_t voice_prompt_status::*field) {
+  k_spinlock_key_t key = k_spin_lock(&status_lock);
+  status.*field += 1U;
+  k_spin_unlock(&status_lock, key);
+}
+
+void step_handler(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(step_work, step_handler);
+
+void schedule_step(k_timeout_t delay) { (void)k_work_reschedule_for_queue(&workq, &step_work, delay); }
+
+void step_handler(struct k_work *) {
+  switch (atomic_get(&state)) {
+  case kKeying: {
+    /* Keyed before the state moves on, so a cancel in between still finds
+     * unkey_at_tail right when its tail runs. */
+    const bool was_on = set_ptt(true);
+    unkey_at_tail = !was_on;
+    /* No lead when the transmitter is up already, or there is none. */
+    if (atomic_cas(&state, kKeying, kLead)) {
+      schedule_step(K_MSEC(on_ptt != nullptr && !was_on ? CONFIG_VOICE_PROMPT_PTT_LEAD_MS : 0));
+    }
+    break;
+  }
+  case kLead:
+    if (atomic_cas(&state, kLead, kPlaying)) {
+      schedule_step(K_MSEC(length_ms + kGuardMs));
+    }
+    break;
+  case kPlaying:
+    /* Guard expired: nobody pulled the samples. */
+    if (atomic_cas(&state, kPlaying, kTail)) {
+      LOG_WRN("playback stalled, announcement aborted");
+      bump(&voice_prompt_status::aborted);
+      schedule_step(K_MSEC(CONFIG_VOICE_PROMPT_PTT_TAIL_MS));
+    }
+    break;
+  case kTail:
+    if (unkey_at_tail) {
+      (void)set_ptt(false);
+      unkey_at_tail = false;
+    }
+    atomic_set(&state, kIdle);
+    break;
+  default:
+    break;
+  }
+}
+
+int workq_init(void) {
+  const struct k_work_queue_config cfg = {
+      .name = "voice_workq",
+  };
+
+  k_work_queue_start(&workq, workq_stack, K_THREAD_STACK_SIZEOF(workq_stack), CONFIG_VOICE_PROMPT_WORKQ_PRIORITY, &cfg);
+  return 0;
+}
+
+} // namespace
+
+SYS_INIT(workq_init, POST_KERNEL, 0);
+
+void voice_prompt_init(voice_prompt_ptt_cb cb, void *user_data) {
+  k_mutex_lock(&say_lock, K_FOREVER);
+  on_ptt = cb;
+  ptt_user = user_data;
+  k_mutex_unlock(&say_lock);
+}
+
+int voice_prompt_say(const char *text) {
+  voice::Word words[voice::Player::kMaxWords];
+  const size_t n = voice::compose(text, words, ARRAY_SIZE(words));
+  if (n == 0) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&say_lock, K_FOREVER);
+  if (atomic_get(&state) != kIdle) {
+    k_mutex_unlock(&say_lock);
+    return -EBUSY;
+  }
+  (void)player.start(words, n);
+  const uint32_t missing = player.missing();
+  length_ms = player.length() / (voice::kSampleRate / 1000U);
+  atomic_set(&state, kKeying);
+  schedule_step(K_NO_WAIT);
+  const int ret = static_cast<int>(length_ms);
+  k_mutex_unlock(&say_lock);
+
+  if (missing != 0U) {
+    k_spinlock_key_t key = k_spin_lock(&status_lock);
+    status.missing += missing;
+    k_spin_unlock(&status_lock, key);
+    LOG_WRN("%u word(s) of \"%s\" not in the prompt pack", missing, text);
+  }
+  LOG_INF("announce \"%s\" (%d ms)", text, ret);
+  return ret;
+}
+
+void voice_prompt_cancel(void) {
+  if (atomic_cas(&state, kKeying, kTail) || atomic_cas(&state, kLead, kTail) || atomic_cas(&state, kPlaying, kTail)) {
+    bump(&voice_prompt_status::aborted);
+    schedule_step(K_MSEC(CONFIG_VOICE_PROMPT_PTT_TAIL_MS));
+  }
+}
+
+size_t voice_prompt_play(int16_t *dst, size_t count, size_t max) {
+  const atomic_val_t now = atomic_get(&state);
+  if (now == kIdle) {
+    return count;
+  }
+  if (now != kPlaying) {
+    /* Lead and tail: the transmitter is keyed for the announcement, so the
+     * host audio must not go out on it. */
+    memset(dst, 0, max * sizeof(int16_t));
+    return max;
+  }
+
+  const uint32_t t0 = k_cycle_get_32();
+  const size_t n = player.fill(dst, max);
+  memset(dst + n, 0, (max - n) * sizeof(int16_t));
+  const bool done = !player.active();
+  const uint32_t cycles = k_cycle_get_32() - t0;
+
+  if (done && atomic_cas(&state, kPlaying, kTail)) {
+    schedule_step(K_MSEC(CONFIG_VOICE_PROMPT_PTT_TAIL_MS));
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&status_lock);
+  status.samples += n;
+  status.prompts += done ? 1U : 0U;
+  status.cycles_last = cycles;
+  if (cycles > status.cycles_max) {
+    status.cycles_max = cycles;
+  }
+  status.cycles_total += cycles;
+  k_spin_unlock(&status_lock, key);
+  return max;
+}
+
+void voice_prompt_get(struct voice_prompt_status *out) {
+  k_spinlock_key_t key = k_spin_lock(&status_lock);
+  *out = status;
+  k_spin_unlock(&status_lock, key);
+  out->busy = atomic_get(&state) != kIdle;
+  out->cycles_per_sec = sys_clock_hw_cycles_per_sec();
+}
+
+#ifdef CONFIG_VOICE_PROMPT_MODULE
+
+int voice_prompt_announce(const char *module, const char *cap) {
+  const mod::Module *m = mod::registry().find(module);
+  const mod::Capability *c = m != nullptr ? m->find(cap) : nullptr;
+  if (c == nullptr) {
+    return -ENOENT;
+  }
+  const mod::Result r = m->execute(mod::Op::Get, cap, "");
+  if (!r.ok()) {
+    return -EIO;
+  }
+  char value[32];
+  mod::JsonWriter w(value, sizeof(value));
+  r.renderValue(w);
+  if (strcmp(value, "null") == 0) {
+    return -EIO;
+  }
+
+  /* The unit only if the vocabulary has it as a word ("MHz" yes, "mV" no). */
+  const char *unit = c->spec().unit;
+  voice::Word word;
+  if (unit == nullptr || voice::compose(unit, &word, 1) != 1 || word >= voice::Word::kA) {
+    unit = "";
+  }
+  char text[48];
+  snprintf(text, sizeof(text), "%s %s", value, unit);
+  return voice_prompt_say(text);
+}
+
+namespace {
+
+using mod::Capability;
+using mod::FieldSpec;
+using mod::Result;
+using mod::ValueType;
+
+const FieldSpec SAY_SPEC{"say", ValueType::String};
+const FieldSpec ANNOUNCE_SPEC{"announce", ValueType::String};
+const FieldSpec BUSY_SPEC{"busy", ValueType::Bool, nullptr, nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+Result say_result(int ret) {
+  if (ret >= 0) {
+    return Result::okInt(ret);
+  }
+  switch (ret) {
+  case -EBUSY:
+    return Result::err("busy");
+  case -ENOENT:
+    return Result::err("unknown_capability");
+  case -EIO:
+    return Result::err("driver_error");
+  default:
+    return Result::err("bad_value");
+  }
+}
+
+/* `do say <text>` -> utterance length in ms. */
+class SayCap : public mod::Action {
+public:
+  const FieldSpec &spec() const override { return SAY_SPEC; }
+
+protected:
+  Result onDo(const char *value) override { return say_result(voice_prompt_say(value)); }
+};
+
+/* `do announce <module>:<cap>`, e.g. `fm:rx_frequency` -> length in ms. */
+class AnnounceCap : public mod::Action {
+public:
+  const FieldSpec &spec() const override { return ANNOUNCE_SPEC; }
+
+protected:
+  Result onDo(const char *value) override {
+    char module[16];
+    const char *colon = strchr(value, ':');
+    if (colon == nullptr || static_cast<size_t>(colon - value) >= sizeof(module)) {
+      return Result::err("bad_value");
+    }
+    memcpy(module, value, colon - value);
+    module[colon - value] = '\0';
+    return say_result(voice_prompt_announce(module, colon + 1));
+  }
+};
+
+class BusyCap : public mod::Telemetry {
+public:
+  const FieldSpec &spec() const override { return BUSY_SPEC; }
+
+protected:
+  Result onGet() override { return Result::okBool(atomic_get(&state) != kIdle); }
+};
+
+SayCap g_say;
+AnnounceCap g_announce;
+BusyCap g_busy;
+
+Capability *const g_caps[] = {&g_say, &g_announce, &g_busy};
+const mod::Identity g_identity{"voice_prompt", "adpcm_clips", "1"};
+mod::Module g_module{g_identity, "voice", g_caps};
+
+} // namespace
+
+mod::Module &mod::voice_module() { return g_module; }
+
+#else
+
+int voice_prompt_announce(const char *module, const char *cap) {
+  ARG_UNUSED(module);
+  ARG_UNUSED(cap);
+  return -ENOTSUP;
+}
+
+#endif /* CONFIG_VOICE_PROMPT_MODULE */
+
+/* ---- `voice` shell ------------------------------------------------------- */
+
+#ifdef CONFIG_VOICE_PROMPT_SHELL
+
+static int print_result(const struct shell *sh, int ret) {
+  if (ret < 0) {
+    shell_error(sh, "VOICE-ERROR %d", ret);
+    return ret;
+  }
+  shell_print(sh, "VOICE-SAY length_ms=%d", ret);
+  return 0;
+}
+
+static int cmd_voice_say(const struct shell *sh, size_t argc, char **argv) {
+  /* The shell splits at spaces; each argument is a pause apart anyway. */
+  char text[96];
+  size_t len = 0;
+  text[0] = '\0';
+  for (size_t i = 1; i < argc; i++) {
+    len += snprintf(text + len, sizeof(text) - len, "%s%s", i > 1 ? " " : "", argv[i]);
+    if (len >= sizeof(text)) {
+      shell_error(sh, "Text too long");
+      return -EINVAL;
+    }
+  }
+  return print_result(sh, voice_prompt_say(text));
+}
+
+static int cmd_voice_announce(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  return print_result(sh, voice_prompt_announce(argv[1], argv[2]));
+}
+
+static int cmd_voice_cancel(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  voice_prompt_cancel();
+  return 0;
+}
+
+static int cmd_voice_status(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+  struct voice_prompt_status st;
+  voice_prompt_get(&st);
+  /* Cost in cycles per 1000 samples keeps the integer resolution. */
+  const uint32_t milli_cyc = st.samples ? static_cast<uint32_t>(st.cycles_total * 1000U / st.samples) : 0;
+  shell_print(sh, "VOICE-STATUS busy=%d prompts=%u aborted=%u missing=%u samples=%u cyc_per_ksample=%u cyc_max=%u cyc_hz=%u", st.busy ? 1 : 0, st.prompts,
+              st.aborted, st.missing, st.samples, milli_cyc, st.cycles_max, st.cycles_per_sec);
+  return 0;
+}
+
+// clang-format off
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    voice_cmds,
+    SHELL_CMD_ARG(say, NULL, "Announce text: say <words, digits, 433.5 MHz, OE5XRX ...>", cmd_voice_say, 2, 15),
+    SHELL_CMD_ARG(announce, NULL, "Announce a capability value: announce <module> <cap>", cmd_voice_announce, 3, 0),
+    SHELL_CMD(cancel, NULL, "Cut the running announcement short", cmd_voice_cancel),
+    SHELL_CMD(status, NULL, "Announcements, skipped words and decode cost", cmd_voice_status),
+    SHELL_SUBCMD_SET_END);
+// clang-format on
+
+SHELL_CMD_REGISTER(voice, &voice_cmds, "Voice prompts (spoken announcements on TX)", NULL);
+
+#endif /* CONFIG_VOICE_PROMPT_SHELL */
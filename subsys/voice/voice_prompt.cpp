@@ -0,0 +1,219 @@
+/**
+ * @file voice_prompt.cpp
+ * @brief Voice prompt composer and clip player. See voice_prompt.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "voice_prompt.h"
+
+#include <cstring>
+
+namespace voice {
+
+namespace {
+
+constexpr const char *kNames[kClipCount] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "point", "minus", "megahertz", "kilohertz", "on", "off", "a", "b", "c", "d", "e", "f",
+    "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z",
+};
+
+/* Spoken words a letter run may be, besides the vocabulary names. */
+struct Alias {
+  const char *text;
+  Word word;
+};
+constexpr Alias kAliases[] = {{"mhz", Word::kMegahertz}, {"khz", Word::kKilohertz}, {"true", Word::kOn}, {"false", Word::kOff}};
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+bool is_alpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+char lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+bool equals_lower(const char *run, size_t len, const char *name) {
+  for (size_t i = 0; i < len; i++) {
+    if (name[i] == '\0' || lower(run[i]) != name[i]) {
+      return false;
+    }
+  }
+  return name[len] == '\0';
+}
+
+/* A whole-word match for a letter run of more than one letter. */
+bool lookup(const char *run, size_t len, Word *out) {
+  if (len < 2) {
+    return false;
+  }
+  for (size_t i = 0; i < static_cast<size_t>(Word::kA); i++) {
+    if (equals_lower(run, len, kNames[i])) {
+      *out = static_cast<Word>(i);
+      return true;
+    }
+  }
+  for (const Alias &a : kAliases) {
+    if (equals_lower(run, len, a.text)) {
+      *out = a.word;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Appends words; the result is all or nothing. */
+class Builder {
+public:
+  Builder(Word *out, size_t max) : out_(out), max_(max) {}
+
+  void add(Word w) {
+    if (n_ < max_) {
+      out_[n_] = w;
+    }
+    n_++;
+    last_ = w;
+  }
+  /* One pause between words: never leading, trailing or doubled. */
+  void pause() { pending_pause_ = n_ > 0 && last_ != Word::kPause; }
+  void flush() {
+    if (pending_pause_) {
+      add(Word::kPause);
+      pending_pause_ = false;
+    }
+  }
+  size_t finish() const { return n_ <= max_ ? n_ : 0; }
+
+private:
+  Word *out_;
+  size_t max_;
+  size_t n_ = 0;
+  Word last_ = Word::kPause;
+  bool pending_pause_ = false;
+};
+
+Word digit(char c) { return static_cast<Word>(c - '0'); }
+
+} // namespace
+
+const char *word_name(Word w) { return w < Word::kPause ? kNames[static_cast<size_t>(w)] : "pause"; }
+
+size_t compose(const char *text, Word *out, size_t max) {
+  Builder b(out, max);
+  const char *p = text;
+  while (*p != '\0') {
+    if (is_digit(*p) || is_alpha(*p) || *p == '-') {
+      b.flush();
+    }
+    if (is_digit(*p)) {
+      while (is_digit(*p)) {
+        b.add(digit(*p++));
+      }
+      if (*p == '.' && is_digit(p[1])) {
+        const char *frac = ++p;
+        while (is_digit(*p)) {
+          p++;
+        }
+        const char *end = p;
+        while (end > frac && end[-1] == '0') {
+          end--;
+        }
+        if (end > frac) {
+          b.add(Word::kPoint);
+          for (const char *d = frac; d < end; d++) {
+            b.add(digit(*d));
+          }
+        }
+      }
+    } else if (is_alpha(*p)) {
+      const char *run = p;
+      while (is_alpha(*p)) {
+        p++;
+      }
+      Word w;
+      if (lookup(run, static_cast<size_t>(p - run), &w)) {
+        b.add(w);
+      } else {
+        for (const char *c = run; c < p; c++) {
+          b.add(static_cast<Word>(static_cast<size_t>(Word::kA) + static_cast<size_t>(lower(*c) - 'a')));
+        }
+      }
+    } else if (*p == '-') {
+      b.add(Word::kMinus);
+      p++;
+    } else if (*p == '"' || *p == '\'') {
+      p++;
+    } else {
+      b.pause();
+      p++;
+    }
+  }
+  return b.finish();
+}
+
+bool Player::start(const Word *words, size_t count) {
+  if (count > kMaxWords) {
+    stop();
+    return false;
+  }
+  memcpy(words_, words, count * sizeof(Word));
+  count_ = count;
+  enter(0);
+  return true;
+}
+
+uint32_t Player::word_samples(Word w) const {
+  if (w == Word::kPause) {
+    return pack_.pause_samples;
+  }
+  return w < Word::kPause ? pack_.clips[static_cast<size_t>(w)].samples : 0U;
+}
+
+uint32_t Player::length() const {
+  uint32_t n = 0;
+  for (size_t i = 0; i < count_; i++) {
+    n += word_samples(words_[i]);
+  }
+  return n;
+}
+
+uint32_t Player::missing() const {
+  uint32_t n = 0;
+  for (size_t i = 0; i < count_; i++) {
+    n += words_[i] != Word::kPause && word_samples(words_[i]) == 0U ? 1U : 0U;
+  }
+  return n;
+}
+
+/* Make word @p pos current, skipping empty ones. */
+void Player::enter(size_t pos) {
+  while (pos < count_ && word_samples(words_[pos]) == 0U) {
+    pos++;
+  }
+  pos_ = pos;
+  sample_ = 0;
+  if (pos_ < count_ && words_[pos_] != Word::kPause) {
+    state_ = pack_.clips[static_cast<size_t>(words_[pos_])].start;
+  }
+}
+
+size_t Player::fill(int16_t *dst, size_t max) {
+  size_t n = 0;
+  while (n < max && active()) {
+    const Word w = words_[pos_];
+    const uint32_t left = word_samples(w) - sample_;
+    const size_t take = left < max - n ? left : max - n;
+    if (w == Word::kPause) {
+      memset(dst + n, 0, take * sizeof(int16_t));
+    } else {
+      const Clip &c = pack_.clips[static_cast<size_t>(w)];
+      audio::adpcmDecode(state_, pack_.data, c.offset + sample_, take, dst + n);
+    }
+    n += take;
+    sample_ += static_cast<uint32_t>(take);
+    if (sample_ == word_samples(w)) {
+      enter(pos_ + 1);
+    }
+  }
+  return n;
+}
+
+} // namespace voice
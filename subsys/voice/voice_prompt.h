@@ -0,0 +1,135 @@
+/**
+ * @file voice_prompt.h
+ * @brief Concatenative voice prompts: vocabulary, utterance builder, clip player.
+ *
+ * A prompt pack holds one IMA-ADPCM clip per vocabulary word (digits, the
+ * NATO letters, "point", "megahertz", ...) in flash, 4 bits per sample. An
+ * utterance is a list of words built from a status string by compose():
+ *
+ *   "433.5000 MHz"  ->  4 3 3 point 5 megahertz
+ *   "OE5XRX"        ->  oscar echo 5 x-ray romeo x-ray
+ *
+ * The player decodes the clips one after the other straight into the
+ * caller's playback block. A clip ends and the next one starts on the very
+ * next sample, also in the middle of a block, so joins are exactly as the
+ * pack was cut: no gap, no overlap, no resampling. Each clip carries its own
+ * ADPCM start state, so any clip follows any other. Pauses (at spaces and
+ * commas) are pack-defined silence, not clips.
+ *
+ * Decoding is one table lookup and a few adds per sample. Pure logic: no
+ * Zephyr, no heap, no float.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_VOICE_PROMPT_H_
+#define OE5XRX_VOICE_PROMPT_H_
+
+#include "ima_adpcm.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace voice {
+
+/** Rate of the clips in a pack. */
+constexpr uint32_t kSampleRate = 8000;
+
+/** Vocabulary. Every word up to kPause has a clip in the pack, in this order. */
+enum class Word : uint8_t {
+  k0,
+  k1,
+  k2,
+  k3,
+  k4,
+  k5,
+  k6,
+  k7,
+  k8,
+  k9,
+  kPoint,
+  kMinus,
+  kMegahertz,
+  kKilohertz,
+  kOn,
+  kOff,
+  kA, /* alpha .. zulu */
+  kZ = kA + 25,
+  kPause, /* pack-defined silence, no clip */
+};
+
+/** Number of clips in a pack. */
+constexpr size_t kClipCount = static_cast<size_t>(Word::kPause);
+
+/** Clip file / lookup name of @p w ("0", "point", "a", ...). */
+const char *word_name(Word w);
+
+/**
+ * Build the utterance for @p text into @p out (at most @p max words):
+ *
+ *  - digits are spoken one by one; in a decimal number, "point" and the
+ *    fraction follow with trailing zeros dropped ("145.5000" -> 1 4 5
+ *    point 5, "433.000" -> 4 3 3);
+ *  - a letter run that is a vocabulary word or unit ("MHz", "kHz",
+ *    "true", "off", case-insensitive) is that word, anything else is spelled;
+ *  - '-' is "minus", spaces and other punctuation are one pause, quotes
+ *    are ignored.
+ *
+ * @return the word count, 0 if @p text has nothing to say or does not fit.
+ */
+size_t compose(const char *text, Word *out, size_t max);
+
+/** One clip: @p samples codes starting at code @p offset of Pack::data. */
+struct Clip {
+  uint32_t offset;
+  uint32_t samples; /* 0: word not in the pack, skipped */
+  audio::AdpcmState start;
+};
+
+struct Pack {
+  const uint8_t *data; /* all clips, ADPCM codes packed as in ima_adpcm.h */
+  const Clip *clips;   /* kClipCount entries, indexed by Word */
+  uint32_t pause_samples;
+};
+
+/** The pack linked into the firmware, generated by scripts/voice_pack.py. */
+extern const Pack builtin_pack;
+
+class Player {
+public:
+  /** Longest utterance, words. */
+  static constexpr size_t kMaxWords = 48;
+
+  explicit Player(const Pack &pack) : pack_(pack) {}
+
+  /** Queue @p words for playback, replacing anything queued. False if too many. */
+  bool start(const Word *words, size_t count);
+  void stop() { count_ = 0; pos_ = 0; }
+  bool active() const { return pos_ < count_; }
+
+  /**
+   * Write the next samples into @p dst, up to @p max. Returns how many were
+   * written; fewer than @p max only when the utterance ends in this block.
+   */
+  size_t fill(int16_t *dst, size_t max);
+
+  /** Length of the queued utterance, samples. */
+  uint32_t length() const;
+  /** Words of the queued utterance without a clip in the pack. */
+  uint32_t missing() const;
+
+private:
+  uint32_t word_samples(Word w) const;
+  void enter(size_t pos);
+
+  const Pack &pack_;
+  Word words_[kMaxWords];
+  size_t count_ = 0;
+  size_t pos_ = 0;      /* current word */
+  uint32_t sample_ = 0; /* next sample within it */
+  audio::AdpcmState state_{};
+};
+
+} // namespace voice
+
+#endif /* OE5XRX_VOICE_PROMPT_H_ */
@@ -0,0 +1,230 @@
+# Copyright (c) 2026 OE5XRX
+# SPDX-License-Identifier: LGPL-3.0-or-later
+"""Two serial audio link stations, mouth-to-ear latency and loss resilience.
+
+Station A is the twister DUT; station B is a second copy of the same
+zephyr.exe started here. The test connects their link pseudottys (uart_1)
+through a relay that cuts the byte stream into link frames and can drop and
+delay them, so the jitter buffer sees real loss, jitter and reordering.
+
+B runs `link echo on` (what it plays goes straight back to A). `link probe`
+on A sends a marker tone and times its return: the round trip covers both
+encoders, both jitter buffers and the relay, and half of it is the one-way
+mouth-to-ear latency.
+"""
+import heapq
+import os
+import random
+import re
+import select
+import subprocess
+import threading
+import time
+import tty
+from pathlib import Path
+
+import pytest
+from twister_harness import DeviceAdapter, Shell
+
+_ANSI = re.compile(r"\x1b\[[0-9;]*m")
+_PTY = re.compile(r"uart_1 connected to pseudotty: (/dev/pts/\d+)")
+_PROBE = re.compile(r"AUDIO-LINK-PROBE result=(\w+)(?: rtt_us=(\d+) m2e_us=(\d+))?")
+
+FRAME_SYNC = b"\xa5\x5a"
+HEADER_BYTES = 13
+CRC_BYTES = 2
+
+# 20 ms frames, 2-frame jitter buffer floor on each side, echo re-framing on B:
+# ~150 ms one way on a clean link. Generous for native_sim scheduling.
+MAX_M2E_US = 300_000
+
+
+def _open_raw(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    tty.setraw(fd)
+    return fd
+
+
+class FrameRelay:
+    """Forwards link frames between two ptys, dropping and delaying some."""
+
+    def __init__(self, pty_a, pty_b, loss=0.0, jitter_ms=0.0, seed=1):
+        self.fds = (_open_raw(pty_a), _open_raw(pty_b))
+        self.loss = loss
+        self.jitter_s = jitter_ms / 1000.0
+        self.rng = random.Random(seed)
+        self.bufs = [bytearray(), bytearray()]
+        self.pending = []  # (due, order, dst_fd, frame)
+        self.order = 0
+        self.forwarded = 0
+        self.dropped = 0
+        self.stop_evt = threading.Event()
+        self.thread = threading.Thread(target=self._run, daemon=True)
+
+    def start(self):
+        self.thread.start()
+        return self
+
+    def stop(self):
+        self.stop_evt.set()
+        self.thread.join(timeout=2)
+        for fd in self.fds:
+            os.close(fd)
+
+    def _frames(self, buf):
+        while True:
+            start = buf.find(FRAME_SYNC)
+            if start < 0:
+                del buf[: max(0, len(buf) - 1)]
+                return
+            del buf[:start]
+            if len(buf) < HEADER_BYTES:
+                return
+            size = HEADER_BYTES + buf[12] + CRC_BYTES
+            if len(buf) < size:
+                return
+            yield bytes(buf[:size])
+            del buf[:size]
+
+    def _run(self):
+        while not self.stop_evt.is_set():
+            ready, _, _ = select.select(self.fds, [], [], 0.002)
+            now = time.monotonic()
+            for side, fd in enumerate(self.fds):
+                if fd not in ready:
+                    continue
+                try:
+                    self.bufs[side] += os.read(fd, 4096)
+                except BlockingIOError:
+                    continue
+                for frame in list(self._frames(self.bufs[side])):
+                    if self.rng.random() < self.loss:
+                        self.dropped += 1
+                        continue
+                    due = now + self.rng.uniform(0.0, self.jitter_s)
+                    heapq.heappush(self.pending, (due, self.order, self.fds[1 - side], frame))
+                    self.order += 1
+            while self.pending and self.pending[0][0] <= now:
+                _, _, dst, frame = heapq.heappop(self.pending)
+                os.write(dst, frame)
+                self.forwarded += 1
+
+
+class Station:
+    """Second station: zephyr.exe with its shell on a pipe."""
+
+    def __init__(self, exe):
+        self.proc = subprocess.Popen([str(exe)], stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        self.lines = []
+        self.cond = threading.Condition()
+        threading.Thread(target=self._reader, daemon=True).start()
+
+    def _reader(self):
+        for raw in self.proc.stdout:
+            line = _ANSI.sub("", raw.decode(errors="replace")).rstrip()
+            with self.cond:
+                self.lines.append(line)
+                self.cond.notify_all()
+
+    def wait_for(self, pattern, timeout=10.0, start=0):
+        deadline = time.monotonic() + timeout
+        with self.cond:
+            while True:
+                for line in self.lines[start:]:
+                    m = re.search(pattern, line)
+                    if m:
+                        return m
+                left = deadline - time.monotonic()
+                if left <= 0:
+                    raise TimeoutError(f"station B: no {pattern!r} in {self.lines[-20:]}")
+                self.cond.wait(left)
+
+    def command(self, cmd, expect, timeout=5.0):
+        with self.cond:
+            start = len(self.lines)
+        self.proc.stdin.write(cmd.encode() + b"\n")
+        self.proc.stdin.flush()
+        return self.wait_for(expect, timeout, start)
+
+    def stop(self):
+        self.proc.kill()
+        self.proc.wait(timeout=5)
+
+
+def _pty_of_dut(dut):
+    for _ in range(200):
+        line = dut.readline(timeout=0.1)
+        m = _PTY.search(line or "")
+        if m:
+            return m.group(1)
+    pytest.fail("station A: no uart_1 pseudotty in the boot log")
+
+
+def _stats(text):
+    line = next(l for l in text.splitlines() if "AUDIO-LINK-STATS" in l)
+    return {k: int(v) for k, v in re.findall(r"(\w+)=(\d+)", line)}
+
+
+def _probe(shell, count):
+    results = []
+    for _ in range(count):
+        out = "\n".join(_ANSI.sub("", l) for l in shell.exec_command("link probe 1500"))
+        m = _PROBE.search(out)
+        assert m, f"no AUDIO-LINK-PROBE line in {out!r}"
+        results.append(int(m.group(3)) if m.group(1) == "ok" else None)
+    return results
+
+
+@pytest.fixture
+def stations(dut: DeviceAdapter):
+    pty_a = _pty_of_dut(dut)
+    shell = Shell(dut, prompt="fm> ")
+    assert shell.wait_for_prompt(), "station A: no shell prompt"
+
+    b = Station(Path(dut.device_config.build_dir) / "zephyr" / "zephyr.exe")
+    try:
+        pty_b = b.wait_for(_PTY.pattern).group(1)
+        b.command("link echo on", r"fm> ")
+        yield shell, b, pty_a, pty_b
+    finally:
+        b.stop()
+
+
+def test_clean_link_latency(stations):
+    shell, b, pty_a, pty_b = stations
+    relay = FrameRelay(pty_a, pty_b).start()
+    try:
+        time.sleep(1.0)  # both jitter buffers fill
+        m2e = _probe(shell, 10)
+    finally:
+        relay.stop()
+
+    assert all(v is not None for v in m2e), f"probes lost on a clean link: {m2e}"
+    print(f"mouth-to-ear: min {min(m2e) / 1000:.1f} ms, max {max(m2e) / 1000:.1f} ms")
+    assert max(m2e) < MAX_M2E_US, f"mouth-to-ear {max(m2e)} us over {MAX_M2E_US} us"
+
+    st = _stats("\n".join(shell.exec_command("link stats")))
+    assert st["crc_errors"] == 0
+    assert st["rx_frames"] > 0 and st["played"] > 0
+
+
+def test_lossy_jittery_link(stations):
+    shell, b, pty_a, pty_b = stations
+    relay = FrameRelay(pty_a, pty_b, loss=0.05, jitter_ms=30, seed=7).start()
+    try:
+        time.sleep(1.0)
+        m2e = _probe(shell, 20)
+    finally:
+        relay.stop()
+
+    ok = [v for v in m2e if v is not None]
+    print(f"lossy: {len(ok)}/{len(m2e)} probes back, relay dropped {relay.dropped}/{relay.dropped + relay.forwarded} frames")
+    # A probe dies if its frame is dropped in either direction (~10 %), and
+    # concealment must not fake a return.
+    assert len(ok) >= 14, f"too many probes lost at 5 % frame loss: {m2e}"
+    assert max(ok) < MAX_M2E_US + 100_000, f"mouth-to-ear {max(ok)} us with 30 ms jitter"
+
+    st = _stats("\n".join(shell.exec_command("link stats")))
+    assert relay.dropped > 0
+    assert st["concealed"] + st["underruns"] > 0, f"losses not concealed: {st}"
+    assert st["jitter_us"] > 0, f"no jitter measured: {st}"
@@ -0,0 +1,45 @@
+/**
+ * @file main.cpp
+ * @brief Serial audio link test station (native_sim).
+ *
+ * Starts the link on the chosen oe5xrx,audio-link UART and makes it the
+ * consumer of the audio stream. The link UART doubles as the stream's opaque
+ * context handle. Everything else is driven from the `link` shell.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+
+#include "audio_stream.h"
+
+#include <oe5xrx/audio/audio_link.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
+
+int main(void) {
+  const struct device *uart = DEVICE_DT_GET(DT_CHOSEN(oe5xrx_audio_link));
+
+  int ret = audio_link_start(uart, NULL, NULL);
+  if (ret != 0) {
+    LOG_ERR("Link start failed: %d", ret);
+    return ret;
+  }
+
+  const struct audio_stream_callbacks cbs = {audio_link_tx_request, audio_link_rx_data, NULL};
+  ret = audio_stream_register(uart, &cbs);
+  if (ret != 0) {
+    LOG_ERR("Audio stream register failed: %d", ret);
+    return ret;
+  }
+
+  const struct audio_format format = {8000, 16, 1};
+  ret = audio_stream_start(uart, &format);
+  if (ret != 0) {
+    LOG_ERR("Audio stream start failed: %d", ret);
+    return ret;
+  }
+  return 0;
+}
@@ -0,0 +1,506 @@
+/**
+ * @file pipeline_sim.cpp
+ * @brief Virtual-time audio pipeline model. See pipeline_sim.h.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#include "pipeline_sim.h"
+
+#include "clock_trim.h"
+#include "feedback_controller.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace sim {
+
+namespace {
+
+/* Mirrors of the firmware constants (usb_audio_bridge.cpp / fm_board.dts). */
+constexpr uint32_t kBytesPerSample = 2;
+constexpr uint16_t kSamplesPerSof = 8;
+constexpr uint32_t kBlockSamples = 8;  /* analog-audio-{in,out} block-samples */
+constexpr uint32_t kTxRingBytes = 512; /* TX_RING_SIZE */
+constexpr uint32_t kRxRingBytes = 512; /* RX_RING_SIZE */
+constexpr uint32_t kTxPrebufferBytes = kTxRingBytes / 2;
+constexpr uint32_t kInMaxSamples = kSamplesPerSof + 1; /* USB_IN_MAX_PACKET_BYTES / 2 */
+constexpr uint32_t kSampleRateHz = 8000;
+constexpr uint32_t kTimHz = 160000000; /* TIM6/TIM7 kernel clock */
+constexpr uint32_t kSyncMaxPpm = 1000; /* CONFIG_APP_AUDIO_SOF_SYNC_MAX_PPM */
+
+/* Virtual time is kept in picoseconds: a week is ~6e17 ps, well inside int64. */
+constexpr int64_t kPsPerUs = 1000000;
+constexpr int64_t kPsPerMs = 1000 * kPsPerUs;
+constexpr int64_t kSofPeriodPs = kPsPerMs; /* Full-Speed SOF, host clock */
+
+/* "Locked" == every SOF fill sample within ±kLockWindow of the set point for
+ * kLockHoldSofs consecutive frames. The window is two DAC blocks: the fill seen
+ * at SOF time legitimately saws by one block as the two clocks slide in phase. */
+constexpr int32_t kLockWindow = 2 * kBlockSamples;
+constexpr uint32_t kLockHoldSofs = 1000;
+
+/* "Rate-locked" == the reported feedback, averaged over one second, is within
+ * kRateLockPpm (two feedback LSBs) of the samples per SOF the device actually
+ * plays, for kRateLockHold seconds in a row. This is what the regulator
+ * estimates; the fill lock above also holds while the estimate is still
+ * wrong, as long as the ring absorbs the difference. */
+constexpr uint32_t kRateWindowSofs = 1000;
+constexpr double kRateLockPpm = 250.0;
+constexpr uint32_t kRateLockHold = 5;
+
+/** Byte ring with free-running uint32 indices (wraps like Zephyr's ring_buf). */
+class Ring {
+public:
+  explicit Ring(uint32_t capacity) : capacity_(capacity) {}
+
+  uint32_t used() const { return head_ - tail_; }
+  uint32_t space() const { return capacity_ - used(); }
+  void reset() { tail_ = head_; }
+
+  /** Returns bytes accepted (short when full, like ring_buf_put). */
+  uint32_t put(uint32_t bytes) {
+    uint32_t n = bytes < space() ? bytes : space();
+    head_ += n;
+    return n;
+  }
+
+  /** Returns bytes taken (short when empty, like ring_buf_get). */
+  uint32_t get(uint32_t bytes) {
+    uint32_t n = bytes < used() ? bytes : used();
+    tail_ += n;
+    return n;
+  }
+
+private:
+  uint32_t capacity_;
+  uint32_t head_ = 0;
+  uint32_t tail_ = 0;
+};
+
+/**
+ * Sampling timer at tick level for sof_sync: a sample lasts `period` ticks of a
+ * clock running device_ppm off the host, and a new period (ARR preload) takes
+ * effect at the next sample edge. Times are host ps.
+ */
+class DeviceClock {
+public:
+  DeviceClock(double device_ppm, uint32_t period)
+      : tick_ps_(1e12 / (kTimHz * (1.0 + device_ppm * 1e-6))), period_cur_(period), period_next_(period), next_edge_ps_(period * tick_ps_) {}
+
+  void set_period(uint32_t period) { period_next_ = period; }
+
+  /** Clock forward to @p t (monotonic). */
+  void advance(int64_t t) {
+    while (next_edge_ps_ <= static_cast<double>(t)) {
+      samples_++;
+      period_cur_ = period_next_;
+      next_edge_ps_ += period_cur_ * tick_ps_;
+    }
+  }
+
+  /** Samples clocked out at @p t, Q24.8 (what analog_audio_out_get_clock reads). */
+  uint32_t position_q8(int64_t t) {
+    advance(t);
+    const double frac = 1.0 - (next_edge_ps_ - static_cast<double>(t)) / (period_cur_ * tick_ps_);
+    return static_cast<uint32_t>((samples_ << 8) + static_cast<uint64_t>(frac * 256.0));
+  }
+
+  /** Time sample edge @p n happens (or happened), extrapolated at the current periods. */
+  int64_t time_of_sample(uint64_t n) const {
+    const double t = n > samples_ ? next_edge_ps_ + static_cast<double>(n - samples_ - 1) * period_next_ * tick_ps_
+                                  : next_edge_ps_ - static_cast<double>(samples_ + 1 - n) * period_cur_ * tick_ps_;
+    return static_cast<int64_t>(t);
+  }
+
+private:
+  double tick_ps_;
+  uint32_t period_cur_;  /* period of the sample in progress */
+  uint32_t period_next_; /* preloaded ARR + 1 */
+  double next_edge_ps_;  /* end of the sample in progress */
+  uint64_t samples_ = 0; /* completed samples */
+};
+
+/** The bridge state the model drives (same gating as usb_audio_bridge.cpp). */
+struct Bridge {
+  Ring tx{kTxRingBytes};
+  Ring rx{kRxRingBytes};
+  bool tx_enabled = false;
+  bool rx_enabled = false;
+  bool tx_prebuffered = false;
+  usb_audio::FeedbackController feedback;
+
+  /* uac2_terminal_update_cb for both terminals. */
+  void set_terminals(bool enabled) {
+    tx_enabled = enabled;
+    tx_prebuffered = false;
+    feedback.reset();
+    if (!enabled) {
+      tx.reset();
+    }
+    rx_enabled = enabled;
+    if (!enabled) {
+      rx.reset();
+    }
+  }
+};
+
+struct LockTracker {
+  bool locked = false;
+  int64_t since_ps = 0;      /* (re)enable time the lock is measured from */
+  int64_t window_start = -1; /* first SOF of the current in-window streak */
+  uint32_t streak = 0;
+
+  void restart(int64_t now) {
+    locked = false;
+    since_ps = now;
+    window_start = -1;
+    streak = 0;
+  }
+
+  /** Feed one SOF fill error; returns the lock time in ms on the SOF that locks, else -1. */
+  double step(int64_t now, int32_t error) {
+    if (locked) {
+      return -1.0;
+    }
+    if (std::abs(error) > kLockWindow) {
+      streak = 0;
+      window_start = -1;
+      return -1.0;
+    }
+    if (streak++ == 0) {
+      window_start = now;
+    }
+    if (streak < kLockHoldSofs) {
+      return -1.0;
+    }
+    locked = true;
+    return static_cast<double>(window_start - since_ps) / static_cast<double>(kPsPerMs);
+  }
+};
+
+/** Windowed feedback average vs the true device rate (Q10.14 samples per SOF). */
+struct RateTracker {
+  bool locked = false;
+  int64_t since_ps = 0;
+  int64_t window_start = 0;  /* first SOF of the current window */
+  int64_t streak_start = -1; /* first SOF of the current in-bound streak */
+  uint32_t streak = 0;
+  uint64_t sum = 0;
+  uint32_t count = 0;
+  double err_sum = 0.0;
+  uint64_t err_count = 0;
+
+  void restart(int64_t now) {
+    locked = false;
+    since_ps = now;
+    streak_start = -1;
+    streak = 0;
+    sum = 0;
+    count = 0;
+  }
+
+  /** Feed one SOF; returns the lock time in ms on the window that locks, else -1. */
+  double step(int64_t now, uint32_t fb, double true_q14, SoakReport &r) {
+    if (count == 0) {
+      window_start = now;
+    }
+    sum += fb;
+    if (++count < kRateWindowSofs) {
+      return -1.0;
+    }
+    const double err_ppm = std::fabs(static_cast<double>(sum) / count / true_q14 - 1.0) * 1e6;
+    sum = 0;
+    count = 0;
+    if (locked) {
+      if (err_ppm > r.max_rate_error_ppm) {
+        r.max_rate_error_ppm = err_ppm;
+      }
+      err_sum += err_ppm;
+      err_count++;
+      return -1.0;
+    }
+    if (err_ppm > kRateLockPpm) {
+      streak = 0;
+      streak_start = -1;
+      return -1.0;
+    }
+    if (streak++ == 0) {
+      streak_start = window_start;
+    }
+    if (streak < kRateLockHold) {
+      return -1.0;
+    }
+    locked = true;
+    return static_cast<double>(streak_start - since_ps) / static_cast<double>(kPsPerMs);
+  }
+};
+
+} // namespace
+
+bool SoakReport::passed(const SoakConfig &cfg) const {
+  return tx_overflow_samples == 0 && tx_underrun_samples == 0 && rx_overflow_samples == 0 && late_refills == 0 && lock_time_ms >= 0.0 &&
+         max_tx_latency_ms <= cfg.max_tx_latency_ms && max_rx_latency_ms <= cfg.max_rx_latency_ms;
+}
+
+SoakReport run_soak(const SoakConfig &cfg) {
+  SoakReport r;
+  Bridge b;
+  LockTracker lock;
+  RateTracker rate_lock;
+  std::mt19937_64 rng(cfg.seed);
+
+  auto jitter_ps = [&rng](uint32_t max_us) -> int64_t {
+    if (max_us == 0) {
+      return 0;
+    }
+    std::uniform_int_distribution<int64_t> d(0, static_cast<int64_t>(max_us) * kPsPerUs);
+    return d(rng);
+  };
+  auto next_suspend_ps = [&rng, &cfg](int64_t now) -> int64_t {
+    if (cfg.suspend_every_s <= 0.0) {
+      return INT64_MAX;
+    }
+    std::exponential_distribution<double> d(1.0 / cfg.suspend_every_s);
+    return now + static_cast<int64_t>(d(rng) * 1e12);
+  };
+
+  const int64_t end_ps = static_cast<int64_t>(cfg.days * 86400.0 * 1e12);
+  /* Device block period expressed in host time: a +ppm device runs fast, so
+   * its blocks arrive slightly more often than the nominal 1 ms. */
+  const double block_ps = (static_cast<double>(kBlockSamples) * 1e12 / kSampleRateHz) / (1.0 + cfg.device_ppm * 1e-6);
+
+  usb_audio::SofClockTrim trim;
+  trim.init(kTimHz, kSampleRateHz, kSamplesPerSof, kSyncMaxPpm);
+  DeviceClock clock(cfg.device_ppm, trim.nominal_period());
+  /* Hardware end of DAC/ADC block n: fixed spacing when free-running, from the
+   * trimmed timer otherwise. */
+  auto block_end = [&](uint64_t n) -> int64_t {
+    if (!cfg.sof_sync) {
+      return static_cast<int64_t>(static_cast<double>(n) * block_ps);
+    }
+    return clock.time_of_sample(n * kBlockSamples);
+  };
+
+  /* DAC position at handler time, as analog_audio_out_get_clock reads it. */
+  auto dac_position_q8 = [&](int64_t t) -> uint32_t {
+    if (cfg.sof_sync) {
+      return clock.position_q8(t);
+    }
+    const double samples = static_cast<double>(t) * kSampleRateHz * (1.0 + cfg.device_ppm * 1e-6) / 1e12;
+    return static_cast<uint32_t>(static_cast<uint64_t>(samples * 256.0));
+  };
+
+  const uint32_t set_point_samples = cfg.sof_sync ? cfg.sync_setpoint : kTxRingBytes / kBytesPerSample / 2;
+  const uint32_t prebuffer_bytes = cfg.sof_sync ? cfg.sync_setpoint * kBytesPerSample : kTxPrebufferBytes;
+
+  b.feedback.init(kSamplesPerSof, cfg.rate_feedback ? usb_audio::FeedbackMode::Rate : usb_audio::FeedbackMode::Pi);
+  b.set_terminals(true);
+  lock.restart(0);
+  rate_lock.restart(0);
+
+  uint64_t sof_index = 0;
+  uint64_t tx_block = 0;
+  uint64_t rx_block = 0;
+  int64_t sof_due = jitter_ps(cfg.sof_jitter_us);
+  int64_t tx_hw = block_end(1);
+  int64_t tx_due = tx_hw + jitter_ps(cfg.wq_jitter_us);
+  int64_t rx_due = tx_hw + jitter_ps(cfg.wq_jitter_us);
+  int64_t suspend_at = next_suspend_ps(0);
+  int64_t resume_at = -1;
+  uint32_t host_acc_q14 = 0; /* host's fractional samples-per-frame accumulator */
+  bool first_lock_pending = true;
+  bool first_rate_lock_pending = true;
+  /* Samples the device plays per SOF, Q10.14: the regulator's target. */
+  const double true_rate_q14 = kSamplesPerSof * 16384.0 * (cfg.sof_sync ? 1.0 : 1.0 + cfg.device_ppm * 1e-6);
+
+  uint64_t err_sum = 0;
+  uint64_t err_count = 0;
+  double fb_sq_sum = 0.0;
+  const int32_t set_point = static_cast<int32_t>(set_point_samples);
+
+  while (true) {
+    const int64_t now = sof_due < tx_due ? (sof_due < rx_due ? sof_due : rx_due) : (tx_due < rx_due ? tx_due : rx_due);
+    if (now >= end_ps) {
+      break;
+    }
+
+    if (now == sof_due) {
+      const int64_t sof_time = static_cast<int64_t>(sof_index) * kSofPeriodPs;
+      sof_index++;
+      sof_due = static_cast<int64_t>(sof_index) * kSofPeriodPs + jitter_ps(cfg.sof_jitter_us);
+
+      /* Bus suspend: no SOFs, the host closes both streams; resume reopens them. */
+      if (resume_at < 0 && sof_time >= suspend_at) {
+        std::uniform_int_distribution<uint32_t> len(10, cfg.suspend_max_ms > 10 ? cfg.suspend_max_ms : 10);
+        resume_at = sof_time + static_cast<int64_t>(len(rng)) * kPsPerMs;
+        b.set_terminals(false);
+        r.suspends++;
+      }
+      if (resume_at >= 0) {
+        if (sof_time < resume_at) {
+          continue;
+        }
+        resume_at = -1;
+        suspend_at = next_suspend_ps(sof_time);
+        b.set_terminals(true);
+        lock.restart(sof_time);
+        rate_lock.restart(sof_time);
+        host_acc_q14 = 0;
+      }
+      r.sofs++;
+
+      /* SOF clock sync runs first in uac2_sof_cb, at handler (jittered) time. */
+      if (cfg.sof_sync) {
+        clock.set_period(trim.update(clock.position_q8(now)));
+      }
+      if (cfg.sof_stamps) {
+        b.feedback.stamp(dac_position_q8(now));
+      }
+
+      /* OUT: the host sizes each packet from the last reported feedback value. */
+      host_acc_q14 += b.feedback.value();
+      const uint32_t out_samples = host_acc_q14 >> 14;
+      host_acc_q14 &= (1U << 14) - 1U;
+      const uint32_t out_bytes = out_samples * kBytesPerSample;
+      const uint32_t put = b.tx.put(out_bytes);
+      r.tx_overflow_samples += (out_bytes - put) / kBytesPerSample;
+
+      /* SOF: feedback step, then the IN packet (at most wMaxPacketSize). */
+      const int32_t tx_used = static_cast<int32_t>(b.tx.used() / kBytesPerSample);
+      b.feedback.update(static_cast<size_t>(tx_used), 2 * set_point_samples);
+      const uint32_t avail = b.rx.used() / kBytesPerSample;
+      const uint32_t in_samples = avail < kInMaxSamples ? avail : kInMaxSamples;
+      r.rx_samples_sent += b.rx.get(in_samples * kBytesPerSample) / kBytesPerSample;
+
+      const double tx_latency = static_cast<double>(tx_used + 2 * static_cast<int32_t>(kBlockSamples)) * 1000.0 / kSampleRateHz;
+      const int32_t error = tx_used - set_point;
+      const double locked_after = lock.step(sof_time, error);
+      if (locked_after >= 0.0) {
+        if (first_lock_pending) {
+          r.lock_time_ms = locked_after;
+          first_lock_pending = false;
+        } else if (locked_after > r.worst_relock_ms) {
+          r.worst_relock_ms = locked_after;
+        }
+      }
+      const double rate_locked_after = rate_lock.step(sof_time, b.feedback.value(), true_rate_q14, r);
+      if (rate_locked_after >= 0.0) {
+        if (first_rate_lock_pending) {
+          r.rate_lock_ms = rate_locked_after;
+          first_rate_lock_pending = false;
+        } else if (rate_locked_after > r.worst_rate_relock_ms) {
+          r.worst_rate_relock_ms = rate_locked_after;
+        }
+      }
+      if (lock.locked) {
+        const uint32_t fb = b.feedback.value();
+        if (err_count == 0 || fb < r.fb_min) {
+          r.fb_min = fb;
+        }
+        if (err_count == 0 || fb > r.fb_max) {
+          r.fb_max = fb;
+        }
+        const double fb_ppm = (fb / true_rate_q14 - 1.0) * 1e6;
+        fb_sq_sum += fb_ppm * fb_ppm;
+        const int32_t abs_err = std::abs(error);
+        if (abs_err > r.max_abs_error) {
+          r.max_abs_error = abs_err;
+        }
+        err_sum += static_cast<uint64_t>(abs_err);
+        err_count++;
+        if (tx_latency > r.max_tx_latency_ms) {
+          r.max_tx_latency_ms = tx_latency;
+        }
+      }
+    } else if (now == tx_due) {
+      /* DAC half consumed at the hardware instant; the refill work runs late by
+       * the workqueue jitter and must land before the DMA wraps onto that half. */
+      if (cfg.sof_sync) {
+        clock.advance(now);
+      }
+      const int64_t hw_time = tx_hw;
+      tx_block++;
+      const int64_t next_hw = block_end(tx_block + 1);
+      tx_hw = next_hw;
+      const int64_t delay = jitter_ps(cfg.wq_jitter_us);
+      if (hw_time + delay >= next_hw) {
+        r.late_refills++;
+      }
+      tx_due = next_hw + jitter_ps(cfg.wq_jitter_us);
+
+      /* sa818_tx_request_cb: silence until prebuffered, then drain the ring. */
+      if (b.tx_enabled) {
+        if (!b.tx_prebuffered && b.tx.used() >= prebuffer_bytes) {
+          b.tx_prebuffered = true;
+        }
+        if (b.tx_prebuffered) {
+          const uint32_t got = b.tx.get(kBlockSamples * kBytesPerSample) / kBytesPerSample;
+          r.tx_samples_played += got;
+          r.tx_underrun_samples += kBlockSamples - got;
+        }
+      }
+    } else {
+      /* ADC half captured; the drain work delivers it into the RX ring. */
+      if (cfg.sof_sync) {
+        clock.advance(now);
+      }
+      rx_block++;
+      const int64_t next_hw = block_end(rx_block + 1);
+      rx_due = next_hw + jitter_ps(cfg.wq_jitter_us);
+      if (b.rx_enabled) {
+        const uint32_t bytes = kBlockSamples * kBytesPerSample;
+        const uint32_t put = b.rx.put(bytes);
+        r.rx_overflow_samples += (bytes - put) / kBytesPerSample;
+        const double rx_latency = static_cast<double>(b.rx.used() / kBytesPerSample) * 1000.0 / kSampleRateHz;
+        if (rx_latency > r.max_rx_latency_ms) {
+          r.max_rx_latency_ms = rx_latency;
+        }
+      }
+    }
+  }
+
+  r.clock_slips = trim.slips();
+  r.trim_ppb = trim.trim_ppb();
+  r.mean_rate_error_ppm = rate_lock.err_count != 0 ? rate_lock.err_sum / static_cast<double>(rate_lock.err_count) : 0.0;
+  r.fb_rms_ppm = err_count != 0 ? std::sqrt(fb_sq_sum / static_cast<double>(err_count)) : 0.0;
+  r.mean_abs_error = err_count != 0 ? static_cast<double>(err_sum) / static_cast<double>(err_count) : 0.0;
+  return r;
+}
+
+void print_report(FILE *out, const SoakConfig &cfg, const SoakReport &r) {
+  const bool ok = r.passed(cfg);
+  fprintf(out, "soak: %.2f simulated days, device %+.1f ppm, jitter sof %u us / wq %u us, seed %llu, feedback %s%s\n", cfg.days, cfg.device_ppm,
+          cfg.sof_jitter_us, cfg.wq_jitter_us, static_cast<unsigned long long>(cfg.seed), cfg.rate_feedback ? "rate" : "pi",
+          cfg.sof_stamps ? " + SOF stamps" : "");
+  fprintf(out, "  volume:     %llu SOFs, %llu TX samples played, %llu RX samples sent, %u suspends\n", static_cast<unsigned long long>(r.sofs),
+          static_cast<unsigned long long>(r.tx_samples_played), static_cast<unsigned long long>(r.rx_samples_sent), r.suspends);
+  fprintf(out, "  drops:      tx_overflow %llu, tx_underrun %llu, rx_overflow %llu, late_refills %llu\n",
+          static_cast<unsigned long long>(r.tx_overflow_samples), static_cast<unsigned long long>(r.tx_underrun_samples),
+          static_cast<unsigned long long>(r.rx_overflow_samples), static_cast<unsigned long long>(r.late_refills));
+  fprintf(out, "  regulation: lock %.0f ms, worst relock %.0f ms, |err| max %d / mean %.2f samples, fb [%u, %u] Q10.14, %.0f ppm rms\n", r.lock_time_ms,
+          r.worst_relock_ms, r.max_abs_error, r.mean_abs_error, r.fb_min, r.fb_max, r.fb_rms_ppm);
+  fprintf(out, "  rate:       lock %.0f ms, worst relock %.0f ms, 1 s average error max %.1f / mean %.1f ppm\n", r.rate_lock_ms, r.worst_rate_relock_ms,
+          r.max_rate_error_ppm, r.mean_rate_error_ppm);
+  if (cfg.sof_sync) {
+    fprintf(out, "  clock sync: trim %+d ppb, %u slips, TX set point %u samples\n", r.trim_ppb, r.clock_slips, cfg.sync_setpoint);
+  }
+  fprintf(out, "  latency:    TX max %.2f ms (bound %u), RX max %.2f ms (bound %u)\n", r.max_tx_latency_ms, cfg.max_tx_latency_ms, r.max_rx_latency_ms,
+          cfg.max_rx_latency_ms);
+  fprintf(out, "  result:     %s\n", ok ? "PASS" : "FAIL");
+  fprintf(out,
+          "SOAK-RESULT {\"ok\":%s,\"days\":%.3f,\"ppm\":%.1f,\"sofs\":%llu,\"suspends\":%u,\"tx_overflow\":%llu,\"tx_underrun\":%llu,"
+          "\"rx_overflow\":%llu,\"late_refills\":%llu,\"lock_ms\":%.1f,\"worst_relock_ms\":%.1f,\"max_abs_err\":%d,\"mean_abs_err\":%.3f,"
+          "\"max_tx_latency_ms\":%.3f,\"max_rx_latency_ms\":%.3f,\"sof_sync\":%s,\"trim_ppb\":%d,\"clock_slips\":%u,"
+          "\"feedback\":\"%s\",\"sof_stamps\":%s,\"rate_lock_ms\":%.1f,\"worst_rate_relock_ms\":%.1f,\"max_rate_err_ppm\":%.2f,"
+          "\"mean_rate_err_ppm\":%.2f,\"fb_rms_ppm\":%.1f}\n",
+          ok ? "true" : "false", cfg.days, cfg.device_ppm, static_cast<unsigned long long>(r.sofs), r.suspends,
+          static_cast<unsigned long long>(r.tx_overflow_samples), static_cast<unsigned long long>(r.tx_underrun_samples),
+          static_cast<unsigned long long>(r.rx_overflow_samples), static_cast<unsigned long long>(r.late_refills), r.lock_time_ms, r.worst_relock_ms,
+          r.max_abs_error, r.mean_abs_error, r.max_tx_latency_ms, r.max_rx_latency_ms, cfg.sof_sync ? "true" : "false", r.trim_ppb,
+          r.clock_slips, cfg.rate_feedback ? "rate" : "pi", cfg.sof_stamps ? "true" : "false", r.rate_lock_ms,
+          r.worst_rate_relock_ms, r.max_rate_error_ppm, r.mean_rate_error_ppm, r.fb_rms_ppm);
+}
+
+} // namespace sim
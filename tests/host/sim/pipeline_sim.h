@@ -0,0 +1,98 @@
+/**
+ * @file pipeline_sim.h
+ * @brief Virtual-time model of the USB <-> analog audio pipeline (host only).
+ *
+ * Discrete-event simulation of the fm_board audio path, driven entirely in
+ * virtual time so simulated days run in seconds:
+ *   - a USB host on its own SOF clock that delivers OUT packets sized from the
+ *     reported explicit-feedback value and drains IN packets (max 9 samples),
+ *   - the device sample clock (TIM6/TIM7) offset by a configurable ppm drift,
+ *     pulling TX blocks and pushing RX blocks of `block-samples` each,
+ *   - scheduling jitter on the usbd thread and the system workqueue,
+ *   - bus suspend/resume (terminals disabled/re-enabled around the gap).
+ *
+ * With `sof_sync` the device clock is modelled at timer-tick level instead: a
+ * sample lasts ARR+1 ticks of a drifting timer clock, ARR is preloaded, and the
+ * real usb_audio::SofClockTrim reprograms it from each (jittered) SOF handler,
+ * as CONFIG_APP_AUDIO_SOF_SYNC does; the TX set point drops to match.
+ *
+ * The regulator under test is the real usb_audio::BufferFeedback, or with
+ * `rate_feedback` the usb_audio::RateFeedback estimator (optionally fed the
+ * DAC position at each SOF handler with `sof_stamps`); the ring
+ * sizes, prebuffer gate and IN packet cap mirror usb_audio_bridge.cpp. The
+ * rings use free-running uint32 byte indices like Zephyr's ring_buf, so a
+ * multi-day run also crosses their wrap point.
+ *
+ * @copyright Copyright (c) 2026 OE5XRX
+ * @spdx-license-identifier LGPL-3.0-or-later
+ */
+#ifndef OE5XRX_HOST_SIM_PIPELINE_SIM_H_
+#define OE5XRX_HOST_SIM_PIPELINE_SIM_H_
+
+#include <cstdint>
+#include <cstdio>
+
+namespace sim {
+
+struct SoakConfig {
+  double days = 1.0;               /* simulated duration */
+  double device_ppm = 0.0;         /* device sample clock vs host SOF clock; + = device faster */
+  uint32_t sof_jitter_us = 0;      /* max usbd-thread delay of SOF/OUT handling */
+  uint32_t wq_jitter_us = 0;       /* max workqueue delay of TX refill / RX delivery */
+  double suspend_every_s = 0.0;    /* mean interval between bus suspends; 0 = never */
+  uint32_t suspend_max_ms = 500;   /* suspend length is uniform in [10, max] ms */
+  uint64_t seed = 1;               /* PRNG seed (runs are deterministic per seed) */
+  uint32_t max_tx_latency_ms = 40; /* pass bound for TX ring + DMA latency after lock */
+  uint32_t max_rx_latency_ms = 8;  /* pass bound for RX ring latency */
+  bool sof_sync = false;           /* lock the sample clock to SOF (CONFIG_APP_AUDIO_SOF_SYNC) */
+  uint32_t sync_setpoint = 32;     /* TX set point with sof_sync, samples */
+  bool rate_feedback = false;      /* RateFeedback instead of the PI (CONFIG_APP_AUDIO_FEEDBACK_RATE) */
+  bool sof_stamps = false;         /* feed the DAC position at SOF to the rate estimator */
+};
+
+struct SoakReport {
+  /* Volume */
+  uint64_t sofs = 0;
+  uint64_t tx_samples_played = 0;
+  uint64_t rx_samples_sent = 0;
+  uint32_t suspends = 0;
+
+  /* Drops (must all be zero) */
+  uint64_t tx_overflow_samples = 0; /* OUT data that did not fit the TX ring */
+  uint64_t tx_underrun_samples = 0; /* DAC pulls short after prebuffering */
+  uint64_t rx_overflow_samples = 0; /* ADC blocks that did not fit the RX ring */
+  uint64_t late_refills = 0;        /* refill ran after the DMA wrapped onto the half */
+
+  /* Regulation */
+  double lock_time_ms = -1.0;   /* first lock after the initial enable; -1 = never */
+  double worst_relock_ms = 0.0; /* slowest lock after a resume */
+  int32_t max_abs_error = 0;    /* worst |fill - set point| once locked, samples */
+  double mean_abs_error = 0.0;  /* mean |fill - set point| once locked, samples */
+  uint32_t fb_min = 0;          /* reported feedback range once locked (Q10.14) */
+  uint32_t fb_max = 0;
+  double fb_rms_ppm = 0.0;           /* RMS of the reported value vs the device rate once locked */
+  double rate_lock_ms = -1.0;        /* reported value settled on the device rate (1 s averages); -1 = never */
+  double worst_rate_relock_ms = 0.0; /* slowest rate lock after a resume */
+  double max_rate_error_ppm = 0.0;   /* worst 1 s feedback average vs device rate once rate-locked */
+  double mean_rate_error_ppm = 0.0;
+
+  /* SOF clock sync (sof_sync only) */
+  uint32_t clock_slips = 0; /* phase re-anchors, expected once per suspend */
+  int32_t trim_ppb = 0;     /* final sample-clock correction */
+
+  /* Latency (ring fill, incl. the DMA double buffer on TX) */
+  double max_tx_latency_ms = 0.0;
+  double max_rx_latency_ms = 0.0;
+
+  bool passed(const SoakConfig &cfg) const;
+};
+
+/** Run one soak to completion. Pure computation; no I/O. */
+SoakReport run_soak(const SoakConfig &cfg);
+
+/** Print a human summary followed by one machine-readable `SOAK-RESULT {...}` line. */
+void print_report(FILE *out, const SoakConfig &cfg, const SoakReport &r);
+
+} // namespace sim
+
+#endif /* OE5XRX_HOST_SIM_PIPELINE_SIM_H_ */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the serial audio link units: ADPCM encode/decode of one
+ * 20 ms frame (capture callback and link thread), framing + parsing, and the
+ * jitter buffer round trip per frame (link thread + playback callback).
+ */
+#include "ima_adpcm.h"
+#include "jitter_buffer.h"
+#include "link_frame.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+namespace {
+
+constexpr size_t kFrame = 160; /* 20 ms at 8 kHz */
+
+struct Tone {
+  int16_t pcm[kFrame];
+  Tone() {
+    for (size_t i = 0; i < kFrame; i++) {
+      pcm[i] = static_cast<int16_t>(8000.0 * std::sin(2.0 * M_PI * 1000.0 * static_cast<double>(i) / 8000.0));
+    }
+  }
+};
+
+const Tone tone;
+
+void BM_AdpcmEncode(benchmark::State &state) {
+  audio::AdpcmState st{};
+  uint8_t codes[audio::adpcmBytes(kFrame)];
+  for (auto _ : state) {
+    audio::adpcmEncode(st, tone.pcm, kFrame, codes);
+    benchmark::DoNotOptimize(codes);
+  }
+  state.SetItemsProcessed(state.iterations() * kFrame);
+}
+BENCHMARK(BM_AdpcmEncode);
+
+void BM_AdpcmDecode(benchmark::State &state) {
+  audio::AdpcmState st{};
+  uint8_t codes[audio::adpcmBytes(kFrame)];
+  audio::adpcmEncode(st, tone.pcm, kFrame, codes);
+  int16_t out[kFrame];
+  for (auto _ : state) {
+    audio::AdpcmState dec{};
+    audio::adpcmDecode(dec, codes, kFrame, out);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kFrame);
+}
+BENCHMARK(BM_AdpcmDecode);
+
+void BM_LinkFrameEncodeParse(benchmark::State &state) {
+  uint8_t payload[audio::adpcmBytes(kFrame)] = {};
+  uint8_t frame[audio::kLinkMaxFrameBytes];
+  audio::LinkFrameHeader hdr{};
+  hdr.length = sizeof(payload);
+  audio::LinkFrameParser parser;
+  uint32_t frames = 0;
+  for (auto _ : state) {
+    hdr.seq++;
+    const size_t len = audio::linkFrameEncode(hdr, payload, frame, sizeof(frame));
+    parser.feed(frame, len, [&frames](const audio::LinkFrameHeader &, const uint8_t *) { frames++; });
+  }
+  benchmark::DoNotOptimize(frames);
+  state.SetBytesProcessed(state.iterations() * (audio::kLinkHeaderBytes + sizeof(payload) + audio::kLinkCrcBytes));
+}
+BENCHMARK(BM_LinkFrameEncodeParse);
+
+void BM_JitterBufferPutGet(benchmark::State &state) {
+  static audio::JitterBuffer<16, kFrame> jb;
+  jb.init({2, 12});
+  int16_t out[8];
+  uint16_t seq = 0;
+  for (auto _ : state) {
+    jb.put(seq, seq * kFrame, seq * kFrame + (seq & 7), tone.pcm);
+    seq++;
+    /* Played out in audio blocks of 8 samples, as the playback callback does. */
+    for (size_t i = 0; i < kFrame; i += 8) {
+      jb.get(out, 8);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_JitterBufferPutGet);
+
+} // namespace
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the USB audio bridge counters: what the bridge adds to
+ * each SOF (OUT receive, both fill samples, feedback, IN send) and the shell /
+ * telemetry snapshot.
+ */
+#include "bridge_stats.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using usb_audio::BridgeStats;
+
+/* Everything one SOF records with both terminals streaming. */
+void BM_BridgeStatsSof(benchmark::State &state) {
+  static BridgeStats st;
+  uint32_t sof = 0;
+  for (auto _ : state) {
+    sof++;
+    st.out_received(16, 16);
+    st.fill(BridgeStats::kOut, 128 + (sof & 7U), 256);
+    st.feedback((8U << 14) + (sof & 15U));
+    st.fill(BridgeStats::kIn, sof & 15U, 256);
+    st.in_sent(16);
+  }
+  BridgeStats::Snapshot s;
+  st.snapshot(&s);
+  benchmark::DoNotOptimize(s);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BridgeStatsSof);
+
+void BM_BridgeStatsSnapshot(benchmark::State &state) {
+  static BridgeStats st;
+  for (uint32_t i = 0; i < 4096; i++) {
+    st.feedback((8U << 14) + (i & 15U));
+  }
+  BridgeStats::Snapshot s;
+  for (auto _ : state) {
+    st.snapshot(&s);
+    benchmark::DoNotOptimize(s);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BridgeStatsSnapshot);
+
+} // namespace
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the audio_stream callback swap: the per-block reader
+ * cost (what the audio path pays) and an uncontended publish.
+ */
+#include "callback_swap.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct Cbs {
+  void (*fn)(void *);
+  void *user;
+};
+
+void Nop(void *) {}
+
+void BM_CallbackSwapPin(benchmark::State &state) {
+  audio::CallbackSwap<Cbs, 2> sw;
+  sw.publish({Nop, nullptr}, [] {});
+  for (auto _ : state) {
+    const Cbs &c = sw.acquire(0);
+    benchmark::DoNotOptimize(c.fn);
+    sw.release(0);
+  }
+}
+BENCHMARK(BM_CallbackSwapPin);
+
+void BM_CallbackSwapPublish(benchmark::State &state) {
+  audio::CallbackSwap<Cbs, 2> sw;
+  for (auto _ : state) {
+    sw.publish({Nop, nullptr}, [] {});
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CallbackSwapPublish);
+
+} // namespace
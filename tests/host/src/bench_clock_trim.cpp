@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the SOF sample-clock trim (one update per SOF).
+ */
+#include "clock_trim.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* fm_board: TIM6/TIM7 at 160 MHz, 8 kHz => 8 samples/SOF, ARR 19999. */
+constexpr uint32_t kTimHz = 160000000;
+constexpr uint32_t kSampleHz = 8000;
+constexpr uint16_t kSamplesPerSof = 8;
+
+/* One control step per iteration, the position wandering a few samples around
+ * the host's so the P, I and dither paths all run. */
+void BM_ClockTrimUpdate(benchmark::State &state) {
+  usb_audio::SofClockTrim trim;
+  trim.init(kTimHz, kSampleHz, kSamplesPerSof, 1000);
+  uint32_t position = 0;
+  uint32_t step = 0;
+  for (auto _ : state) {
+    position += (kSamplesPerSof << 8) + (step++ % 7) * 16 - 48;
+    benchmark::DoNotOptimize(trim.update(position));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClockTrimUpdate);
+
+/* Closed loop against a timer running 500 ppm fast: 1000 SOFs (one simulated
+ * second) per iteration, mirroring test_locks_to_drifting_device. */
+void BM_ClockTrimClosedLoop1s(benchmark::State &state) {
+  constexpr int kSofsPerIteration = 1000;
+  const uint64_t ticks_per_sof_q16 = ((static_cast<uint64_t>(kTimHz) << 16) / 1000) * 1000500 / 1000000;
+  usb_audio::SofClockTrim trim;
+  trim.init(kTimHz, kSampleHz, kSamplesPerSof, 1000);
+  uint64_t tick_q16 = 0;
+  uint32_t samples = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kSofsPerIteration; i++) {
+      const uint64_t period_q16 = static_cast<uint64_t>(trim.period()) << 16;
+      const uint32_t position = (samples << 8) + static_cast<uint32_t>((tick_q16 << 8) / period_q16);
+      const uint64_t next_q16 = static_cast<uint64_t>(trim.update(position)) << 16;
+      tick_q16 += ticks_per_sof_q16;
+      while (tick_q16 >= next_q16) {
+        tick_q16 -= next_q16;
+        samples++;
+      }
+    }
+    benchmark::DoNotOptimize(samples);
+  }
+  state.SetItemsProcessed(state.iterations() * kSofsPerIteration);
+}
+BENCHMARK(BM_ClockTrimClosedLoop1s);
+
+} // namespace
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the PCM format conversion kernels. Each iteration is
+ * one millisecond of stereo audio at 48 kHz (48 frames), the heaviest UAC2
+ * Full-Speed case. items_per_second counts frames, so 48000 / items_per_second
+ * is the share of the CPU the conversion takes at 48 kHz on this machine.
+ */
+#include "pcm_convert.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr size_t kFrames = 48; /* 1 ms at 48 kHz */
+
+using Encoding = audio::pcm::Encoding;
+
+std::array<int16_t, 2 * kFrames> Ramp() {
+  std::array<int16_t, 2 * kFrames> pcm{};
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>(i * 1499U);
+  }
+  return pcm;
+}
+
+void SetFrames(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kFrames));
+}
+
+void EncodingArgs(benchmark::internal::Benchmark *b) {
+  b->Arg(static_cast<int>(Encoding::kS16))->Arg(static_cast<int>(Encoding::kS24))->Arg(static_cast<int>(Encoding::kS32))->Arg(static_cast<int>(Encoding::kF32));
+}
+
+/* RX edge: mono core block -> stereo wire frames (duplicate + widen). */
+void BM_ToWireStereo(benchmark::State &state) {
+  const audio::pcm::Format fmt{static_cast<Encoding>(state.range(0)), 2};
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  for (auto _ : state) {
+    audio::pcm::to_wire(pcm.data(), wire.data(), kFrames, fmt);
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_ToWireStereo)->Apply(EncodingArgs);
+
+/* TX edge: stereo wire frames -> mono core block (narrow + downmix). */
+void BM_FromWireStereo(benchmark::State &state) {
+  const audio::pcm::Format fmt{static_cast<Encoding>(state.range(0)), 2};
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  audio::pcm::to_wire(pcm.data(), wire.data(), kFrames, fmt);
+  std::array<int16_t, kFrames> mono{};
+  for (auto _ : state) {
+    audio::pcm::from_wire(wire.data(), mono.data(), kFrames, fmt, nullptr);
+    benchmark::DoNotOptimize(mono.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_FromWireStereo)->Apply(EncodingArgs);
+
+/* Dual RX edge: processed + raw planes -> stereo wire frames. */
+void BM_ToWirePair(benchmark::State &state) {
+  const auto enc = static_cast<Encoding>(state.range(0));
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  for (auto _ : state) {
+    audio::pcm::to_wire_pair(pcm.data(), pcm.data() + kFrames, wire.data(), kFrames, enc);
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_ToWirePair)->Apply(EncodingArgs);
+
+/* Worst TX case with dither on. */
+void BM_FromWireStereoDither(benchmark::State &state) {
+  const audio::pcm::Format fmt{Encoding::kS24, 2};
+  const auto pcm = Ramp();
+  std::array<uint8_t, kFrames * 8> wire{};
+  audio::pcm::to_wire(pcm.data(), wire.data(), kFrames, fmt);
+  std::array<int16_t, kFrames> mono{};
+  audio::pcm::Dither dither;
+  dither.enabled = true;
+  for (auto _ : state) {
+    audio::pcm::from_wire(wire.data(), mono.data(), kFrames, fmt, &dither);
+    benchmark::DoNotOptimize(mono.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_FromWireStereoDither);
+
+void BM_Interleave(benchmark::State &state) {
+  const auto pcm = Ramp();
+  std::array<int16_t, 2 * kFrames> frames{};
+  for (auto _ : state) {
+    audio::pcm::interleave(pcm.data(), pcm.data() + kFrames, frames.data(), kFrames);
+    benchmark::DoNotOptimize(frames.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_Interleave);
+
+void BM_Deinterleave(benchmark::State &state) {
+  const auto pcm = Ramp();
+  std::array<int16_t, kFrames> left{};
+  std::array<int16_t, kFrames> right{};
+  for (auto _ : state) {
+    audio::pcm::deinterleave(pcm.data(), left.data(), right.data(), kFrames);
+    benchmark::DoNotOptimize(left.data());
+    benchmark::DoNotOptimize(right.data());
+    benchmark::ClobberMemory();
+  }
+  SetFrames(state);
+}
+BENCHMARK(BM_Deinterleave);
+
+} // namespace
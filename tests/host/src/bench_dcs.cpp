@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmark for the DCS decoder (one capture block per call).
+ */
+#include "dcs_decoder.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+/* One second of 023N NRZ under a 440 Hz-ish square "voice", replayed in blocks. */
+std::vector<int16_t> MakeSignal() {
+  std::vector<int16_t> pcm(8000);
+  const uint32_t word = dcs::encode(0023);
+  for (size_t i = 0; i < pcm.size(); i++) {
+    const size_t bit = (i * dcs::kBitRateMilli / 8000000U) % dcs::kWordBits;
+    const int32_t code = ((word >> bit) & 1U) ? 1500 : -1500;
+    const int32_t voice = ((i / 9) & 1U) ? 4000 : -4000;
+    pcm[i] = static_cast<int16_t>(code + voice);
+  }
+  return pcm;
+}
+
+void BM_DcsFeed(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  const std::vector<int16_t> pcm = MakeSignal();
+  dcs::Decoder d;
+  size_t pos = 0;
+  for (auto _ : state) {
+    d.feed(&pcm[pos], n);
+    pos = (pos + n) % pcm.size();
+    benchmark::DoNotOptimize(d.detection());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+/* The fm_board DT block (8 samples) and the driver maxima (16). */
+BENCHMARK(BM_DcsFeed)->Arg(8)->Arg(16);
+
+} // namespace
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the audio DMA interrupt path: the lock-free capture
+ * hand-off (pcm_ring.h) and the entry-timing stamp (irq_timing.h).
+ */
+#include "adc_pcm.h"
+#include "irq_timing.h"
+#include "pcm_ring.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* One capture block through the ring as the ZLI handler and the drain work do
+ * it: claim, convert, commit in the handler; peek, release on the thread. */
+void BM_PcmRingBlockHandOff(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  static struct pcm_ring ring;
+  std::array<uint16_t, 16> raw{};
+  for (size_t i = 0; i < raw.size(); i++) {
+    raw[i] = static_cast<uint16_t>((i * 257U) & 0x0FFFU);
+  }
+  pcm_ring_reset(&ring);
+  int32_t sink = 0;
+  for (auto _ : state) {
+    int16_t *dst = pcm_ring_claim(&ring);
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = adc_to_pcm16(raw[i], 12);
+    }
+    pcm_ring_commit(&ring);
+    const int16_t *block = pcm_ring_peek(&ring);
+    sink += block[n - 1];
+    pcm_ring_release(&ring);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_PcmRingBlockHandOff)->Arg(8)->Arg(16);
+
+/* The stamp taken first thing in every audio DMA interrupt. */
+void BM_IrqTimingMark(benchmark::State &state) {
+  struct irq_timing t;
+  irq_timing_reset(&t, 160000);
+  uint32_t now = 0;
+  for (auto _ : state) {
+    now += 160000U + (now & 0x3FU);
+    irq_timing_mark(&t, now);
+    benchmark::ClobberMemory();
+  }
+  benchmark::DoNotOptimize(t.jitter_max);
+}
+BENCHMARK(BM_IrqTimingMark);
+
+} // namespace
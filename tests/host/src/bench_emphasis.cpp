@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the MCU pre-/de-emphasis filter (one block per call).
+ */
+#include "emphasis.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* Block sizes: the fm_board DT block (8 samples) and the driver maxima (16). */
+void BlockArgs(benchmark::internal::Benchmark *b) {
+  b->Arg(8)->Arg(16);
+}
+
+void Fill(std::array<int16_t, 16> &pcm) {
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>((i * 1499U) & 0x1FFFU);
+  }
+}
+
+/* Steady state: filter on, as in the voice-mode TX refill / RX delivery. */
+void BM_EmphasisBlock(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  audio::Emphasis f(audio::Emphasis::Mode::kDe, true);
+  std::array<int16_t, 16> pcm{};
+  for (auto _ : state) {
+    Fill(pcm);
+    f.process(pcm.data(), n, true);
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_EmphasisBlock)->Apply(BlockArgs);
+
+/* Worst case: every block is a switch block (filter + crossfade). */
+void BM_EmphasisSwitchBlock(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  audio::Emphasis f(audio::Emphasis::Mode::kPre);
+  std::array<int16_t, 16> pcm{};
+  bool on = false;
+  for (auto _ : state) {
+    Fill(pcm);
+    on = !on;
+    f.process(pcm.data(), n, on);
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_EmphasisSwitchBlock)->Apply(BlockArgs);
+
+} // namespace
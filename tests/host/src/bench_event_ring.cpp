@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the event bus ingress ring: the publish cost a driver or
+ * ISR pays, and a burst drained by the bus thread.
+ */
+#include "event_ring.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct Evt {
+  uint8_t type;
+  int32_t value;
+  uint32_t stamp;
+};
+
+void BM_EventRingPushPop(benchmark::State &state) {
+  events::EventRing<Evt, 32> ring;
+  Evt out{};
+  for (auto _ : state) {
+    ring.push({1, 1, 0});
+    ring.pop(out);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_EventRingPushPop);
+
+void BM_EventRingBurst(benchmark::State &state) {
+  const int burst = static_cast<int>(state.range(0));
+  events::EventRing<Evt, 32> ring;
+  Evt out{};
+  for (auto _ : state) {
+    for (int i = 0; i < burst; i++) {
+      ring.push({2, i, 0});
+    }
+    while (ring.pop(out)) {
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_EventRingBurst)->Arg(4)->Arg(32);
+
+} // namespace
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the UAC2 explicit-feedback regulators (one update per SOF).
+ */
+#include "feedback.h"
+#include "rate_feedback.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* fm_board audio: 8 kHz, 16-bit mono => 8 samples/SOF, TX ring 256 samples. */
+constexpr uint16_t kSamplesPerSof = 8;
+constexpr size_t kCapacity = 256; /* samples */
+
+/* One control step per iteration, with the ring fill wandering around the set
+ * point so both clamp branches and the integrator bound are exercised. */
+void BM_FeedbackUpdate(benchmark::State &state) {
+  usb_audio::BufferFeedback fb;
+  fb.init(kSamplesPerSof);
+  size_t used = kCapacity / 2;
+  size_t step = 0;
+  for (auto _ : state) {
+    used = (kCapacity / 2 - 24) + (step++ % 49);
+    fb.update(used, kCapacity);
+    benchmark::DoNotOptimize(fb.value());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FeedbackUpdate);
+
+/* Closed loop against a sink drifting by the USB 500 ppm worst case: 1000 SOFs
+ * (one simulated second) per iteration, mirroring test_converges_under_drift. */
+void BM_FeedbackClosedLoop1s(benchmark::State &state) {
+  constexpr int kSofsPerIteration = 1000;
+  const int64_t consume_q14 = (static_cast<int64_t>(kSamplesPerSof) << 14) + 66;
+  for (auto _ : state) {
+    usb_audio::BufferFeedback fb;
+    fb.init(kSamplesPerSof);
+    int64_t ring_q14 = static_cast<int64_t>(kCapacity / 2) << 14;
+    for (int i = 0; i < kSofsPerIteration; i++) {
+      fb.update(static_cast<size_t>(ring_q14 >> 14), kCapacity);
+      ring_q14 += static_cast<int64_t>(fb.value()) - consume_q14;
+    }
+    benchmark::DoNotOptimize(ring_q14);
+  }
+  state.SetItemsProcessed(state.iterations() * kSofsPerIteration);
+}
+BENCHMARK(BM_FeedbackClosedLoop1s);
+
+/* RateFeedback step with a SOF stamp, same fill pattern as BM_FeedbackUpdate.
+ * Past its start-up the filter runs on the steady-state gains. */
+void BM_RateFeedbackUpdate(benchmark::State &state) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  uint32_t position = 0;
+  size_t step = 0;
+  for (auto _ : state) {
+    fb.stamp(position);
+    position += kSamplesPerSof << 8;
+    fb.update((kCapacity / 2 - 24) + (step++ % 49), kCapacity);
+    benchmark::DoNotOptimize(fb.value());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RateFeedbackUpdate);
+
+/* BM_FeedbackClosedLoop1s for the rate estimator, fill only. */
+void BM_RateFeedbackClosedLoop1s(benchmark::State &state) {
+  constexpr int kSofsPerIteration = 1000;
+  const int64_t consume_q14 = (static_cast<int64_t>(kSamplesPerSof) << 14) + 66;
+  for (auto _ : state) {
+    usb_audio::RateFeedback fb;
+    fb.init(kSamplesPerSof);
+    int64_t ring_q14 = static_cast<int64_t>(kCapacity / 2) << 14;
+    for (int i = 0; i < kSofsPerIteration; i++) {
+      fb.update(static_cast<size_t>(ring_q14 >> 14), kCapacity);
+      ring_q14 += static_cast<int64_t>(fb.value()) - consume_q14;
+    }
+    benchmark::DoNotOptimize(ring_q14);
+  }
+  state.SetItemsProcessed(state.iterations() * kSofsPerIteration);
+}
+BENCHMARK(BM_RateFeedbackClosedLoop1s);
+
+} // namespace
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmark for the boot-confirm health gate state machine, driven with
+ * fake (virtual-time) hooks like tests/boot_confirm.
+ */
+#include "health_gate.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using namespace boot;
+
+struct FakeEnv {
+  int64_t now = 0;
+};
+
+int64_t f_now(void *c) {
+  return static_cast<FakeEnv *>(c)->now;
+}
+void f_sleep(void *c, int64_t ms) {
+  static_cast<FakeEnv *>(c)->now += ms;
+}
+bool f_confd(void *) {
+  return false;
+}
+int f_confirm(void *) {
+  return 0;
+}
+void f_reboot(void *) {}
+
+bool probe_always(void *) {
+  return true;
+}
+
+/* A full trial-boot run to Confirmed: 3 s dwell at a 250 ms poll => 13 sweeps
+ * over three criteria (usb / shell / sa818 in the firmware wiring). */
+void BM_HealthGateConfirm(benchmark::State &state) {
+  const GateConfig cfg{/*deadline*/ 30000, /*dwell*/ 3000, /*poll*/ 250};
+  for (auto _ : state) {
+    FakeEnv e;
+    const GateHooks hooks{f_now, f_sleep, f_confd, f_confirm, f_reboot, &e};
+    const HealthCriterion crit[] = {{"usb", probe_always, &e}, {"shell", probe_always, &e}, {"sa818", probe_always, &e}};
+    GateOutcome out = run_health_gate(cfg, hooks, crit, 3);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_HealthGateConfirm);
+
+} // namespace
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the module framework JSON rendering (describe + execute),
+ * using a small fake module so no driver is involved.
+ */
+#include <benchmark/benchmark.h>
+#include <oe5xrx/module/iface.h>
+
+namespace {
+
+const mod::Range kGainRanges[] = {{nullptr, 0.0, 8.0}};
+const mod::FieldSpec kGainSpec{"gain", mod::ValueType::Int, "dB", kGainRanges, 1};
+const mod::FieldSpec kLevelSpec{"level", mod::ValueType::Float, "dBFS", nullptr, 0, nullptr, 0, /*readonly=*/true};
+
+class GainCap : public mod::Setting {
+public:
+  const mod::FieldSpec &spec() const override { return kGainSpec; }
+
+protected:
+  mod::Result onSet(const char *) override { return mod::Result::okInt(gain_); }
+  mod::Result onGet() override { return mod::Result::okInt(gain_); }
+
+private:
+  int gain_ = 4;
+};
+
+class LevelCap : public mod::Telemetry {
+public:
+  const mod::FieldSpec &spec() const override { return kLevelSpec; }
+
+protected:
+  mod::Result onGet() override { return mod::Result::okFloat(-12.5); }
+};
+
+GainCap g_gain;
+LevelCap g_level;
+mod::Capability *const g_caps[] = {&g_gain, &g_level};
+const mod::Identity g_identity{"bench", "host", "0"};
+mod::Module g_module{g_identity, "bench", g_caps};
+
+void BM_ModuleDescribe(benchmark::State &state) {
+  char buf[1024];
+  for (auto _ : state) {
+    mod::JsonWriter w(buf, sizeof(buf));
+    g_module.describe(w);
+    benchmark::DoNotOptimize(w.c_str());
+  }
+}
+BENCHMARK(BM_ModuleDescribe);
+
+void BM_ModuleExecuteGet(benchmark::State &state) {
+  char buf[256];
+  for (auto _ : state) {
+    mod::JsonWriter w(buf, sizeof(buf));
+    g_module.execute(mod::Op::Get, "level", "").render(w, "bench", "level", "get");
+    benchmark::DoNotOptimize(w.c_str());
+  }
+}
+BENCHMARK(BM_ModuleExecuteGet);
+
+} // namespace
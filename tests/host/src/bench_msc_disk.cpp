@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the USB drive: synthesizing one 512-byte sector per
+ * call (what a bulk read costs beyond the USB transfer) and feeding the log
+ * ring.
+ */
+#include "log_ring.h"
+#include "virtual_fat.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+namespace {
+
+using msc::LogRing;
+using msc::VirtualFat;
+
+std::array<uint8_t, 16384> g_ring_data;
+LogRing::Control g_ring_ctl;
+LogRing g_ring{g_ring_ctl, g_ring_data.data(), static_cast<uint32_t>(g_ring_data.size())};
+LogRing::Snapshot g_snap;
+
+void ReadLog(uint32_t offset, uint8_t *dst, uint32_t len, void *) { g_ring.read(g_snap, offset, dst, len); }
+
+/* A drive as on the target: the full log ring plus a few small files. */
+const VirtualFat &BenchFat() {
+  static VirtualFat fat("OE5XRX FM", 1);
+  static const bool ready = [] {
+    g_ring.attach();
+    std::array<uint8_t, 100> line;
+    line.fill('x');
+    for (size_t i = 0; i < 2 * g_ring_data.size() / line.size(); i++) {
+      g_ring.write(line.data(), line.size());
+    }
+    g_snap = g_ring.snapshot();
+    fat.add("LOG.TXT", g_snap.size, ReadLog, nullptr);
+    fat.add("STATUS.TXT", 3000, ReadLog, nullptr);
+    return true;
+  }();
+  (void)ready;
+  return fat;
+}
+
+/* Arg: 0 boot sector, 1 FAT, 2 root directory, 3 file data. */
+void BM_VfatSector(benchmark::State &state) {
+  const VirtualFat &fat = BenchFat();
+  static constexpr uint32_t kSectors[] = {0, VirtualFat::kReservedSectors, VirtualFat::kFirstRootSector, VirtualFat::kFirstDataSector + 5};
+  const uint32_t sector = kSectors[state.range(0)];
+  std::array<uint8_t, VirtualFat::kSectorSize> buf;
+  for (auto _ : state) {
+    fat.read(sector, buf.data());
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buf.size()));
+}
+BENCHMARK(BM_VfatSector)->DenseRange(0, 3);
+
+/* One formatted log line into the ring (the log backend's per-message cost). */
+void BM_LogRingWrite(benchmark::State &state) {
+  static constexpr char kLine[] = "[00:01:23.456,000] <inf> audio_stream: audio pipeline recovered in 12 ms\r\n";
+  for (auto _ : state) {
+    g_ring.write(reinterpret_cast<const uint8_t *>(kLine), sizeof(kLine) - 1);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(kLine) - 1));
+}
+BENCHMARK(BM_LogRingWrite);
+
+} // namespace
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the adaptive RX notch cascade (one capture block per call).
+ */
+#include "adaptive_notch.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* Section counts allowed by APP_AUDIO_NOTCH_SECTIONS. */
+void SectionArgs(benchmark::internal::Benchmark *b) {
+  b->Arg(1)->Arg(2)->Arg(4);
+}
+
+void Fill(std::array<int16_t, 8> &pcm, uint32_t &phase) {
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>((phase++ * 1499U) & 0x1FFFU);
+  }
+}
+
+/* Steady state: notch switched in, 8-sample fm_board capture block. */
+void BM_NotchBlock(benchmark::State &state) {
+  audio::AdaptiveNotch f({static_cast<uint8_t>(state.range(0)), 10, 7}, true);
+  std::array<int16_t, 8> pcm{};
+  uint32_t phase = 0;
+  for (auto _ : state) {
+    Fill(pcm, phase);
+    f.process(pcm.data(), pcm.size(), true);
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pcm.size()));
+}
+BENCHMARK(BM_NotchBlock)->Apply(SectionArgs);
+
+/* Worst case: every block is a switch block (cascade + crossfade). */
+void BM_NotchSwitchBlock(benchmark::State &state) {
+  audio::AdaptiveNotch f({static_cast<uint8_t>(state.range(0)), 10, 7});
+  std::array<int16_t, 8> pcm{};
+  uint32_t phase = 0;
+  bool on = false;
+  for (auto _ : state) {
+    Fill(pcm, phase);
+    on = !on;
+    f.process(pcm.data(), pcm.size(), on);
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pcm.size()));
+}
+BENCHMARK(BM_NotchSwitchBlock)->Apply(SectionArgs);
+
+} // namespace
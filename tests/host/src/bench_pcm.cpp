@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the ADC->PCM and PCM->DAC per-block conversion passes.
+ */
+#include "adc_pcm.h"
+#include "adc_scan.h"
+#include "dac_pcm.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr uint8_t kResolution = 12;
+
+/* Block sizes: the fm_board DT block (8 samples) and the driver maxima (16). */
+void BlockArgs(benchmark::internal::Benchmark *b) {
+  b->Arg(8)->Arg(16);
+}
+
+/* The single-rank conversion loop of aai_push_half (runs in ISR context per half). */
+void BM_AdcToPcm16Block(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::array<uint16_t, 16> raw{};
+  std::array<int16_t, 16> pcm{};
+  for (size_t i = 0; i < raw.size(); i++) {
+    raw[i] = static_cast<uint16_t>((i * 257U) & 0x0FFFU);
+  }
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; i++) {
+      pcm[i] = adc_to_pcm16(raw[i], kResolution);
+    }
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_AdcToPcm16Block)->Apply(BlockArgs);
+
+/* The multi-rank pass in aai_push_half: one 8-sample block of [audio, aux...]
+ * scan frames per iteration, ranks 1 (audio only), 3 (fm_board) and 5 (max).
+ * The difference to ranks 1 is the cost of the auxiliary monitoring. */
+void BM_AdcScanSplitBlock(benchmark::State &state) {
+  const uint8_t ranks = static_cast<uint8_t>(state.range(0));
+  constexpr size_t kBlock = 8;
+  std::array<uint16_t, kBlock * (1 + ADC_SCAN_AUX_MAX)> raw{};
+  std::array<int16_t, kBlock> pcm{};
+  for (size_t i = 0; i < raw.size(); i++) {
+    raw[i] = static_cast<uint16_t>((i * 257U) & 0x0FFFU);
+  }
+  struct adc_scan_aux aux = {};
+  uint32_t avg_q4[ADC_SCAN_AUX_MAX];
+  for (auto _ : state) {
+    adc_scan_split(raw.data(), kBlock, ranks, kResolution, pcm.data(), &aux);
+    (void)adc_scan_take(&aux, static_cast<uint8_t>(ranks - 1U), 4000, avg_q4);
+    benchmark::DoNotOptimize(pcm.data());
+    benchmark::DoNotOptimize(avg_q4);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBlock));
+}
+BENCHMARK(BM_AdcScanSplitBlock)->Arg(1)->Arg(3)->Arg(5);
+
+/* Mirrors the conversion loop in aao_refill_work (one DMA half per call). */
+void BM_Pcm16ToDacBlock(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0));
+  std::array<int16_t, 16> pcm{};
+  std::array<uint16_t, 16> dac{};
+  for (size_t i = 0; i < pcm.size(); i++) {
+    pcm[i] = static_cast<int16_t>(i * 4099U);
+  }
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; i++) {
+      dac[i] = pcm16_to_dac(pcm[i], kResolution);
+    }
+    benchmark::DoNotOptimize(dac.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_Pcm16ToDacBlock)->Apply(BlockArgs);
+
+} // namespace
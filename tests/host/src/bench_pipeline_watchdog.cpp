@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the audio pipeline watchdog: the per-block heartbeat on
+ * the audio path and the monitor's periodic poll.
+ */
+#include "pipeline_watchdog.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using audio::PipelineWatchdog;
+
+void init_all_armed(PipelineWatchdog &w) {
+  const PipelineWatchdog::Config cfg = {{8, 8, 8}, 3};
+  w.init(cfg);
+  for (uint8_t ch = 0; ch < PipelineWatchdog::kChannels; ch++) {
+    w.arm(static_cast<PipelineWatchdog::Channel>(ch), true, 0);
+  }
+}
+
+/* Cost added to every capture/playback block and every SOF. */
+void BM_WatchdogBeat(benchmark::State &state) {
+  PipelineWatchdog w;
+  init_all_armed(w);
+  uint32_t now = 0;
+  for (auto _ : state) {
+    w.beat(PipelineWatchdog::kPlayback, ++now);
+  }
+  benchmark::DoNotOptimize(w.stats());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WatchdogBeat);
+
+/* Healthy poll over three armed channels (the steady-state monitor cost). */
+void BM_WatchdogPollHealthy(benchmark::State &state) {
+  PipelineWatchdog w;
+  init_all_armed(w);
+  uint32_t now = 0;
+  for (auto _ : state) {
+    now++;
+    for (uint8_t ch = 0; ch < PipelineWatchdog::kChannels; ch++) {
+      w.beat(static_cast<PipelineWatchdog::Channel>(ch), now);
+    }
+    benchmark::DoNotOptimize(w.poll(now));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WatchdogPollHealthy);
+
+} // namespace
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the module action scheduler: the bookkeeping of one
+ * wakeup (collect, execute a no-op, reschedule, find the next deadline) with
+ * a full table, and the next-deadline search alone.
+ */
+#include "action_scheduler.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+namespace {
+
+using sched::ActionScheduler;
+
+constexpr size_t kEntries = 16;
+
+/* kEntries periodic entries with co-prime-ish periods, so wakeups rarely coincide. */
+void Fill(ActionScheduler &s) {
+  for (size_t i = 0; i < kEntries; i++) {
+    sched::Spec spec{};
+    spec.delay_ms = static_cast<uint32_t>(i + 1);
+    spec.period_ms = static_cast<uint32_t>(7 + 13 * i);
+    spec.action.op = sched::Op::kDo;
+    strcpy(spec.action.module, "fm");
+    strcpy(spec.action.cap, "ptt");
+    s.set(i, spec, 0);
+  }
+}
+
+/* One wakeup: jump to the next deadline and run what is due there. */
+void BM_SchedulerWakeup(benchmark::State &state) {
+  static ActionScheduler::Entry table[kEntries];
+  ActionScheduler s(table);
+  Fill(s);
+  uint64_t now = 0;
+  for (auto _ : state) {
+    s.next_due(&now);
+    const size_t ran = s.run_due(now, [&]() { return now; }, [](size_t, const sched::Action &) { return true; });
+    benchmark::DoNotOptimize(ran);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(s.stats().runs));
+}
+BENCHMARK(BM_SchedulerWakeup);
+
+void BM_SchedulerNextDue(benchmark::State &state) {
+  static ActionScheduler::Entry table[kEntries];
+  ActionScheduler s(table);
+  Fill(s);
+  uint64_t due = 0;
+  for (auto _ : state) {
+    s.next_due(&due);
+    benchmark::DoNotOptimize(due);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SchedulerNextDue);
+
+} // namespace
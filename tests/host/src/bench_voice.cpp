@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Host benchmarks for the voice prompt engine: composing an announcement and
+ * decoding it one playback block per call.
+ */
+#include "voice_prompt.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/* Every clip 4000 samples (0.5 s) of arbitrary codes, back to back. */
+constexpr uint32_t kClipSamples = 4000;
+std::array<uint8_t, voice::kClipCount * kClipSamples / 2> g_data;
+std::array<voice::Clip, voice::kClipCount> g_clips;
+
+const voice::Pack &BenchPack() {
+  static const voice::Pack pack = [] {
+    uint32_t lcg = 1;
+    for (uint8_t &b : g_data) {
+      lcg = lcg * 1664525U + 1013904223U;
+      b = static_cast<uint8_t>(lcg >> 24);
+    }
+    for (size_t i = 0; i < g_clips.size(); i++) {
+      g_clips[i] = {static_cast<uint32_t>(i) * kClipSamples, kClipSamples, {0, 0}};
+    }
+    return voice::Pack{g_data.data(), g_clips.data(), 2000};
+  }();
+  return pack;
+}
+
+void BM_VoiceCompose(benchmark::State &state) {
+  std::array<voice::Word, voice::Player::kMaxWords> words{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(voice::compose("433.5000 MHz OE5XRX", words.data(), words.size()));
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_VoiceCompose);
+
+/* Playback hook cost per block (8: fm_board, 48: one UAC2 ms at 48 kHz). */
+void BM_VoiceFill(benchmark::State &state) {
+  voice::Player player(BenchPack());
+  std::array<voice::Word, voice::Player::kMaxWords> words{};
+  const size_t n = voice::compose("433.5000 MHz OE5XRX", words.data(), words.size());
+  std::array<int16_t, 48> pcm{};
+  const size_t block = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    if (!player.active()) {
+      player.start(words.data(), n);
+    }
+    benchmark::DoNotOptimize(player.fill(pcm.data(), block));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(block));
+}
+BENCHMARK(BM_VoiceFill)->Arg(8)->Arg(48);
+
+} // namespace
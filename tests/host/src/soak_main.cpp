@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 OE5XRX
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ *
+ * Accelerated-time soak of the USB <-> analog audio pipeline (see
+ * sim/pipeline_sim.h). Exits non-zero if any sample was dropped, the feedback
+ * loop never locked, or a latency bound was exceeded.
+ *
+ *   fm_host_soak --days 7 --ppm 500 --sof-jitter-us 300 --wq-jitter-us 600 --suspend-every-s 3600
+ *   fm_host_soak --sync 1 --sync-setpoint 32 --ppm 500 --max-tx-latency-ms 8
+ *   fm_host_soak --feedback rate --sof-stamps 1 --ppm -500
+ */
+#include "pipeline_sim.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kMaxJitterUs = 999; /* must stay below one 1 ms block/SOF period */
+
+void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--days D] [--ppm P] [--sof-jitter-us U] [--wq-jitter-us U]\n"
+          "          [--suspend-every-s S] [--suspend-max-ms M] [--seed N]\n"
+          "          [--max-tx-latency-ms M] [--max-rx-latency-ms M]\n"
+          "          [--sync 0|1] [--sync-setpoint SAMPLES]\n"
+          "          [--feedback pi|rate] [--sof-stamps 0|1]\n",
+          argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  sim::SoakConfig cfg;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 2;
+    }
+    const char *val = argv[++i];
+    if (strcmp(opt, "--days") == 0) {
+      cfg.days = strtod(val, nullptr);
+    } else if (strcmp(opt, "--ppm") == 0) {
+      cfg.device_ppm = strtod(val, nullptr);
+    } else if (strcmp(opt, "--sof-jitter-us") == 0) {
+      cfg.sof_jitter_us = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--wq-jitter-us") == 0) {
+      cfg.wq_jitter_us = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--suspend-every-s") == 0) {
+      cfg.suspend_every_s = strtod(val, nullptr);
+    } else if (strcmp(opt, "--suspend-max-ms") == 0) {
+      cfg.suspend_max_ms = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--seed") == 0) {
+      cfg.seed = strtoull(val, nullptr, 10);
+    } else if (strcmp(opt, "--max-tx-latency-ms") == 0) {
+      cfg.max_tx_latency_ms = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--max-rx-latency-ms") == 0) {
+      cfg.max_rx_latency_ms = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--sync") == 0) {
+      cfg.sof_sync = strtoul(val, nullptr, 10) != 0;
+    } else if (strcmp(opt, "--sync-setpoint") == 0) {
+      cfg.sync_setpoint = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+    } else if (strcmp(opt, "--feedback") == 0) {
+      if (strcmp(val, "pi") == 0) {
+        cfg.rate_feedback = false;
+      } else if (strcmp(val, "rate") == 0) {
+        cfg.rate_feedback = true;
+      } else {
+        usage(argv[0]);
+        return 2;
+      }
+    } else if (strcmp(opt, "--sof-stamps") == 0) {
+      cfg.sof_stamps = strtoul(val, nullptr, 10) != 0;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (cfg.days <= 0.0 || cfg.sof_jitter_us > kMaxJitterUs || cfg.wq_jitter_us > kMaxJitterUs || cfg.sync_setpoint < 16 || cfg.sync_setpoint > 128) {
+    fprintf(stderr, "soak: days must be > 0, jitter <= %u us and the sync set point 16..128 samples\n", kMaxJitterUs);
+    return 2;
+  }
+
+  const sim::SoakReport report = sim::run_soak(cfg);
+  sim::print_report(stdout, cfg, report);
+  return report.passed(cfg) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
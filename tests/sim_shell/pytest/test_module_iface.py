@@ -33,7 +33,7 @@ def test_module_describe_valid_json(shell):
     assert d["identity"]["version"] == "vhf"
 
     caps = {c["name"]: c for c in d["capabilities"]}
-    assert set(caps) == {"frequency", "tx_frequency", "rx_frequency", "ptt", "power_level", "rssi", "volume", "bandwidth", "squelch", "tx_tone", "rx_tone", "band"}
+    assert set(caps) == {"frequency", "tx_frequency", "rx_frequency", "ptt", "power_level", "rssi", "volume", "bandwidth", "squelch", "tx_tone", "rx_tone", "band", "ready_ms"}
 
     assert caps["frequency"]["kind"] == "setting"
     assert caps["frequency"]["type"] == "float"
@@ -61,6 +61,11 @@ def test_module_describe_valid_json(shell):
     assert caps["band"]["kind"] == "telemetry"
     assert caps["band"]["type"] == "string"
 
+    assert caps["ready_ms"]["kind"] == "telemetry"
+    assert caps["ready_ms"]["type"] == "int"
+    assert caps["ready_ms"]["unit"] == "ms"
+    assert caps["ready_ms"]["readonly"] is True
+
 
 def test_module_set_frequency_e2e(sa818_sim, shell):
     """The §8 datapoint: typed set flows through the real driver to the module."""
@@ -343,6 +348,22 @@ def test_module_band_string_arm(sa818_sim, shell):
     assert r["value"] == "vhf"
 
 
+def test_module_ready_telemetry(sa818_sim, shell):
+    """A fresh power-up is polled ready well inside the ceiling and reported in ms."""
+    shell.exec_command("sa818 power off")
+    shell.exec_command("sa818 power on")
+    r = _payload(shell.exec_command("module fm get ready_ms"), "MODULE-RESULT")
+    assert r["ok"] is True
+    assert isinstance(r["value"], int) and 0 <= r["value"] < 1000
+
+    out = "\n".join(shell.exec_command("sa818 ready"))
+    m = re.search(r"SA818-READY last_ms=(\d+) .* count=(\d+) timeouts=(\d+) probes=(\d+)", out)
+    assert m, out
+    assert int(m.group(1)) == r["value"]
+    assert int(m.group(2)) >= 1
+    assert int(m.group(4)) >= 1
+
+
 def test_module_set_parse_edges(sa818_sim, shell):
     """Pin the accept/reject behavior of numeric parsing across the to_arithmetic swap."""
     shell.exec_command("sa818 power on")
@@ -4,10 +4,35 @@
  *
  * Unit tests for the UAC2 explicit-feedback regulator (native_sim).
  */
+#include "action_scheduler.h"
+#include "adaptive_notch.h"
 #include "adc_pcm.h"
+#include "adc_scan.h"
+#include "bridge_stats.h"
+#include "callback_swap.h"
+#include "clock_trim.h"
 #include "dac_pcm.h"
+#include "dcs_decoder.h"
+#include "emphasis.h"
+#include "event_ring.h"
 #include "feedback.h"
+#include "feedback_controller.h"
+#include "ima_adpcm.h"
+#include "irq_timing.h"
+#include "jitter_buffer.h"
+#include "link_frame.h"
+#include "log_ring.h"
+#include "pcm_convert.h"
+#include "pcm_ring.h"
+#include "pipeline_watchdog.h"
+#include "rate_feedback.h"
+#include "sync_start.h"
+#include "virtual_fat.h"
+#include "voice_prompt.h"
 
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 
 /* fm_board audio: 8 kHz, 16-bit mono => 8 samples/SOF, TX ring 256 samples. */
@@ -107,6 +132,116 @@ ZTEST(feedback, test_integrator_is_bounded) {
   zassert_equal(fb.value(), kNominal - (1u << 13), "did not recover to the lower clamp, got %u", (unsigned)fb.value());
 }
 
+ZTEST_SUITE(rate_feedback, NULL, NULL, NULL, NULL, NULL);
+
+/* Host + ring model as in test_converges_under_drift: the sink consumes
+ * @p consume_q14 per frame; optionally stamp its position (Q24.8). */
+static int32_t run_rate_loop(usb_audio::RateFeedback &fb, int64_t consume_q14, int frames, bool stamps) {
+  const int32_t cap = (int32_t)kCapacity;
+  int64_t ring_q14 = (int64_t)(cap / 2) << 14;
+  int64_t played_q14 = 0;
+
+  for (int i = 0; i < frames; i++) {
+    if (stamps) {
+      fb.stamp((uint32_t)(played_q14 >> 6));
+    }
+    fb.update((size_t)(ring_q14 >> 14), (size_t)cap);
+    zassert_equal(fb.value() % 16, 0U, "value %u not 16-aligned at frame %d", (unsigned)fb.value(), i);
+    ring_q14 += (int64_t)fb.value();
+    ring_q14 -= consume_q14;
+    played_q14 += consume_q14;
+    zassert_true(ring_q14 > 0 && (ring_q14 >> 14) < cap, "ring out of bounds at frame %d", i);
+  }
+  return (int32_t)(ring_q14 >> 14);
+}
+
+ZTEST(rate_feedback, test_nominal_until_prebuffered) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  for (size_t used = 0; used < kCapacity / 2; used += 8) {
+    fb.update(used, kCapacity); /* filling up, nothing played yet */
+  }
+  zassert_equal(fb.value(), kNominal, "value must stay nominal while prebuffering, got %u", (unsigned)fb.value());
+  zassert_equal(fb.rate(), kNominal, "rate must stay nominal while prebuffering, got %u", (unsigned)fb.rate());
+}
+
+ZTEST(rate_feedback, test_converges_under_drift) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  const int64_t consume_q14 = ((int64_t)kSamplesPerSof << 14) + 66; /* +500 ppm */
+
+  const int32_t used = run_rate_loop(fb, consume_q14, 60000, false);
+  const int32_t setp = (int32_t)kCapacity / 2;
+  zassert_true(used > setp - 4 && used < setp + 4, "ring not held at the set point: %d", used);
+  zassert_true(abs((int32_t)fb.rate() - (int32_t)consume_q14) <= 4, "rate estimate %u, device %d", (unsigned)fb.rate(), (int)consume_q14);
+}
+
+ZTEST(rate_feedback, test_stamps_measure_rate) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  const int64_t consume_q14 = ((int64_t)kSamplesPerSof << 14) - 66; /* -500 ppm */
+
+  /* Stamps alone settle the rate within a second, before the fill moves. */
+  (void)run_rate_loop(fb, consume_q14, 1000, true);
+  zassert_true(abs((int32_t)fb.rate() - (int32_t)consume_q14) <= 2, "rate estimate %u, device %d", (unsigned)fb.rate(), (int)consume_q14);
+}
+
+ZTEST(rate_feedback, test_stamp_gap_ignored) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  const uint32_t step_q8 = (uint32_t)kSamplesPerSof << 8;
+  uint32_t pos = 0xFFFFF000U; /* crosses the uint32 wrap below */
+
+  for (int i = 0; i < 100; i++) {
+    fb.stamp(pos);
+    pos += step_q8;
+  }
+  zassert_equal(fb.rate(), kNominal, "nominal stamps must give nominal, got %u", (unsigned)fb.rate());
+
+  /* Missed SOFs (or a restarted DAC) re-anchor instead of reading as a rate. */
+  pos += 20 * step_q8;
+  fb.stamp(pos);
+  pos = 0;
+  fb.stamp(pos);
+  zassert_equal(fb.rate(), kNominal, "gap must not move the rate, got %u", (unsigned)fb.rate());
+}
+
+ZTEST(rate_feedback, test_clamped) {
+  usb_audio::RateFeedback fb;
+  fb.init(kSamplesPerSof);
+  fb.update(kCapacity / 2, kCapacity);
+  for (int i = 0; i < 100000; i++) {
+    fb.update(0, kCapacity); /* ring empty whatever is reported */
+    zassert_true(fb.value() <= kNominal + (1u << 13), "value %u above the clamp", (unsigned)fb.value());
+  }
+  zassert_true(fb.rate() <= kNominal + (1u << 13), "rate %u above the clamp", (unsigned)fb.rate());
+  zassert_true(fb.value() >= kNominal + (1u << 13) - 16, "value %u should sit at the upper clamp", (unsigned)fb.value());
+}
+
+ZTEST(rate_feedback, test_controller_switch_is_bumpless) {
+  usb_audio::FeedbackController fc;
+  fc.init(kSamplesPerSof, usb_audio::FeedbackMode::Pi);
+  for (int i = 0; i < 200; i++) {
+    fc.update(kCapacity / 2 - 8, kCapacity); /* emptier than the set point */
+  }
+  const uint32_t pi_value = fc.value();
+  zassert_true(pi_value > kNominal, "PI should raise the value, got %u", (unsigned)pi_value);
+
+  fc.set_mode(usb_audio::FeedbackMode::Rate);
+  zassert_equal(fc.mode(), usb_audio::FeedbackMode::Rate, "mode not switched");
+  zassert_equal(fc.value(), pi_value, "switch must carry the value over, got %u", (unsigned)fc.value());
+  zassert_equal(fc.rate(), pi_value, "no stamps: the value seeds the rate, got %u", (unsigned)fc.rate());
+  fc.update(kCapacity / 2, kCapacity); /* anchors the fill at the set point */
+  zassert_true(abs((int32_t)fc.value() - (int32_t)pi_value) <= 16, "rate step jumped from %u to %u", (unsigned)pi_value, (unsigned)fc.value());
+
+  /* And back: the PI integrator picks up the rate estimator's value. */
+  const uint32_t rate_value = fc.value();
+  fc.set_mode(usb_audio::FeedbackMode::Pi);
+  zassert_equal(fc.value(), rate_value, "switch back must carry the value over, got %u", (unsigned)fc.value());
+  fc.update(kCapacity / 2, kCapacity);
+  zassert_true(abs((int32_t)fc.value() - (int32_t)rate_value) <= 16, "PI step jumped from %u to %u", (unsigned)rate_value, (unsigned)fc.value());
+}
+
 ZTEST_SUITE(adc_pcm, NULL, NULL, NULL, NULL, NULL);
 
 ZTEST(adc_pcm, test_midpoint_is_zero) {
@@ -127,6 +262,133 @@ ZTEST(adc_pcm, test_16bit_is_identity_offset) {
   zassert_equal(adc_to_pcm16(65535, 16), 32767, "got %d", adc_to_pcm16(65535, 16));
 }
 
+ZTEST_SUITE(adc_scan, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(adc_scan, test_split_deinterleaves_ranks) {
+  /* Three ranks: audio, then two auxiliary channels summed per frame. */
+  const uint16_t src[] = {2048, 100, 1000, 0, 101, 1001, 4095, 102, 1002, 1024, 103, 1003};
+  int16_t pcm[4];
+  struct adc_scan_aux aux = {};
+  adc_scan_split(src, 4, 3, 12, pcm, &aux);
+  for (size_t i = 0; i < 4; i++) {
+    zassert_equal(pcm[i], adc_to_pcm16(src[3 * i], 12), "frame %u: got %d", (unsigned)i, pcm[i]);
+  }
+  zassert_equal(aux.sum[0], 406U, "aux0 sum %u", aux.sum[0]);
+  zassert_equal(aux.sum[1], 4006U, "aux1 sum %u", aux.sum[1]);
+  zassert_equal(aux.count, 4U, "count %u", aux.count);
+}
+
+ZTEST(adc_scan, test_single_rank_leaves_aux_alone) {
+  const uint16_t src[] = {0, 2048, 4095};
+  int16_t pcm[3];
+  struct adc_scan_aux aux = {};
+  adc_scan_split(src, 3, 1, 12, pcm, &aux);
+  zassert_equal(pcm[1], 0, "got %d", pcm[1]);
+  zassert_equal(aux.count, 0U, "count %u", aux.count);
+}
+
+ZTEST(adc_scan, test_take_averages_per_period) {
+  /* Readings alternating 100/101 average to 100.5 = 1608 in Q4. */
+  uint16_t src[2 * 8];
+  for (size_t i = 0; i < 8; i++) {
+    src[2 * i] = 2048;
+    src[2 * i + 1] = static_cast<uint16_t>(100 + (i & 1U));
+  }
+  int16_t pcm[8];
+  struct adc_scan_aux aux = {};
+  uint32_t avg_q4[ADC_SCAN_AUX_MAX] = {};
+  adc_scan_split(src, 4, 2, 12, pcm, &aux);
+  zassert_false(adc_scan_take(&aux, 1, 8, avg_q4), "published before the period");
+  adc_scan_split(&src[8], 4, 2, 12, pcm, &aux);
+  zassert_true(adc_scan_take(&aux, 1, 8, avg_q4), "not published after the period");
+  zassert_equal(avg_q4[0], 1608U, "avg_q4 %u", avg_q4[0]);
+  zassert_equal(aux.count, 0U, "sums not restarted");
+  zassert_equal(aux.sum[0], 0U, "sums not restarted");
+}
+
+ZTEST(adc_scan, test_vdda_from_vrefint) {
+  /* VREFINT_CAL of 1.212 V at 3.0 V, 14 bits; read at 12 bits with VDDA 3.3 V. */
+  const uint32_t vdda = adc_scan_vdda_mv(1504U * 16U, 12, 6619, 14, 3000);
+  zassert_within(vdda, 3300U, 3U, "vdda %u mV", vdda);
+  zassert_equal(adc_scan_vdda_mv(0, 12, 6619, 14, 3000), 0U, "zero reading must not divide");
+}
+
+ZTEST(adc_scan, test_mv_scales_to_vdda) {
+  zassert_equal(adc_scan_mv(4095U * 16U, 12, 3300), 3300U, "full scale");
+  zassert_equal(adc_scan_mv(2048U * 16U, 12, 3300), 1650U, "mid scale");
+  zassert_equal(adc_scan_mv(0, 12, 3300), 0U, "zero");
+}
+
+ZTEST(adc_scan, test_temperature_interpolates_calibration) {
+  const struct adc_scan_ts_cal cal = {1000, 1400, 30, 130, 14, 3000};
+  /* Same VDDA and resolution as the calibration: the points themselves. */
+  zassert_equal(adc_scan_temp_dc(1000U * 16U, 14, 3000, &cal), 300, "cal1");
+  zassert_equal(adc_scan_temp_dc(1400U * 16U, 14, 3000, &cal), 1300, "cal2");
+  /* Halfway, read at 12 bits: 1200 >> 2 = 300 counts. */
+  zassert_equal(adc_scan_temp_dc(300U * 16U, 12, 3000, &cal), 800, "mid");
+  /* Below cal1 extrapolates (rounded to nearest). */
+  zassert_equal(adc_scan_temp_dc(996U * 16U, 14, 3000, &cal), 290, "below");
+  /* A higher VDDA reads lower for the same sensor voltage. */
+  zassert_equal(adc_scan_temp_dc(909U * 16U + 1U, 14, 3300, &cal), 300, "vdda compensation");
+}
+
+ZTEST_SUITE(sync_start, NULL, NULL, NULL, NULL, NULL);
+
+/* Records the hardware steps in order; each step fails if told to. */
+struct SyncFake {
+  char log[8];
+  size_t n;
+  int fail_arm_in, fail_arm_out, fail_stop_in, fail_stop_out;
+};
+
+static int sync_step(void *ctx, char step, int ret) {
+  SyncFake *f = static_cast<SyncFake *>(ctx);
+  f->log[f->n++] = step;
+  return ret;
+}
+
+static const struct sync_start_ops kSyncFakeOps = {
+    [](void *c) { return sync_step(c, 'I', static_cast<SyncFake *>(c)->fail_arm_in); },
+    [](void *c) { return sync_step(c, 'O', static_cast<SyncFake *>(c)->fail_arm_out); },
+    [](void *c) { (void)sync_step(c, 'R', 0); },
+    [](void *c) { return sync_step(c, 'i', static_cast<SyncFake *>(c)->fail_stop_in); },
+    [](void *c) { return sync_step(c, 'o', static_cast<SyncFake *>(c)->fail_stop_out); },
+};
+
+ZTEST(sync_start, test_arms_both_then_runs_the_timer) {
+  SyncFake f = {};
+  zassert_equal(sync_start(&kSyncFakeOps, &f), 0);
+  zassert_equal(f.n, 3U);
+  zassert_mem_equal(f.log, "IOR", 3, "capture, playback, then the shared timer");
+}
+
+ZTEST(sync_start, test_capture_failure_starts_nothing) {
+  SyncFake f = {};
+  f.fail_arm_in = -EIO;
+  zassert_equal(sync_start(&kSyncFakeOps, &f), -EIO);
+  zassert_equal(f.n, 1U, "no playback, no timer after a failed capture");
+}
+
+ZTEST(sync_start, test_playback_failure_stops_capture) {
+  SyncFake f = {};
+  f.fail_arm_out = -EBUSY;
+  zassert_equal(sync_start(&kSyncFakeOps, &f), -EBUSY, "the playback error is reported");
+  zassert_equal(f.n, 3U);
+  zassert_mem_equal(f.log, "IOi", 3, "capture rolled back, timer never run");
+}
+
+ZTEST(sync_start, test_stop_capture_first_and_always_both) {
+  SyncFake f = {};
+  zassert_equal(sync_stop(&kSyncFakeOps, &f), 0);
+  zassert_mem_equal(f.log, "io", 2, "capture (and the timer) stops first");
+
+  f = {};
+  f.fail_stop_in = -EALREADY;
+  f.fail_stop_out = -EIO;
+  zassert_equal(sync_stop(&kSyncFakeOps, &f), -EALREADY, "first error wins");
+  zassert_equal(f.n, 2U, "playback stopped even after a capture error");
+}
+
 ZTEST_SUITE(dac_pcm, NULL, NULL, NULL, NULL, NULL);
 
 ZTEST(dac_pcm, test_midpoint_is_dac_midscale) {
@@ -148,3 +410,1782 @@ ZTEST(dac_pcm, test_roundtrip_with_adc) {
     zassert_equal(pcm16_to_dac(pcm, 12), code, "code %u -> pcm %d -> %u", code, pcm, pcm16_to_dac(pcm, 12));
   }
 }
+
+ZTEST_SUITE(emphasis, NULL, NULL, NULL, NULL, NULL);
+
+static constexpr size_t kEmphBlock = 8;   /* analog-audio block-samples */
+static constexpr size_t kEmphLen = 8000;  /* 1 s at 8 kHz */
+static constexpr int32_t kEmphAmp = 8000; /* ~-12 dBFS: headroom for +9.4 dB HF */
+static int16_t emph_in[kEmphLen];
+static int16_t emph_buf[kEmphLen];
+
+static void emph_sine(double hz) {
+  for (size_t i = 0; i < kEmphLen; i++) {
+    emph_in[i] = (int16_t)lround(kEmphAmp * sin(2.0 * M_PI * hz * (double)i / 8000.0));
+  }
+}
+
+static void emph_run(audio::Emphasis &f, int16_t *buf, bool enabled) {
+  for (size_t i = 0; i < kEmphLen; i += kEmphBlock) {
+    f.process(&buf[i], kEmphBlock, enabled);
+  }
+}
+
+/* Peak over the second half (filter settled). */
+static int32_t emph_peak(const int16_t *buf) {
+  int32_t peak = 0;
+  for (size_t i = kEmphLen / 2; i < kEmphLen; i++) {
+    peak = abs(buf[i]) > peak ? abs(buf[i]) : peak;
+  }
+  return peak;
+}
+
+ZTEST(emphasis, test_unity_gain_at_1khz) {
+  audio::Emphasis pre(audio::Emphasis::Mode::kPre);
+  audio::Emphasis de(audio::Emphasis::Mode::kDe);
+  emph_sine(1000.0);
+
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(pre, emph_buf, true);
+  zassert_within(emph_peak(emph_buf), kEmphAmp, kEmphAmp / 16, "pre @1k: peak %d", emph_peak(emph_buf));
+
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(de, emph_buf, true);
+  zassert_within(emph_peak(emph_buf), kEmphAmp, kEmphAmp / 16, "de @1k: peak %d", emph_peak(emph_buf));
+}
+
+ZTEST(emphasis, test_slope) {
+  /* 300 Hz vs 3 kHz spans ~17 dB on the pre-emphasis curve. */
+  audio::Emphasis lo(audio::Emphasis::Mode::kPre);
+  audio::Emphasis hi(audio::Emphasis::Mode::kPre);
+
+  emph_sine(300.0);
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(lo, emph_buf, true);
+  int32_t p_lo = emph_peak(emph_buf);
+
+  emph_sine(3000.0);
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(hi, emph_buf, true);
+  int32_t p_hi = emph_peak(emph_buf);
+
+  zassert_true(p_hi > 6 * p_lo && p_hi < 8 * p_lo, "3k/300 ratio off: %d / %d", p_hi, p_lo);
+}
+
+ZTEST(emphasis, test_pre_de_round_trip_is_flat) {
+  audio::Emphasis pre(audio::Emphasis::Mode::kPre, true);
+  audio::Emphasis de(audio::Emphasis::Mode::kDe, true);
+  for (size_t i = 0; i < kEmphLen; i++) {
+    emph_in[i] = (int16_t)lround(4000 * sin(2.0 * M_PI * 440.0 * i / 8000.0) + 3000 * sin(2.0 * M_PI * 2200.0 * i / 8000.0));
+  }
+
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(pre, emph_buf, true);
+  emph_run(de, emph_buf, true);
+  for (size_t i = 0; i < kEmphLen; i++) {
+    zassert_within(emph_buf[i], emph_in[i], 4, "sample %u: %d vs %d", (unsigned)i, emph_buf[i], emph_in[i]);
+  }
+}
+
+ZTEST(emphasis, test_disabled_is_bit_exact) {
+  audio::Emphasis pre(audio::Emphasis::Mode::kPre);
+  emph_sine(1234.0);
+
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+  emph_run(pre, emph_buf, false);
+  zassert_mem_equal(emph_buf, emph_in, sizeof(emph_buf), "bypass must not touch samples");
+}
+
+ZTEST(emphasis, test_switch_is_click_free) {
+  /* Toggle every 100 ms on a 1 kHz tone (unity gain, only a phase shift): the
+   * crossfade keeps every sample-to-sample step within the tone's own slope. */
+  audio::Emphasis pre(audio::Emphasis::Mode::kPre);
+  emph_sine(1000.0);
+  memcpy(emph_buf, emph_in, sizeof(emph_buf));
+
+  for (size_t i = 0; i < kEmphLen; i += kEmphBlock) {
+    pre.process(&emph_buf[i], kEmphBlock, (i / 800) % 2 == 1);
+  }
+  zassert_true(pre.enabled(), "must end in the last requested state (on)");
+
+  const int32_t max_step = (int32_t)(kEmphAmp * 2.0 * sin(M_PI * 1000.0 / 8000.0) * 1.1);
+  for (size_t i = 1; i < kEmphLen; i++) {
+    zassert_true(abs(emph_buf[i] - emph_buf[i - 1]) <= max_step, "step %d at %u", emph_buf[i] - emph_buf[i - 1], (unsigned)i);
+  }
+}
+
+ZTEST_SUITE(pcm_convert, NULL, NULL, NULL, NULL, NULL);
+
+static const int16_t kPcmRamp[] = {0, 1, -1, 255, -256, 12345, -12345, 32767, -32768};
+static constexpr size_t kPcmRampLen = sizeof(kPcmRamp) / sizeof(kPcmRamp[0]);
+
+static int16_t narrow_s32(int32_t v) {
+  int16_t out;
+  audio::pcm::narrow(reinterpret_cast<const uint8_t *>(&v), &out, 1, audio::pcm::Encoding::kS32, NULL);
+  return out;
+}
+
+static int16_t narrow_f32(float v) {
+  int16_t out;
+  audio::pcm::narrow(reinterpret_cast<const uint8_t *>(&v), &out, 1, audio::pcm::Encoding::kF32, NULL);
+  return out;
+}
+
+ZTEST(pcm_convert, test_widen_narrow_round_trip) {
+  const audio::pcm::Encoding encodings[] = {audio::pcm::Encoding::kS16, audio::pcm::Encoding::kS24, audio::pcm::Encoding::kS32,
+                                            audio::pcm::Encoding::kF32};
+  for (audio::pcm::Encoding enc : encodings) {
+    uint8_t wire[kPcmRampLen * 4];
+    int16_t back[kPcmRampLen];
+    audio::pcm::widen(kPcmRamp, wire, kPcmRampLen, enc);
+    audio::pcm::narrow(wire, back, kPcmRampLen, enc, NULL);
+    zassert_mem_equal(back, kPcmRamp, sizeof(kPcmRamp), "encoding %d", (int)enc);
+  }
+  /* MSB-aligned: s24 sample 0x123400 packed little-endian. */
+  const int16_t x = 0x1234;
+  uint8_t s24[3];
+  audio::pcm::widen(&x, s24, 1, audio::pcm::Encoding::kS24);
+  zassert_true(s24[0] == 0x00 && s24[1] == 0x34 && s24[2] == 0x12);
+}
+
+ZTEST(pcm_convert, test_narrow_rounds_and_saturates) {
+  zassert_equal(narrow_s32(0x00007FFF), 0);
+  zassert_equal(narrow_s32(0x00008000), 1); /* half up */
+  zassert_equal(narrow_s32(-0x00008000), 0);
+  zassert_equal(narrow_s32(-0x00008001), -1);
+  zassert_equal(narrow_s32(INT32_MAX), 32767); /* rounds past full scale */
+  zassert_equal(narrow_s32(INT32_MIN), -32768);
+  zassert_equal(narrow_f32(0.5F), 16384);
+  zassert_equal(narrow_f32(1.0F), 32767);
+  zassert_equal(narrow_f32(-1.0F), -32768);
+  zassert_equal(narrow_f32(4.0F), 32767);
+  zassert_equal(narrow_f32(-4.0F), -32768);
+  zassert_equal(narrow_f32(NAN), 32767);
+}
+
+ZTEST(pcm_convert, test_dither_is_unbiased_within_one_lsb) {
+  /* 100.25 LSB in s32: rounding alone always gives 100; dither spreads it
+   * over 99..101 with the exact value as mean. */
+  static int32_t in[4096];
+  static int16_t out[4096];
+  for (size_t i = 0; i < 4096; i++) {
+    in[i] = (100 << 16) + (1 << 14);
+  }
+  audio::pcm::Dither dither;
+  dither.enabled = true;
+  audio::pcm::narrow(reinterpret_cast<const uint8_t *>(in), out, 4096, audio::pcm::Encoding::kS32, &dither);
+  int32_t sum = 0;
+  for (size_t i = 0; i < 4096; i++) {
+    zassert_true(out[i] >= 99 && out[i] <= 101, "sample %d", out[i]);
+    sum += out[i];
+  }
+  const double mean = (double)sum / 4096.0;
+  zassert_true(fabs(mean - 100.25) < 0.05, "mean %f", mean);
+}
+
+ZTEST(pcm_convert, test_interleave_round_trip_odd_length) {
+  const int16_t left[5] = {1, 2, 3, 4, 5};
+  const int16_t right[5] = {-1, -2, -3, -4, -5};
+  int16_t frames[10];
+  int16_t l[5], r[5];
+  audio::pcm::interleave(left, right, frames, 5);
+  const int16_t expected[10] = {1, -1, 2, -2, 3, -3, 4, -4, 5, -5};
+  zassert_mem_equal(frames, expected, sizeof(expected));
+  audio::pcm::deinterleave(frames, l, r, 5);
+  zassert_mem_equal(l, left, sizeof(left));
+  zassert_mem_equal(r, right, sizeof(right));
+}
+
+ZTEST(pcm_convert, test_downmix_and_duplicate) {
+  int16_t frames[8] = {100, 200, 1, 2, -1, -2, 32767, 32767};
+  audio::pcm::downmix(frames, frames, 4); /* in place */
+  zassert_equal(frames[0], 150);
+  zassert_equal(frames[1], 2);  /* 1.5 rounds up */
+  zassert_equal(frames[2], -1); /* -1.5 rounds up */
+  zassert_equal(frames[3], 32767);
+  int16_t stereo[6];
+  const int16_t mono[3] = {7, -8, 32767};
+  audio::pcm::duplicate(mono, stereo, 3);
+  const int16_t expected[6] = {7, 7, -8, -8, 32767, 32767};
+  zassert_mem_equal(stereo, expected, sizeof(expected));
+}
+
+ZTEST(pcm_convert, test_gain_rounds_and_saturates) {
+  int16_t block[6] = {1000, -1000, 3, -3, 20000, -20000};
+  const int16_t unity[6] = {1000, -1000, 3, -3, 20000, -20000};
+  audio::pcm::apply_gain(block, 6, audio::pcm::kGainUnity);
+  zassert_mem_equal(block, unity, sizeof(unity));
+  audio::pcm::apply_gain(block, 6, audio::pcm::kGainUnity / 2); /* -6 dB */
+  const int16_t half[6] = {500, -500, 2, -1, 10000, -10000};    /* 1.5 -> 2, -1.5 -> -1 */
+  zassert_mem_equal(block, half, sizeof(half));
+  audio::pcm::apply_gain(block, 6, 4 * audio::pcm::kGainUnity); /* +12 dB */
+  const int16_t loud[6] = {2000, -2000, 8, -4, 32767, -32768};
+  zassert_mem_equal(block, loud, sizeof(loud));
+}
+
+ZTEST(pcm_convert, test_stereo_wire_round_trip) {
+  /* Longer than the internal chunk; s24 stereo as a 24-bit host would send. */
+  static int16_t mono[100];
+  static int16_t back[100];
+  static uint8_t wire[100 * 6];
+  for (size_t i = 0; i < 100; i++) {
+    mono[i] = (int16_t)(i * 653U);
+  }
+  audio::pcm::Format fmt;
+  zassert_true(audio::pcm::format_from(24, false, 2, &fmt));
+  zassert_equal(audio::pcm::frame_bytes(fmt), 6U);
+  audio::pcm::to_wire(mono, wire, 100, fmt);
+  audio::pcm::from_wire(wire, back, 100, fmt, NULL);
+  zassert_mem_equal(back, mono, sizeof(mono));
+  zassert_false(audio::pcm::format_from(24, true, 2, &fmt));
+  zassert_false(audio::pcm::format_from(16, false, 3, &fmt));
+}
+
+ZTEST(pcm_convert, test_wire_pair_keeps_both_planes) {
+  /* Processed + raw RX planes, longer than the internal chunk. */
+  static int16_t left[70], right[70], l[70], r[70];
+  static int16_t stereo[140];
+  static uint8_t wire[70 * 8];
+  for (size_t i = 0; i < 70; i++) {
+    left[i] = (int16_t)(i * 461U);
+    right[i] = (int16_t)(-(int)i * 17);
+  }
+  const audio::pcm::Encoding encodings[] = {audio::pcm::Encoding::kS16, audio::pcm::Encoding::kS24, audio::pcm::Encoding::kS32,
+                                            audio::pcm::Encoding::kF32};
+  for (audio::pcm::Encoding enc : encodings) {
+    audio::pcm::to_wire_pair(left, right, wire, 70, enc);
+    audio::pcm::narrow(wire, stereo, 140, enc, NULL);
+    audio::pcm::deinterleave(stereo, l, r, 70);
+    zassert_mem_equal(l, left, sizeof(left), "encoding %d", (int)enc);
+    zassert_mem_equal(r, right, sizeof(right), "encoding %d", (int)enc);
+  }
+}
+
+ZTEST_SUITE(callback_swap, NULL, NULL, NULL, NULL, NULL);
+
+struct swap_cbs {
+  int id;
+};
+
+using TestSwap = audio::CallbackSwap<swap_cbs, 2>;
+
+ZTEST(callback_swap, test_idle_publish_never_waits) {
+  TestSwap sw;
+  int waits = 0;
+  sw.publish({1}, [&] { waits++; });
+  zassert_equal(sw.acquire(0).id, 1, "reader sees the published set");
+  sw.release(0);
+  sw.publish({2}, [&] { waits++; });
+  zassert_equal(sw.acquire(1).id, 2, "second publish visible");
+  sw.release(1);
+  zassert_equal(waits, 0, "no reader was pinned, publish must not wait");
+}
+
+ZTEST(callback_swap, test_publish_waits_for_pinned_old_set) {
+  TestSwap sw;
+  sw.publish({1}, [] {});
+  const swap_cbs &old = sw.acquire(0); /* block in flight on set 1 */
+  int waits = 0;
+  sw.publish({2}, [&] {
+    /* Still inside the old block: the old set must stay intact. */
+    zassert_equal(old.id, 1, "old set overwritten under its reader");
+    if (++waits == 3) {
+      sw.release(0); /* block ends */
+    }
+  });
+  zassert_equal(waits, 3, "publish returned before the old block ended");
+  zassert_equal(sw.acquire(0).id, 2, "next block must use the new set");
+  sw.release(0);
+}
+
+ZTEST(callback_swap, test_reader_on_new_set_does_not_block) {
+  TestSwap sw;
+  sw.publish({1}, [] {});
+  (void)sw.acquire(0);
+  int waits = 0;
+  sw.publish({2}, [&] {
+    waits++;
+    /* The other backend starts a block meanwhile: it gets the new set and
+     * stays pinned, which must not hold the writer. */
+    zassert_equal(sw.acquire(1).id, 2, "late reader must see the new set");
+    sw.release(0);
+  });
+  zassert_equal(waits, 1, "writer waited on a reader of the new set");
+  sw.release(1);
+  zassert_equal(sw.current().id, 2, "writer view");
+}
+
+ZTEST_SUITE(event_ring, NULL, NULL, NULL, NULL, NULL);
+
+struct ring_evt {
+  uint8_t type;
+  int32_t value;
+};
+
+/* Must not need a constructor: drivers publish before C++ static init. */
+constinit static events::EventRing<ring_evt, 4> g_static_ring;
+
+ZTEST(event_ring, test_fifo_until_full) {
+  events::EventRing<ring_evt, 4> ring;
+  ring_evt e{};
+  zassert_false(ring.pop(e), "new ring must be empty");
+  for (int32_t i = 0; i < 4; i++) {
+    zassert_true(ring.push({1, i}), "push %d into a non-full ring", i);
+  }
+  zassert_false(ring.push({1, 99}), "fifth push must report full");
+  for (int32_t i = 0; i < 4; i++) {
+    zassert_true(ring.pop(e), "pop %d", i);
+    zassert_equal(e.value, i, "FIFO order: expected %d, got %d", i, e.value);
+  }
+  zassert_false(ring.pop(e), "drained ring must be empty");
+}
+
+ZTEST(event_ring, test_many_laps_keep_order) {
+  events::EventRing<ring_evt, 4> ring;
+  int32_t next_in = 0;
+  int32_t next_out = 0;
+  ring_evt e{};
+  /* Producer runs ahead by up to three, like bursts between bus-thread runs. */
+  for (int lap = 0; lap < 1000; lap++) {
+    const int burst = 1 + lap % 3;
+    for (int i = 0; i < burst; i++) {
+      zassert_true(ring.push({2, next_in}), "push at lap %d", lap);
+      next_in++;
+    }
+    while (ring.pop(e)) {
+      zassert_equal(e.value, next_out, "lap %d: expected %d, got %d", lap, next_out, e.value);
+      next_out++;
+    }
+  }
+  zassert_equal(next_in, next_out, "every event delivered once");
+}
+
+ZTEST(event_ring, test_static_instance_usable_without_constructor) {
+  ring_evt e{};
+  zassert_true(g_static_ring.push({3, 7}), "zero-initialized ring must accept a push");
+  zassert_true(g_static_ring.pop(e), "and deliver it");
+  zassert_equal(e.type, 3, "type");
+  zassert_equal(e.value, 7, "value");
+  zassert_false(g_static_ring.pop(e), "then be empty");
+}
+
+ZTEST_SUITE(dcs, NULL, NULL, NULL, NULL, NULL);
+
+static constexpr size_t kDcsBlock = 8;
+static constexpr size_t kDcsLen = 12000; /* 1.5 s: ~8.7 codeword periods */
+static int16_t dcs_buf[kDcsLen];
+
+static uint32_t dcs_rng = 1;
+static int32_t dcs_noise(int32_t amp) {
+  dcs_rng = dcs_rng * 1664525U + 1013904223U;
+  return (int32_t)((dcs_rng >> 16) % (uint32_t)(2 * amp + 1)) - amp;
+}
+
+/* NRZ codeword stream (bit 0 first) at 134.4 bit/s off by @p ppm, band-limited
+ * like the radio's audio path, under voice, noise and a DC offset. */
+static void dcs_synth(uint32_t word, bool inverted, double ppm, int32_t voice, int32_t noise) {
+  const double step = dcs::kBitRateMilli / 1000.0 * (1.0 + ppm * 1e-6) / 8000.0;
+  double phase = 0.0;
+  double lp = 0.0;
+  int bit = 0;
+  for (size_t i = 0; i < kDcsLen; i++) {
+    const bool b = (((word >> bit) & 1U) != 0) != inverted;
+    lp += ((b ? 1.0 : -1.0) - lp) * 0.2;
+    const double v = voice * (sin(2.0 * M_PI * 440.0 * i / 8000.0) + 0.5 * sin(2.0 * M_PI * 1100.0 * i / 8000.0));
+    dcs_buf[i] = (int16_t)lround(1500.0 * lp + v + dcs_noise(noise) + 300.0);
+    phase += step;
+    if (phase >= 1.0) {
+      phase -= 1.0;
+      bit = (bit + 1) % dcs::kWordBits;
+    }
+  }
+}
+
+static void dcs_run(dcs::Decoder &d) {
+  for (size_t i = 0; i < kDcsLen; i += kDcsBlock) {
+    d.feed(&dcs_buf[i], kDcsBlock);
+  }
+}
+
+ZTEST(dcs, test_codewords_are_golay) {
+  /* Golay (23,12) has minimum distance 7; the decoder's 2-bit correction plus
+   * a safety margin relies on it. */
+  for (size_t i = 0; i < dcs::kCodeCount; i++) {
+    const uint32_t a = dcs::encode(dcs::code_at(i));
+    zassert_equal(a & 0x1FFU, dcs::code_at(i), "code bits of %03o", dcs::code_at(i));
+    zassert_equal((a >> 9) & 7U, 4U, "marker of %03o", dcs::code_at(i));
+    for (size_t j = i + 1; j < dcs::kCodeCount; j++) {
+      const int dist = __builtin_popcount(a ^ dcs::encode(dcs::code_at(j)));
+      zassert_true(dist >= 7, "%03o vs %03o: distance %d", dcs::code_at(i), dcs::code_at(j), dist);
+    }
+  }
+}
+
+ZTEST(dcs, test_decodes_every_normal_code) {
+  for (size_t i = 0; i < dcs::kCodeCount; i++) {
+    dcs::Decoder d;
+    dcs_synth(dcs::encode(dcs::code_at(i)), false, (i % 2) ? 200.0 : -200.0, 6000, 2000);
+    dcs_run(d);
+    const dcs::Detection &det = d.detection();
+    zassert_true(det.locked, "%03oN not locked", dcs::code_at(i));
+    zassert_equal(det.code, dcs::code_at(i), "%03oN decoded as %03o", dcs::code_at(i), det.code);
+    zassert_false(det.inverted, "%03oN decoded as inverted", dcs::code_at(i));
+  }
+}
+
+ZTEST(dcs, test_decodes_every_inverted_code) {
+  /* An inverted code is either reported as such, or -- when its complement is
+   * another code's rotation -- as that normal code with this one as its alias. */
+  for (size_t i = 0; i < dcs::kCodeCount; i++) {
+    dcs::Decoder d;
+    dcs_synth(dcs::encode(dcs::code_at(i)), true, 100.0, 6000, 2000);
+    dcs_run(d);
+    const dcs::Detection &det = d.detection();
+    zassert_true(det.locked, "%03oI not locked", dcs::code_at(i));
+    if (det.inverted) {
+      zassert_equal(det.code, dcs::code_at(i), "%03oI decoded as %03oI", dcs::code_at(i), det.code);
+    } else {
+      zassert_true(det.has_alias && det.alias_code == dcs::code_at(i), "%03oI decoded as %03oN", dcs::code_at(i), det.code);
+    }
+  }
+}
+
+ZTEST(dcs, test_drops_lock_without_code) {
+  dcs::Decoder d;
+  dcs_synth(dcs::encode(0023), false, 0.0, 3000, 1000);
+  dcs_run(d);
+  zassert_true(d.detection().locked, "023N not locked");
+
+  dcs_synth(0, false, 0.0, 3000, 1000); /* carrier still up, code gone (constant level) */
+  dcs_run(d);
+  zassert_false(d.detection().locked, "lock held without code");
+  zassert_equal(d.locks(), 1U, "unexpected relock");
+}
+
+ZTEST(dcs, test_voice_and_noise_never_lock) {
+  dcs::Decoder d;
+  for (int s = 0; s < 40; s++) { /* 60 s */
+    for (size_t i = 0; i < kDcsLen; i++) {
+      const size_t n = s * kDcsLen + i;
+      dcs_buf[i] = (int16_t)lround(3000.0 * sin(2.0 * M_PI * 440.0 * n / 8000.0) + dcs_noise(4000));
+    }
+    dcs_run(d);
+  }
+  zassert_equal(d.locks(), 0U, "false lock on voice + noise");
+}
+
+/* SOF clock trim: a device sampling timer whose tick clock runs @p ppm off the
+ * host's SOF clock, clocked for one 1 ms frame at a time with whatever period
+ * the controller last programmed. */
+struct TrimDevice {
+  uint64_t ticks_per_sof_q16; /* device timer ticks per host ms, Q16 */
+  uint64_t tick_q16 = 0;      /* ticks into the current sample, Q16 */
+  uint32_t samples = 0;
+  uint32_t period;
+
+  TrimDevice(uint32_t tim_hz, int32_t ppm, uint32_t period0)
+      : ticks_per_sof_q16((((uint64_t)tim_hz << 16) / 1000) * (uint64_t)(1000000 + ppm) / 1000000), period(period0) {}
+
+  uint32_t position() const { return (samples << 8) + (uint32_t)((tick_q16 << 8) / ((uint64_t)period << 16)); }
+
+  void run_sof() {
+    tick_q16 += ticks_per_sof_q16;
+    while (tick_q16 >= ((uint64_t)period << 16)) {
+      tick_q16 -= (uint64_t)period << 16;
+      samples++;
+    }
+  }
+};
+
+static constexpr uint32_t kTimHz = 160000000; /* fm_board TIM6/TIM7 kernel clock */
+
+/* Run @p sofs frames; return the summed programmed period. */
+static uint64_t trim_run(usb_audio::SofClockTrim &t, TrimDevice &d, int sofs) {
+  uint64_t sum = 0;
+  for (int i = 0; i < sofs; i++) {
+    d.period = t.update(d.position());
+    sum += d.period;
+    d.run_sof();
+  }
+  return sum;
+}
+
+ZTEST_SUITE(clock_trim, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(clock_trim, test_nominal_period) {
+  usb_audio::SofClockTrim t;
+  t.init(kTimHz, 8000, 8, 1000);
+  zassert_equal(t.nominal_period(), 20000U, "8 kHz off 160 MHz is ARR 19999");
+  zassert_equal(t.period(), 20000U);
+  zassert_false(t.locked());
+}
+
+ZTEST(clock_trim, test_locks_to_drifting_device) {
+  static const int32_t ppms[] = {500, -500};
+  for (int32_t ppm : ppms) {
+    usb_audio::SofClockTrim t;
+    t.init(kTimHz, 8000, 8, 1000);
+    TrimDevice d(kTimHz, ppm, t.nominal_period());
+    trim_run(t, d, 30000); /* 30 s */
+
+    zassert_true(t.locked(), "not locked at %d ppm", ppm);
+    /* A device fast by ppm needs the clock slowed by ppm / (1 + ppm). */
+    const int32_t want = -ppm * 1000;
+    zassert_true(abs(t.trim_ppb() - want) < 5000, "%d ppm: trim %d ppb", ppm, t.trim_ppb());
+    zassert_true(abs(t.phase_error()) <= (1 << 8), "%d ppm: phase error %d/256", ppm, t.phase_error());
+    zassert_equal(t.slips(), 0U);
+  }
+}
+
+ZTEST(clock_trim, test_dither_averages_fractional_divider) {
+  /* 48 kHz off 160 MHz is 3333.33 ticks: no integer ARR gets it right. */
+  usb_audio::SofClockTrim t;
+  t.init(kTimHz, 48000, 48, 1000);
+  TrimDevice d(kTimHz, 0, t.nominal_period());
+  trim_run(t, d, 20000);
+  zassert_true(t.locked());
+
+  const int sofs = 3000;
+  uint32_t start = d.samples;
+  uint64_t sum = trim_run(t, d, sofs);
+  /* Mean period within 1/100 tick (3 ppm) of 160e6 / 48e3. */
+  const uint64_t mean_x100 = sum * 100 / sofs;
+  zassert_true(mean_x100 >= 333330 && mean_x100 <= 333336, "mean period %llu/100", (unsigned long long)mean_x100);
+  zassert_true(d.samples - start >= 48U * sofs - 2 && d.samples - start <= 48U * sofs + 2, "%u samples", d.samples - start);
+}
+
+ZTEST(clock_trim, test_slip_reanchors_and_keeps_drift) {
+  usb_audio::SofClockTrim t;
+  t.init(kTimHz, 8000, 8, 1000);
+  TrimDevice d(kTimHz, 300, t.nominal_period());
+  trim_run(t, d, 30000);
+  zassert_true(t.locked());
+  const int32_t before = t.trim_ppb();
+
+  d.samples += 1000; /* e.g. the stream stalled across a suspend */
+  trim_run(t, d, 1);
+  zassert_equal(t.slips(), 1U);
+  zassert_false(t.locked());
+  zassert_true(abs(t.trim_ppb() - before) < 20000, "drift estimate lost: %d -> %d", before, t.trim_ppb());
+
+  trim_run(t, d, 10000);
+  zassert_true(t.locked());
+  zassert_equal(t.slips(), 1U);
+}
+
+ZTEST(clock_trim, test_trim_clamped) {
+  usb_audio::SofClockTrim t;
+  t.init(kTimHz, 8000, 8, 1000);
+  TrimDevice d(kTimHz, 5000, t.nominal_period()); /* far outside the range */
+  trim_run(t, d, 20000);
+  zassert_true(abs(t.trim_ppb() + 1000000) < 1000, "trim %d ppb", t.trim_ppb());
+  zassert_false(t.locked());
+
+  t.reset();
+  zassert_equal(t.period(), t.nominal_period());
+  zassert_equal(t.trim_ppb(), 0);
+}
+
+/* ---- pipeline watchdog ---------------------------------------------------- */
+
+using Wdt = audio::PipelineWatchdog;
+
+static void wdt_init(Wdt &w, uint32_t max_restarts) {
+  const Wdt::Config cfg = {{8, 8, 8}, max_restarts};
+  w.init(cfg);
+}
+
+/* Beat every channel in @p mask once per ms from @p t for @p ms, polling each
+ * ms; return the first non-kNone action (kNone if there was none). */
+static Wdt::Action wdt_run(Wdt &w, uint32_t &t, uint32_t ms, uint8_t mask) {
+  for (uint32_t i = 0; i < ms; i++) {
+    t++;
+    for (uint8_t ch = 0; ch < Wdt::kChannels; ch++) {
+      if (mask & (1U << ch)) {
+        w.beat(static_cast<Wdt::Channel>(ch), t);
+      }
+    }
+    Wdt::Action a = w.poll(t);
+    if (a != Wdt::Action::kNone) {
+      return a;
+    }
+  }
+  return Wdt::Action::kNone;
+}
+
+ZTEST_SUITE(pipeline_watchdog, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(pipeline_watchdog, test_healthy_stream_never_stalls) {
+  Wdt w;
+  wdt_init(w, 3);
+  uint32_t t = 1000;
+  for (uint8_t ch = 0; ch < Wdt::kChannels; ch++) {
+    w.arm(static_cast<Wdt::Channel>(ch), true, t);
+  }
+  zassert_equal(w.armed_mask(), 0x7);
+  zassert_equal(wdt_run(w, t, 10000, 0x7), Wdt::Action::kNone);
+  zassert_equal(w.stalled_mask(), 0);
+  zassert_equal(w.stats().restarts, 0U);
+}
+
+ZTEST(pipeline_watchdog, test_disarmed_channel_never_stalls) {
+  Wdt w;
+  wdt_init(w, 3);
+  uint32_t t = 0;
+  w.arm(Wdt::kCapture, true, t);
+  w.arm(Wdt::kSof, true, t);
+  w.arm(Wdt::kSof, false, t); /* e.g. bus suspended */
+  zassert_equal(wdt_run(w, t, 1000, 1U << Wdt::kCapture), Wdt::Action::kNone);
+  zassert_equal(w.stats().stalls[Wdt::kSof], 0U);
+  zassert_equal(w.stats().stalls[Wdt::kPlayback], 0U);
+}
+
+ZTEST(pipeline_watchdog, test_stall_restarts_and_records_mttr) {
+  Wdt w;
+  wdt_init(w, 3);
+  uint32_t t = 0;
+  w.arm(Wdt::kCapture, true, t);
+  w.arm(Wdt::kPlayback, true, t);
+  zassert_equal(wdt_run(w, t, 100, 0x3), Wdt::Action::kNone);
+
+  /* Playback refill stops: detected once its 8 ms timeout has passed. */
+  const uint32_t stalled_at = t;
+  zassert_equal(wdt_run(w, t, 100, 1U << Wdt::kCapture), Wdt::Action::kRestart);
+  zassert_equal(t - stalled_at, 9U, "detected after %u ms", t - stalled_at);
+  zassert_equal(w.stalled_mask(), 1U << Wdt::kPlayback);
+  zassert_equal(w.stats().stalls[Wdt::kPlayback], 1U);
+  zassert_equal(w.stats().restarts, 1U);
+
+  /* The restart brings it back 3 ms later; recovery needs a beat on every
+   * armed channel after the restart. */
+  const uint32_t detected = t;
+  zassert_equal(wdt_run(w, t, 3, 1U << Wdt::kCapture), Wdt::Action::kNone);
+  zassert_equal(w.stats().recoveries, 0U);
+  zassert_equal(wdt_run(w, t, 1, 0x3), Wdt::Action::kNone);
+  zassert_equal(w.stats().recoveries, 1U);
+  zassert_equal(w.stats().mttr_last_ms, t - detected);
+  zassert_equal(w.stats().mttr_max_ms, 4U);
+  zassert_equal(w.stats().mttr_sum_ms, 4U);
+  zassert_equal(w.stalled_mask(), 0);
+
+  /* Healthy again: no further action. */
+  zassert_equal(wdt_run(w, t, 1000, 0x3), Wdt::Action::kNone);
+}
+
+ZTEST(pipeline_watchdog, test_escalates_to_reboot) {
+  Wdt w;
+  wdt_init(w, 2);
+  uint32_t t = 0;
+  w.arm(Wdt::kSof, true, t);
+  zassert_equal(wdt_run(w, t, 20, 0), Wdt::Action::kRestart);
+  zassert_equal(wdt_run(w, t, 20, 0), Wdt::Action::kRestart);
+  zassert_equal(wdt_run(w, t, 20, 0), Wdt::Action::kReboot);
+  zassert_equal(w.stats().restarts, 2U);
+  zassert_equal(w.stats().recoveries, 0U);
+  zassert_equal(w.stats().stalls[Wdt::kSof], 3U);
+}
+
+ZTEST(pipeline_watchdog, test_episode_resets_restart_budget) {
+  Wdt w;
+  wdt_init(w, 1);
+  uint32_t t = 0;
+  w.arm(Wdt::kCapture, true, t);
+  for (int episode = 0; episode < 3; episode++) {
+    zassert_equal(wdt_run(w, t, 20, 0), Wdt::Action::kRestart);
+    zassert_equal(wdt_run(w, t, 20, 1U << Wdt::kCapture), Wdt::Action::kNone);
+  }
+  zassert_equal(w.stats().recoveries, 3U);
+  zassert_equal(w.stats().restarts, 3U);
+}
+
+ZTEST(pipeline_watchdog, test_uptime_wrap) {
+  Wdt w;
+  wdt_init(w, 3);
+  uint32_t t = UINT32_MAX - 50;
+  w.arm(Wdt::kCapture, true, t);
+  zassert_equal(wdt_run(w, t, 100, 1U << Wdt::kCapture), Wdt::Action::kNone);
+  zassert_equal(wdt_run(w, t, 100, 0), Wdt::Action::kRestart);
+  zassert_true(t < 100, "did not wrap");
+  zassert_equal(wdt_run(w, t, 1, 1U << Wdt::kCapture), Wdt::Action::kNone);
+  zassert_equal(w.stats().recoveries, 1U);
+  zassert_equal(w.stats().mttr_last_ms, 1U);
+}
+
+/* ---- USB audio bridge statistics ------------------------------------------ */
+
+using Stats = usb_audio::BridgeStats;
+
+ZTEST_SUITE(bridge_stats, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(bridge_stats, test_traffic_overflow_underrun) {
+  static Stats st;
+  st.reset();
+  st.out_received(16, 16);
+  st.out_received(16, 6); /* ring full: 10 bytes dropped */
+  st.in_captured(16, 16);
+  st.in_captured(16, 0);
+  st.in_sent(18);
+  st.in_empty();
+  st.out_drained(16, 16);
+  st.out_drained(16, 4);
+  st.prebuffer_reset();
+
+  Stats::Snapshot s;
+  st.snapshot(&s);
+  zassert_equal(s.bytes[Stats::kOut], 32U);
+  zassert_equal(s.bytes[Stats::kIn], 18U);
+  zassert_equal(s.overflows[Stats::kOut], 1U);
+  zassert_equal(s.dropped[Stats::kOut], 10U);
+  zassert_equal(s.overflows[Stats::kIn], 1U);
+  zassert_equal(s.dropped[Stats::kIn], 16U);
+  zassert_equal(s.underruns[Stats::kOut], 1U);
+  zassert_equal(s.underruns[Stats::kIn], 1U);
+  zassert_equal(s.prebuffer_resets, 1U);
+}
+
+ZTEST(bridge_stats, test_send_errors_by_errno) {
+  static Stats st;
+  st.reset();
+  const int errs[] = {-11, -11, -12, -5, -19, -22, -11, -22};
+  for (int e : errs) {
+    st.in_send_failed(e);
+  }
+
+  Stats::Snapshot s;
+  st.snapshot(&s);
+  /* Slots in order of first occurrence; the fifth distinct errno is "other". */
+  zassert_equal(s.send_errors[0].err, -11);
+  zassert_equal(s.send_errors[0].count, 3U);
+  zassert_equal(s.send_errors[1].err, -12);
+  zassert_equal(s.send_errors[1].count, 1U);
+  zassert_equal(s.send_errors[2].err, -5);
+  zassert_equal(s.send_errors[3].err, -19);
+  zassert_equal(s.send_errors_other, 2U);
+}
+
+ZTEST(bridge_stats, test_fill_histogram) {
+  static Stats st;
+  st.reset();
+  st.fill(Stats::kOut, 0, 256);
+  st.fill(Stats::kOut, 31, 256);
+  st.fill(Stats::kOut, 128, 256);
+  st.fill(Stats::kOut, 255, 256);
+  st.fill(Stats::kOut, 256, 256); /* full ring lands in the top bin */
+  st.fill(Stats::kIn, 40, 256);
+
+  Stats::Snapshot s;
+  st.snapshot(&s);
+  zassert_equal(s.fill[Stats::kOut][0], 2U);
+  zassert_equal(s.fill[Stats::kOut][4], 1U);
+  zassert_equal(s.fill[Stats::kOut][Stats::kFillBins - 1], 2U);
+  zassert_equal(s.fill[Stats::kIn][1], 1U);
+  zassert_equal(s.fill[Stats::kIn][0], 0U);
+}
+
+ZTEST(bridge_stats, test_feedback_min_max_trace) {
+  static Stats st;
+  st.reset();
+  Stats::Snapshot s;
+  st.snapshot(&s);
+  zassert_equal(s.feedback_min, 0U, "no value yet");
+  zassert_equal(s.feedback_max, 0U);
+  zassert_equal(s.trace_len, 0U);
+
+  /* Value i at SOF i: every kTraceEvery-th one is traced, the ring keeps the
+   * last kTraceLen, oldest first. */
+  const uint32_t sofs = (Stats::kTraceLen + 3) * Stats::kTraceEvery;
+  for (uint32_t i = 0; i < sofs; i++) {
+    st.feedback(kNominal + (i % 7U) - 3U);
+  }
+  st.snapshot(&s);
+  zassert_equal(s.feedback_min, kNominal - 3U);
+  zassert_equal(s.feedback_max, kNominal + 3U);
+  zassert_equal(s.trace_len, Stats::kTraceLen);
+  for (uint32_t i = 0; i < Stats::kTraceLen; i++) {
+    const uint32_t sof = (i + 3) * Stats::kTraceEvery;
+    zassert_equal(s.trace[i], kNominal + (sof % 7U) - 3U, "trace[%u] = %u", i, s.trace[i]);
+  }
+
+  st.reset();
+  st.snapshot(&s);
+  zassert_equal(s.feedback_max, 0U);
+  zassert_equal(s.trace_len, 0U);
+  zassert_equal(s.bytes[Stats::kOut], 0U);
+}
+
+ZTEST_SUITE(ima_adpcm, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(ima_adpcm, test_tone_round_trip_snr) {
+  static int16_t pcm[800];
+  static uint8_t codes[audio::adpcmBytes(800)];
+  static int16_t out[800];
+  for (size_t i = 0; i < 800; i++) {
+    pcm[i] = static_cast<int16_t>(8000.0 * sin(2.0 * M_PI * 1000.0 * i / 8000.0));
+  }
+  audio::AdpcmState enc{};
+  audio::AdpcmState dec{};
+  audio::adpcmEncode(enc, pcm, 800, codes);
+  audio::adpcmDecode(dec, codes, 800, out);
+  zassert_equal(enc.predictor, dec.predictor, "encoder and decoder state diverged");
+  zassert_equal(enc.index, dec.index, "encoder and decoder step index diverged");
+
+  /* Skip the step-size ramp-up at the start. */
+  int64_t sig = 0;
+  int64_t err = 0;
+  for (size_t i = 80; i < 800; i++) {
+    const int32_t e = out[i] - pcm[i];
+    sig += static_cast<int64_t>(pcm[i]) * pcm[i];
+    err += static_cast<int64_t>(e) * e;
+  }
+  zassert_true(err > 0 && sig / err >= 100, "SNR below 20 dB (%lld/%lld)", (long long)sig, (long long)err);
+}
+
+ZTEST(ima_adpcm, test_frames_decode_independently_from_carried_state) {
+  int16_t pcm[40];
+  for (size_t i = 0; i < 40; i++) {
+    pcm[i] = static_cast<int16_t>((i * 1237) % 4000 - 2000);
+  }
+  /* One encoder run, cut into two frames; the second frame decodes from the
+   * state the encoder had at its start (what the frame header carries). */
+  audio::AdpcmState enc{};
+  uint8_t a[10];
+  uint8_t b[10];
+  audio::adpcmEncode(enc, pcm, 20, a);
+  const audio::AdpcmState at_b = enc;
+  audio::adpcmEncode(enc, &pcm[20], 20, b);
+
+  int16_t whole[40];
+  audio::AdpcmState dec{};
+  audio::adpcmDecode(dec, a, 20, whole);
+  audio::adpcmDecode(dec, b, 20, &whole[20]);
+
+  int16_t second[20];
+  audio::AdpcmState alone = at_b;
+  audio::adpcmDecode(alone, b, 20, second);
+  zassert_mem_equal(second, &whole[20], sizeof(second), "second frame must not depend on the first");
+}
+
+ZTEST(ima_adpcm, test_odd_count_pads_high_nibble) {
+  const int16_t pcm[5] = {1000, 2000, 3000, 2000, 1000};
+  uint8_t codes[3] = {0xFF, 0xFF, 0xFF};
+  audio::AdpcmState enc{};
+  audio::adpcmEncode(enc, pcm, 5, codes);
+  zassert_equal(codes[2] & 0xF0, 0, "trailing high nibble must be zero");
+
+  int16_t out[5];
+  audio::AdpcmState dec{};
+  audio::adpcmDecode(dec, codes, 5, out);
+  zassert_equal(enc.predictor, dec.predictor);
+  zassert_equal(enc.index, dec.index);
+}
+
+ZTEST_SUITE(link_frame, NULL, NULL, NULL, NULL, NULL);
+
+struct link_rx {
+  audio::LinkFrameHeader hdr[4];
+  uint8_t first_payload[4];
+  int count;
+};
+
+static size_t link_make(uint16_t seq, uint8_t fill, uint8_t *out, size_t cap) {
+  uint8_t payload[80];
+  memset(payload, fill, sizeof(payload));
+  audio::LinkFrameHeader hdr{};
+  hdr.flags = audio::LinkFrameHeader::kCos;
+  hdr.seq = seq;
+  hdr.timestamp = 160U * seq + 0x10000000U;
+  hdr.adpcm = {-1234, 42};
+  hdr.length = sizeof(payload);
+  return audio::linkFrameEncode(hdr, payload, out, cap);
+}
+
+static void link_feed(audio::LinkFrameParser &p, link_rx &rx, const uint8_t *data, size_t len, size_t piece) {
+  for (size_t off = 0; off < len; off += piece) {
+    const size_t n = len - off < piece ? len - off : piece;
+    p.feed(&data[off], n, [&rx](const audio::LinkFrameHeader &h, const uint8_t *payload) {
+      if (rx.count < 4) {
+        rx.hdr[rx.count] = h;
+        rx.first_payload[rx.count] = payload[0];
+      }
+      rx.count++;
+    });
+  }
+}
+
+ZTEST(link_frame, test_round_trip_any_split) {
+  uint8_t frame[audio::kLinkMaxFrameBytes];
+  const size_t len = link_make(7, 0x3C, frame, sizeof(frame));
+  zassert_equal(len, audio::kLinkHeaderBytes + 80 + audio::kLinkCrcBytes);
+
+  const size_t pieces[] = {1, 3, 16, len};
+  for (size_t piece : pieces) {
+    audio::LinkFrameParser p;
+    link_rx rx{};
+    link_feed(p, rx, frame, len, piece);
+    zassert_equal(rx.count, 1, "piece %u: frames", (unsigned)piece);
+    zassert_equal(rx.hdr[0].seq, 7);
+    zassert_equal(rx.hdr[0].timestamp, 160U * 7 + 0x10000000U);
+    zassert_equal(rx.hdr[0].flags, audio::LinkFrameHeader::kCos);
+    zassert_equal(rx.hdr[0].adpcm.predictor, -1234);
+    zassert_equal(rx.hdr[0].adpcm.index, 42);
+    zassert_equal(rx.hdr[0].length, 80);
+    zassert_equal(rx.first_payload[0], 0x3C);
+    zassert_equal(p.stats().crc_errors, 0U);
+  }
+}
+
+ZTEST(link_frame, test_corrupt_frame_costs_only_itself) {
+  static uint8_t stream[3 * audio::kLinkMaxFrameBytes];
+  size_t len = 0;
+  for (uint16_t seq = 0; seq < 3; seq++) {
+    len += link_make(seq, static_cast<uint8_t>(0x10 + seq), &stream[len], sizeof(stream) - len);
+  }
+  stream[95 + 20] ^= 0x01; /* payload bit flip in the second frame */
+
+  audio::LinkFrameParser p;
+  link_rx rx{};
+  link_feed(p, rx, stream, len, 7);
+  zassert_equal(rx.count, 2, "frames around the corrupt one must survive");
+  zassert_equal(rx.hdr[0].seq, 0);
+  zassert_equal(rx.hdr[1].seq, 2);
+  zassert_equal(p.stats().crc_errors, 1U);
+}
+
+ZTEST(link_frame, test_truncated_frame_and_garbage_resync) {
+  static uint8_t stream[3 * audio::kLinkMaxFrameBytes];
+  const uint8_t garbage[] = {0x00, 0xA5, 0x13, 0x5A, 0xA5};
+  size_t len = 0;
+  memcpy(stream, garbage, sizeof(garbage));
+  len += sizeof(garbage);
+  len += link_make(1, 0x21, &stream[len], sizeof(stream) - len) - 30; /* cut short */
+  len += link_make(2, 0x22, &stream[len], sizeof(stream) - len);
+
+  audio::LinkFrameParser p;
+  link_rx rx{};
+  link_feed(p, rx, stream, len, 5);
+  zassert_equal(rx.count, 1, "frame after the truncated one must be found");
+  zassert_equal(rx.hdr[0].seq, 2);
+  zassert_equal(rx.first_payload[0], 0x22);
+  zassert_true(p.stats().skipped > 0, "garbage must be counted");
+}
+
+ZTEST(link_frame, test_encode_rejects_small_buffer) {
+  uint8_t frame[40];
+  zassert_equal(link_make(0, 0, frame, sizeof(frame)), 0U);
+}
+
+ZTEST_SUITE(jitter_buffer, NULL, NULL, NULL, NULL, NULL);
+
+using TestJb = audio::JitterBuffer<8, 4>;
+
+static void jb_put(TestJb &jb, uint16_t seq, int32_t arrival_offset = 0) {
+  int16_t pcm[4];
+  for (int16_t &v : pcm) {
+    v = static_cast<int16_t>(100 * (seq + 1));
+  }
+  jb.put(seq, 4U * seq, static_cast<uint32_t>(4 * seq + arrival_offset), pcm);
+}
+
+/* Play one frame; returns its (constant) sample value. */
+static int16_t jb_get(TestJb &jb) {
+  int16_t out[4];
+  jb.get(out, 4);
+  return out[3];
+}
+
+ZTEST(jitter_buffer, test_buffers_to_target_then_plays_in_order) {
+  TestJb jb;
+  jb.init({2, 6});
+  jb_put(jb, 0);
+  zassert_equal(jb_get(jb), 0, "must buffer until the target depth");
+  zassert_false(jb.playing());
+  jb_put(jb, 1);
+  zassert_equal(jb_get(jb), 100);
+  zassert_true(jb.playing());
+  jb_put(jb, 2);
+  zassert_equal(jb_get(jb), 200);
+  zassert_equal(jb_get(jb), 300);
+  zassert_equal(jb.stats().played, 3U);
+  zassert_equal(jb.stats().concealed, 0U);
+}
+
+ZTEST(jitter_buffer, test_reordered_frames_play_in_sequence) {
+  TestJb jb;
+  jb.init({2, 6});
+  jb_put(jb, 1);
+  jb_put(jb, 0);
+  jb_put(jb, 3);
+  jb_put(jb, 2);
+  for (int16_t k = 1; k <= 4; k++) {
+    zassert_equal(jb_get(jb), 100 * k, "frame %d", k - 1);
+  }
+  zassert_equal(jb.stats().late, 0U);
+}
+
+ZTEST(jitter_buffer, test_lost_frame_is_concealed) {
+  TestJb jb;
+  jb.init({2, 6});
+  jb_put(jb, 0);
+  jb_put(jb, 1);
+  jb_put(jb, 3);
+  jb_put(jb, 4);
+  zassert_equal(jb_get(jb), 100);
+  zassert_equal(jb_get(jb), 200);
+  zassert_equal(jb_get(jb), 100, "previous frame at half level");
+  zassert_equal(jb_get(jb), 400);
+  zassert_equal(jb_get(jb), 500);
+  zassert_equal(jb.stats().concealed, 1U);
+  zassert_equal(jb.stats().underruns, 0U);
+}
+
+ZTEST(jitter_buffer, test_underrun_rebuffers_deeper) {
+  TestJb jb;
+  jb.init({2, 6});
+  jb_put(jb, 0);
+  jb_put(jb, 1);
+  zassert_equal(jb_get(jb), 100);
+  zassert_equal(jb_get(jb), 200);
+  zassert_equal(jb_get(jb), 0, "dry: silence");
+  zassert_equal(jb.stats().underruns, 1U);
+  zassert_equal(jb.stats().target, 3, "one extra frame after an underrun");
+  zassert_false(jb.playing());
+
+  /* The missing frame was only late: it plays once the deeper target fills. */
+  jb_put(jb, 2);
+  jb_put(jb, 3);
+  zassert_equal(jb_get(jb), 0, "still below the new target");
+  jb_put(jb, 4);
+  zassert_equal(jb_get(jb), 300);
+  zassert_equal(jb.stats().concealed, 0U);
+}
+
+ZTEST(jitter_buffer, test_late_duplicate_and_resync) {
+  TestJb jb;
+  jb.init({2, 6});
+  jb_put(jb, 0);
+  jb_put(jb, 1);
+  jb_put(jb, 2);
+  (void)jb_get(jb);
+  jb_put(jb, 0);
+  zassert_equal(jb.stats().late, 1U);
+  jb_put(jb, 2);
+  zassert_equal(jb.stats().duplicates, 1U);
+
+  /* Far beyond the window (sender restarted): flush and follow. */
+  jb_put(jb, 1000);
+  zassert_equal(jb.stats().resyncs, 1U);
+  zassert_equal(jb.stats().depth, 1);
+  jb_put(jb, 1001);
+  zassert_equal(jb_get(jb), static_cast<int16_t>(100 * 1001));
+}
+
+ZTEST(jitter_buffer, test_backward_restart_resyncs) {
+  TestJb jb;
+  jb.init({2, 6});
+  for (uint16_t seq = 500; seq < 504; seq++) {
+    jb_put(jb, seq);
+    (void)jb_get(jb);
+  }
+  zassert_true(jb.playing());
+
+  /* The sender restarted at 0: far behind, not late. */
+  jb_put(jb, 0);
+  zassert_equal(jb.stats().resyncs, 1U);
+  zassert_equal(jb.stats().late, 0U);
+  jb_put(jb, 1);
+  zassert_equal(jb_get(jb), 100);
+  zassert_equal(jb_get(jb), 200);
+  zassert_equal(jb.stats().late, 0U);
+}
+
+ZTEST(jitter_buffer, test_jitter_raises_target) {
+  TestJb jb;
+  jb.init({2, 6});
+  for (uint16_t seq = 0; seq < 60; seq++) {
+    jb_put(jb, seq, (seq % 2) ? 6 : 0);
+    (void)jb_get(jb);
+  }
+  zassert_true(jb.stats().jitter_q4 >= 16 * 4, "jitter estimate %u", jb.stats().jitter_q4);
+  zassert_true(jb.stats().target > 2 && jb.stats().target <= 6, "target %u", jb.stats().target);
+}
+
+ZTEST_SUITE(pcm_ring, NULL, NULL, NULL, NULL, NULL);
+
+static void ring_put(struct pcm_ring &r, int16_t v) {
+  int16_t *slot = pcm_ring_claim(&r);
+  zassert_not_null(slot);
+  slot[0] = v;
+  pcm_ring_commit(&r);
+}
+
+ZTEST(pcm_ring, test_fifo_until_full_then_counts_overruns) {
+  static struct pcm_ring r;
+  pcm_ring_reset(&r);
+  zassert_is_null(pcm_ring_peek(&r));
+  for (uint32_t i = 0; i < PCM_RING_BLOCKS; i++) {
+    ring_put(r, static_cast<int16_t>(i));
+  }
+  zassert_is_null(pcm_ring_claim(&r));
+  zassert_is_null(pcm_ring_claim(&r));
+  zassert_equal(pcm_ring_overruns(&r), 2U);
+  for (uint32_t i = 0; i < PCM_RING_BLOCKS; i++) {
+    const int16_t *b = pcm_ring_peek(&r);
+    zassert_not_null(b);
+    zassert_equal(b[0], static_cast<int16_t>(i));
+    pcm_ring_release(&r);
+  }
+  zassert_is_null(pcm_ring_peek(&r));
+}
+
+ZTEST(pcm_ring, test_peeked_block_stays_put_until_released) {
+  static struct pcm_ring r;
+  pcm_ring_reset(&r);
+  ring_put(r, 7);
+  const int16_t *b = pcm_ring_peek(&r);
+  /* The producer fills every other slot meanwhile; the one being read is not handed out. */
+  for (uint32_t i = 1; i < PCM_RING_BLOCKS; i++) {
+    ring_put(r, 100);
+  }
+  zassert_is_null(pcm_ring_claim(&r));
+  zassert_equal(b[0], 7);
+  pcm_ring_release(&r);
+  zassert_not_null(pcm_ring_claim(&r));
+}
+
+ZTEST(pcm_ring, test_indices_wrap) {
+  static struct pcm_ring r;
+  pcm_ring_reset(&r);
+  r.head = r.tail = UINT32_MAX - 3U;
+  for (int16_t i = 0; i < 10; i++) {
+    ring_put(r, i);
+    const int16_t *b = pcm_ring_peek(&r);
+    zassert_not_null(b);
+    zassert_equal(b[0], i);
+    pcm_ring_release(&r);
+  }
+  zassert_is_null(pcm_ring_peek(&r));
+  zassert_equal(pcm_ring_overruns(&r), 0U);
+}
+
+ZTEST_SUITE(irq_timing, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(irq_timing, test_exact_period_has_no_jitter) {
+  struct irq_timing t, snap;
+  irq_timing_reset(&t, 160000);
+  for (uint32_t i = 0; i < 10; i++) {
+    irq_timing_mark(&t, 5000 + i * 160000U);
+  }
+  irq_timing_read(&t, &snap);
+  zassert_equal(snap.count, 10U);
+  zassert_equal(snap.period_min, 160000U);
+  zassert_equal(snap.period_max, 160000U);
+  zassert_equal(snap.jitter_max, 0U);
+  zassert_equal(irq_timing_jitter_mean(&snap), 0U);
+  zassert_equal(snap.seq % 2U, 0U);
+}
+
+ZTEST(irq_timing, test_late_entry_shows_in_both_intervals) {
+  struct irq_timing t, snap;
+  irq_timing_reset(&t, 1000);
+  irq_timing_mark(&t, 0);
+  irq_timing_mark(&t, 1000);
+  irq_timing_mark(&t, 2300); /* entered 300 cycles late */
+  irq_timing_mark(&t, 3000);
+  irq_timing_read(&t, &snap);
+  zassert_equal(snap.period_min, 700U);
+  zassert_equal(snap.period_max, 1300U);
+  zassert_equal(snap.jitter_max, 300U);
+  zassert_equal(irq_timing_jitter_mean(&snap), 200U); /* (0 + 300 + 300) / 3 */
+}
+
+ZTEST(irq_timing, test_cycle_counter_wrap) {
+  struct irq_timing t, snap;
+  irq_timing_reset(&t, 1000);
+  irq_timing_mark(&t, UINT32_MAX - 499U);
+  irq_timing_mark(&t, 500);
+  irq_timing_read(&t, &snap);
+  zassert_equal(snap.period_max, 1000U);
+  zassert_equal(snap.jitter_max, 0U);
+}
+
+/* ---- Module action scheduler ---------------------------------------------- */
+
+using sched::ActionScheduler;
+
+static sched::Spec sched_spec(uint32_t delay_ms, uint32_t period_ms, const char *cap) {
+  sched::Spec spec{};
+  spec.delay_ms = delay_ms;
+  spec.period_ms = period_ms;
+  spec.action.op = sched::Op::kDo;
+  strcpy(spec.action.module, "fm");
+  strcpy(spec.action.cap, cap);
+  return spec;
+}
+
+ZTEST_SUITE(action_scheduler, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(action_scheduler, test_parse) {
+  uint32_t slot;
+  sched::Spec spec;
+  zassert_true(sched::parse("3:5000:600000:fm:do:ptt:on", &slot, &spec));
+  zassert_equal(slot, 3U);
+  zassert_equal(spec.delay_ms, 5000U);
+  zassert_equal(spec.period_ms, 600000U);
+  zassert_str_equal(spec.action.module, "fm");
+  zassert_equal(spec.action.op, sched::Op::kDo);
+  zassert_str_equal(spec.action.cap, "ptt");
+  zassert_str_equal(spec.action.value, "on");
+
+  zassert_true(sched::parse("0:0:0:fm:get:rssi", &slot, &spec), "value is optional");
+  zassert_str_equal(spec.action.value, "");
+  zassert_true(sched::parse("1:10:0:aux:set:text:a:b", &slot, &spec), "value keeps its colons");
+  zassert_str_equal(spec.action.value, "a:b");
+
+  zassert_false(sched::parse("x:0:0:fm:do:ptt:on", &slot, &spec));
+  zassert_false(sched::parse("0:0:0:fm:run:ptt:on", &slot, &spec));
+  zassert_false(sched::parse("0:0:0::do:ptt:on", &slot, &spec));
+  zassert_false(sched::parse("0:0:0:fm:do", &slot, &spec));
+  zassert_false(sched::parse("0:99999999999:0:fm:do:ptt:on", &slot, &spec));
+  zassert_false(sched::parse("0:0:0:a_module_id_too_long:do:ptt:on", &slot, &spec));
+}
+
+ZTEST(action_scheduler, test_one_shot_and_periodic_in_due_order) {
+  static ActionScheduler::Entry table[4];
+  ActionScheduler s(table);
+  zassert_true(s.set(0, sched_spec(100, 0, "once"), 0));
+  zassert_true(s.set(2, sched_spec(40, 50, "every"), 0));
+  zassert_false(s.set(4, sched_spec(1, 0, "x"), 0), "slot out of range");
+  zassert_equal(s.used(), 2U);
+
+  uint64_t due;
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, 40000U);
+
+  uint64_t now = 0;
+  size_t order[8];
+  size_t n = 0;
+  auto exec = [&](size_t slot, const sched::Action &) {
+    order[n++] = slot;
+    return true;
+  };
+  auto clock = [&]() { return now; };
+
+  now = 39999;
+  zassert_equal(s.run_due(now, clock, exec), 0U, "not due a microsecond early");
+  now = 40000;
+  zassert_equal(s.run_due(now, clock, exec), 1U);
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, 90000U, "period counts from the due time");
+
+  now = 100000; /* both the periodic (90 ms) and the one-shot (100 ms) */
+  zassert_equal(s.run_due(now, clock, exec), 2U);
+  zassert_equal(order[1], 2U, "earliest first");
+  zassert_equal(order[2], 0U);
+  zassert_false(s.entry(0).used, "one-shot freed");
+  zassert_equal(s.entry(2).late_last_us, 10000U);
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, 140000U, "lateness does not drift the period");
+}
+
+ZTEST(action_scheduler, test_jitter_and_skipped_periods) {
+  static ActionScheduler::Entry table[2];
+  ActionScheduler s(table);
+  s.set(0, sched_spec(10, 10, "beacon"), 0);
+
+  uint64_t now = 0;
+  auto clock = [&]() { return now; };
+  bool ok = true;
+  auto exec = [&](size_t, const sched::Action &) { return ok; };
+
+  now = 10300; /* 300 us late */
+  s.run_due(now, clock, exec);
+  now = 20100; /* 100 us late */
+  ok = false;
+  s.run_due(now, clock, exec);
+  now = 55000; /* due at 30 ms: 25 ms late, the 40 and 50 ms runs are gone */
+  ok = true;
+  s.run_due(now, clock, exec);
+
+  const ActionScheduler::Stats &st = s.stats();
+  zassert_equal(st.runs, 3U);
+  zassert_equal(st.failures, 1U);
+  zassert_equal(st.skipped, 2U);
+  zassert_equal(st.late_last_us, 25000U);
+  zassert_equal(st.late_max_us, 25000U);
+  zassert_equal(st.late_mean_us(), (300U + 100U + 25000U) / 3U);
+  zassert_equal(st.late_rms_us(), 14434U); /* sqrt((300^2 + 100^2 + 25000^2) / 3) */
+  zassert_equal(s.entry(0).skipped, 2U);
+  uint64_t due;
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, 60000U, "phase kept across the gap");
+
+  s.reset_stats();
+  zassert_equal(s.stats().runs, 0U);
+  zassert_equal(s.entry(0).late_max_us, 0U);
+}
+
+ZTEST(action_scheduler, test_far_entries_and_clock_reading) {
+  static ActionScheduler::Entry table[3];
+  ActionScheduler s(table);
+  /* Same wheel bucket, different revolutions. */
+  const uint32_t rev_ms = ActionScheduler::kWheelSlots * ActionScheduler::kTickUs / 1000U;
+  s.set(0, sched_spec(5 + 3 * rev_ms, 0, "far"), 0);
+  s.set(1, sched_spec(5, 0, "near"), 0);
+  s.set(2, sched_spec(3600000, 0, "hour"), 0);
+
+  uint64_t due;
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, 5000U);
+
+  uint64_t now = 5000;
+  size_t ran_slot = 99;
+  auto exec = [&](size_t slot, const sched::Action &) {
+    ran_slot = slot;
+    now += 700; /* the operation takes 0.7 ms */
+    return true;
+  };
+  auto clock = [&]() { return now; };
+  zassert_equal(s.run_due(now, clock, exec), 1U, "later revolution stays put");
+  zassert_equal(ran_slot, 1U);
+  zassert_true(s.next_due(&due));
+  zassert_equal(due, (5U + 3U * rev_ms) * 1000U, "beyond one revolution");
+
+  /* Long idle gap: the whole wheel is walked once. */
+  now = 3600000000ULL;
+  zassert_equal(s.run_due(now, clock, exec), 2U);
+  zassert_false(s.next_due(&due), "table empty");
+
+  /* Two entries due together: the second one's lateness includes the first's run. */
+  s.set(0, sched_spec(1, 0, "a"), now);
+  s.set(1, sched_spec(1, 0, "b"), now);
+  now += 1000;
+  zassert_equal(s.run_due(now, clock, exec), 2U);
+  zassert_equal(s.stats().late_last_us, 700U);
+
+  zassert_true(s.set(2, sched_spec(1, 5, "p"), now));
+  zassert_true(s.remove(2));
+  zassert_false(s.remove(2));
+  zassert_false(s.next_due(&due));
+}
+
+/* ---- Adaptive RX notch ----------------------------------------------------- */
+
+using audio::AdaptiveNotch;
+
+static constexpr size_t kNotchBlock = 8;
+static constexpr size_t kNotchLen = 16000; /* 2 s at 8 kHz */
+static int16_t notch_in[kNotchLen];
+static int16_t notch_buf[kNotchLen];
+
+/* Two tones plus uniform noise (fixed LCG, so runs are repeatable). */
+static void notch_signal(double f1, double a1, double f2, double a2, int32_t noise) {
+  uint32_t lcg = 1;
+  for (size_t i = 0; i < kNotchLen; i++) {
+    lcg = lcg * 1664525U + 1013904223U;
+    const int32_t n = noise ? (int32_t)(lcg >> 16) % (2 * noise + 1) - noise : 0;
+    const double t = (double)i / 8000.0;
+    notch_in[i] = (int16_t)(lround(a1 * sin(2.0 * M_PI * f1 * t) + a2 * sin(2.0 * M_PI * f2 * t)) + n);
+  }
+  memcpy(notch_buf, notch_in, sizeof(notch_buf));
+}
+
+static void notch_run(AdaptiveNotch &f, bool enabled) {
+  for (size_t i = 0; i < kNotchLen; i += kNotchBlock) {
+    f.process(&notch_buf[i], kNotchBlock, enabled);
+  }
+}
+
+static double notch_freq(const AdaptiveNotch &f, size_t i) {
+  return acos(-(double)f.section(i).a / (double)(1 << AdaptiveNotch::kCoefBits) / 2.0) * 8000.0 / (2.0 * M_PI);
+}
+
+/* Power over the last quarter, input vs output, in dB. */
+static double notch_depth_db() {
+  double in = 0;
+  double out = 0;
+  for (size_t i = kNotchLen * 3 / 4; i < kNotchLen; i++) {
+    in += (double)notch_in[i] * notch_in[i];
+    out += (double)notch_buf[i] * notch_buf[i];
+  }
+  return 10.0 * log10(in / (out + 1.0));
+}
+
+ZTEST_SUITE(adaptive_notch, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(adaptive_notch, test_hum_converges_and_locks) {
+  AdaptiveNotch f({1, 10, 7}, true);
+  notch_signal(50.0, 8000, 0, 0, 0);
+  notch_run(f, true);
+  const AdaptiveNotch::SectionStatus s = f.section(0);
+  zassert_true(s.locked);
+  zassert_equal(s.locks, 1U);
+  zassert_true(s.converge_samples <= 1600U, "converged after %u samples", s.converge_samples);
+  zassert_within(notch_freq(f, 0), 50.0, 0.5);
+  zassert_true(notch_depth_db() > 30.0, "depth %.1f dB", notch_depth_db());
+}
+
+ZTEST(adaptive_notch, test_tracks_distant_tone) {
+  /* From the 50 Hz start onto a stray carrier far up the band. */
+  AdaptiveNotch f({1, 10, 7}, true);
+  notch_signal(1234.0, 4000, 0, 0, 200);
+  notch_run(f, true);
+  zassert_true(f.section(0).locked);
+  zassert_within(notch_freq(f, 0), 1234.0, 2.0);
+  zassert_true(notch_depth_db() > 15.0, "depth %.1f dB", notch_depth_db());
+}
+
+ZTEST(adaptive_notch, test_cascade_takes_two_tones) {
+  AdaptiveNotch f({2, 10, 7}, true);
+  notch_signal(50.0, 6000, 1000.0, 2000, 0);
+  notch_run(f, true);
+  zassert_true(f.section(0).locked && f.section(1).locked);
+  const double lo = fmin(notch_freq(f, 0), notch_freq(f, 1));
+  const double hi = fmax(notch_freq(f, 0), notch_freq(f, 1));
+  zassert_within(lo, 50.0, 1.0);
+  zassert_within(hi, 1000.0, 1.0);
+  zassert_true(notch_depth_db() > 25.0, "depth %.1f dB", notch_depth_db());
+}
+
+ZTEST(adaptive_notch, test_disabled_is_bit_exact_but_adapts) {
+  AdaptiveNotch f({1, 10, 7});
+  notch_signal(50.0, 8000, 0, 0, 100);
+  notch_run(f, false);
+  zassert_mem_equal(notch_buf, notch_in, sizeof(notch_buf));
+  zassert_true(f.section(0).locked);
+  zassert_within(notch_freq(f, 0), 50.0, 0.5);
+
+  f.reset();
+  zassert_false(f.section(0).locked);
+  zassert_equal(f.section(0).locks, 0U);
+}
+
+ZTEST(adaptive_notch, test_noise_never_locks) {
+  AdaptiveNotch f({2, 10, 7}, true);
+  notch_signal(0, 0, 0, 0, 6000);
+  notch_run(f, true);
+  zassert_equal(f.section(0).locks, 0U);
+  zassert_equal(f.section(1).locks, 0U);
+  /* A notch on white noise takes a sliver of it, nothing more. */
+  zassert_true(notch_depth_db() < 0.5, "depth %.1f dB", notch_depth_db());
+}
+
+/* ---- Voice prompts --------------------------------------------------------- */
+
+using voice::Word;
+
+static size_t voice_compose(const char *text, Word *out) { return voice::compose(text, out, voice::Player::kMaxWords); }
+
+static Word voice_letter(char c) { return (Word)((size_t)Word::kA + (size_t)(c - 'a')); }
+
+ZTEST_SUITE(voice_prompt, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(voice_prompt, test_compose_frequency) {
+  Word w[voice::Player::kMaxWords];
+  const Word want[] = {Word::k4, Word::k3, Word::k3, Word::kPoint, Word::k5, Word::kPause, Word::kMegahertz};
+  zassert_equal(voice_compose("433.5000 MHz", w), sizeof(want) / sizeof(want[0]));
+  zassert_mem_equal(w, want, sizeof(want));
+
+  /* An all-zero fraction has no "point"; quotes (JSON strings) are not spoken. */
+  const Word whole[] = {Word::k4, Word::k3, Word::k3};
+  zassert_equal(voice_compose("\"433.000\"", w), sizeof(whole) / sizeof(whole[0]));
+  zassert_mem_equal(w, whole, sizeof(whole));
+
+  const Word neg[] = {Word::kMinus, Word::k1, Word::k2, Word::kPause, Word::kOff};
+  zassert_equal(voice_compose("  -12,, off ", w), sizeof(neg) / sizeof(neg[0]));
+  zassert_mem_equal(w, neg, sizeof(neg));
+}
+
+ZTEST(voice_prompt, test_compose_spells_unknown_words) {
+  Word w[voice::Player::kMaxWords];
+  const Word call[] = {voice_letter('o'), voice_letter('e'), Word::k5, voice_letter('x'), voice_letter('r'), voice_letter('x')};
+  zassert_equal(voice_compose("OE5XRX", w), sizeof(call) / sizeof(call[0]));
+  zassert_mem_equal(w, call, sizeof(call));
+  zassert_equal(strcmp(voice::word_name(w[0]), "o"), 0);
+
+  zassert_equal(voice_compose("true", w), 1U);
+  zassert_equal(w[0], Word::kOn);
+  zassert_equal(voice_compose("kHz", w), 1U);
+  zassert_equal(w[0], Word::kKilohertz);
+
+  zassert_equal(voice_compose("", w), 0U);
+  zassert_equal(voice_compose(" ;! ", w), 0U);
+  zassert_equal(voice::compose("12345", w, 4), 0U, "overflow is all or nothing");
+}
+
+/* A pack of three clips with odd lengths at odd code offsets, "point" missing. */
+static constexpr uint32_t kVoicePause = 11;
+static uint8_t voice_data[64];
+static voice::Clip voice_clips[voice::kClipCount];
+static int16_t voice_pcm[3][50];
+static const Word kVoiceWords[3] = {Word::k3, Word::k4, Word::kMegahertz};
+static const uint32_t kVoiceLen[3] = {37, 50, 23};
+static const voice::Pack voice_pack{voice_data, voice_clips, kVoicePause};
+
+static void voice_build_pack() {
+  memset(voice_data, 0, sizeof(voice_data));
+  memset(voice_clips, 0, sizeof(voice_clips));
+  uint32_t offset = 1;
+  for (size_t c = 0; c < 3; c++) {
+    for (size_t i = 0; i < kVoiceLen[c]; i++) {
+      voice_pcm[c][i] = (int16_t)(6000.0 * sin(0.3 * (double)(i + 1) * (double)(c + 1)));
+    }
+    const audio::AdpcmState start{(int16_t)(100 * c), (uint8_t)(10 * c)};
+    uint8_t codes[audio::adpcmBytes(50)];
+    audio::AdpcmState st = start;
+    audio::adpcmEncode(st, voice_pcm[c], kVoiceLen[c], codes);
+    for (size_t i = 0; i < kVoiceLen[c]; i++) {
+      const uint8_t code = (codes[i / 2] >> (4 * (i % 2))) & 0x0F;
+      voice_data[(offset + i) / 2] |= (uint8_t)(code << (4 * ((offset + i) % 2)));
+    }
+    voice_clips[(size_t)kVoiceWords[c]] = {offset, kVoiceLen[c], start};
+    /* What the clip decodes to on its own: the reference for the joins. */
+    st = start;
+    audio::adpcmDecode(st, codes, kVoiceLen[c], voice_pcm[c]);
+    offset += kVoiceLen[c];
+  }
+}
+
+ZTEST(voice_prompt, test_player_joins_are_gapless) {
+  voice_build_pack();
+  const Word words[] = {Word::k3, Word::kPoint, Word::k4, Word::kPause, Word::kMegahertz, Word::k3};
+  int16_t want[37 + 50 + kVoicePause + 23 + 37];
+  size_t n = 0;
+  for (size_t c : {0, 1}) {
+    memcpy(&want[n], voice_pcm[c], kVoiceLen[c] * sizeof(int16_t));
+    n += kVoiceLen[c];
+  }
+  memset(&want[n], 0, kVoicePause * sizeof(int16_t));
+  n += kVoicePause;
+  for (size_t c : {2, 0}) {
+    memcpy(&want[n], voice_pcm[c], kVoiceLen[c] * sizeof(int16_t));
+    n += kVoiceLen[c];
+  }
+
+  /* Any block size: clip boundaries fall anywhere inside a block. */
+  for (size_t block : {1, 7, 8, 13, 200}) {
+    voice::Player p(voice_pack);
+    zassert_true(p.start(words, sizeof(words) / sizeof(words[0])));
+    zassert_equal(p.length(), sizeof(want) / sizeof(want[0]));
+    zassert_equal(p.missing(), 1U);
+    int16_t got[sizeof(want) / sizeof(want[0]) + 200];
+    size_t total = 0;
+    while (p.active()) {
+      const size_t k = p.fill(&got[total], block);
+      zassert_true(k == block || !p.active(), "short block mid-utterance");
+      total += k;
+    }
+    zassert_equal(total, sizeof(want) / sizeof(want[0]), "block %u", (unsigned)block);
+    zassert_mem_equal(got, want, sizeof(want), "block %u", (unsigned)block);
+    zassert_equal(p.fill(got, block), 0U);
+  }
+}
+
+ZTEST(voice_prompt, test_player_limits) {
+  voice_build_pack();
+  voice::Player p(voice_pack);
+  Word words[voice::Player::kMaxWords + 1] = {};
+  zassert_false(p.start(words, sizeof(words) / sizeof(words[0])));
+  zassert_false(p.active());
+
+  /* Nothing but missing clips: no samples at all. */
+  const Word missing[] = {Word::kPoint, voice_letter('a')};
+  zassert_true(p.start(missing, sizeof(missing) / sizeof(missing[0])));
+  zassert_false(p.active());
+  zassert_equal(p.length(), 0U);
+  zassert_equal(p.missing(), 2U);
+
+  zassert_true(p.start(kVoiceWords, 3));
+  int16_t buf[8];
+  zassert_equal(p.fill(buf, sizeof(buf) / sizeof(buf[0])), sizeof(buf) / sizeof(buf[0]));
+  p.stop();
+  zassert_false(p.active());
+  zassert_equal(p.fill(buf, sizeof(buf) / sizeof(buf[0])), 0U);
+}
+
+/* ---- USB drive: virtual FAT and log ring ------------------------------------ */
+
+using msc::LogRing;
+using msc::VirtualFat;
+
+/* File content is a function of the offset, so any sector can be checked. */
+static uint8_t vfat_byte(uintptr_t file, uint32_t offset) { return (uint8_t)(offset * 7U + offset / 251U + file); }
+
+static void vfat_file(uint32_t offset, uint8_t *dst, uint32_t len, void *user) {
+  for (uint32_t i = 0; i < len; i++) {
+    dst[i] = vfat_byte((uintptr_t)user, offset + i);
+  }
+}
+
+static uint32_t vfat_get16(const uint8_t *p) { return p[0] | (uint32_t)p[1] << 8; }
+
+static uint32_t vfat_get32(const uint8_t *p) { return vfat_get16(p) | vfat_get16(p + 2) << 16; }
+
+/* Read a file back the way a host does: boot sector, root directory, FAT chain. */
+static bool vfat_check_file(const VirtualFat &fat, const char name[11], uintptr_t id, uint32_t size) {
+  uint8_t sec[VirtualFat::kSectorSize];
+  fat.read(0, sec);
+  const uint32_t spc = sec[13];
+  const uint32_t fat_start = vfat_get16(sec + 14);
+  const uint32_t root_start = fat_start + sec[16] * vfat_get16(sec + 22);
+  const uint32_t data_start = root_start + vfat_get16(sec + 17) * 32U / VirtualFat::kSectorSize;
+
+  uint32_t cluster = 0;
+  bool found = false;
+  for (uint32_t e = 0; e < vfat_get16(sec + 17) && !found; e++) {
+    uint8_t dir[VirtualFat::kSectorSize];
+    fat.read(root_start + e / 16U, dir);
+    const uint8_t *ent = dir + 32U * (e % 16U);
+    if (memcmp(ent, name, 11) == 0) {
+      found = ent[11] == 0x21 && vfat_get32(ent + 28) == size;
+      cluster = vfat_get16(ent + 26);
+    }
+  }
+  if (!found) {
+    return false;
+  }
+  uint32_t offset = 0;
+  while (offset < size) {
+    if (cluster < 2 || cluster >= 0xFFF8) {
+      return false;
+    }
+    for (uint32_t s = 0; s < spc && offset < size; s++) {
+      fat.read(data_start + (cluster - 2U) * spc + s, sec);
+      for (uint32_t i = 0; i < VirtualFat::kSectorSize; i++, offset++) {
+        if (sec[i] != (offset < size ? vfat_byte(id, offset) : 0)) {
+          return false;
+        }
+      }
+    }
+    uint8_t fs[VirtualFat::kSectorSize];
+    fat.read(fat_start + cluster / 256U, fs);
+    cluster = vfat_get16(fs + 2U * (cluster % 256U));
+  }
+  return cluster >= 0xFFF8 || size == 0;
+}
+
+ZTEST_SUITE(virtual_fat, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(virtual_fat, test_boot_sector_is_fat16) {
+  VirtualFat fat("oe5xrx fm", 0x12345678);
+  uint8_t sec[VirtualFat::kSectorSize];
+  fat.read(0, sec);
+  zassert_equal(sec[510], 0x55);
+  zassert_equal(sec[511], 0xAA);
+  zassert_equal(vfat_get16(sec + 11), 512U);
+  zassert_equal(vfat_get16(sec + 19), VirtualFat::kSectorCount);
+  zassert_mem_equal(sec + 43, "OE5XRX FM  ", 11);
+  zassert_mem_equal(sec + 54, "FAT16   ", 8);
+  zassert_equal(vfat_get32(sec + 39), 0x12345678U);
+
+  /* Hosts pick FAT12/16/32 by the cluster count alone. */
+  const uint32_t fat_sectors = vfat_get16(sec + 22);
+  const uint32_t data = VirtualFat::kSectorCount - vfat_get16(sec + 14) - sec[16] * fat_sectors - vfat_get16(sec + 17) * 32U / 512U;
+  const uint32_t clusters = data / sec[13];
+  zassert_true(clusters >= 4085U && clusters < 65525U, "%u clusters", clusters);
+  zassert_true(fat_sectors * 256U >= clusters + 2U, "FAT too small");
+
+  /* Both FAT copies start with the media entries; the label is root entry 0. */
+  fat.read(1, sec);
+  zassert_equal(vfat_get16(sec), 0xFFF8U);
+  fat.read(1 + fat_sectors, sec);
+  zassert_equal(vfat_get16(sec), 0xFFF8U);
+  fat.read(VirtualFat::kFirstRootSector, sec);
+  zassert_equal(sec[11], 0x08);
+}
+
+ZTEST(virtual_fat, test_files_read_back_through_fat) {
+  static VirtualFat fat("FM", 1);
+  /* Sub-sector, empty, exactly one cluster, and one spanning FAT sectors. */
+  zassert_true(fat.add("log.txt", 300, vfat_file, (void *)1));
+  zassert_true(fat.add("EMPTY.BIN", 0, vfat_file, (void *)2));
+  zassert_true(fat.add("ONE", VirtualFat::kClusterSize, vfat_file, (void *)3));
+  zassert_true(fat.add("BIG.WAV", 300U * VirtualFat::kClusterSize + 17U, vfat_file, (void *)4));
+  zassert_equal(fat.files(), 4U);
+
+  zassert_true(vfat_check_file(fat, "LOG     TXT", 1, 300));
+  zassert_true(vfat_check_file(fat, "EMPTY   BIN", 2, 0));
+  zassert_true(vfat_check_file(fat, "ONE        ", 3, VirtualFat::kClusterSize));
+  zassert_true(vfat_check_file(fat, "BIG     WAV", 4, 300U * VirtualFat::kClusterSize + 17U));
+
+  /* Past the last file and past the volume: zeros. */
+  uint8_t sec[VirtualFat::kSectorSize];
+  const uint8_t zero[VirtualFat::kSectorSize] = {};
+  fat.read(VirtualFat::kSectorCount - 1U, sec);
+  zassert_mem_equal(sec, zero, sizeof(sec));
+  fat.read(VirtualFat::kSectorCount + 5U, sec);
+  zassert_mem_equal(sec, zero, sizeof(sec));
+
+  fat.clear();
+  zassert_equal(fat.files(), 0U);
+  fat.read(VirtualFat::kFirstRootSector, sec);
+  zassert_equal(sec[32], 0, "root entry 1 must be free after clear()");
+}
+
+ZTEST(virtual_fat, test_add_rejects) {
+  static VirtualFat fat("FM", 1);
+  zassert_false(fat.add("", 1, vfat_file, NULL));
+  zassert_false(fat.add(".TXT", 1, vfat_file, NULL));
+  zassert_false(fat.add("TOOLONGNAME.TXT", 1, vfat_file, NULL));
+  zassert_false(fat.add("A.TEXT", 1, vfat_file, NULL));
+  zassert_false(fat.add("A B.TXT", 1, vfat_file, NULL));
+  zassert_false(fat.add("A.TXT", 1, NULL, NULL));
+  zassert_false(fat.add("HUGE.BIN", VirtualFat::kSectorCount * VirtualFat::kSectorSize, vfat_file, NULL));
+  for (size_t i = 0; i < VirtualFat::kMaxFiles; i++) {
+    zassert_true(fat.add("F.TXT", 1, vfat_file, NULL));
+  }
+  zassert_false(fat.add("F.TXT", 1, vfat_file, NULL));
+}
+
+static LogRing::Control ring_ctl;
+static uint8_t ring_data[64];
+
+ZTEST_SUITE(log_ring, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(log_ring, test_keeps_newest_bytes) {
+  memset(&ring_ctl, 0xA5, sizeof(ring_ctl)); /* power-on garbage */
+  LogRing r(ring_ctl, ring_data, sizeof(ring_data));
+  zassert_false(r.attach());
+  zassert_equal(r.size(), 0U);
+
+  char text[200];
+  for (size_t i = 0; i < sizeof(text); i++) {
+    text[i] = (char)('a' + i % 26);
+  }
+  r.write((const uint8_t *)text, 10);
+  zassert_equal(r.size(), 10U);
+  r.write((const uint8_t *)text + 10, 100); /* wraps */
+  r.write((const uint8_t *)text + 110, 90); /* longer than the ring after one more wrap */
+  zassert_equal(r.size(), sizeof(ring_data));
+
+  const LogRing::Snapshot snap = r.snapshot();
+  uint8_t out[sizeof(ring_data)];
+  r.read(snap, 0, out, snap.size);
+  zassert_mem_equal(out, text + sizeof(text) - sizeof(ring_data), sizeof(ring_data));
+  r.read(snap, 60, out, 4);
+  zassert_mem_equal(out, text + sizeof(text) - 4, 4);
+}
+
+ZTEST(log_ring, test_snapshot_survives_writes_and_reset) {
+  memset(&ring_ctl, 0, sizeof(ring_ctl));
+  LogRing r(ring_ctl, ring_data, sizeof(ring_data));
+  zassert_false(r.attach());
+  r.write((const uint8_t *)"0123456789", 10);
+  const LogRing::Snapshot snap = r.snapshot();
+
+  /* 60 more bytes overwrite the snapshot's first 6. */
+  uint8_t fill[60];
+  memset(fill, '#', sizeof(fill));
+  r.write(fill, sizeof(fill));
+  uint8_t out[10];
+  r.read(snap, 0, out, sizeof(out));
+  zassert_mem_equal(out, "      6789", 10);
+
+  /* A warm reset keeps the text; a corrupted control block does not. */
+  LogRing again(ring_ctl, ring_data, sizeof(ring_data));
+  zassert_true(again.attach());
+  zassert_equal(again.boots(), 1U);
+  zassert_equal(again.size(), 64U);
+  ring_ctl.head ^= 1U;
+  zassert_false(again.attach());
+  zassert_equal(again.size(), 0U);
+}